@@ -5,7 +5,7 @@
 //~ rjf: Layer Initialization
 
 internal void
-ac_init(void)
+ac_init(CmdLine *cmdline)
 {
   Arena *arena = arena_alloc();
   ac_shared = push_array(arena, AC_Shared, 1);
@@ -13,6 +13,16 @@ ac_init(void)
   ac_shared->cache_slots_count = 256;
   ac_shared->cache_slots = push_array(arena, AC_Cache *, ac_shared->cache_slots_count);
   ac_shared->cache_stripes = stripe_array_alloc(arena);
+  ac_shared->budget_size = AC_DEFAULT_BUDGET_SIZE;
+  String8 budget_mb_string = cmd_line_string(cmdline, str8_lit("artifact_cache_budget_mb"));
+  if(budget_mb_string.size != 0)
+  {
+    U64 budget_mb = 0;
+    if(try_u64_from_str8_c_rules(budget_mb_string, &budget_mb))
+    {
+      ac_shared->budget_size = MB(budget_mb);
+    }
+  }
   for EachElement(idx, ac_shared->req_batches)
   {
     ac_shared->req_batches[idx].mutex = mutex_alloc();
@@ -21,6 +31,265 @@ ac_init(void)
   ac_shared->cancel_thread = thread_launch(ac_cancel_thread_entry_point, 0);
   ac_shared->cancel_thread_mutex = mutex_alloc();
   mutex_take(ac_shared->cancel_thread_mutex);
+  
+  //- rjf: launch express threads, which take high priority thin requests
+  // outside of the lockstep async tick, so they never wait on wide jobs
+  ac_shared->express_batch.mutex = mutex_alloc();
+  ac_shared->express_batch.arena = arena_alloc();
+  ac_shared->express_cv = cond_var_alloc();
+  ac_shared->express_threads_count = Clamp(2, os_get_system_info()->logical_processor_count/4, 4);
+  String8 express_threads_count_string = cmd_line_string(cmdline, str8_lit("ac_express_thread_count"));
+  if(express_threads_count_string.size != 0)
+  {
+    try_u64_from_str8_c_rules(express_threads_count_string, &ac_shared->express_threads_count);
+  }
+  ac_shared->express_threads = push_array(arena, Thread, ac_shared->express_threads_count);
+  for EachIndex(idx, ac_shared->express_threads_count)
+  {
+    ac_shared->express_threads[idx] = thread_launch(ac_express_thread_entry_point, (void *)idx);
+  }
+}
+
+////////////////////////////////
+//~ rjf: Memory Accounting
+
+internal void
+ac_node_set_size(AC_Cache *cache, AC_Node *node, U64 size)
+{
+  U64 old_size = node->size;
+  node->size = size;
+  ins_atomic_u64_add_eval(&cache->counters.total_size, size - old_size);
+  ins_atomic_u64_add_eval(&ac_shared->total_size, size - old_size);
+}
+
+internal int
+ac_evict_candidate_compare(AC_EvictCandidate *a, AC_EvictCandidate *b)
+{
+  int result = 0;
+  if(a->last_time_touched_us < b->last_time_touched_us)
+  {
+    result = -1;
+  }
+  else if(a->last_time_touched_us > b->last_time_touched_us)
+  {
+    result = +1;
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Statistics
+
+internal void
+ac_latency_histogram_record(AC_LatencyHistogram *histogram, U64 us)
+{
+  U64 bucket_idx = (us == 0 ? 0 : 64 - clz64(us));
+  bucket_idx = Min(bucket_idx, AC_LATENCY_BUCKET_COUNT-1);
+  ins_atomic_u64_inc_eval(&histogram->counts[bucket_idx]);
+  ins_atomic_u64_inc_eval(&histogram->total_count);
+  ins_atomic_u64_add_eval(&histogram->total_us, us);
+  for(U64 max_us = ins_atomic_u64_eval(&histogram->max_us); max_us < us;)
+  {
+    U64 prev_max_us = ins_atomic_u64_eval_cond_assign(&histogram->max_us, us, max_us);
+    if(prev_max_us == max_us)
+    {
+      break;
+    }
+    max_us = prev_max_us;
+  }
+}
+
+internal U64
+ac_latency_histogram_percentile_us(AC_LatencyHistogram *histogram, F64 pct)
+{
+  U64 result = 0;
+  U64 total_count = 0;
+  for EachElement(idx, histogram->counts)
+  {
+    total_count += histogram->counts[idx];
+  }
+  if(total_count != 0)
+  {
+    U64 target_count = Max(1, (U64)(total_count*pct));
+    U64 running_count = 0;
+    for EachElement(idx, histogram->counts)
+    {
+      running_count += histogram->counts[idx];
+      if(running_count >= target_count)
+      {
+        result = (idx+1 < AC_LATENCY_BUCKET_COUNT ? (1ull<<idx) : histogram->max_us);
+        break;
+      }
+    }
+    result = Min(result, histogram->max_us);
+  }
+  return result;
+}
+
+internal AC_Stats
+ac_stats(Arena *arena)
+{
+  AC_Stats stats = {0};
+  
+  //- rjf: gather per-cache counters
+  {
+    Temp scratch = scratch_begin(&arena, 1);
+    typedef struct CacheNode CacheNode;
+    struct CacheNode
+    {
+      CacheNode *next;
+      AC_CacheStats v;
+    };
+    CacheNode *first = 0;
+    CacheNode *last = 0;
+    for EachIndex(cache_slot_idx, ac_shared->cache_slots_count)
+    {
+      Stripe *cache_stripe = stripe_from_slot_idx(&ac_shared->cache_stripes, cache_slot_idx);
+      RWMutexScope(cache_stripe->rw_mutex, 0)
+      {
+        for EachNode(cache, AC_Cache, ac_shared->cache_slots[cache_slot_idx])
+        {
+          CacheNode *n = push_array(scratch.arena, CacheNode, 1);
+          SLLQueuePush(first, last, n);
+          n->v.name = cache->name;
+          MemoryCopyStruct(&n->v.counters, &cache->counters);
+          stats.caches_count += 1;
+        }
+      }
+    }
+    stats.caches = push_array(arena, AC_CacheStats, stats.caches_count);
+    {
+      U64 idx = 0;
+      for EachNode(n, CacheNode, first)
+      {
+        MemoryCopyStruct(&stats.caches[idx], &n->v);
+        idx += 1;
+      }
+    }
+    scratch_end(scratch);
+  }
+  
+  //- rjf: gather queue depths
+  for EachElement(idx, stats.queues)
+  {
+    AC_RequestBatch *batch = (idx < ArrayCount(ac_shared->req_batches) ? &ac_shared->req_batches[idx] : &ac_shared->express_batch);
+    MutexScope(batch->mutex)
+    {
+      stats.queues[idx].wide_count      = batch->wide_count;
+      stats.queues[idx].thin_count      = batch->thin_count;
+      stats.queues[idx].peak_wide_count = batch->peak_wide_count;
+      stats.queues[idx].peak_thin_count = batch->peak_thin_count;
+      stats.queues[idx].deferred_count  = batch->deferred_count;
+    }
+  }
+  
+  //- rjf: gather memory budget
+  stats.total_size = ins_atomic_u64_eval(&ac_shared->total_size);
+  stats.budget_size = ac_shared->budget_size;
+  
+  return stats;
+}
+
+internal String8List
+ac_string_list_from_stats(Arena *arena, AC_Stats *stats)
+{
+  String8List strings = {0};
+  str8_list_pushf(arena, &strings, "artifact cache: %S / %S budget",
+                  str8_from_memory_size(arena, stats->total_size),
+                  str8_from_memory_size(arena, stats->budget_size));
+  for EachElement(idx, stats->queues)
+  {
+    AC_QueueStats *q = &stats->queues[idx];
+    read_only local_persist char *queue_names[] = {"high priority", "low priority", "express"};
+    str8_list_pushf(arena, &strings, "  queue (%s): %I64u wide, %I64u thin (peak %I64u wide, %I64u thin), %I64u deferred",
+                    queue_names[idx],
+                    q->wide_count, q->thin_count, q->peak_wide_count, q->peak_thin_count, q->deferred_count);
+  }
+  for EachIndex(idx, stats->caches_count)
+  {
+    AC_CacheStats *c = &stats->caches[idx];
+    AC_LatencyHistogram *latencies[] = {&c->counters.create_latency, &c->counters.wait_latency};
+    char *latency_names[] = {"create", "wait"};
+    str8_list_pushf(arena, &strings, "%S: %I64u artifacts, %S",
+                    c->name, c->counters.node_count, str8_from_memory_size(arena, c->counters.total_size));
+    str8_list_pushf(arena, &strings, "  %I64u hits (%I64u stale), %I64u misses, %I64u requests, %I64u retries, %I64u cancels, %I64u evicts (%I64u over budget)",
+                    c->counters.hit_count, c->counters.stale_hit_count, c->counters.miss_count,
+                    c->counters.request_count, c->counters.retry_count, c->counters.cancel_count,
+                    c->counters.evict_count, c->counters.budget_evict_count);
+    for EachElement(latency_idx, latencies)
+    {
+      AC_LatencyHistogram *h = latencies[latency_idx];
+      if(h->total_count != 0)
+      {
+        str8_list_pushf(arena, &strings, "  %s: %I64u, avg %I64uus, p50 %I64uus, p99 %I64uus, max %I64uus",
+                        latency_names[latency_idx],
+                        h->total_count,
+                        h->total_us/h->total_count,
+                        ac_latency_histogram_percentile_us(h, 0.50),
+                        ac_latency_histogram_percentile_us(h, 0.99),
+                        h->max_us);
+      }
+    }
+  }
+  return strings;
+}
+
+////////////////////////////////
+//~ rjf: Cache Completion Helpers
+
+internal AC_Cache *
+ac_cache_from_create_function(AC_CreateFunctionType *create)
+{
+  AC_Cache *cache = 0;
+  U64 cache_hash = u64_hash_from_str8(str8_struct(&create));
+  U64 cache_slot_idx = cache_hash%ac_shared->cache_slots_count;
+  Stripe *cache_stripe = stripe_from_slot_idx(&ac_shared->cache_stripes, cache_slot_idx);
+  RWMutexScope(cache_stripe->rw_mutex, 0)
+  {
+    for(AC_Cache *c = ac_shared->cache_slots[cache_slot_idx]; c != 0; c = c->next)
+    {
+      if(c->create == create)
+      {
+        cache = c;
+        break;
+      }
+    }
+  }
+  return cache;
+}
+
+internal void
+ac_cache_record_create(AC_Cache *cache, U64 create_us, B32 retry)
+{
+  ac_latency_histogram_record(&cache->counters.create_latency, create_us);
+  if(retry)
+  {
+    ins_atomic_u64_inc_eval(&cache->counters.retry_count);
+  }
+}
+
+internal void
+ac_cache_write_val(AC_Cache *cache, String8 key, AC_Artifact val, U64 gen, U64 size)
+{
+  U64 hash = u64_hash_from_str8(key);
+  U64 slot_idx = hash%cache->slots_count;
+  AC_Slot *slot = &cache->slots[slot_idx];
+  Stripe *stripe = stripe_from_slot_idx(&cache->stripes, slot_idx);
+  RWMutexScope(stripe->rw_mutex, 1)
+  {
+    for(AC_Node *n = slot->first; n != 0; n = n->next)
+    {
+      if(str8_match(n->key, key, 0))
+      {
+        n->last_completed_gen = gen;
+        n->val = val;
+        ac_node_set_size(cache, n, size);
+        ins_atomic_u64_dec_eval(&n->working_count);
+        ins_atomic_u64_inc_eval(&n->completion_count);
+      }
+    }
+  }
+  cond_var_broadcast(stripe->cv);
 }
 
 ////////////////////////////////
@@ -30,7 +299,12 @@ internal AC_Artifact
 ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U64 endt_us)
 {
   ProfBeginFunction();
-  AC_RequestBatch *req_batch = &ac_shared->req_batches[params->flags & AC_Flag_HighPriority ? 0 : 1];
+  // NOTE: requests made from within an express request (e.g. memory
+  // reads made while building a call stack) go to the async tick - if they
+  // waited on the express threads, every express thread could be blocked on
+  // requests which only an express thread can service
+  B32 is_express = (params->flags & AC_Flag_HighPriority && !(params->flags & AC_Flag_Wide) && ac_shared->express_threads_count != 0 && !ac_is_express_thread);
+  AC_RequestBatch *req_batch = (is_express ? &ac_shared->express_batch : &ac_shared->req_batches[params->flags & AC_Flag_HighPriority ? 0 : 1]);
   
   //- rjf: create function -> cache
   AC_Cache *cache = 0;
@@ -56,6 +330,7 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
           SLLStackPush(ac_shared->cache_slots[cache_slot_idx], cache);
           cache->create = params->create;
           cache->destroy = params->destroy;
+          cache->name = params->name;
           cache->slots_count = Max(256, params->slots_count);
           cache->slots = push_array(cache_stripe->arena, AC_Slot, cache->slots_count);
           cache->stripes = stripe_array_alloc(cache_stripe->arena);
@@ -77,6 +352,7 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
   //- rjf: cache * key -> existing artifact
   B32 artifact_is_stale = 1;
   B32 got_artifact = 0;
+  B32 got_stale_artifact = 0;
   B32 need_request = 0;
   AC_Artifact artifact = {0};
   RWMutexScope(stripe->rw_mutex, 0)
@@ -90,6 +366,7 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
         if(ins_atomic_u64_eval(&n->completion_count) != 0 && (!is_stale || !(params->flags & AC_Flag_WaitForFresh)))
         {
           got_artifact = 1;
+          got_stale_artifact = is_stale;
           artifact_is_stale = is_stale;
           artifact = n->val;
           access_touch(access, &n->access_pt, stripe->cv);
@@ -105,6 +382,7 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
   }
   
   //- rjf: didn't get artifact we want? -> fall back to slow path
+  U64 wait_begin_us = 0;
   if(!got_artifact || need_request)
   {
     RWMutexScope(stripe->rw_mutex, 1) for(;;)
@@ -141,6 +419,7 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
         node->key = str8_copy(stripe->arena, key);
         node->working_count = 1;
         node->evict_threshold_us = params->evict_threshold_us;
+        ins_atomic_u64_inc_eval(&cache->counters.node_count);
       }
       node->access_pt.last_time_touched_us = os_now_microseconds();
       node->access_pt.last_update_idx_touched = update_tick_idx();
@@ -156,22 +435,32 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
           {
             SLLQueuePush(req_batch->first_wide, req_batch->last_wide, n);
             req_batch->wide_count += 1;
+            req_batch->peak_wide_count = Max(req_batch->peak_wide_count, req_batch->wide_count);
           }
           else
           {
             SLLQueuePush(req_batch->first_thin, req_batch->last_thin, n);
             req_batch->thin_count += 1;
+            req_batch->peak_thin_count = Max(req_batch->peak_thin_count, req_batch->thin_count);
           }
           n->v.key = str8_copy(req_batch->arena, key);
           n->v.gen = params->gen;
           n->v.cancel_signal = &node->cancelled;
           n->v.create = params->create;
         }
-        cond_var_broadcast(async_tick_start_cond_var);
-        ins_atomic_u32_eval_assign(&async_loop_again, 1);
-        if(params->flags & AC_Flag_HighPriority)
+        ins_atomic_u64_inc_eval(&cache->counters.request_count);
+        if(is_express)
         {
-          ins_atomic_u32_eval_assign(&async_loop_again_high_priority, 1);
+          cond_var_signal(ac_shared->express_cv);
+        }
+        else
+        {
+          cond_var_broadcast(async_tick_start_cond_var);
+          ins_atomic_u32_eval_assign(&async_loop_again, 1);
+          if(params->flags & AC_Flag_HighPriority)
+          {
+            ins_atomic_u32_eval_assign(&async_loop_again_high_priority, 1);
+          }
         }
       }
       
@@ -179,7 +468,8 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
       if(!got_artifact && ins_atomic_u64_eval(&node->completion_count) != 0 && ((node->last_completed_gen == params->gen) || !(params->flags & AC_Flag_WaitForFresh) || out_of_time))
       {
         got_artifact = 1;
-        artifact_is_stale = (node->last_completed_gen == params->gen);
+        got_stale_artifact = (node->last_completed_gen != params->gen);
+        artifact_is_stale = got_stale_artifact;
         artifact = node->val;
         access_touch(access, &node->access_pt, stripe->cv);
       }
@@ -191,10 +481,32 @@ ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U6
       }
       
       // rjf: wait for results
+      if(wait_begin_us == 0)
+      {
+        wait_begin_us = os_now_microseconds();
+      }
       cond_var_wait_rw(stripe->cv, stripe->rw_mutex, 1, endt_us);
     }
   }
   
+  //- rjf: record hit/miss & time spent waiting
+  if(got_artifact)
+  {
+    ins_atomic_u64_inc_eval(&cache->counters.hit_count);
+    if(got_stale_artifact)
+    {
+      ins_atomic_u64_inc_eval(&cache->counters.stale_hit_count);
+    }
+  }
+  else
+  {
+    ins_atomic_u64_inc_eval(&cache->counters.miss_count);
+  }
+  if(wait_begin_us != 0)
+  {
+    ac_latency_histogram_record(&cache->counters.wait_latency, os_now_microseconds() - wait_begin_us);
+  }
+  
   //- rjf: report staleness
   if(params->stale_out)
   {
@@ -256,6 +568,9 @@ ac_async_tick(void)
                     DLLRemove(slot->first, slot->last, n);
                     n->next = (AC_Node *)stripe->free;
                     stripe->free = n;
+                    ac_node_set_size(cache, n, 0);
+                    ins_atomic_u64_dec_eval(&cache->counters.node_count);
+                    ins_atomic_u64_inc_eval(&cache->counters.evict_count);
                     if(cache->destroy)
                     {
                       cache->destroy(n->val);
@@ -273,6 +588,114 @@ ac_async_tick(void)
       }
     }
   }
+  lane_sync();
+  
+  //////////////////////////////
+  //- rjf: over memory budget? -> evict least-recently-touched unreferenced artifacts
+  //
+  if(lane_idx() == 0 && ins_atomic_u64_eval(&ac_shared->total_size) > ac_shared->budget_size) ProfScope("evict over budget")
+  {
+    //- rjf: gather all completed, idle, unreferenced nodes
+    AC_EvictCandidateChunk *first_chunk = 0;
+    AC_EvictCandidateChunk *last_chunk = 0;
+    U64 candidates_count = 0;
+    for EachIndex(cache_slot_idx, ac_shared->cache_slots_count)
+    {
+      Stripe *cache_stripe = stripe_from_slot_idx(&ac_shared->cache_stripes, cache_slot_idx);
+      RWMutexScope(cache_stripe->rw_mutex, 0)
+      {
+        for EachNode(cache, AC_Cache, ac_shared->cache_slots[cache_slot_idx])
+        {
+          if(ins_atomic_u64_eval(&cache->counters.total_size) == 0)
+          {
+            continue;
+          }
+          for EachIndex(slot_idx, cache->slots_count)
+          {
+            AC_Slot *slot = &cache->slots[slot_idx];
+            Stripe *stripe = stripe_from_slot_idx(&cache->stripes, slot_idx);
+            RWMutexScope(stripe->rw_mutex, 0)
+            {
+              for EachNode(n, AC_Node, slot->first)
+              {
+                if(n->size != 0 &&
+                   ins_atomic_u64_eval(&n->working_count) == 0 &&
+                   access_pt_is_expired(&n->access_pt, .time = 0))
+                {
+                  AC_EvictCandidateChunk *chunk = last_chunk;
+                  if(chunk == 0 || chunk->count >= chunk->cap)
+                  {
+                    chunk = push_array(scratch.arena, AC_EvictCandidateChunk, 1);
+                    SLLQueuePush(first_chunk, last_chunk, chunk);
+                    chunk->cap = 1024;
+                    chunk->v = push_array_no_zero(scratch.arena, AC_EvictCandidate, chunk->cap);
+                  }
+                  AC_EvictCandidate *c = &chunk->v[chunk->count];
+                  c->cache = cache;
+                  c->slot_idx = slot_idx;
+                  c->node = n;
+                  c->last_time_touched_us = ins_atomic_u64_eval(&n->access_pt.last_time_touched_us);
+                  chunk->count += 1;
+                  candidates_count += 1;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    
+    //- rjf: flatten & sort, oldest first
+    AC_EvictCandidate *candidates = push_array_no_zero(scratch.arena, AC_EvictCandidate, candidates_count);
+    {
+      U64 idx = 0;
+      for EachNode(chunk, AC_EvictCandidateChunk, first_chunk)
+      {
+        MemoryCopy(candidates + idx, chunk->v, sizeof(chunk->v[0])*chunk->count);
+        idx += chunk->count;
+      }
+    }
+    quick_sort(candidates, candidates_count, sizeof(candidates[0]), ac_evict_candidate_compare);
+    
+    //- rjf: evict until under budget; re-check each node, since it may have
+    // been touched, re-requested, or evicted since it was gathered
+    for EachIndex(idx, candidates_count)
+    {
+      if(ins_atomic_u64_eval(&ac_shared->total_size) <= ac_shared->budget_size)
+      {
+        break;
+      }
+      AC_EvictCandidate *c = &candidates[idx];
+      AC_Cache *cache = c->cache;
+      AC_Slot *slot = &cache->slots[c->slot_idx];
+      Stripe *stripe = stripe_from_slot_idx(&cache->stripes, c->slot_idx);
+      RWMutexScope(stripe->rw_mutex, 1)
+      {
+        for EachNode(n, AC_Node, slot->first)
+        {
+          if(n == c->node)
+          {
+            if(n->access_pt.last_time_touched_us == c->last_time_touched_us &&
+               ins_atomic_u64_eval(&n->working_count) == 0 &&
+               access_pt_is_expired(&n->access_pt, .time = 0))
+            {
+              DLLRemove(slot->first, slot->last, n);
+              n->next = (AC_Node *)stripe->free;
+              stripe->free = n;
+              ac_node_set_size(cache, n, 0);
+              ins_atomic_u64_dec_eval(&cache->counters.node_count);
+              ins_atomic_u64_inc_eval(&cache->counters.budget_evict_count);
+              if(cache->destroy)
+              {
+                cache->destroy(n->val);
+              }
+            }
+            break;
+          }
+        }
+      }
+    }
+  }
   
   //////////////////////////////
   //- rjf: gather requests
@@ -373,7 +796,10 @@ ac_async_tick(void)
         // rjf: compute val
         B32 retry = 0;
         U64 gen = r->gen;
-        AC_Artifact val = r->create(r->key, r->cancel_signal, &retry, &gen);
+        U64 size = 0;
+        U64 create_begin_us = os_now_microseconds();
+        AC_Artifact val = r->create(r->key, r->cancel_signal, &retry, &gen, &size);
+        U64 create_end_us = os_now_microseconds();
         
         // rjf: retry? -> resubmit request
         if(retry && lane_idx() == 0)
@@ -392,45 +818,21 @@ ac_async_tick(void)
         
         // rjf: create function -> cache
         AC_Cache *cache = 0;
-        if(!retry && lane_idx() == 0)
+        if(lane_idx() == 0)
         {
-          U64 cache_hash = u64_hash_from_str8(str8_struct(&r->create));
-          U64 cache_slot_idx = cache_hash%ac_shared->cache_slots_count;
-          Stripe *cache_stripe = stripe_from_slot_idx(&ac_shared->cache_stripes, cache_slot_idx);
-          RWMutexScope(cache_stripe->rw_mutex, 0)
-          {
-            for(AC_Cache *c = ac_shared->cache_slots[cache_slot_idx]; c != 0; c = c->next)
-            {
-              if(c->create == r->create)
-              {
-                cache = c;
-                break;
-              }
-            }
-          }
+          cache = ac_cache_from_create_function(r->create);
+        }
+        
+        // rjf: record latency & retries
+        if(cache != 0)
+        {
+          ac_cache_record_create(cache, create_end_us - create_begin_us, retry);
         }
         
         // rjf: write value into cache
         if(!retry && lane_idx() == 0)
         {
-          U64 hash = u64_hash_from_str8(r->key);
-          U64 slot_idx = hash%cache->slots_count;
-          AC_Slot *slot = &cache->slots[slot_idx];
-          Stripe *stripe = stripe_from_slot_idx(&cache->stripes, slot_idx);
-          RWMutexScope(stripe->rw_mutex, 1)
-          {
-            for(AC_Node *n = slot->first; n != 0; n = n->next)
-            {
-              if(str8_match(n->key, r->key, 0))
-              {
-                n->last_completed_gen = gen;
-                n->val = val;
-                ins_atomic_u64_dec_eval(&n->working_count);
-                ins_atomic_u64_inc_eval(&n->completion_count);
-              }
-            }
-          }
-          cond_var_broadcast(stripe->cv);
+          ac_cache_write_val(cache, r->key, val, gen, size);
         }
         
         // rjf: increment count
@@ -479,7 +881,10 @@ ac_async_tick(void)
         // rjf: compute val
         B32 retry = 0;
         U64 gen = r->gen;
-        AC_Artifact val = r->create(r->key, r->cancel_signal, &retry, &gen);
+        U64 size = 0;
+        U64 create_begin_us = os_now_microseconds();
+        AC_Artifact val = r->create(r->key, r->cancel_signal, &retry, &gen, &size);
+        U64 create_end_us = os_now_microseconds();
         
         // rjf: restore wide lane ctx
         lane_ctx(lane_ctx_restore);
@@ -500,46 +905,18 @@ ac_async_tick(void)
         }
         
         // rjf: create function -> cache
-        AC_Cache *cache = 0;
-        if(!retry)
+        AC_Cache *cache = ac_cache_from_create_function(r->create);
+        
+        // rjf: record latency & retries
+        if(cache != 0)
         {
-          U64 cache_hash = u64_hash_from_str8(str8_struct(&r->create));
-          U64 cache_slot_idx = cache_hash%ac_shared->cache_slots_count;
-          Stripe *cache_stripe = stripe_from_slot_idx(&ac_shared->cache_stripes, cache_slot_idx);
-          RWMutexScope(cache_stripe->rw_mutex, 0)
-          {
-            for(AC_Cache *c = ac_shared->cache_slots[cache_slot_idx]; c != 0; c = c->next)
-            {
-              if(c->create == r->create)
-              {
-                cache = c;
-                break;
-              }
-            }
-          }
+          ac_cache_record_create(cache, create_end_us - create_begin_us, retry);
         }
         
         // rjf: write value into cache
         if(!retry)
         {
-          U64 hash = u64_hash_from_str8(r->key);
-          U64 slot_idx = hash%cache->slots_count;
-          AC_Slot *slot = &cache->slots[slot_idx];
-          Stripe *stripe = stripe_from_slot_idx(&cache->stripes, slot_idx);
-          RWMutexScope(stripe->rw_mutex, 1)
-          {
-            for(AC_Node *n = slot->first; n != 0; n = n->next)
-            {
-              if(str8_match(n->key, r->key, 0))
-              {
-                n->last_completed_gen = gen;
-                n->val = val;
-                ins_atomic_u64_dec_eval(&n->working_count);
-                ins_atomic_u64_inc_eval(&n->completion_count);
-              }
-            }
-          }
-          cond_var_broadcast(stripe->cv);
+          ac_cache_write_val(cache, r->key, val, gen, size);
         }
       }
       lane_sync();
@@ -554,6 +931,9 @@ ac_async_tick(void)
       AC_RequestBatch *batch = &ac_shared->req_batches[task_idx];
       MutexScope(batch->mutex)
       {
+        // rjf: count deferrals
+        batch->deferred_count += (task->wide_count - done_wide_count) + (task->thin_count - done_thin_count);
+        
         // rjf: push leftover wide tasks
         for(U64 idx = done_wide_count; idx < task->wide_count; idx += 1)
         {
@@ -633,9 +1013,10 @@ ac_cancel_thread_entry_point(void *p)
                       {
                         break;
                       }
-                      else
+                      else if(!n->cancelled)
                       {
                         n->cancelled = 1;
+                        ins_atomic_u64_inc_eval(&cache->counters.cancel_count);
                       }
                     }
                   }
@@ -652,3 +1033,87 @@ ac_cancel_thread_entry_point(void *p)
     }
   }
 }
+
+////////////////////////////////
+//~ rjf: Express Threads
+
+internal void
+ac_express_thread_entry_point(void *p)
+{
+  U64 thread_idx = (U64)p;
+  ThreadNameF("ac_express_thread_%I64u", thread_idx);
+  is_async_thread = 1;
+  ac_is_express_thread = 1;
+  AC_RequestBatch *batch = &ac_shared->express_batch;
+  for(;!ins_atomic_u32_eval(&global_async_exit);)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    
+    //- rjf: take next request
+    B32 got_request = 0;
+    AC_Request r = {0};
+    MutexScope(batch->mutex)
+    {
+      for(;batch->first_thin == 0 && !ins_atomic_u32_eval(&global_async_exit);)
+      {
+        cond_var_wait(ac_shared->express_cv, batch->mutex, max_U64);
+      }
+      if(batch->first_thin != 0)
+      {
+        got_request = 1;
+        MemoryCopyStruct(&r, &batch->first_thin->v);
+        r.key = str8_copy(scratch.arena, r.key);
+        SLLQueuePop(batch->first_thin, batch->last_thin);
+        batch->thin_count -= 1;
+        if(batch->first_thin == 0)
+        {
+          arena_clear(batch->arena);
+        }
+      }
+    }
+    
+    //- rjf: compute val on a single lane
+    if(got_request) ProfScope("express request")
+    {
+      U64 lane_ctx_broadcast_memory = 0;
+      LaneCtx single_lane_ctx = {0, 1, {0}, &lane_ctx_broadcast_memory};
+      LaneCtx lane_ctx_restore = lane_ctx(single_lane_ctx);
+      B32 retry = 0;
+      U64 gen = r.gen;
+      U64 size = 0;
+      U64 create_begin_us = os_now_microseconds();
+      AC_Artifact val = r.create(r.key, r.cancel_signal, &retry, &gen, &size);
+      U64 create_end_us = os_now_microseconds();
+      lane_ctx(lane_ctx_restore);
+      
+      // rjf: record latency & retries
+      AC_Cache *cache = ac_cache_from_create_function(r.create);
+      ac_cache_record_create(cache, create_end_us - create_begin_us, retry);
+      
+      // rjf: retry? -> resubmit to the regular high priority batch, so that
+      // retries are paced by the async tick, rather than spinning here
+      if(retry)
+      {
+        AC_RequestBatch *retry_batch = &ac_shared->req_batches[0];
+        MutexScope(retry_batch->mutex)
+        {
+          AC_RequestNode *n = push_array(retry_batch->arena, AC_RequestNode, 1);
+          SLLQueuePush(retry_batch->first_thin, retry_batch->last_thin, n);
+          retry_batch->thin_count += 1;
+          MemoryCopyStruct(&n->v, &r);
+          n->v.key = str8_copy(retry_batch->arena, n->v.key);
+        }
+        ins_atomic_u32_eval_assign(&async_loop_again, 1);
+        cond_var_broadcast(async_tick_start_cond_var);
+      }
+      
+      // rjf: write value into cache
+      else
+      {
+        ac_cache_write_val(cache, r.key, val, gen, size);
+      }
+    }
+    
+    scratch_end(scratch);
+  }
+}
@@ -16,7 +16,7 @@ struct AC_Artifact
 ////////////////////////////////
 //~ rjf: Artifact Computation Function Types
 
-typedef AC_Artifact AC_CreateFunctionType(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out);
+typedef AC_Artifact AC_CreateFunctionType(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out);
 typedef void AC_DestroyFunctionType(AC_Artifact artifact);
 
 typedef U32 AC_Flags;
@@ -31,6 +31,7 @@ AC_FlagsEnum;
 typedef struct AC_ArtifactParams AC_ArtifactParams;
 struct AC_ArtifactParams
 {
+  String8 name;
   AC_CreateFunctionType *create;
   AC_DestroyFunctionType *destroy;
   U64 slots_count;
@@ -40,6 +41,67 @@ struct AC_ArtifactParams
   AC_Flags flags;
 };
 
+////////////////////////////////
+//~ rjf: Statistics Types
+
+// NOTE: latency histograms bucket by log2(microseconds); bucket 0 holds
+// [0us, 1us), bucket i holds [2^(i-1)us, 2^i us), and the last bucket holds
+// everything beyond.
+#define AC_LATENCY_BUCKET_COUNT 24
+
+typedef struct AC_LatencyHistogram AC_LatencyHistogram;
+struct AC_LatencyHistogram
+{
+  U64 counts[AC_LATENCY_BUCKET_COUNT];
+  U64 total_count;
+  U64 total_us;
+  U64 max_us;
+};
+
+typedef struct AC_CacheCounters AC_CacheCounters;
+struct AC_CacheCounters
+{
+  U64 hit_count;
+  U64 stale_hit_count;
+  U64 miss_count;
+  U64 request_count;
+  U64 retry_count;
+  U64 cancel_count;
+  U64 evict_count;
+  U64 budget_evict_count;
+  U64 node_count;
+  U64 total_size;
+  AC_LatencyHistogram create_latency;
+  AC_LatencyHistogram wait_latency;
+};
+
+typedef struct AC_CacheStats AC_CacheStats;
+struct AC_CacheStats
+{
+  String8 name;
+  AC_CacheCounters counters;
+};
+
+typedef struct AC_QueueStats AC_QueueStats;
+struct AC_QueueStats
+{
+  U64 wide_count;
+  U64 thin_count;
+  U64 peak_wide_count;
+  U64 peak_thin_count;
+  U64 deferred_count;
+};
+
+typedef struct AC_Stats AC_Stats;
+struct AC_Stats
+{
+  AC_CacheStats *caches;
+  U64 caches_count;
+  AC_QueueStats queues[3]; // 0: high priority, 1: low priority, 2: express
+  U64 total_size;
+  U64 budget_size;
+};
+
 ////////////////////////////////
 //~ rjf: Cache Types
 
@@ -77,7 +139,7 @@ struct AC_Node
   U64 completion_count;
   U64 evict_threshold_us;
   B32 cancelled;
-  U64 _unused_;
+  U64 size;
 };
 
 typedef struct AC_Slot AC_Slot;
@@ -94,11 +156,33 @@ struct AC_Cache
   AC_Cache *next;
   AC_CreateFunctionType *create;
   AC_DestroyFunctionType *destroy;
+  String8 name;
   
   // rjf: artifact cache
   U64 slots_count;
   AC_Slot *slots;
   StripeArray stripes;
+  
+  // rjf: statistics & memory accounting
+  AC_CacheCounters counters;
+};
+
+typedef struct AC_EvictCandidate AC_EvictCandidate;
+struct AC_EvictCandidate
+{
+  AC_Cache *cache;
+  U64 slot_idx;
+  AC_Node *node;
+  U64 last_time_touched_us;
+};
+
+typedef struct AC_EvictCandidateChunk AC_EvictCandidateChunk;
+struct AC_EvictCandidateChunk
+{
+  AC_EvictCandidateChunk *next;
+  AC_EvictCandidate *v;
+  U64 count;
+  U64 cap;
 };
 
 typedef struct AC_RequestBatch AC_RequestBatch;
@@ -112,6 +196,9 @@ struct AC_RequestBatch
   AC_RequestNode *last_thin;
   U64 wide_count;
   U64 thin_count;
+  U64 peak_wide_count;
+  U64 peak_thin_count;
+  U64 deferred_count;
 };
 
 typedef struct AC_Shared AC_Shared;
@@ -124,29 +211,66 @@ struct AC_Shared
   AC_Cache **cache_slots;
   StripeArray cache_stripes;
   
+  // rjf: memory budget
+  U64 budget_size;
+  U64 total_size;
+  
   // rjf: requests
   AC_RequestBatch req_batches[2]; // 0: high priority, 1: low priority
   
+  // rjf: express requests (high priority thin), serviced by express threads
+  AC_RequestBatch express_batch;
+  CondVar express_cv;
+  U64 express_threads_count;
+  Thread *express_threads;
+  
   // rjf: cancel thread
   Thread cancel_thread;
   Mutex cancel_thread_mutex;
 };
 
+////////////////////////////////
+//~ rjf: Budget Defaults
+
+#define AC_DEFAULT_BUDGET_SIZE GB(2)
+
 ////////////////////////////////
 //~ rjf: Globals
 
 global AC_Shared *ac_shared = 0;
+thread_static B32 ac_is_express_thread = 0;
 
 ////////////////////////////////
 //~ rjf: Layer Initialization
 
-internal void ac_init(void);
+internal void ac_init(CmdLine *cmdline);
+
+////////////////////////////////
+//~ rjf: Memory Accounting
+
+internal void ac_node_set_size(AC_Cache *cache, AC_Node *node, U64 size);
+internal int ac_evict_candidate_compare(AC_EvictCandidate *a, AC_EvictCandidate *b);
+
+////////////////////////////////
+//~ rjf: Statistics
+
+internal void ac_latency_histogram_record(AC_LatencyHistogram *histogram, U64 us);
+internal U64 ac_latency_histogram_percentile_us(AC_LatencyHistogram *histogram, F64 pct);
+internal AC_Stats ac_stats(Arena *arena);
+internal String8List ac_string_list_from_stats(Arena *arena, AC_Stats *stats);
+
+////////////////////////////////
+//~ rjf: Cache Completion Helpers
+
+internal AC_Cache *ac_cache_from_create_function(AC_CreateFunctionType *create);
+internal void ac_cache_record_create(AC_Cache *cache, U64 create_us, B32 retry);
+internal void ac_cache_write_val(AC_Cache *cache, String8 key, AC_Artifact val, U64 gen, U64 size);
 
 ////////////////////////////////
 //~ rjf: Cache Lookups
 
 internal AC_Artifact ac_artifact_from_key_(Access *access, String8 key, AC_ArtifactParams *params, U64 endt_us);
-#define ac_artifact_from_key(access, key, create_fn, destroy_fn, endt_us, ...) ac_artifact_from_key_((access), (key), &(AC_ArtifactParams){.create = (create_fn), .destroy = (destroy_fn), .evict_threshold_us = (2000000), __VA_ARGS__}, (endt_us))
+#define ac_artifact_from_key(access, key, create_fn, destroy_fn, endt_us, ...) ac_artifact_from_key_((access), (key), &(AC_ArtifactParams){.name = str8_lit(#create_fn), .create = (create_fn), .destroy = (destroy_fn), .evict_threshold_us = (2000000), __VA_ARGS__}, (endt_us))
 
 ////////////////////////////////
 //~ rjf: Asynchronous Tick
@@ -158,4 +282,9 @@ internal void ac_async_tick(void);
 
 internal void ac_cancel_thread_entry_point(void *p);
 
+////////////////////////////////
+//~ rjf: Express Threads
+
+internal void ac_express_thread_entry_point(void *p);
+
 #endif // ARTIFACT_CACHE_H
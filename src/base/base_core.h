@@ -903,7 +903,8 @@ typedef U64 DenseTime;
 typedef U32 FilePropertyFlags;
 enum
 {
-  FilePropertyFlag_IsFolder = (1 << 0),
+  FilePropertyFlag_IsFolder   = (1 << 0),
+  FilePropertyFlag_IsReadOnly = (1 << 1),
 };
 
 typedef struct FileProperties FileProperties;
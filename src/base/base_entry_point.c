@@ -55,7 +55,7 @@ main_thread_base_entry_point(int arguments_count, char **arguments)
   
   //- rjf: initialize all included layers
 #if defined(ARTIFACT_CACHE_H) && !defined(AC_INIT_MANUAL)
-  ac_init();
+  ac_init(&cmdline);
 #endif
 #if defined(ASYNC_H) && !defined(ASYNC_INIT_MANUAL)
   async_init(&cmdline);
@@ -138,6 +138,16 @@ main_thread_base_entry_point(int arguments_count, char **arguments)
   {
     thread_join(async_threads[idx], max_U64);
   }
+#if defined(ARTIFACT_CACHE_H)
+  MutexScope(ac_shared->express_batch.mutex)
+  {
+    cond_var_broadcast(ac_shared->express_cv);
+  }
+  for EachIndex(idx, ac_shared->express_threads_count)
+  {
+    thread_join(ac_shared->express_threads[idx], max_U64);
+  }
+#endif
   
   //- rjf: end captures
   if(capture)
@@ -36,6 +36,18 @@ c_key_match(C_Key a, C_Key b)
   return (MemoryMatchStruct(&a.root, &b.root) && c_id_match(a.id, b.id));
 }
 
+internal void
+c_file_map_release(C_FileMap *file_map, String8 view)
+{
+  if(view.str != 0)
+  {
+    os_file_map_view_close(file_map->map, view.str, r1u64(0, view.size));
+  }
+  os_file_map_close(file_map->map);
+  os_file_close(file_map->file);
+  MemoryZeroStruct(file_map);
+}
+
 ////////////////////////////////
 //~ rjf: Main Layer Initialization
 
@@ -155,24 +167,14 @@ c_root_release(C_Root root)
 ////////////////////////////////
 //~ rjf: Cache Submission
 
-internal U128
-c_submit_data(C_Key key, Arena **data_arena, String8 data)
+internal B32
+c_commit_blob(U128 hash, Arena **data_arena, C_FileMap *file_map, String8 data, U128 *rope_chunk_hashes, U64 *rope_chunk_offs, U64 rope_chunk_count, B32 is_key_ref)
 {
-  //- rjf: unpack key
-  U64 key_hash = u64_hash_from_str8(str8_struct(&key));
-  U64 key_slot_idx = key_hash%c_shared->key_slots_count;
-  U64 key_stripe_idx = key_slot_idx%c_shared->key_stripes_count;
-  C_KeySlot *key_slot = &c_shared->key_slots[key_slot_idx];
-  C_Stripe *key_stripe = &c_shared->key_stripes[key_stripe_idx];
-  
-  //- rjf: hash data, unpack hash
-  U128 hash = u128_hash_from_str8(data);
   U64 slot_idx = hash.u64[1]%c_shared->blob_slots_count;
   U64 stripe_idx = slot_idx%c_shared->blob_stripes_count;
   C_BlobSlot *slot = &c_shared->blob_slots[slot_idx];
   C_Stripe *stripe = &c_shared->blob_stripes[stripe_idx];
-  
-  //- rjf: commit to (hash -> data) cache
+  B32 is_new = 0;
   ProfScope("commit to (hash -> data) cache") RWMutexScope(stripe->rw_mutex, 1)
   {
     // rjf: find existing node
@@ -191,10 +193,15 @@ c_submit_data(C_Key key, Arena **data_arena, String8 data)
     {
       arena_release(*data_arena);
     }
+    if(node != 0 && file_map != 0)
+    {
+      c_file_map_release(file_map, data);
+    }
     
     // rjf: allocate node if needed
     if(node == 0)
     {
+      is_new = 1;
       node = c_shared->blob_stripes_free_nodes[stripe_idx];
       if(node)
       {
@@ -210,19 +217,49 @@ c_submit_data(C_Key key, Arena **data_arena, String8 data)
       {
         node->arena = *data_arena;
       }
+      if(file_map != 0)
+      {
+        node->file_map = *file_map;
+      }
       node->data = data;
+      node->rope_chunk_hashes = rope_chunk_hashes;
+      node->rope_chunk_offs = rope_chunk_offs;
+      node->rope_chunk_count = rope_chunk_count;
       DLLPushBack(slot->first, slot->last, node);
     }
     
-    // rjf: bump key ref count
-    node->key_ref_count += 1;
+    // rjf: bump key / downstream ref count
+    if(is_key_ref)
+    {
+      node->key_ref_count += 1;
+    }
+    else
+    {
+      node->downstream_ref_count += 1;
+    }
     
-    // rjf "steal" arena from caller
+    // rjf "steal" arena / file map from caller
     if(data_arena != 0)
     {
       *data_arena = 0;
     }
+    if(file_map != 0)
+    {
+      MemoryZeroStruct(file_map);
+    }
   }
+  return is_new;
+}
+
+internal void
+c_key_push_hash(C_Key key, U128 hash)
+{
+  //- rjf: unpack key
+  U64 key_hash = u64_hash_from_str8(str8_struct(&key));
+  U64 key_slot_idx = key_hash%c_shared->key_slots_count;
+  U64 key_stripe_idx = key_slot_idx%c_shared->key_stripes_count;
+  C_KeySlot *key_slot = &c_shared->key_slots[key_slot_idx];
+  C_Stripe *key_stripe = &c_shared->key_stripes[key_stripe_idx];
   
   //- rjf: commit to (key -> list(hash)) cache
   U128 key_expired_hash = {0};
@@ -321,7 +358,74 @@ c_submit_data(C_Key key, Arena **data_arena, String8 data)
       }
     }
   }
+}
+
+internal U128
+c_submit_data(C_Key key, Arena **data_arena, String8 data)
+{
+  U128 hash = u128_hash_from_str8(data);
+  c_commit_blob(hash, data_arena, 0, data, 0, 0, 0, 1);
+  c_key_push_hash(key, hash);
+  return hash;
+}
+
+internal U128
+c_submit_blob(Arena **data_arena, String8 data)
+{
+  // NOTE: not correllated with any key - the caller owns one downstream
+  // reference to the returned hash, and releases it via c_hash_downstream_dec.
+  U128 hash = u128_hash_from_str8(data);
+  c_commit_blob(hash, data_arena, 0, data, 0, 0, 0, 0);
+  return hash;
+}
+
+internal U128
+c_submit_rope(C_Key key, U128 *chunk_hashes, U64 *chunk_sizes, U64 chunk_count)
+{
+  //- rjf: hash chunk hash list; seeded, so ropes never collide with a blob of the same bytes
+  U128 hash = u128_hash_from_seed_str8(0x65706f72, str8((U8 *)chunk_hashes, sizeof(chunk_hashes[0])*chunk_count));
+  
+  //- rjf: commit rope node; chunk offsets let readers size & range-read the
+  // rope without flattening it
+  U64 rope_arena_size = sizeof(chunk_hashes[0])*chunk_count + sizeof(U64)*(chunk_count+1) + ARENA_HEADER_SIZE;
+  Arena *rope_arena = arena_alloc(.reserve_size = rope_arena_size, .commit_size = rope_arena_size);
+  U128 *rope_chunk_hashes = push_array_no_zero(rope_arena, U128, chunk_count);
+  U64 *rope_chunk_offs = push_array_no_zero(rope_arena, U64, chunk_count+1);
+  MemoryCopy(rope_chunk_hashes, chunk_hashes, sizeof(chunk_hashes[0])*chunk_count);
+  rope_chunk_offs[0] = 0;
+  for EachIndex(idx, chunk_count)
+  {
+    rope_chunk_offs[idx+1] = rope_chunk_offs[idx] + chunk_sizes[idx];
+  }
+  B32 is_new = c_commit_blob(hash, &rope_arena, 0, str8_zero(), rope_chunk_hashes, rope_chunk_offs, chunk_count, 1);
+  
+  //- rjf: new rope -> hold chunks alive for as long as the rope is alive
+  if(is_new)
+  {
+    for EachIndex(idx, chunk_count)
+    {
+      c_hash_downstream_inc(chunk_hashes[idx]);
+    }
+  }
   
+  //- rjf: push to key's history
+  c_key_push_hash(key, hash);
+  return hash;
+}
+
+internal U128
+c_hash_from_mapped_chunk_hashes(U128 *chunk_hashes, U64 chunk_count)
+{
+  // NOTE: seeded, so mapped blobs never collide with a blob or rope of the same bytes
+  U128 hash = u128_hash_from_seed_str8(0x70616d, str8((U8 *)chunk_hashes, sizeof(chunk_hashes[0])*chunk_count));
+  return hash;
+}
+
+internal U128
+c_submit_mapped_data(C_Key key, C_FileMap *file_map, String8 data, U128 hash)
+{
+  c_commit_blob(hash, 0, file_map, data, 0, 0, 0, 1);
+  c_key_push_hash(key, hash);
   return hash;
 }
 
@@ -449,6 +553,8 @@ c_data_from_hash(Access *access, U128 hash)
   U64 stripe_idx = slot_idx%c_shared->blob_stripes_count;
   C_BlobSlot *slot = &c_shared->blob_slots[slot_idx];
   C_Stripe *stripe = &c_shared->blob_stripes[stripe_idx];
+  U128 *rope_chunk_hashes = 0;
+  U64 rope_chunk_count = 0;
   MutexScopeR(stripe->rw_mutex)
   {
     for(C_BlobNode *n = slot->first; n != 0; n = n->next)
@@ -456,11 +562,153 @@ c_data_from_hash(Access *access, U128 hash)
       if(u128_match(n->hash, hash))
       {
         result = n->data;
+        if(result.str == 0)
+        {
+          rope_chunk_hashes = n->rope_chunk_hashes;
+          rope_chunk_count = n->rope_chunk_count;
+        }
+        access_touch(access, &n->access_pt, stripe->cv);
+        break;
+      }
+    }
+  }
+  
+  //- rjf: unflattened rope -> flatten chunks into contiguous data. the node
+  // was touched above, so its chunk list stays alive for this access.
+  if(rope_chunk_count != 0) ProfScope("flatten rope")
+  {
+    Temp scratch = scratch_begin(0, 0);
+    String8List chunks = {0};
+    for EachIndex(idx, rope_chunk_count)
+    {
+      str8_list_push(scratch.arena, &chunks, c_data_from_hash(access, rope_chunk_hashes[idx]));
+    }
+    Arena *flat_arena = arena_alloc(.reserve_size = chunks.total_size + ARENA_HEADER_SIZE, .commit_size = chunks.total_size + ARENA_HEADER_SIZE);
+    String8 flat = str8(push_array_no_zero(flat_arena, U8, chunks.total_size), chunks.total_size);
+    {
+      U64 off = 0;
+      for(String8Node *n = chunks.first; n != 0; n = n->next)
+      {
+        MemoryCopy(flat.str + off, n->string.str, n->string.size);
+        off += n->string.size;
+      }
+    }
+    MutexScopeW(stripe->rw_mutex)
+    {
+      for(C_BlobNode *n = slot->first; n != 0; n = n->next)
+      {
+        if(u128_match(n->hash, hash))
+        {
+          if(n->data.str == 0)
+          {
+            n->data = flat;
+            n->rope_flat_arena = flat_arena;
+            flat_arena = 0;
+          }
+          result = n->data;
+          break;
+        }
+      }
+    }
+    if(flat_arena != 0)
+    {
+      arena_release(flat_arena);
+    }
+    scratch_end(scratch);
+  }
+  
+  ProfEnd();
+  return result;
+}
+
+internal U64
+c_size_from_hash(Access *access, U128 hash)
+{
+  U64 result = 0;
+  U64 slot_idx = hash.u64[1]%c_shared->blob_slots_count;
+  U64 stripe_idx = slot_idx%c_shared->blob_stripes_count;
+  C_BlobSlot *slot = &c_shared->blob_slots[slot_idx];
+  C_Stripe *stripe = &c_shared->blob_stripes[stripe_idx];
+  MutexScopeR(stripe->rw_mutex)
+  {
+    for(C_BlobNode *n = slot->first; n != 0; n = n->next)
+    {
+      if(u128_match(n->hash, hash))
+      {
+        result = (n->rope_chunk_offs != 0) ? n->rope_chunk_offs[n->rope_chunk_count] : n->data.size;
+        access_touch(access, &n->access_pt, stripe->cv);
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+internal U64
+c_read_from_hash(Access *access, U128 hash, Rng1U64 range, void *out)
+{
+  ProfBeginFunction();
+  U64 result = 0;
+  U64 slot_idx = hash.u64[1]%c_shared->blob_slots_count;
+  U64 stripe_idx = slot_idx%c_shared->blob_stripes_count;
+  C_BlobSlot *slot = &c_shared->blob_slots[slot_idx];
+  C_Stripe *stripe = &c_shared->blob_stripes[stripe_idx];
+  String8 data = {0};
+  U128 *rope_chunk_hashes = 0;
+  U64 *rope_chunk_offs = 0;
+  U64 rope_chunk_count = 0;
+  MutexScopeR(stripe->rw_mutex)
+  {
+    for(C_BlobNode *n = slot->first; n != 0; n = n->next)
+    {
+      if(u128_match(n->hash, hash))
+      {
+        data = n->data;
+        rope_chunk_hashes = n->rope_chunk_hashes;
+        rope_chunk_offs = n->rope_chunk_offs;
+        rope_chunk_count = n->rope_chunk_count;
         access_touch(access, &n->access_pt, stripe->cv);
         break;
       }
     }
   }
+  
+  //- rjf: contiguous data (or already-flattened rope) -> copy directly
+  if(rope_chunk_offs == 0 || data.str != 0)
+  {
+    Rng1U64 read_range = intersect_1u64(range, r1u64(0, data.size));
+    if(read_range.min < read_range.max)
+    {
+      MemoryCopy(out, data.str + read_range.min, dim_1u64(read_range));
+      result = dim_1u64(read_range);
+    }
+  }
+  
+  //- rjf: rope -> binary search first chunk, copy from each touched chunk
+  else
+  {
+    Rng1U64 read_range = intersect_1u64(range, r1u64(0, rope_chunk_offs[rope_chunk_count]));
+    U64 chunk_idx = 0;
+    for(U64 hi = rope_chunk_count; chunk_idx < hi;)
+    {
+      U64 mid = chunk_idx + (hi - chunk_idx)/2;
+      if(rope_chunk_offs[mid+1] <= read_range.min) { chunk_idx = mid+1; }
+      else { hi = mid; }
+    }
+    for(U64 off = read_range.min; off < read_range.max && chunk_idx < rope_chunk_count; chunk_idx += 1)
+    {
+      String8 chunk = c_data_from_hash(access, rope_chunk_hashes[chunk_idx]);
+      Rng1U64 chunk_read_range = intersect_1u64(r1u64(off, read_range.max), r1u64(rope_chunk_offs[chunk_idx], rope_chunk_offs[chunk_idx] + chunk.size));
+      if(chunk_read_range.min >= chunk_read_range.max)
+      {
+        break;
+      }
+      MemoryCopy((U8 *)out + (chunk_read_range.min - read_range.min), chunk.str + (chunk_read_range.min - rope_chunk_offs[chunk_idx]), dim_1u64(chunk_read_range));
+      off = chunk_read_range.max;
+      result += dim_1u64(chunk_read_range);
+    }
+  }
+  
   ProfEnd();
   return result;
 }
@@ -475,6 +723,16 @@ c_async_tick(void)
   
   //- rjf: garbage collect blobs
   {
+    Temp scratch = scratch_begin(0, 0);
+    typedef struct C_ReleasedRope C_ReleasedRope;
+    struct C_ReleasedRope
+    {
+      C_ReleasedRope *next;
+      Arena *arena;
+      U128 *chunk_hashes;
+      U64 chunk_count;
+    };
+    C_ReleasedRope *first_released_rope = 0;
     Rng1U64 range = lane_range(c_shared->blob_slots_count);
     for EachInRange(slot_idx, range)
     {
@@ -502,10 +760,27 @@ c_async_tick(void)
               {
                 DLLRemove(slot->first, slot->last, n);
                 SLLStackPush(c_shared->blob_stripes_free_nodes[stripe_idx], n);
-                if(n->arena != 0)
+                if(n->rope_flat_arena != 0)
+                {
+                  arena_release(n->rope_flat_arena);
+                }
+                if(n->rope_chunk_hashes != 0)
+                {
+                  // rjf: chunk refs live in other stripes; release them after unlocking
+                  C_ReleasedRope *rope = push_array(scratch.arena, C_ReleasedRope, 1);
+                  SLLStackPush(first_released_rope, rope);
+                  rope->arena = n->arena;
+                  rope->chunk_hashes = n->rope_chunk_hashes;
+                  rope->chunk_count = n->rope_chunk_count;
+                }
+                else if(n->arena != 0)
                 {
                   arena_release(n->arena);
                 }
+                if(!os_handle_match(n->file_map.map, os_handle_zero()))
+                {
+                  c_file_map_release(&n->file_map, n->data);
+                }
               }
             }
           }
@@ -516,6 +791,15 @@ c_async_tick(void)
         }
       }
     }
+    for(C_ReleasedRope *rope = first_released_rope; rope != 0; rope = rope->next)
+    {
+      for EachIndex(idx, rope->chunk_count)
+      {
+        c_hash_downstream_dec(rope->chunk_hashes[idx]);
+      }
+      arena_release(rope->arena);
+    }
+    scratch_end(scratch);
   }
   
   ProfEnd();
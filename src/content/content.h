@@ -39,6 +39,22 @@
 // can then, together with the root and key, read memory for that range, then
 // submit that data to the hash store, correllating with the root and key
 // combo.
+//
+// Large buffers which are edited incrementally (e.g. the output log) can be
+// submitted as "ropes" - a list of chunk hashes, where each chunk is its own
+// content-level blob. Submitting a new version then only requires hashing the
+// chunks which changed. A rope blob holds downstream references to its
+// chunks, and it is only flattened into contiguous data once some reader
+// asks for it via `c_data_from_hash`. Readers which only need the size or a
+// sub-range (e.g. evaluation reads of the output log every frame) use
+// `c_size_from_hash` / `c_read_from_hash`, which never flatten.
+//
+// Large files can be submitted as "mapped" blobs, whose data is a read-only
+// view of the file, so pages are only faulted in once they are touched, and
+// no copy of the file is made. Submitters must only do so for files whose
+// contents cannot change underneath the view (e.g. read-only files). The hash of a mapped blob is formed from
+// hashes of fixed-size chunks of its data, so that submitters can hash the
+// chunks in parallel.
 
 ////////////////////////////////
 //~ rjf: Key Types
@@ -138,6 +154,15 @@ struct C_KeySlot
 ////////////////////////////////
 //~ rjf: Content Blob Cache Types
 
+#define C_MAPPED_BLOB_CHUNK_SIZE MB(4)
+
+typedef struct C_FileMap C_FileMap;
+struct C_FileMap
+{
+  OS_Handle file;
+  OS_Handle map;
+};
+
 typedef struct C_BlobNode C_BlobNode;
 struct C_BlobNode
 {
@@ -149,6 +174,15 @@ struct C_BlobNode
   AccessPt access_pt;
   U64 key_ref_count;
   U64 downstream_ref_count;
+  
+  // rjf: rope blobs (data is a list of chunk blobs, flattened on first read)
+  U128 *rope_chunk_hashes;
+  U64 *rope_chunk_offs;
+  U64 rope_chunk_count;
+  Arena *rope_flat_arena;
+  
+  // rjf: mapped blobs (data is a view of a mapped file)
+  C_FileMap file_map;
 };
 
 typedef struct C_BlobSlot C_BlobSlot;
@@ -201,6 +235,7 @@ internal C_ID c_id_make(U64 u64_0, U64 u64_1);
 internal B32 c_id_match(C_ID a, C_ID b);
 internal C_Key c_key_make(C_Root root, C_ID id);
 internal B32 c_key_match(C_Key a, C_Key b);
+internal void c_file_map_release(C_FileMap *file_map, String8 view);
 
 ////////////////////////////////
 //~ rjf: Main Layer Initialization
@@ -217,6 +252,10 @@ internal void c_root_release(C_Root root);
 //~ rjf: Cache Submission
 
 internal U128 c_submit_data(C_Key key, Arena **data_arena, String8 data);
+internal U128 c_submit_blob(Arena **data_arena, String8 data);
+internal U128 c_submit_rope(C_Key key, U128 *chunk_hashes, U64 *chunk_sizes, U64 chunk_count);
+internal U128 c_hash_from_mapped_chunk_hashes(U128 *chunk_hashes, U64 chunk_count);
+internal U128 c_submit_mapped_data(C_Key key, C_FileMap *file_map, String8 data, U128 hash);
 
 ////////////////////////////////
 //~ rjf: Key Closing
@@ -234,6 +273,8 @@ internal void c_hash_downstream_dec(U128 hash);
 
 internal U128 c_hash_from_key(C_Key key, U64 rewind_count);
 internal String8 c_data_from_hash(Access *access, U128 hash);
+internal U64 c_size_from_hash(Access *access, U128 hash);
+internal U64 c_read_from_hash(Access *access, U128 hash, Rng1U64 range, void *out);
 
 ////////////////////////////////
 //~ rjf: Asynchronous Tick
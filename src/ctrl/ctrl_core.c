@@ -1476,6 +1476,17 @@ ctrl_init(void)
     ctrl_state->module_image_info_cache.stripes[idx].arena = arena_alloc();
     ctrl_state->module_image_info_cache.stripes[idx].rw_mutex = rw_mutex_alloc();
   }
+  ctrl_state->page_gen_cache.slots_count = 4096;
+  ctrl_state->page_gen_cache.slots = push_array(arena, CTRL_PageGenCacheSlot, ctrl_state->page_gen_cache.slots_count);
+  ctrl_state->page_gen_cache.stripes_count = os_get_system_info()->logical_processor_count;
+  ctrl_state->page_gen_cache.stripes = push_array(arena, CTRL_PageGenCacheStripe, ctrl_state->page_gen_cache.stripes_count);
+  for(U64 idx = 0; idx < ctrl_state->page_gen_cache.stripes_count; idx += 1)
+  {
+    ctrl_state->page_gen_cache.stripes[idx].arena = arena_alloc();
+    ctrl_state->page_gen_cache.stripes[idx].rw_mutex = rw_mutex_alloc();
+  }
+  ctrl_state->page_gen_cache.tracked_processes_rw_mutex = rw_mutex_alloc();
+  ctrl_state->page_gen_cache.tracked_processes_arena = arena_alloc();
   ctrl_state->u2c_ring_size = KB(64);
   ctrl_state->u2c_ring_base = push_array_no_zero(arena, U8, ctrl_state->u2c_ring_size);
   ctrl_state->u2c_ring_mutex = mutex_alloc();
@@ -1497,6 +1508,7 @@ ctrl_init(void)
   ctrl_state->ctrl_thread_entity_ctx_rw_mutex = rw_mutex_alloc();
   ctrl_state->ctrl_thread_entity_store = ctrl_entity_ctx_rw_store_alloc();
   ctrl_state->ctrl_thread_eval_cache = e_cache_alloc();
+  ctrl_state->bp_cond_cache_arena = arena_alloc();
   ctrl_state->ctrl_thread_msg_process_arena = arena_alloc();
   ctrl_state->dmn_event_arena = arena_alloc();
   ctrl_state->user_entry_point_arena = arena_alloc();
@@ -1702,6 +1714,26 @@ ctrl_intel_pdata_from_module_voff(Arena *arena, CTRL_Handle module_handle, U64 v
   return first_pdata;
 }
 
+internal ExecutableImageKind
+ctrl_image_kind_from_module(CTRL_Handle module_handle)
+{
+  ExecutableImageKind result = ExecutableImageKind_Null;
+  U64 hash = ctrl_hash_from_handle(module_handle);
+  U64 slot_idx = hash%ctrl_state->module_image_info_cache.slots_count;
+  U64 stripe_idx = slot_idx%ctrl_state->module_image_info_cache.stripes_count;
+  CTRL_ModuleImageInfoCacheSlot *slot = &ctrl_state->module_image_info_cache.slots[slot_idx];
+  CTRL_ModuleImageInfoCacheStripe *stripe = &ctrl_state->module_image_info_cache.stripes[stripe_idx];
+  MutexScopeR(stripe->rw_mutex) for(CTRL_ModuleImageInfoCacheNode *n = slot->first; n != 0; n = n->next)
+  {
+    if(ctrl_handle_match(n->module, module_handle))
+    {
+      result = n->image_kind;
+      break;
+    }
+  }
+  return result;
+}
+
 internal U64
 ctrl_entry_point_voff_from_module(CTRL_Handle module_handle)
 {
@@ -2646,10 +2678,163 @@ ctrl_unwind_step__pe_x64(CTRL_Handle process_handle, CTRL_Handle module_handle,
   return result;
 }
 
+//- rjf: [x64 ELF]
+
+internal REGS_Reg64 *
+ctrl_unwind_reg_from_dw_reg__elf_x64(REGS_RegBlockX64 *regs, DW_Reg dw_reg)
+{
+  local_persist REGS_Reg64 dummy = {0};
+  REGS_Reg64 *result = &dummy;
+  switch(dw_reg)
+  {
+    case DW_RegX64_Rax:{result = &regs->rax;}break;
+    case DW_RegX64_Rdx:{result = &regs->rdx;}break;
+    case DW_RegX64_Rcx:{result = &regs->rcx;}break;
+    case DW_RegX64_Rbx:{result = &regs->rbx;}break;
+    case DW_RegX64_Rsi:{result = &regs->rsi;}break;
+    case DW_RegX64_Rdi:{result = &regs->rdi;}break;
+    case DW_RegX64_Rbp:{result = &regs->rbp;}break;
+    case DW_RegX64_Rsp:{result = &regs->rsp;}break;
+    case DW_RegX64_R8 :{result = &regs->r8 ;}break;
+    case DW_RegX64_R9 :{result = &regs->r9 ;}break;
+    case DW_RegX64_R10:{result = &regs->r10;}break;
+    case DW_RegX64_R11:{result = &regs->r11;}break;
+    case DW_RegX64_R12:{result = &regs->r12;}break;
+    case DW_RegX64_R13:{result = &regs->r13;}break;
+    case DW_RegX64_R14:{result = &regs->r14;}break;
+    case DW_RegX64_R15:{result = &regs->r15;}break;
+    case DW_RegX64_Rip:{result = &regs->rip;}break;
+  }
+  return result;
+}
+
+internal CTRL_UnwindStepResult
+ctrl_unwind_step__elf_x64(CTRL_Handle process_handle, CTRL_Handle module_handle, U64 module_base_vaddr, REGS_RegBlockX64 *regs, B32 rip_is_return_address, U64 endt_us)
+{
+  B32 is_stale = 0;
+  B32 is_good = 0;
+  Access *access = access_open();
+  
+  //////////////////////////////
+  //- rjf: module -> compiled unwind table
+  //
+  CTRL_ElfUnwindTable *table = ctrl_elf_unwind_table_from_module(access, process_handle, module_handle, module_base_vaddr, endt_us);
+  if(table == 0)
+  {
+    is_stale = 1;
+  }
+  
+  //////////////////////////////
+  //- rjf: rip_voff -> unwind row
+  //
+  CTRL_ElfUnwindRow *row = 0;
+  if(table != 0 && table->rows_count != 0)
+  {
+    // NOTE: in caller frames, rip is a return address, which may be one
+    // past the end of the calling function (noreturn calls) - look up the
+    // call instruction instead, so we don't pick up the next function's FDE
+    U64 rip_voff = regs->rip.u64 - module_base_vaddr;
+    if(rip_is_return_address && rip_voff != 0)
+    {
+      rip_voff -= 1;
+    }
+    
+    // NOTE: binary search: find max index s.t. rows[index].voff <= rip_voff
+    U64 min = 0;
+    U64 opl = table->rows_count;
+    for(;min + 1 < opl;)
+    {
+      U64 mid = (min + opl)/2;
+      if(table->rows[mid].voff <= rip_voff)
+      {
+        min = mid;
+      }
+      else
+      {
+        opl = mid;
+      }
+    }
+    CTRL_ElfUnwindRow *candidate = &table->rows[min];
+    if(candidate->voff <= rip_voff && !(candidate->flags & (CTRL_ElfUnwindRowFlag_NoInfo|CTRL_ElfUnwindRowFlag_Unsupported)))
+    {
+      row = candidate;
+    }
+  }
+  
+  //////////////////////////////
+  //- rjf: apply row's rules
+  //
+  if(row != 0)
+  {
+    is_good = 1;
+    
+    // rjf: compute CFA
+    U64 cfa = ctrl_unwind_reg_from_dw_reg__elf_x64(regs, row->cfa_reg)->u64 + (S64)row->cfa_off;
+    
+    // rjf: compute caller's register values, from the callee's registers
+    U64 new_values[CTRL_ElfUnwindRegX64_COUNT] = {0};
+    for EachIndex(idx, CTRL_ElfUnwindRegX64_COUNT)
+    {
+      U64 value = ctrl_unwind_reg_from_dw_reg__elf_x64(regs, ctrl_dw_reg_from_elf_unwind_reg_x64((CTRL_ElfUnwindRegX64)idx))->u64;
+      switch(row->rules[idx])
+      {
+        case CTRL_ElfUnwindRule_SameValue:{}break;
+        case CTRL_ElfUnwindRule_Undefined:
+        {
+          if(idx == CTRL_ElfUnwindRegX64_ReturnAddress)
+          {
+            value = 0;
+          }
+        }break;
+        case CTRL_ElfUnwindRule_Offset:
+        {
+          B32 read_good = ctrl_process_memory_read_struct(process_handle, cfa + (S64)row->offs[idx], &is_stale, &value, endt_us);
+          if(!read_good)
+          {
+            is_good = 0;
+          }
+        }break;
+        case CTRL_ElfUnwindRule_ValOffset:
+        {
+          value = cfa + (S64)row->offs[idx];
+        }break;
+        case CTRL_ElfUnwindRule_Register:
+        {
+          value = ctrl_unwind_reg_from_dw_reg__elf_x64(regs, (DW_Reg)row->offs[idx])->u64;
+        }break;
+      }
+      new_values[idx] = value;
+    }
+    
+    // rjf: commit
+    if(is_good)
+    {
+      for EachIndex(idx, CTRL_ElfUnwindRegX64_COUNT)
+      {
+        if(idx != CTRL_ElfUnwindRegX64_ReturnAddress)
+        {
+          ctrl_unwind_reg_from_dw_reg__elf_x64(regs, ctrl_dw_reg_from_elf_unwind_reg_x64((CTRL_ElfUnwindRegX64)idx))->u64 = new_values[idx];
+        }
+      }
+      regs->rip.u64 = new_values[CTRL_ElfUnwindRegX64_ReturnAddress];
+      regs->rsp.u64 = cfa;
+    }
+  }
+  
+  //////////////////////////////
+  //- rjf: fill & return
+  //
+  access_close(access);
+  CTRL_UnwindStepResult result = {0};
+  if(!is_good) {result.flags |= CTRL_UnwindFlag_Error;}
+  if(is_stale) {result.flags |= CTRL_UnwindFlag_Stale;}
+  return result;
+}
+
 //- rjf: abstracted unwind step
 
 internal CTRL_UnwindStepResult
-ctrl_unwind_step(CTRL_Handle process, CTRL_Handle module, U64 module_base_vaddr, Arch arch, void *reg_block, U64 endt_us)
+ctrl_unwind_step(CTRL_Handle process, CTRL_Handle module, U64 module_base_vaddr, Arch arch, void *reg_block, B32 rip_is_return_address, U64 endt_us)
 {
   CTRL_UnwindStepResult result = {0};
   switch(arch)
@@ -2657,7 +2842,17 @@ ctrl_unwind_step(CTRL_Handle process, CTRL_Handle module, U64 module_base_vaddr,
     default:{}break;
     case Arch_x64:
     {
-      result = ctrl_unwind_step__pe_x64(process, module, module_base_vaddr, (REGS_RegBlockX64 *)reg_block, endt_us);
+      switch(ctrl_image_kind_from_module(module))
+      {
+        default:
+        {
+          result = ctrl_unwind_step__pe_x64(process, module, module_base_vaddr, (REGS_RegBlockX64 *)reg_block, endt_us);
+        }break;
+        case ExecutableImageKind_Elf64:
+        {
+          result = ctrl_unwind_step__elf_x64(process, module, module_base_vaddr, (REGS_RegBlockX64 *)reg_block, rip_is_return_address, endt_us);
+        }break;
+      }
     }break;
   }
   return result;
@@ -2692,13 +2887,16 @@ ctrl_unwind_from_thread(Arena *arena, CTRL_EntityCtx *ctx, CTRL_Handle thread, U
     unwind.flags = 0;
     for(;;)
     {
-      // rjf: regs -> rip*module
+      // rjf: regs -> rip*module; every frame but the first was reached by a
+      // call, so its rip is a return address - find the module of the call
       U64 rip = regs_rip_from_arch_block(arch, regs_block);
       U64 rsp = regs_rsp_from_arch_block(arch, regs_block);
+      B32 rip_is_return_address = (frame_node_count != 0);
+      U64 rip_lookup = (rip_is_return_address && rip != 0) ? rip-1 : rip;
       CTRL_Entity *module = &ctrl_entity_nil;
       for(CTRL_Entity *m = process_entity->first; m != &ctrl_entity_nil; m = m->next)
       {
-        if(m->kind == CTRL_EntityKind_Module && contains_1u64(m->vaddr_range, rip))
+        if(m->kind == CTRL_EntityKind_Module && contains_1u64(m->vaddr_range, rip_lookup))
         {
           module = m;
           break;
@@ -2720,7 +2918,7 @@ ctrl_unwind_from_thread(Arena *arena, CTRL_EntityCtx *ctx, CTRL_Handle thread, U
       frame_node_count += 1;
       
       // rjf: unwind one step
-      CTRL_UnwindStepResult step = ctrl_unwind_step(process_entity->handle, module->handle, module->vaddr_range.min, arch, regs_block, endt_us);
+      CTRL_UnwindStepResult step = ctrl_unwind_step(process_entity->handle, module->handle, module->vaddr_range.min, arch, regs_block, rip_is_return_address, endt_us);
       unwind.flags |= step.flags;
       if(step.flags & CTRL_UnwindFlag_Error ||
          regs_rsp_from_arch_block(arch, regs_block) == 0 ||
@@ -3089,6 +3287,7 @@ ctrl_thread__entry_point(void *p)
           arena_clear(ctrl_state->ctrl_thread_msg_process_arena);
           ctrl_state->module_req_cache_slots_count = 4096;
           ctrl_state->module_req_cache_slots = push_array(ctrl_state->ctrl_thread_msg_process_arena, CTRL_ModuleReqCacheNode *, ctrl_state->module_req_cache_slots_count);
+          ctrl_thread__bp_cond_cache_reset();
           MemoryZeroStruct(&ctrl_state->msg_user_bp_touched_files);
           MemoryZeroStruct(&ctrl_state->msg_user_bp_touched_symbols);
           MemoryCopyArray(ctrl_state->exception_code_filters, msg->exception_code_filters);
@@ -3407,6 +3606,7 @@ ctrl_thread__module_open(CTRL_Handle process, CTRL_Handle module, Rng1U64 vaddr_
   String8 raddbg_data = {0};
   Rng1U64 raddbg_section_voff_range = r1u64(0, 0);
   Rng1U64 raddbg_is_attached_section_voff_range = r1u64(0, 0);
+  ExecutableImageKind image_kind = ExecutableImageKind_Null;
   ProfScope("unpack relevant PE info")
   {
     B32 is_valid = 1;
@@ -3443,6 +3643,10 @@ ctrl_thread__module_open(CTRL_Handle process, CTRL_Handle module, Rng1U64 vaddr_
         is_valid = 0;
       }
     }
+    if(is_valid)
+    {
+      image_kind = ExecutableImageKind_CoffPe;
+    }
     
     //- rjf: unpack range of optional extension header
     U32 opt_ext_size = file_header.optional_header_size;
@@ -3634,13 +3838,28 @@ ctrl_thread__module_open(CTRL_Handle process, CTRL_Handle module, Rng1U64 vaddr_
       if(raddbg_is_attached_section_voff_range.max != raddbg_is_attached_section_voff_range.min)
       {
         U8 new_value = 1;
-        dmn_process_write_struct(process.dmn_handle, vaddr_range.min + raddbg_is_attached_section_voff_range.min, &new_value);
+        U64 new_value_vaddr = vaddr_range.min + raddbg_is_attached_section_voff_range.min;
+        dmn_process_write_struct(process.dmn_handle, new_value_vaddr, &new_value);
+        ctrl_page_gen_cache_mark_dirty(process, r1u64(new_value_vaddr, new_value_vaddr+sizeof(new_value)));
       }
       
       scratch_end(scratch);
     }
   }
   
+  //////////////////////////////
+  //- rjf: detect ELF images (unwind info is compiled lazily, via the ELF unwind table artifact cache)
+  //
+  if(image_kind == ExecutableImageKind_Null)
+  {
+    U8 e_ident[ELF_Identifier_Max] = {0};
+    if(dmn_process_read_struct(process.dmn_handle, vaddr_range.min, &e_ident) == sizeof(e_ident) &&
+       MemoryMatch(e_ident, elf_magic, sizeof(elf_magic)))
+    {
+      image_kind = ELF_HdrIs64Bit(e_ident) ? ExecutableImageKind_Elf64 : ExecutableImageKind_Elf32;
+    }
+  }
+  
   //////////////////////////////
   //- rjf: pick default initial debug info path
   //
@@ -3716,6 +3935,7 @@ ctrl_thread__module_open(CTRL_Handle process, CTRL_Handle module, Rng1U64 vaddr_
         DLLPushBack(slot->first, slot->last, node);
         node->module = module;
         node->arena = arena;
+        node->image_kind = image_kind;
         node->pdatas = pdatas;
         node->pdatas_count = pdatas_count;
         node->entry_point_voff = entry_point_voff;
@@ -3766,7 +3986,9 @@ ctrl_thread__module_close(CTRL_Handle process, CTRL_Handle module, Rng1U64 vaddr
   if(raddbg_section_voff_range.max != raddbg_section_voff_range.min)
   {
     U8 new_value = 0;
-    dmn_process_write_struct(process.dmn_handle, vaddr_range.min + raddbg_section_voff_range.min, &new_value);
+    U64 new_value_vaddr = vaddr_range.min + raddbg_section_voff_range.min;
+    dmn_process_write_struct(process.dmn_handle, new_value_vaddr, &new_value);
+    ctrl_page_gen_cache_mark_dirty(process, r1u64(new_value_vaddr, new_value_vaddr+sizeof(new_value)));
   }
 }
 
@@ -4002,6 +4224,10 @@ ctrl_thread__next_dmn_event(Arena *arena, DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg,
       {
         dmn_process_write(spoof->process, r1u64(spoof->vaddr, spoof->vaddr+size_of_spoof), &spoof_old_ip_value);
       }
+      
+      // rjf: tracked pages may have been written during this run - they are
+      // swept once the stop is reported
+      ins_atomic_u64_eval_assign(&ctrl_state->page_gen_cache.sweep_is_pending, 1);
     }
   }
   
@@ -4022,6 +4248,22 @@ ctrl_thread__next_dmn_event(Arena *arena, DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg,
     }
   }
   
+  //- rjf: entities coming or going => compiled breakpoint conditions may
+  // refer to stale modules/threads
+  switch(event->kind)
+  {
+    default:{}break;
+    case DMN_EventKind_CreateProcess:
+    case DMN_EventKind_CreateThread:
+    case DMN_EventKind_LoadModule:
+    case DMN_EventKind_ExitProcess:
+    case DMN_EventKind_ExitThread:
+    case DMN_EventKind_UnloadModule:
+    {
+      ctrl_thread__bp_cond_cache_reset();
+    }break;
+  }
+  
   //- rjf: push ctrl events associated with this demon event
   CTRL_EventList evts = {0};
   ProfScope("push ctrl events associated with this demon event") switch(event->kind)
@@ -4498,6 +4740,107 @@ ctrl_thread__eval_scope_end(CTRL_EvalScope *scope)
   access_close(scope->access);
 }
 
+//- rjf: breakpoint condition cache
+
+internal void
+ctrl_thread__bp_cond_cache_reset(void)
+{
+  for EachIndex(slot_idx, ctrl_state->bp_cond_cache_slots_count)
+  {
+    for(CTRL_BpCondCacheNode *n = ctrl_state->bp_cond_cache_slots[slot_idx]; n != 0; n = n->next)
+    {
+      ctrl_thread__eval_scope_end(n->eval_scope);
+      arena_release(n->arena);
+    }
+  }
+  arena_clear(ctrl_state->bp_cond_cache_arena);
+  ctrl_state->bp_cond_cache_slots_count = 256;
+  ctrl_state->bp_cond_cache_slots = push_array(ctrl_state->bp_cond_cache_arena, CTRL_BpCondCacheNode *, ctrl_state->bp_cond_cache_slots_count);
+}
+
+internal E_Interpretation
+ctrl_thread__bp_cond_interpretation(CTRL_UserBreakpointList *user_bps, CTRL_Entity *thread, U64 vaddr, String8 condition)
+{
+  ProfBeginFunction();
+  Arena *arena = ctrl_state->bp_cond_cache_arena;
+  
+  //- rjf: (thread, vaddr, condition) -> slot
+  U64 hash = 0;
+  {
+    U64 buf[] = {thread->handle.machine_id, thread->handle.dmn_handle.u64[0], vaddr, ctrl_hash_from_string(condition)};
+    hash = ctrl_hash_from_string(str8((U8 *)buf, sizeof(buf)));
+  }
+  U64 slot_idx = hash%ctrl_state->bp_cond_cache_slots_count;
+  
+  //- rjf: find existing node
+  CTRL_BpCondCacheNode *node = 0;
+  for(CTRL_BpCondCacheNode *n = ctrl_state->bp_cond_cache_slots[slot_idx]; n != 0; n = n->next)
+  {
+    if(ctrl_handle_match(n->thread, thread->handle) && n->vaddr == vaddr && str8_match(n->condition, condition, 0))
+    {
+      node = n;
+      break;
+    }
+  }
+  
+  //- rjf: find the trap module's debug info, & whether it is ready, without waiting
+  DI_Key dbgi_key = {0};
+  B32 dbgi_is_ready = 0;
+  {
+    Access *access = access_open();
+    CTRL_Entity *process = ctrl_process_from_entity(thread);
+    CTRL_Entity *module = ctrl_module_from_process_vaddr(process, vaddr);
+    dbgi_key = ctrl_dbgi_key_from_module(module);
+    dbgi_is_ready = (di_rdi_from_key(access, dbgi_key, 0, 0) != &rdi_parsed_nil);
+    access_close(access);
+  }
+  
+  //- rjf: cached, but compiled against other debug info (or before it was
+  // ready) => recompile, since the condition's names may resolve differently now
+  B32 need_compile = (node == 0);
+  if(node != 0 && (!di_key_match(node->dbgi_key, dbgi_key) || node->dbgi_is_ready != dbgi_is_ready))
+  {
+    ctrl_thread__eval_scope_end(node->eval_scope);
+    arena_clear(node->arena);
+    need_compile = 1;
+  }
+  
+  //- rjf: not cached => build scope, compile to bytecode, & store
+  if(need_compile) ProfScope("compile breakpoint condition")
+  {
+    if(node == 0)
+    {
+      node = push_array(arena, CTRL_BpCondCacheNode, 1);
+      SLLStackPush(ctrl_state->bp_cond_cache_slots[slot_idx], node);
+      node->thread    = thread->handle;
+      node->vaddr     = vaddr;
+      node->condition = push_str8_copy(arena, condition);
+      node->arena     = arena_alloc();
+    }
+    node->eval_scope    = ctrl_thread__eval_scope_begin(node->arena, user_bps, thread);
+    node->bytecode      = push_str8_copy(node->arena, e_bytecode_from_string(condition));
+    node->dbgi_key      = dbgi_key;
+    node->dbgi_is_ready = (node->eval_scope->base_ctx.primary_dbg_info->rdi != &rdi_parsed_nil);
+  }
+  
+  //- rjf: cached => reselect the scope's contexts, without discarding the
+  // compiled bytecode of other conditions
+  else
+  {
+    e_select_cache(ctrl_state->ctrl_thread_eval_cache);
+    e_reselect_base_ctx(&node->eval_scope->base_ctx);
+  }
+  
+  //- rjf: recompute frame base for this hit, & interpret
+  CTRL_EvalScope *scope = node->eval_scope;
+  node->frame_base = 0;
+  scope->interpret_ctx.frame_base = &node->frame_base;
+  e_select_interpret_ctx(&scope->interpret_ctx, scope->base_ctx.primary_dbg_info->rdi, scope->base_ctx.thread_ip_voff);
+  E_Interpretation result = e_interpret(node->bytecode);
+  ProfEnd();
+  return result;
+}
+
 //- rjf: log flusher
 
 internal void
@@ -4623,6 +4966,9 @@ ctrl_thread__attach(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
     }
   }
   
+  //- rjf: find which tracked pages were written since the last stop
+  ctrl_thread__page_gen_cache_sweep();
+  
   //- rjf: record stop
   {
     CTRL_EventList evts = {0};
@@ -4675,6 +5021,9 @@ ctrl_thread__kill(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
     }
   }
   
+  //- rjf: find which tracked pages were written since the last stop
+  ctrl_thread__page_gen_cache_sweep();
+  
   //- rjf: record stop
   {
     CTRL_EventList evts = {0};
@@ -4765,6 +5114,9 @@ ctrl_thread__kill_all(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
     }
   }
   
+  //- rjf: find which tracked pages were written since the last stop
+  ctrl_thread__page_gen_cache_sweep();
+  
   //- rjf: record stop
   {
     CTRL_EventList evts = {0};
@@ -4811,6 +5163,9 @@ ctrl_thread__detach(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
     }
   }
   
+  //- rjf: find which tracked pages were written since the last stop
+  ctrl_thread__page_gen_cache_sweep();
+  
   //- rjf: record stop
   {
     CTRL_EventList evts = {0};
@@ -5572,18 +5927,17 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
         // rjf: evaluate hit stop conditions
         if(conditions.node_count != 0) ProfScope("evaluate hit stop conditions")
         {
-          CTRL_EvalScope *eval_scope = ctrl_thread__eval_scope_begin(temp.arena, &msg->user_bps, thread);
           for(String8Node *condition_n = conditions.first; condition_n != 0; condition_n = condition_n->next)
           {
-            // rjf: evaluate
-            E_Eval eval = zero_struct;
+            // rjf: evaluate (compiled once per thread/address/condition, then re-interpreted)
+            E_Interpretation interpretation = zero_struct;
             ProfScope("evaluate expression")
             {
-              eval = e_eval_from_string(condition_n->string);
+              interpretation = ctrl_thread__bp_cond_interpretation(&msg->user_bps, thread, event->instruction_pointer, condition_n->string);
             }
             
             // rjf: interpret evaluation
-            if(eval.code == E_InterpretationCode_Good && eval.value.u64 == 0)
+            if(interpretation.code == E_InterpretationCode_Good && interpretation.value.u64 == 0)
             {
               hit_user_bp = 0;
               hit_conditional_bp_but_filtered = 1;
@@ -5597,7 +5951,6 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
               break;
             }
           }
-          ctrl_thread__eval_scope_end(eval_scope);
         }
         
         // rjf: gather trap net hits
@@ -5893,6 +6246,11 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
     }
   }
   
+  //////////////////////////////
+  //- rjf: find which tracked pages were written since the last stop
+  //
+  ctrl_thread__page_gen_cache_sweep();
+  
   //////////////////////////////
   //- rjf: record stop
   //
@@ -5977,6 +6335,9 @@ ctrl_thread__single_step(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
     }
   }
   
+  //- rjf: find which tracked pages were written since the last stop
+  ctrl_thread__page_gen_cache_sweep();
+  
   //- rjf: record stop
   {
     CTRL_EventList evts = {0};
@@ -6000,85 +6361,418 @@ ctrl_thread__single_step(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
 }
 
 ////////////////////////////////
-//~ rjf: Process Memory Artifact Cache Hooks / Lookups
+//~ rjf: Process Memory Page Generation Functions
 
-internal AC_Artifact
-ctrl_memory_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out)
+internal U64
+ctrl_page_mem_gen(CTRL_Handle process, U64 page_vaddr, B32 *clean_since_last_stop_out)
 {
-  AC_Artifact artifact = {0};
+  CTRL_PageGenCache *cache = &ctrl_state->page_gen_cache;
+  U64 result = 0;
+  B32 clean_since_last_stop = 0;
+  MutexScopeR(cache->tracked_processes_rw_mutex)
   {
-    //- rjf: unpack key
-    CTRL_Handle process = {0};
-    Rng1U64 vaddr_range = {0};
-    B32 zero_terminated = 0;
+    //- rjf: is this process tracked? if not, every page shares the global generation
+    B32 is_tracked = 0;
+    for EachNode(n, CTRL_HandleNode, cache->tracked_processes.first)
     {
-      U64 key_read_off = 0;
-      key_read_off += str8_deserial_read_struct(key, key_read_off, &process);
-      key_read_off += str8_deserial_read_struct(key, key_read_off, &vaddr_range);
-      key_read_off += str8_deserial_read_struct(key, key_read_off, &zero_terminated);
+      if(ctrl_handle_match(n->v, process))
+      {
+        is_tracked = 1;
+        break;
+      }
     }
-    
-    //- rjf: clamp vaddr range
-    Rng1U64 vaddr_range_clamped = vaddr_range;
+    if(ins_atomic_u64_eval(&cache->sweep_is_pending))
     {
-      vaddr_range_clamped.max = Max(vaddr_range_clamped.max, vaddr_range_clamped.min);
-      U64 max_size_cap = Min(max_U64-vaddr_range_clamped.min, GB(1));
-      vaddr_range_clamped.max = Min(vaddr_range_clamped.max, vaddr_range_clamped.min+max_size_cap);
+      is_tracked = 0;
     }
-    
-    //- rjf: do read
-    U64 range_size = dim_1u64(vaddr_range_clamped);
-    Arena *range_arena = 0;
-    void *range_base = 0;
-    U64 zero_terminated_size = 0;
-    U64 pre_read_mem_gen = ctrl_mem_gen();
-    B32 pre_run_state = ins_atomic_u64_eval(&ctrl_state->ctrl_thread_run_state);
-    if(range_size != 0)
+    if(!is_tracked)
     {
-      // rjf: set up arena
-      U64 page_size = os_get_system_info()->page_size; // TODO(rjf): @page_size_from_process
-      U64 arena_size = AlignPow2(range_size + ARENA_HEADER_SIZE, page_size);
-      range_arena = arena_alloc(.reserve_size = range_size+ARENA_HEADER_SIZE, .commit_size = range_size+ARENA_HEADER_SIZE);
-      
-      // rjf: if we got an arena -> push buffer & read
-      if(range_arena != 0)
-      {
-        // rjf: read as much as possible
-        range_base = push_array_no_zero(range_arena, U8, range_size);
-        U64 bytes_read = 0;
-        U64 retry_count = 0;
-        U64 retry_limit = range_size > page_size ? 64 : 0;
-        for(Rng1U64 vaddr_range_clamped_retry = vaddr_range_clamped;
-            retry_count <= retry_limit;
-            retry_count += 1)
-        {
-          bytes_read = dmn_process_read(process.dmn_handle, vaddr_range_clamped_retry, range_base);
-          if(bytes_read == 0 && vaddr_range_clamped_retry.max > vaddr_range_clamped_retry.min)
+      result = ctrl_mem_gen();
+    }
+    
+    //- rjf: tracked -> find or create this page's node
+    if(is_tracked)
+    {
+      U64 sweep_idx = ins_atomic_u64_eval(&cache->sweep_idx);
+      U64 hash_data[] = {process.machine_id, process.dmn_handle.u64[0], page_vaddr};
+      U64 hash = ctrl_hash_from_string(str8((U8 *)hash_data, sizeof(hash_data)));
+      U64 slot_idx = hash%cache->slots_count;
+      U64 stripe_idx = slot_idx%cache->stripes_count;
+      CTRL_PageGenCacheSlot *slot = &cache->slots[slot_idx];
+      CTRL_PageGenCacheStripe *stripe = &cache->stripes[stripe_idx];
+      B32 found = 0;
+      MutexScopeR(stripe->rw_mutex)
+      {
+        for(CTRL_PageGenCacheNode *n = slot->first; n != 0; n = n->next)
+        {
+          if(n->vaddr == page_vaddr && ctrl_handle_match(n->process, process))
           {
-            U64 diff = (vaddr_range_clamped_retry.max-vaddr_range_clamped_retry.min)/2;
-            vaddr_range_clamped_retry.max -= diff;
-            vaddr_range_clamped_retry.max = AlignDownPow2(vaddr_range_clamped_retry.max, page_size);
-            if(diff == 0)
-            {
-              break;
-            }
+            found = 1;
+            result = n->mem_gen;
+            ins_atomic_u64_eval_assign(&n->last_sweep_idx_touched, sweep_idx);
+            break;
           }
-          else
+        }
+      }
+      if(!found) MutexScopeW(stripe->rw_mutex)
+      {
+        CTRL_PageGenCacheNode *node = 0;
+        for(CTRL_PageGenCacheNode *n = slot->first; n != 0; n = n->next)
+        {
+          if(n->vaddr == page_vaddr && ctrl_handle_match(n->process, process))
           {
+            node = n;
             break;
           }
         }
-        
-        // rjf: if we read nothing, release arena
-        if(bytes_read == 0)
+        if(node == 0)
         {
-          arena_release(range_arena);
-          range_base = 0;
-          range_arena = 0;
+          node = stripe->free_node;
+          if(node != 0)
+          {
+            SLLStackPop(stripe->free_node);
+          }
+          else
+          {
+            node = push_array_no_zero(stripe->arena, CTRL_PageGenCacheNode, 1);
+          }
+          MemoryZeroStruct(node);
+          DLLPushBack(slot->first, slot->last, node);
+          node->process = process;
+          node->vaddr   = page_vaddr;
+          node->mem_gen = ctrl_mem_gen();
         }
-        
-        // rjf: if we only got a partial read, zero the rest
-        else if(bytes_read < range_size)
+        result = node->mem_gen;
+        node->last_sweep_idx_touched = sweep_idx;
+      }
+      clean_since_last_stop = (result < ins_atomic_u64_eval(&cache->last_sweep_mem_gen));
+    }
+  }
+  if(clean_since_last_stop_out != 0)
+  {
+    *clean_since_last_stop_out = clean_since_last_stop;
+  }
+  return result;
+}
+
+internal U64
+ctrl_mem_gen_from_process_vaddr_range(CTRL_Handle process, Rng1U64 range, B32 zero_terminated, B32 *clean_since_last_stop_out)
+{
+  U64 result = 0;
+  B32 clean_since_last_stop = 0;
+  
+  //- rjf: page-aligned reads, up to a chunk, change only when one of their
+  // pages does
+  if(!zero_terminated &&
+     range.max > range.min &&
+     range.min%DMN_DIRTY_PAGE_SIZE == 0 &&
+     range.max%DMN_DIRTY_PAGE_SIZE == 0 &&
+     dim_1u64(range) <= CTRL_MEM_CHUNK_SIZE)
+  {
+    clean_since_last_stop = 1;
+    for(U64 page_vaddr = range.min; page_vaddr < range.max; page_vaddr += DMN_DIRTY_PAGE_SIZE)
+    {
+      B32 page_clean_since_last_stop = 0;
+      U64 page_mem_gen = ctrl_page_mem_gen(process, page_vaddr, &page_clean_since_last_stop);
+      result = Max(result, page_mem_gen);
+      clean_since_last_stop = (clean_since_last_stop && page_clean_since_last_stop);
+    }
+  }
+  
+  //- rjf: all other reads use the global generation
+  else
+  {
+    result = ctrl_mem_gen();
+  }
+  
+  if(clean_since_last_stop_out != 0)
+  {
+    *clean_since_last_stop_out = clean_since_last_stop;
+  }
+  return result;
+}
+
+internal void
+ctrl_page_gen_cache_mark_dirty(CTRL_Handle process, Rng1U64 range)
+{
+  CTRL_PageGenCache *cache = &ctrl_state->page_gen_cache;
+  U64 new_mem_gen = ins_atomic_u64_inc_eval(&ctrl_state->mem_gen);
+  for(U64 page_vaddr = AlignDownPow2(range.min, DMN_DIRTY_PAGE_SIZE); page_vaddr < range.max; page_vaddr += DMN_DIRTY_PAGE_SIZE)
+  {
+    U64 hash_data[] = {process.machine_id, process.dmn_handle.u64[0], page_vaddr};
+    U64 hash = ctrl_hash_from_string(str8((U8 *)hash_data, sizeof(hash_data)));
+    U64 slot_idx = hash%cache->slots_count;
+    U64 stripe_idx = slot_idx%cache->stripes_count;
+    CTRL_PageGenCacheSlot *slot = &cache->slots[slot_idx];
+    CTRL_PageGenCacheStripe *stripe = &cache->stripes[stripe_idx];
+    MutexScopeW(stripe->rw_mutex)
+    {
+      for(CTRL_PageGenCacheNode *n = slot->first; n != 0; n = n->next)
+      {
+        if(n->vaddr == page_vaddr && ctrl_handle_match(n->process, process))
+        {
+          n->mem_gen = new_mem_gen;
+          break;
+        }
+      }
+    }
+  }
+}
+
+internal int
+ctrl_page_gen_sweep_entry_compare(CTRL_PageGenSweepEntry *a, CTRL_PageGenSweepEntry *b)
+{
+  int result = 0;
+  if(a->process.dmn_handle.u64[0] < b->process.dmn_handle.u64[0])      { result = -1; }
+  else if(a->process.dmn_handle.u64[0] > b->process.dmn_handle.u64[0]) { result = +1; }
+  else if(a->vaddr < b->vaddr)                                         { result = -1; }
+  else if(a->vaddr > b->vaddr)                                         { result = +1; }
+  return result;
+}
+
+internal void
+ctrl_thread__page_gen_cache_sweep(void)
+{
+  CTRL_PageGenCache *cache = &ctrl_state->page_gen_cache;
+  if(!ins_atomic_u64_eval(&cache->sweep_is_pending))
+  {
+    return;
+  }
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0, 0);
+  CTRL_EntityCtx *entity_ctx = &ctrl_state->ctrl_thread_entity_store->ctx;
+  U64 sweep_idx = ins_atomic_u64_eval(&cache->sweep_idx);
+  CTRL_EntityArray processes = ctrl_entity_array_from_kind(entity_ctx, CTRL_EntityKind_Process);
+  
+  //- rjf: gather all page nodes
+  U64 entries_count = 0;
+  CTRL_PageGenSweepEntry *entries = 0;
+  ProfScope("gather all page nodes")
+  {
+    U64 entries_cap = 0;
+    for EachIndex(stripe_idx, cache->stripes_count) MutexScopeR(cache->stripes[stripe_idx].rw_mutex)
+    {
+      for(U64 slot_idx = stripe_idx; slot_idx < cache->slots_count; slot_idx += cache->stripes_count)
+      {
+        for(CTRL_PageGenCacheNode *n = cache->slots[slot_idx].first; n != 0; n = n->next)
+        {
+          entries_cap += 1;
+        }
+      }
+    }
+    entries = push_array(scratch.arena, CTRL_PageGenSweepEntry, entries_cap);
+    for EachIndex(stripe_idx, cache->stripes_count) MutexScopeR(cache->stripes[stripe_idx].rw_mutex)
+    {
+      for(U64 slot_idx = stripe_idx; slot_idx < cache->slots_count; slot_idx += cache->stripes_count)
+      {
+        for(CTRL_PageGenCacheNode *n = cache->slots[slot_idx].first; n != 0 && entries_count < entries_cap; n = n->next)
+        {
+          entries[entries_count].process = n->process;
+          entries[entries_count].vaddr   = n->vaddr;
+          entries[entries_count].dirty   = 1;
+          entries_count += 1;
+        }
+      }
+    }
+  }
+  
+  //- rjf: gather processes whose dirty tracking was reset at the last sweep
+  CTRL_HandleList last_tracked_processes = {0};
+  MutexScopeR(cache->tracked_processes_rw_mutex)
+  {
+    for EachNode(n, CTRL_HandleNode, cache->tracked_processes.first)
+    {
+      ctrl_handle_list_push(scratch.arena, &last_tracked_processes, &n->v);
+    }
+  }
+  
+  //- rjf: sort pages by process & address, query dirty flags for each contiguous run
+  ProfScope("query dirty flags")
+  {
+    quick_sort(entries, entries_count, sizeof(entries[0]), ctrl_page_gen_sweep_entry_compare);
+    for(U64 run_first_idx = 0, run_opl_idx = 0; run_first_idx < entries_count; run_first_idx = run_opl_idx)
+    {
+      for(run_opl_idx = run_first_idx+1;
+          run_opl_idx < entries_count &&
+          ctrl_handle_match(entries[run_opl_idx].process, entries[run_first_idx].process) &&
+          entries[run_opl_idx].vaddr == entries[run_opl_idx-1].vaddr + DMN_DIRTY_PAGE_SIZE;
+          run_opl_idx += 1);
+      B32 run_process_was_tracked = 0;
+      for EachNode(n, CTRL_HandleNode, last_tracked_processes.first)
+      {
+        if(ctrl_handle_match(n->v, entries[run_first_idx].process))
+        {
+          run_process_was_tracked = 1;
+          break;
+        }
+      }
+      U64 run_count = run_opl_idx - run_first_idx;
+      U64 *dirty_flags = push_array(scratch.arena, U64, (run_count+63)/64);
+      Rng1U64 run_range = r1u64(entries[run_first_idx].vaddr, entries[run_opl_idx-1].vaddr + DMN_DIRTY_PAGE_SIZE);
+      if(run_process_was_tracked && dmn_process_read_dirty_pages(entries[run_first_idx].process.dmn_handle, run_range, dirty_flags))
+      {
+        for EachIndex(idx, run_count)
+        {
+          entries[run_first_idx+idx].dirty = !!(dirty_flags[idx/64] & (1ull<<(idx%64)));
+        }
+      }
+    }
+  }
+  
+  //- rjf: reset dirty tracking for all live processes, for the next stop
+  CTRL_HandleList tracked_processes = {0};
+  ProfScope("reset dirty tracking")
+  {
+    for EachIndex(idx, processes.count)
+    {
+      CTRL_Handle process = processes.v[idx]->handle;
+      if(dmn_process_clear_dirty_pages(process.dmn_handle))
+      {
+        ctrl_handle_list_push(scratch.arena, &tracked_processes, &process);
+      }
+    }
+  }
+  
+  //- rjf: publish new generation; advance all pages which were dirty, or which
+  // belonged to processes we could not track; drop pages of dead processes,
+  // and pages which have not been read for a while
+  U64 new_mem_gen = ins_atomic_u64_inc_eval(&ctrl_state->mem_gen);
+  MutexScopeW(cache->tracked_processes_rw_mutex)
+  {
+    for EachIndex(entry_idx, entries_count)
+    {
+      CTRL_PageGenSweepEntry *entry = &entries[entry_idx];
+      B32 process_is_live = 0;
+      for EachIndex(idx, processes.count)
+      {
+        if(ctrl_handle_match(processes.v[idx]->handle, entry->process))
+        {
+          process_is_live = 1;
+          break;
+        }
+      }
+      U64 hash_data[] = {entry->process.machine_id, entry->process.dmn_handle.u64[0], entry->vaddr};
+      U64 hash = ctrl_hash_from_string(str8((U8 *)hash_data, sizeof(hash_data)));
+      U64 slot_idx = hash%cache->slots_count;
+      U64 stripe_idx = slot_idx%cache->stripes_count;
+      CTRL_PageGenCacheSlot *slot = &cache->slots[slot_idx];
+      CTRL_PageGenCacheStripe *stripe = &cache->stripes[stripe_idx];
+      MutexScopeW(stripe->rw_mutex)
+      {
+        for(CTRL_PageGenCacheNode *n = slot->first; n != 0; n = n->next)
+        {
+          if(n->vaddr == entry->vaddr && ctrl_handle_match(n->process, entry->process))
+          {
+            if(!process_is_live || sweep_idx - n->last_sweep_idx_touched >= CTRL_PAGE_GEN_CACHE_IDLE_SWEEP_COUNT)
+            {
+              DLLRemove(slot->first, slot->last, n);
+              SLLStackPush(stripe->free_node, n);
+            }
+            else if(entry->dirty)
+            {
+              n->mem_gen = new_mem_gen;
+            }
+            break;
+          }
+        }
+      }
+    }
+    arena_clear(cache->tracked_processes_arena);
+    MemoryZeroStruct(&cache->tracked_processes);
+    for EachNode(n, CTRL_HandleNode, tracked_processes.first)
+    {
+      ctrl_handle_list_push(cache->tracked_processes_arena, &cache->tracked_processes, &n->v);
+    }
+    ins_atomic_u64_eval_assign(&cache->last_sweep_mem_gen, new_mem_gen);
+    ins_atomic_u64_inc_eval(&cache->sweep_idx);
+    ins_atomic_u64_eval_assign(&cache->sweep_is_pending, 0);
+  }
+  
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+////////////////////////////////
+//~ rjf: Process Memory Artifact Cache Hooks / Lookups
+
+internal AC_Artifact
+ctrl_memory_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out)
+{
+  AC_Artifact artifact = {0};
+  {
+    //- rjf: unpack key
+    CTRL_Handle process = {0};
+    Rng1U64 vaddr_range = {0};
+    B32 zero_terminated = 0;
+    {
+      U64 key_read_off = 0;
+      key_read_off += str8_deserial_read_struct(key, key_read_off, &process);
+      key_read_off += str8_deserial_read_struct(key, key_read_off, &vaddr_range);
+      key_read_off += str8_deserial_read_struct(key, key_read_off, &zero_terminated);
+    }
+    
+    //- rjf: clamp vaddr range
+    Rng1U64 vaddr_range_clamped = vaddr_range;
+    {
+      vaddr_range_clamped.max = Max(vaddr_range_clamped.max, vaddr_range_clamped.min);
+      U64 max_size_cap = Min(max_U64-vaddr_range_clamped.min, GB(1));
+      vaddr_range_clamped.max = Min(vaddr_range_clamped.max, vaddr_range_clamped.min+max_size_cap);
+    }
+    
+    //- rjf: do read
+    U64 range_size = dim_1u64(vaddr_range_clamped);
+    Arena *range_arena = 0;
+    void *range_base = 0;
+    U64 zero_terminated_size = 0;
+    U64 pre_read_mem_gen = ctrl_mem_gen();
+    U64 pre_read_key_mem_gen = ctrl_mem_gen_from_process_vaddr_range(process, vaddr_range, zero_terminated, 0);
+    B32 pre_run_state = ins_atomic_u64_eval(&ctrl_state->ctrl_thread_run_state);
+    if(range_size != 0)
+    {
+      // rjf: set up arena
+      U64 page_size = os_get_system_info()->page_size; // TODO(rjf): @page_size_from_process
+      U64 arena_size = AlignPow2(range_size + ARENA_HEADER_SIZE, page_size);
+      range_arena = arena_alloc(.reserve_size = range_size+ARENA_HEADER_SIZE, .commit_size = range_size+ARENA_HEADER_SIZE);
+      
+      // rjf: if we got an arena -> push buffer & read
+      if(range_arena != 0)
+      {
+        // rjf: read as much as possible
+        range_base = push_array_no_zero(range_arena, U8, range_size);
+        U64 bytes_read = 0;
+        U64 retry_count = 0;
+        U64 retry_limit = range_size > page_size ? 64 : 0;
+        for(Rng1U64 vaddr_range_clamped_retry = vaddr_range_clamped;
+            retry_count <= retry_limit;
+            retry_count += 1)
+        {
+          bytes_read = dmn_process_read(process.dmn_handle, vaddr_range_clamped_retry, range_base);
+          if(bytes_read == 0 && vaddr_range_clamped_retry.max > vaddr_range_clamped_retry.min)
+          {
+            U64 diff = (vaddr_range_clamped_retry.max-vaddr_range_clamped_retry.min)/2;
+            vaddr_range_clamped_retry.max -= diff;
+            vaddr_range_clamped_retry.max = AlignDownPow2(vaddr_range_clamped_retry.max, page_size);
+            if(diff == 0)
+            {
+              break;
+            }
+          }
+          else
+          {
+            break;
+          }
+        }
+        
+        // rjf: if we read nothing, release arena
+        if(bytes_read == 0)
+        {
+          arena_release(range_arena);
+          range_base = 0;
+          range_arena = 0;
+        }
+        
+        // rjf: if we only got a partial read, zero the rest
+        else if(bytes_read < range_size)
         {
           MemoryZero((U8 *)range_base + bytes_read, range_size-bytes_read);
         }
@@ -6124,7 +6818,8 @@ ctrl_memory_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64
     if((zero_terminated_size > 0 || !key_has_history) && range_base != 0 && range_size != 0 && pre_read_mem_gen == post_read_mem_gen)
     {
       hash = c_submit_data(content_key, &range_arena, str8((U8 *)range_base, zero_terminated_size));
-      gen_out[0] = pre_read_mem_gen;
+      gen_out[0] = pre_read_key_mem_gen;
+      size_out[0] = zero_terminated_size;
     }
     
     //- rjf: wakeup on new submissions
@@ -6176,10 +6871,11 @@ ctrl_key_from_process_vaddr_range(CTRL_Handle process, Rng1U64 vaddr_range, B32
   } key_data = {process, vaddr_range, zero_terminated};
 #pragma pack(pop)
   String8 key = str8_struct(&key_data);
+  U64 mem_gen = ctrl_mem_gen_from_process_vaddr_range(process, vaddr_range, zero_terminated, 0);
   Access *access = access_open();
   AC_Artifact artifact = ac_artifact_from_key(access, key, ctrl_memory_artifact_create, ctrl_memory_artifact_destroy, endt_us,
                                               .flags = AC_Flag_HighPriority | (wait_for_fresh ? AC_Flag_WaitForFresh : 0),
-                                              .gen = ctrl_mem_gen(),
+                                              .gen = mem_gen,
                                               .slots_count = 2048,
                                               .stale_out = out_is_stale,
                                               .evict_threshold_us = 10000000);
@@ -6192,6 +6888,66 @@ ctrl_key_from_process_vaddr_range(CTRL_Handle process, Rng1U64 vaddr_range, B32
 
 //- rjf: process memory reading helpers
 
+internal void
+ctrl_bit_flags_fill(U64 *flags, Rng1U64 bit_range)
+{
+  U64 bit_idx = bit_range.min;
+  for(; bit_idx < bit_range.max && bit_idx%64 != 0; bit_idx += 1)
+  {
+    flags[bit_idx/64] |= (1ull<<(bit_idx%64));
+  }
+  for(; bit_idx+64 <= bit_range.max; bit_idx += 64)
+  {
+    flags[bit_idx/64] = max_U64;
+  }
+  for(; bit_idx < bit_range.max; bit_idx += 1)
+  {
+    flags[bit_idx/64] |= (1ull<<(bit_idx%64));
+  }
+}
+
+internal void
+ctrl_bit_flags_from_byte_diff(U64 *flags, U64 flags_bit_off, String8 last_data, String8 data)
+{
+  U64 common_size = Min(last_data.size, data.size);
+  U64 idx = 0;
+  
+  //- rjf: compare 16 bytes at a time, only visiting bits for bytes which differ
+#if ARCH_X64
+  for(; idx+16 <= common_size; idx += 16)
+  {
+    __m128i last_bytes = _mm_loadu_si128((__m128i *)(last_data.str+idx));
+    __m128i now_bytes  = _mm_loadu_si128((__m128i *)(data.str+idx));
+    U32 changed_mask = (~(U32)_mm_movemask_epi8(_mm_cmpeq_epi8(last_bytes, now_bytes))) & 0xffff;
+    for(; changed_mask != 0; changed_mask &= changed_mask-1)
+    {
+      U64 bit_idx = flags_bit_off + idx + ctz32(changed_mask);
+      flags[bit_idx/64] |= (1ull<<(bit_idx%64));
+    }
+  }
+#endif
+  
+  //- rjf: compare leftover bytes one at a time
+  for(; idx < common_size; idx += 1)
+  {
+    if(last_data.str[idx] != data.str[idx])
+    {
+      U64 bit_idx = flags_bit_off + idx;
+      flags[bit_idx/64] |= (1ull<<(bit_idx%64));
+    }
+  }
+  
+  //- rjf: bytes past the end of the last data are compared against zero
+  for(; idx < data.size; idx += 1)
+  {
+    if(data.str[idx] != 0)
+    {
+      U64 bit_idx = flags_bit_off + idx;
+      flags[bit_idx/64] |= (1ull<<(bit_idx%64));
+    }
+  }
+}
+
 internal CTRL_ProcessMemorySlice
 ctrl_process_memory_slice_from_vaddr_range(Arena *arena, CTRL_Handle process, Rng1U64 range, B32 wait_for_fresh, U64 endt_us)
 {
@@ -6202,109 +6958,94 @@ ctrl_process_memory_slice_from_vaddr_range(Arena *arena, CTRL_Handle process, Rn
      range.min <= 0x000FFFFFFFFFFFFFull &&
      range.max <= 0x000FFFFFFFFFFFFFull)
   {
-    Temp scratch = scratch_begin(&arena, 1);
     Access *access = access_open();
     
-    //- rjf: unpack address range, prepare per-touched-page info
-    U64 page_size = KB(4);
+    //- rjf: unpack address range
+    U64 page_size = DMN_DIRTY_PAGE_SIZE;
+    U64 chunk_size = CTRL_MEM_CHUNK_SIZE;
     Rng1U64 page_range = r1u64(AlignDownPow2(range.min, page_size), AlignPow2(range.max, page_size));
-    U64 page_count = dim_1u64(page_range)/page_size;
-    U128 *page_hashes = push_array(scratch.arena, U128, page_count);
-    U128 *page_last_hashes = push_array(scratch.arena, U128, page_count);
-    
-    //- rjf: gather hashes & last-hashes for each page
-    ProfScope("gather hashes & last-hashes for each page")
-    {
-      for(U64 page_idx = 0; page_idx < page_count; page_idx += 1)
-      {
-        U64 page_base_vaddr = page_range.min + page_idx*page_size;
-        B32 page_is_stale = 0;
-        C_Key page_key = ctrl_key_from_process_vaddr_range(process, r1u64(page_base_vaddr, page_base_vaddr+page_size), 0, wait_for_fresh, endt_us, &page_is_stale);
-        U128 page_hash = c_hash_from_key(page_key, 0);
-        U128 page_last_hash = c_hash_from_key(page_key, 1);
-        result.stale = (result.stale || page_is_stale);
-        page_hashes[page_idx] = page_hash;
-        page_last_hashes[page_idx] = page_last_hash;
-      }
-    }
     
     //- rjf: setup output buffers
     void *read_out = push_array(arena, U8, dim_1u64(range));
     U64 *byte_bad_flags = push_array(arena, U64, (dim_1u64(range)+63)/64);
     U64 *byte_changed_flags = push_array(arena, U64, (dim_1u64(range)+63)/64);
     
-    //- rjf: iterate pages, fill output
-    ProfScope("iterate pages, fill output")
+    //- rjf: iterate blocks, fill output. blocks are whole chunks where the
+    // range covers an aligned chunk - so large ranges are read & hashed as a
+    // few big pieces - and single pages otherwise.
+    ProfScope("iterate blocks, fill output")
     {
-      U64 write_off = 0;
-      for(U64 page_idx = 0; page_idx < page_count; page_idx += 1)
+      U64 page_blocks_opl_vaddr = 0;
+      for(U64 block_vaddr = page_range.min; block_vaddr < page_range.max;)
       {
-        // rjf: read data for this page
-        String8 data = c_data_from_hash(access, page_hashes[page_idx]);
-        Rng1U64 data_vaddr_range = r1u64(page_range.min + page_idx*page_size, page_range.min + page_idx*page_size+data.size);
-        
-        // rjf: skip/chop bytes which are irrelevant for the actual requested read
-        String8 in_range_data = data;
-        if(page_idx == page_count-1 && data_vaddr_range.max > range.max)
+        // rjf: pick block size
+        U64 block_size = page_size;
+        if(block_vaddr >= page_blocks_opl_vaddr && block_vaddr%chunk_size == 0 && block_vaddr+chunk_size <= page_range.max)
         {
-          in_range_data = str8_chop(in_range_data, data_vaddr_range.max-range.max);
+          block_size = chunk_size;
         }
-        if(page_idx == 0 && range.min > data_vaddr_range.min)
+        
+        // rjf: get hashes for this block
+        Rng1U64 block_vaddr_range = r1u64(block_vaddr, block_vaddr+block_size);
+        B32 block_is_stale = 0;
+        B32 block_is_clean = 0;
+        C_Key block_key = ctrl_key_from_process_vaddr_range(process, block_vaddr_range, 0, wait_for_fresh, endt_us, &block_is_stale);
+        ctrl_mem_gen_from_process_vaddr_range(process, block_vaddr_range, 0, &block_is_clean);
+        U128 block_hash = c_hash_from_key(block_key, 0);
+        U128 block_last_hash = c_hash_from_key(block_key, 1);
+        result.stale = (result.stale || block_is_stale);
+        
+        // rjf: read data for this block
+        String8 data = c_data_from_hash(access, block_hash);
+        
+        // rjf: a fresh chunk which came back short crosses unreadable memory;
+        // keep the readable prefix, & fall back to pages for the rest of it
+        if(block_size > page_size && !block_is_stale && data.size < block_size)
         {
-          in_range_data = str8_skip(in_range_data, range.min-data_vaddr_range.min);
+          U64 good_size = AlignDownPow2(data.size, page_size);
+          page_blocks_opl_vaddr = block_vaddr+chunk_size;
+          if(good_size == 0)
+          {
+            continue;
+          }
+          block_size = good_size;
+          block_vaddr_range.max = block_vaddr+good_size;
+          data = str8_prefix(data, good_size);
         }
         
+        // rjf: skip/chop bytes which are irrelevant for the actual requested read
+        Rng1U64 data_vaddr_range = r1u64(block_vaddr, block_vaddr+data.size);
+        Rng1U64 in_range_data_vaddr_range = intersect_1u64(data_vaddr_range, range);
+        String8 in_range_data = str8_substr(data, r1u64(in_range_data_vaddr_range.min-block_vaddr, in_range_data_vaddr_range.max-block_vaddr));
+        U64 write_off = Max(block_vaddr, range.min) - range.min;
+        
         // rjf: write this chunk
-        MemoryCopy((U8*)read_out+write_off, in_range_data.str, in_range_data.size);
+        MemoryCopy((U8 *)read_out+write_off, in_range_data.str, in_range_data.size);
         
-        // rjf; if this page's data doesn't fill the entire range, mark
+        // rjf: if this block's data doesn't fill the entire block, mark
         // missing bytes as bad
-        if(data.size < page_size) ProfScope("mark missing bytes as bad")
+        if(data.size < block_size)
         {
-          Rng1U64 invalid_range = r1u64(data_vaddr_range.min+data.size, data_vaddr_range.min + page_size);
+          Rng1U64 invalid_range = r1u64(block_vaddr+data.size, block_vaddr+block_size);
           Rng1U64 in_range_invalid_range = intersect_1u64(invalid_range, range);
-          for(U64 invalid_vaddr = in_range_invalid_range.min;
-              invalid_vaddr < in_range_invalid_range.max;
-              invalid_vaddr += 1)
+          if(in_range_invalid_range.max > in_range_invalid_range.min)
           {
-            U64 idx_in_range = invalid_vaddr - range.min;
-            byte_bad_flags[idx_in_range/64] |= (1ull<<(idx_in_range%64));
+            ctrl_bit_flags_fill(byte_bad_flags, r1u64(in_range_invalid_range.min-range.min, in_range_invalid_range.max-range.min));
           }
         }
         
-        // rjf: if this page's hash & last_hash don't match, diff each byte &
-        // fill out changed flags
-        if(!u128_match(page_hashes[page_idx], page_last_hashes[page_idx])) ProfScope("hashes don't match; diff each byte")
-        {
-          String8 last_data = c_data_from_hash(access, page_last_hashes[page_idx]);
-          String8 in_range_last_data = last_data;
-          if(page_idx == page_count-1 && data_vaddr_range.max > range.max)
-          {
-            in_range_last_data = str8_chop(in_range_last_data, data_vaddr_range.max-range.max);
-          }
-          if(page_idx == 0 && range.min > data_vaddr_range.min)
-          {
-            in_range_last_data = str8_skip(in_range_last_data, range.min-data_vaddr_range.min);
-          }
-          for(U64 idx = 0; idx < in_range_data.size; idx += 1)
-          {
-            U8 last_byte = idx < in_range_last_data.size ? in_range_last_data.str[idx] : 0;
-            U8 now_byte  = idx < in_range_data.size ? in_range_data.str[idx] : 0;
-            if(last_byte != now_byte)
-            {
-              U64 idx_in_read_out = write_off+idx;
-              byte_changed_flags[idx_in_read_out/64] |= (1ull<<(idx_in_read_out%64));
-            }
-          }
+        // rjf: if this block's hash & last_hash don't match, diff each byte &
+        // fill out changed flags (blocks known to be clean since the last stop
+        // cannot have changed, whatever their last two hashes were)
+        if(!block_is_clean && !u128_match(block_hash, block_last_hash)) ProfScope("hashes don't match; diff each byte")
+        {
+          String8 last_data = c_data_from_hash(access, block_last_hash);
+          String8 in_range_last_data = str8_substr(last_data, r1u64(in_range_data_vaddr_range.min-block_vaddr, in_range_data_vaddr_range.max-block_vaddr));
+          ctrl_bit_flags_from_byte_diff(byte_changed_flags, write_off, in_range_last_data, in_range_data);
         }
         
-        // rjf: increment past this chunk
-        U64 bytes_to_skip = page_size;
-        if(page_idx == 0 && range.min > data_vaddr_range.min)
-        {
-          bytes_to_skip -= (range.min-data_vaddr_range.min);
-        }
-        write_off += bytes_to_skip;
+        // rjf: increment past this block
+        block_vaddr += block_size;
       }
     }
     
@@ -6329,7 +7070,6 @@ ctrl_process_memory_slice_from_vaddr_range(Arena *arena, CTRL_Handle process, Rn
     }
     
     access_close(access);
-    scratch_end(scratch);
   }
   ProfEnd();
   return result;
@@ -6365,7 +7105,7 @@ ctrl_process_write(CTRL_Handle process, Rng1U64 range, void *src)
   //- rjf: success -> bump generation
   if(result)
   {
-    ins_atomic_u64_inc_eval(&ctrl_state->mem_gen);
+    ctrl_page_gen_cache_mark_dirty(process, range);
   }
   
   //- rjf: success -> wait for cache updates, for small regions - prefer relatively seamless
@@ -6396,7 +7136,7 @@ ctrl_process_write(CTRL_Handle process, Rng1U64 range, void *src)
 //~ rjf: Call Stack Artifact Cache Hooks / Lookups
 
 internal AC_Artifact
-ctrl_call_stack_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out)
+ctrl_call_stack_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out)
 {
   AC_Artifact artifact = {0};
   {
@@ -6554,6 +7294,7 @@ ctrl_call_stack_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out,
     {
       artifact.u64[0] = (U64)arena;
       artifact.u64[1] = (U64)call_stack;
+      size_out[0] = arena_pos(arena);
     }
     
     //- rjf: mark retry
@@ -6595,7 +7336,7 @@ ctrl_call_stack_from_thread(Access *access, CTRL_Handle thread_handle, B32 high_
 //~ rjf: Call Stack Tree Artifact Cache Hooks / Lookups
 
 internal AC_Artifact
-ctrl_call_stack_tree_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out)
+ctrl_call_stack_tree_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out)
 {
   Temp scratch = scratch_begin(0, 0);
   Access *access = access_open();
@@ -6701,6 +7442,10 @@ ctrl_call_stack_tree_artifact_create(String8 key, B32 *cancel_signal, B32 *retry
   {
     artifact.u64[0] = (U64)arena;
     artifact.u64[1] = (U64)tree;
+    if(arena != 0)
+    {
+      size_out[0] = arena_pos(arena);
+    }
   }
   
   //- rjf: retry on stale
@@ -6737,3 +7482,485 @@ ctrl_call_stack_tree(Access *access, U64 endt_us)
   }
   return result;
 }
+
+////////////////////////////////
+//~ rjf: ELF Unwind Table Artifact Cache Hooks / Lookups
+
+//- rjf: helpers
+
+internal DW_Reg
+ctrl_dw_reg_from_elf_unwind_reg_x64(CTRL_ElfUnwindRegX64 reg)
+{
+  DW_Reg result = DW_RegX64_Rip;
+  switch(reg)
+  {
+    default:{}break;
+    case CTRL_ElfUnwindRegX64_Rbx:{result = DW_RegX64_Rbx;}break;
+    case CTRL_ElfUnwindRegX64_Rbp:{result = DW_RegX64_Rbp;}break;
+    case CTRL_ElfUnwindRegX64_R12:{result = DW_RegX64_R12;}break;
+    case CTRL_ElfUnwindRegX64_R13:{result = DW_RegX64_R13;}break;
+    case CTRL_ElfUnwindRegX64_R14:{result = DW_RegX64_R14;}break;
+    case CTRL_ElfUnwindRegX64_R15:{result = DW_RegX64_R15;}break;
+  }
+  return result;
+}
+
+internal int
+ctrl_elf_unwind_row_compare(CTRL_ElfUnwindRow *a, CTRL_ElfUnwindRow *b)
+{
+  // NOTE: FDE end markers sort before rows at the same voff, so that
+  // an FDE which starts exactly where another ends takes precedence.
+  int result = 0;
+  B32 a_is_end = !!(a->flags & CTRL_ElfUnwindRowFlag_NoInfo);
+  B32 b_is_end = !!(b->flags & CTRL_ElfUnwindRowFlag_NoInfo);
+  if(a->voff < b->voff)           { result = -1; }
+  else if(a->voff > b->voff)      { result = +1; }
+  else if(a_is_end && !b_is_end)  { result = -1; }
+  else if(!a_is_end && b_is_end)  { result = +1; }
+  return result;
+}
+
+internal
+DW_DECODE_PTR(ctrl_elf_unwind_decode_ptr)
+{
+  // NOTE: DW_CFA_set_loc is all but unused in .eh_frame, and we have no
+  // position for relative encodings here - only decode the value, so that
+  // the instruction stream stays in sync.
+  EH_PtrEnc encoding = *(EH_PtrEnc *)ud;
+  EH_PtrCtx ptr_ctx = {0};
+  return eh_read_ptr(data, 0, &ptr_ctx, encoding & EH_PtrEnc_TypeMask, ptr_out);
+}
+
+internal B32
+ctrl_elf_unwind_cie_from_eh_frame_off(String8 eh_frame, U64 off, EH_PtrCtx *ptr_ctx, DW_CIE *cie_out, EH_Augmentation *aug_out)
+{
+  B32 is_good = 0;
+  
+  //- rjf: read entry header
+  U64 length = 0;
+  U64 length_size = str8_deserial_read_dwarf_packed_size(eh_frame, off, &length);
+  U64 cursor = off + length_size;
+  U64 opl = cursor + length;
+  String8 data = str8_prefix(eh_frame, opl);
+  U32 id = max_U32;
+  cursor += str8_deserial_read_struct(data, cursor, &id);
+  
+  //- rjf: read CIE fields
+  U8 version = 0;
+  String8 aug_string = {0};
+  U64 code_align_factor = 0;
+  S64 data_align_factor = 0;
+  U64 ret_addr_reg = 0;
+  if(length_size != 0 && opl <= eh_frame.size && id == 0)
+  {
+    cursor += str8_deserial_read_struct(data, cursor, &version);
+    cursor += str8_deserial_read_cstr(data, cursor, &aug_string);
+    cursor += str8_deserial_read_uleb128(data, cursor, &code_align_factor);
+    cursor += str8_deserial_read_sleb128(data, cursor, &data_align_factor);
+    if(version == DW_Version_1)
+    {
+      cursor += str8_deserial_read(data, cursor, &ret_addr_reg, sizeof(U8), sizeof(U8));
+    }
+    else
+    {
+      cursor += str8_deserial_read_uleb128(data, cursor, &ret_addr_reg);
+    }
+    is_good = (cursor <= opl);
+  }
+  
+  //- rjf: read augmentation data; without a 'z' the augmentation's size is
+  // unknown, so we can't parse past it
+  String8 aug_data = {0};
+  MemoryZeroStruct(aug_out);
+  if(is_good && aug_string.size != 0)
+  {
+    if(aug_string.str[0] == 'z')
+    {
+      U64 aug_data_size = 0;
+      cursor += str8_deserial_read_uleb128(data, cursor, &aug_data_size);
+      aug_data = str8_substr(data, r1u64(cursor, cursor + aug_data_size));
+      EH_PtrCtx aug_ptr_ctx = *ptr_ctx;
+      aug_ptr_ctx.raw_base_vaddr += cursor;
+      eh_parse_aug_data(aug_string, aug_data, &aug_ptr_ctx, aug_out);
+      cursor += aug_data_size;
+      is_good = (cursor <= opl);
+    }
+    else
+    {
+      is_good = 0;
+    }
+  }
+  else
+  {
+    aug_out->lsda_encoding    = EH_PtrEnc_Omit;
+    aug_out->handler_encoding = EH_PtrEnc_Omit;
+    aug_out->addr_encoding    = EH_PtrEnc_UData8;
+  }
+  
+  //- rjf: fill
+  if(is_good)
+  {
+    MemoryZeroStruct(cie_out);
+    cie_out->insts             = str8_substr(data, r1u64(cursor, opl));
+    cie_out->aug_string        = aug_string;
+    cie_out->aug_data          = aug_data;
+    cie_out->code_align_factor = code_align_factor;
+    cie_out->data_align_factor = data_align_factor;
+    cie_out->ret_addr_reg      = ret_addr_reg;
+    cie_out->format            = (length_size == sizeof(U32) ? DW_Format_32Bit : DW_Format_64Bit);
+    cie_out->version           = version;
+    cie_out->address_size      = 8;
+  }
+  return is_good;
+}
+
+//- rjf: .eh_frame -> compiled unwind table
+
+internal CTRL_ElfUnwindTable
+ctrl_elf_unwind_table_from_eh_frame(Arena *arena, String8 eh_frame, U64 eh_frame_vaddr, U64 module_base_vaddr)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+  Arena *cfi_arena = arena_alloc();
+  typedef struct RowChunkNode RowChunkNode;
+  struct RowChunkNode
+  {
+    RowChunkNode *next;
+    CTRL_ElfUnwindRow v[1024];
+    U64 count;
+  };
+  RowChunkNode *first_chunk = 0;
+  RowChunkNode *last_chunk = 0;
+  U64 rows_count = 0;
+  
+  //////////////////////////////
+  //- rjf: run each FDE's CFI program once, gathering the rows it produces
+  //
+  EH_PtrCtx ptr_ctx = {0};
+  ptr_ctx.raw_base_vaddr = eh_frame_vaddr;
+  ptr_ctx.ptr_align      = 8;
+  U64 cie_off = max_U64;
+  B32 cie_good = 0;
+  DW_CIE cie = {0};
+  EH_Augmentation cie_aug = {0};
+  for(U64 off = 0, next_off = 0; off < eh_frame.size; off = next_off)
+  {
+    //- rjf: read entry header; zero-length entry terminates .eh_frame
+    U64 length = 0;
+    U64 length_size = str8_deserial_read_dwarf_packed_size(eh_frame, off, &length);
+    U32 id = 0;
+    U64 id_off = off + length_size;
+    next_off = id_off + length;
+    if(length_size == 0 || length == 0 || next_off > eh_frame.size ||
+       str8_deserial_read_struct(eh_frame, id_off, &id) != sizeof(id))
+    {
+      break;
+    }
+    
+    //- rjf: skip CIEs - they are parsed when first referenced by an FDE
+    if(id == 0 || id > id_off)
+    {
+      continue;
+    }
+    
+    //- rjf: FDE -> CIE
+    if(id_off - id != cie_off)
+    {
+      cie_off = id_off - id;
+      cie_good = ctrl_elf_unwind_cie_from_eh_frame_off(eh_frame, cie_off, &ptr_ctx, &cie, &cie_aug);
+    }
+    if(!cie_good || (cie_aug.addr_encoding & EH_PtrEnc_Indirect))
+    {
+      continue;
+    }
+    
+    //- rjf: read FDE's PC range & instructions
+    String8 data = str8_prefix(eh_frame, next_off);
+    U64 cursor = id_off + sizeof(id);
+    U64 pc_begin = 0;
+    U64 pc_size = 0;
+    cursor += eh_read_ptr(data, cursor, &ptr_ctx, cie_aug.addr_encoding, &pc_begin);
+    cursor += eh_read_ptr(data, cursor, &ptr_ctx, cie_aug.addr_encoding & EH_PtrEnc_TypeMask, &pc_size);
+    if(cie.aug_string.size != 0)
+    {
+      U64 aug_data_size = 0;
+      cursor += str8_deserial_read_uleb128(data, cursor, &aug_data_size);
+      cursor += aug_data_size;
+    }
+    if(pc_begin < module_base_vaddr || pc_size == 0 || cursor > next_off)
+    {
+      continue;
+    }
+    DW_FDE fde = {0};
+    fde.format      = cie.format;
+    fde.cie_pointer = cie_off;
+    fde.pc_range    = r1u64(pc_begin, pc_begin + pc_size);
+    fde.insts       = str8_substr(data, r1u64(cursor, next_off));
+    
+    //- rjf: interpret CFI program, push a compact row for each address range it describes
+    Temp temp = temp_begin(cfi_arena);
+    DW_CFI_Unwind *uw = dw_cfi_unwind_init(temp.arena, Arch_x64, &cie, &fde, ctrl_elf_unwind_decode_ptr, &cie_aug.addr_encoding);
+    CTRL_ElfUnwindRow *last_fde_row = 0;
+    for(B32 row_good = 1; row_good && fde.pc_range.min <= uw->pc && uw->pc < fde.pc_range.max; row_good = dw_cfi_next_row(temp.arena, uw))
+    {
+      // rjf: DWARF row -> compact row
+      CTRL_ElfUnwindRow row;
+      MemoryZeroStruct(&row);
+      row.voff = uw->pc - module_base_vaddr;
+      if(uw->row->cfa.rule == DW_CFA_Rule_RegOff && uw->row->cfa.reg <= DW_RegX64_Rip && uw->row->cfa.off == (S32)uw->row->cfa.off)
+      {
+        row.cfa_reg = (U8)uw->row->cfa.reg;
+        row.cfa_off = (S32)uw->row->cfa.off;
+      }
+      else
+      {
+        row.flags |= CTRL_ElfUnwindRowFlag_Unsupported;
+      }
+      for EachIndex(idx, CTRL_ElfUnwindRegX64_COUNT)
+      {
+        B32 is_ret_addr = (idx == CTRL_ElfUnwindRegX64_ReturnAddress);
+        DW_Reg dw_reg = is_ret_addr ? (DW_Reg)cie.ret_addr_reg : ctrl_dw_reg_from_elf_unwind_reg_x64((CTRL_ElfUnwindRegX64)idx);
+        DW_CFI_Register *src = (dw_reg < uw->reg_count) ? &uw->row->regs[dw_reg] : 0;
+        DW_CFI_RegisterRule src_rule = src ? src->rule : DW_CFI_RegisterRule_Expression;
+        S64 src_n = (src_rule == DW_CFI_RegisterRule_Offset || src_rule == DW_CFI_RegisterRule_ValOffset || src_rule == DW_CFI_RegisterRule_Register) ? src->n : 0;
+        switch(src_rule)
+        {
+          default:{row.flags |= CTRL_ElfUnwindRowFlag_Unsupported;}break;
+          case DW_CFI_RegisterRule_SameValue:
+          {
+            // NOTE: "same value" has no meaning for the return address column
+            if(is_ret_addr)
+            {
+              row.flags |= CTRL_ElfUnwindRowFlag_Unsupported;
+            }
+            row.rules[idx] = CTRL_ElfUnwindRule_SameValue;
+          }break;
+          case DW_CFI_RegisterRule_Undefined:{row.rules[idx] = CTRL_ElfUnwindRule_Undefined;}break;
+          case DW_CFI_RegisterRule_Offset:   {row.rules[idx] = CTRL_ElfUnwindRule_Offset;}break;
+          case DW_CFI_RegisterRule_ValOffset:{row.rules[idx] = CTRL_ElfUnwindRule_ValOffset;}break;
+          case DW_CFI_RegisterRule_Register:
+          {
+            row.rules[idx] = CTRL_ElfUnwindRule_Register;
+            if(src_n < 0 || src_n > DW_RegX64_Rip)
+            {
+              row.flags |= CTRL_ElfUnwindRowFlag_Unsupported;
+            }
+          }break;
+        }
+        if(src_n != (S32)src_n)
+        {
+          row.flags |= CTRL_ElfUnwindRowFlag_Unsupported;
+        }
+        row.offs[idx] = (S32)src_n;
+      }
+      
+      // rjf: push row; rules at the same address replace the previous row
+      if(last_fde_row != 0 && last_fde_row->voff == row.voff)
+      {
+        *last_fde_row = row;
+      }
+      else
+      {
+        if(last_chunk == 0 || last_chunk->count >= ArrayCount(last_chunk->v))
+        {
+          RowChunkNode *chunk = push_array_no_zero(scratch.arena, RowChunkNode, 1);
+          chunk->next = 0;
+          chunk->count = 0;
+          SLLQueuePush(first_chunk, last_chunk, chunk);
+        }
+        last_fde_row = &last_chunk->v[last_chunk->count];
+        last_chunk->count += 1;
+        rows_count += 1;
+        *last_fde_row = row;
+      }
+    }
+    temp_end(temp);
+    
+    //- rjf: push end marker for this FDE
+    {
+      if(last_chunk == 0 || last_chunk->count >= ArrayCount(last_chunk->v))
+      {
+        RowChunkNode *chunk = push_array_no_zero(scratch.arena, RowChunkNode, 1);
+        chunk->next = 0;
+        chunk->count = 0;
+        SLLQueuePush(first_chunk, last_chunk, chunk);
+      }
+      CTRL_ElfUnwindRow *row = &last_chunk->v[last_chunk->count];
+      last_chunk->count += 1;
+      rows_count += 1;
+      MemoryZeroStruct(row);
+      row->voff  = fde.pc_range.max - module_base_vaddr;
+      row->flags = CTRL_ElfUnwindRowFlag_NoInfo;
+    }
+  }
+  
+  //////////////////////////////
+  //- rjf: flatten, sort, & compact rows
+  //
+  CTRL_ElfUnwindTable table = {0};
+  {
+    CTRL_ElfUnwindRow *rows = push_array_no_zero(arena, CTRL_ElfUnwindRow, rows_count);
+    U64 idx = 0;
+    for(RowChunkNode *n = first_chunk; n != 0; n = n->next)
+    {
+      MemoryCopy(rows + idx, n->v, sizeof(n->v[0])*n->count);
+      idx += n->count;
+    }
+    quick_sort(rows, rows_count, sizeof(rows[0]), ctrl_elf_unwind_row_compare);
+    
+    // rjf: collapse rows at the same address (the last one wins)
+    U64 unique_count = 0;
+    for EachIndex(src_idx, rows_count)
+    {
+      if(unique_count != 0 && rows[unique_count-1].voff == rows[src_idx].voff)
+      {
+        unique_count -= 1;
+      }
+      rows[unique_count] = rows[src_idx];
+      unique_count += 1;
+    }
+    
+    // rjf: drop rows which only repeat the rules of the row before them
+    U64 compact_count = 0;
+    U64 rules_size = sizeof(rows[0]) - OffsetOf(CTRL_ElfUnwindRow, cfa_off);
+    for EachIndex(src_idx, unique_count)
+    {
+      if(compact_count == 0 || !MemoryMatch(&rows[compact_count-1].cfa_off, &rows[src_idx].cfa_off, rules_size))
+      {
+        rows[compact_count] = rows[src_idx];
+        compact_count += 1;
+      }
+    }
+    arena_pop(arena, sizeof(rows[0])*(rows_count - compact_count));
+    table.rows = rows;
+    table.rows_count = compact_count;
+  }
+  
+  arena_release(cfi_arena);
+  scratch_end(scratch);
+  ProfEnd();
+  return table;
+}
+
+//- rjf: artifact cache hooks
+
+internal AC_Artifact
+ctrl_elf_unwind_table_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0, 0);
+  
+  //- rjf: unpack key
+  CTRL_Handle process = {0};
+  U64 module_base_vaddr = 0;
+  str8_deserial_read_struct(key, 0, &process);
+  str8_deserial_read_struct(key, sizeof(CTRL_Handle)*2, &module_base_vaddr);
+  
+  //- rjf: read ELF header & program headers from module's image
+  ELF_Hdr64 hdr = {0};
+  ELF_Phdr64 *phdrs = 0;
+  U64 phdrs_count = 0;
+  if(dmn_process_read_struct(process.dmn_handle, module_base_vaddr, &hdr) == sizeof(hdr) &&
+     MemoryMatch(hdr.e_ident, elf_magic, sizeof(elf_magic)) &&
+     ELF_HdrIs64Bit(hdr.e_ident) &&
+     hdr.e_phentsize == sizeof(ELF_Phdr64))
+  {
+    phdrs_count = hdr.e_phnum;
+    phdrs = push_array(scratch.arena, ELF_Phdr64, phdrs_count);
+    dmn_process_read(process.dmn_handle, r1u64(module_base_vaddr + hdr.e_phoff, module_base_vaddr + hdr.e_phoff + sizeof(ELF_Phdr64)*phdrs_count), phdrs);
+  }
+  
+  //- rjf: program headers -> load bias, .eh_frame_hdr
+  U64 min_load_vaddr = max_U64;
+  ELF_Phdr64 *eh_frame_hdr_phdr = 0;
+  for EachIndex(idx, phdrs_count)
+  {
+    if(phdrs[idx].p_type == ELF_PType_Load)
+    {
+      min_load_vaddr = Min(min_load_vaddr, AlignDownPow2(phdrs[idx].p_vaddr, KB(4)));
+    }
+    else if(phdrs[idx].p_type == ELF_PType_GnuEHFrame)
+    {
+      eh_frame_hdr_phdr = &phdrs[idx];
+    }
+  }
+  U64 load_bias = module_base_vaddr - min_load_vaddr;
+  
+  //- rjf: .eh_frame_hdr -> .eh_frame vaddr
+  U64 eh_frame_vaddr = 0;
+  if(eh_frame_hdr_phdr != 0 && min_load_vaddr != max_U64)
+  {
+    U64 eh_frame_hdr_vaddr = load_bias + eh_frame_hdr_phdr->p_vaddr;
+    U8 eh_frame_hdr[16] = {0};
+    U64 eh_frame_hdr_size = dmn_process_read(process.dmn_handle, r1u64(eh_frame_hdr_vaddr, eh_frame_hdr_vaddr + Min(sizeof(eh_frame_hdr), eh_frame_hdr_phdr->p_memsz)), eh_frame_hdr);
+    U8 version = eh_frame_hdr[0];
+    EH_PtrEnc eh_frame_ptr_enc = eh_frame_hdr[1];
+    if(eh_frame_hdr_size >= 4 && version == 1 && eh_frame_ptr_enc != EH_PtrEnc_Omit && !(eh_frame_ptr_enc & EH_PtrEnc_Indirect))
+    {
+      EH_PtrCtx ptr_ctx = {0};
+      ptr_ctx.raw_base_vaddr = eh_frame_hdr_vaddr;
+      ptr_ctx.data_vaddr     = eh_frame_hdr_vaddr;
+      ptr_ctx.ptr_align      = 8;
+      eh_read_ptr(str8(eh_frame_hdr, eh_frame_hdr_size), 4, &ptr_ctx, eh_frame_ptr_enc, &eh_frame_vaddr);
+    }
+  }
+  
+  //- rjf: read .eh_frame, up to the end of its containing segment
+  String8 eh_frame = {0};
+  if(eh_frame_vaddr != 0)
+  {
+    for EachIndex(idx, phdrs_count)
+    {
+      Rng1U64 segment_vaddr_range = r1u64(load_bias + phdrs[idx].p_vaddr, load_bias + phdrs[idx].p_vaddr + phdrs[idx].p_filesz);
+      if(phdrs[idx].p_type == ELF_PType_Load && contains_1u64(segment_vaddr_range, eh_frame_vaddr))
+      {
+        U64 size = segment_vaddr_range.max - eh_frame_vaddr;
+        eh_frame.str = push_array_no_zero(scratch.arena, U8, size);
+        eh_frame.size = dmn_process_read(process.dmn_handle, r1u64(eh_frame_vaddr, eh_frame_vaddr + size), eh_frame.str);
+        break;
+      }
+    }
+  }
+  
+  //- rjf: compile
+  Arena *arena = arena_alloc();
+  CTRL_ElfUnwindTable *table = push_array(arena, CTRL_ElfUnwindTable, 1);
+  table[0] = ctrl_elf_unwind_table_from_eh_frame(arena, eh_frame, eh_frame_vaddr, module_base_vaddr);
+  
+  //- rjf: bundle table as artifact
+  AC_Artifact artifact = {0};
+  artifact.u64[0] = (U64)arena;
+  artifact.u64[1] = (U64)table;
+  size_out[0] = arena_pos(arena);
+  scratch_end(scratch);
+  ProfEnd();
+  return artifact;
+}
+
+internal void
+ctrl_elf_unwind_table_artifact_destroy(AC_Artifact artifact)
+{
+  Arena *arena = (Arena *)artifact.u64[0];
+  if(arena != 0)
+  {
+    arena_release(arena);
+  }
+}
+
+internal CTRL_ElfUnwindTable *
+ctrl_elf_unwind_table_from_module(Access *access, CTRL_Handle process, CTRL_Handle module, U64 module_base_vaddr, U64 endt_us)
+{
+#pragma pack(push, 1)
+  struct
+  {
+    CTRL_Handle process;
+    CTRL_Handle module;
+    U64 module_base_vaddr;
+  } key_data = {process, module, module_base_vaddr};
+#pragma pack(pop)
+  AC_Artifact artifact = ac_artifact_from_key(access, str8_struct(&key_data), ctrl_elf_unwind_table_artifact_create, ctrl_elf_unwind_table_artifact_destroy, endt_us,
+                                              .flags = AC_Flag_HighPriority,
+                                              .evict_threshold_us = 60000000);
+  CTRL_ElfUnwindTable *table = (CTRL_ElfUnwindTable *)artifact.u64[1];
+  return table;
+}
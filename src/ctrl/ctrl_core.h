@@ -4,6 +4,13 @@
 #ifndef CTRL_CORE_H
 #define CTRL_CORE_H
 
+////////////////////////////////
+//~ rjf: Includes
+
+#if ARCH_X64
+# include <emmintrin.h>
+#endif
+
 ////////////////////////////////
 //~ rjf: ID Types
 
@@ -258,6 +265,62 @@ struct CTRL_Unwind
   CTRL_UnwindFlags flags;
 };
 
+////////////////////////////////
+//~ rjf: ELF Unwind Table Types
+//
+// A module's .eh_frame CFI is compiled once into a sorted array of rows. Each
+// row holds the CFA & register rules valid from its voff up to the next row's
+// voff, so an unwind step is a binary search plus reads of saved registers,
+// rather than an interpretation of the CFI program for the containing FDE.
+
+typedef U8 CTRL_ElfUnwindRule;
+enum
+{
+  CTRL_ElfUnwindRule_SameValue, // register is not modified by this frame
+  CTRL_ElfUnwindRule_Undefined, // register is not recoverable
+  CTRL_ElfUnwindRule_Offset,    // register is saved at [cfa + off]
+  CTRL_ElfUnwindRule_ValOffset, // register's value is cfa + off
+  CTRL_ElfUnwindRule_Register,  // register's value is in DWARF register #off
+};
+
+typedef enum CTRL_ElfUnwindRegX64
+{
+  CTRL_ElfUnwindRegX64_Rbx,
+  CTRL_ElfUnwindRegX64_Rbp,
+  CTRL_ElfUnwindRegX64_R12,
+  CTRL_ElfUnwindRegX64_R13,
+  CTRL_ElfUnwindRegX64_R14,
+  CTRL_ElfUnwindRegX64_R15,
+  CTRL_ElfUnwindRegX64_ReturnAddress,
+  CTRL_ElfUnwindRegX64_COUNT
+}
+CTRL_ElfUnwindRegX64;
+
+typedef U8 CTRL_ElfUnwindRowFlags;
+enum
+{
+  CTRL_ElfUnwindRowFlag_NoInfo      = (1<<0), // no FDE covers this row's range
+  CTRL_ElfUnwindRowFlag_Unsupported = (1<<1), // CFA or register rules need DWARF expressions
+};
+
+typedef struct CTRL_ElfUnwindRow CTRL_ElfUnwindRow;
+struct CTRL_ElfUnwindRow
+{
+  U64 voff;
+  S32 cfa_off;
+  U8 cfa_reg;
+  CTRL_ElfUnwindRowFlags flags;
+  CTRL_ElfUnwindRule rules[CTRL_ElfUnwindRegX64_COUNT];
+  S32 offs[CTRL_ElfUnwindRegX64_COUNT];
+};
+
+typedef struct CTRL_ElfUnwindTable CTRL_ElfUnwindTable;
+struct CTRL_ElfUnwindTable
+{
+  CTRL_ElfUnwindRow *rows;
+  U64 rows_count;
+};
+
 ////////////////////////////////
 //~ rjf: Call Stack Types
 
@@ -585,6 +648,73 @@ struct CTRL_ThreadRegCache
   CTRL_ThreadRegCacheStripe *stripes;
 };
 
+////////////////////////////////
+//~ rjf: Process Memory Page Generation Cache Types
+//
+// NOTE: for processes whose dirty pages the demon layer can report, each
+// page that has been read gets its own memory generation, which only advances
+// when a stop finds that page written. clean pages then keep their cached
+// contents & hashes across stops, rather than being re-read after each one.
+// pages are only swept at stops which are reported to the user; between a run
+// and its sweep (e.g. during conditional breakpoint evaluation), all pages
+// share the global generation. pages which are not read for a number of
+// sweeps are dropped, and start over with a fresh generation if read again.
+
+#define CTRL_PAGE_GEN_CACHE_IDLE_SWEEP_COUNT 8
+
+typedef struct CTRL_PageGenCacheNode CTRL_PageGenCacheNode;
+struct CTRL_PageGenCacheNode
+{
+  CTRL_PageGenCacheNode *next;
+  CTRL_PageGenCacheNode *prev;
+  CTRL_Handle process;
+  U64 vaddr;
+  U64 mem_gen;
+  U64 last_sweep_idx_touched;
+};
+
+typedef struct CTRL_PageGenCacheSlot CTRL_PageGenCacheSlot;
+struct CTRL_PageGenCacheSlot
+{
+  CTRL_PageGenCacheNode *first;
+  CTRL_PageGenCacheNode *last;
+};
+
+typedef struct CTRL_PageGenCacheStripe CTRL_PageGenCacheStripe;
+struct CTRL_PageGenCacheStripe
+{
+  Arena *arena;
+  RWMutex rw_mutex;
+  CTRL_PageGenCacheNode *free_node;
+};
+
+typedef struct CTRL_PageGenCache CTRL_PageGenCache;
+struct CTRL_PageGenCache
+{
+  U64 slots_count;
+  CTRL_PageGenCacheSlot *slots;
+  U64 stripes_count;
+  CTRL_PageGenCacheStripe *stripes;
+  RWMutex tracked_processes_rw_mutex;
+  Arena *tracked_processes_arena;
+  CTRL_HandleList tracked_processes;
+  U64 last_sweep_mem_gen;
+  U64 sweep_idx;
+  U64 sweep_is_pending;
+};
+
+// NOTE: reads which cover whole, aligned chunks of this size are cached
+// as one artifact per chunk, rather than one per page.
+#define CTRL_MEM_CHUNK_SIZE KB(64)
+
+typedef struct CTRL_PageGenSweepEntry CTRL_PageGenSweepEntry;
+struct CTRL_PageGenSweepEntry
+{
+  CTRL_Handle process;
+  U64 vaddr;
+  B32 dirty;
+};
+
 ////////////////////////////////
 //~ rjf: Module Image Info Cache Types
 
@@ -595,6 +725,7 @@ struct CTRL_ModuleImageInfoCacheNode
   CTRL_ModuleImageInfoCacheNode *prev;
   CTRL_Handle module;
   Arena *arena;
+  ExecutableImageKind image_kind;
   PE_IntelPdata *pdatas;
   U64 pdatas_count;
   U64 entry_point_voff;
@@ -656,6 +787,29 @@ struct CTRL_EvalScope
   E_InterpretCtx interpret_ctx;
 };
 
+////////////////////////////////
+//~ rjf: Breakpoint Condition Cache Types
+//
+// NOTE: conditions are compiled to bytecode once per (thread, trap
+// address, condition string), & only re-interpreted on later hits. the cache
+// lives until the next ctrl message, or until modules/threads/processes come
+// or go, since any of those can change what a condition's names resolve to.
+
+typedef struct CTRL_BpCondCacheNode CTRL_BpCondCacheNode;
+struct CTRL_BpCondCacheNode
+{
+  CTRL_BpCondCacheNode *next;
+  CTRL_Handle thread;
+  U64 vaddr;
+  String8 condition;
+  Arena *arena;
+  DI_Key dbgi_key;
+  B32 dbgi_is_ready;
+  CTRL_EvalScope *eval_scope;
+  String8 bytecode;
+  U64 frame_base;
+};
+
 ////////////////////////////////
 //~ rjf: Module Requirement Cache Types
 
@@ -689,6 +843,7 @@ struct CTRL_State
   // rjf: caches
   CTRL_ThreadRegCache thread_reg_cache;
   CTRL_ModuleImageInfoCache module_image_info_cache;
+  CTRL_PageGenCache page_gen_cache;
   
   // rjf: generations
   U64 run_gen;
@@ -733,6 +888,9 @@ struct CTRL_State
   CTRL_DbgDirNode *dbg_dir_root;
   U64 module_req_cache_slots_count;
   CTRL_ModuleReqCacheNode **module_req_cache_slots;
+  Arena *bp_cond_cache_arena;
+  U64 bp_cond_cache_slots_count;
+  CTRL_BpCondCacheNode **bp_cond_cache_slots;
   String8List msg_user_bp_touched_files;
   String8List msg_user_bp_touched_symbols;
 };
@@ -910,6 +1068,7 @@ internal B32 ctrl_thread_write_reg_block(CTRL_Handle thread, void *block);
 
 //- rjf: cache lookups
 internal PE_IntelPdata *ctrl_intel_pdata_from_module_voff(Arena *arena, CTRL_Handle module_handle, U64 voff);
+internal ExecutableImageKind ctrl_image_kind_from_module(CTRL_Handle module_handle);
 internal U64 ctrl_entry_point_voff_from_module(CTRL_Handle module_handle);
 internal Rng1U64 ctrl_tls_vaddr_range_from_module(CTRL_Handle module_handle);
 internal String8 ctrl_initial_debug_info_path_from_module(Arena *arena, CTRL_Handle module_handle);
@@ -924,9 +1083,11 @@ internal CTRL_Unwind ctrl_unwind_deep_copy(Arena *arena, Arch arch, CTRL_Unwind
 //- rjf: [x64]
 internal REGS_Reg64 *ctrl_unwind_reg_from_pe_gpr_reg__pe_x64(REGS_RegBlockX64 *regs, PE_UnwindGprRegX64 gpr_reg);
 internal CTRL_UnwindStepResult ctrl_unwind_step__pe_x64(CTRL_Handle process_handle, CTRL_Handle module_handle, U64 module_base_vaddr, REGS_RegBlockX64 *regs, U64 endt_us);
+internal REGS_Reg64 *ctrl_unwind_reg_from_dw_reg__elf_x64(REGS_RegBlockX64 *regs, DW_Reg dw_reg);
+internal CTRL_UnwindStepResult ctrl_unwind_step__elf_x64(CTRL_Handle process_handle, CTRL_Handle module_handle, U64 module_base_vaddr, REGS_RegBlockX64 *regs, B32 rip_is_return_address, U64 endt_us);
 
 //- rjf: abstracted unwind step
-internal CTRL_UnwindStepResult ctrl_unwind_step(CTRL_Handle process, CTRL_Handle module, U64 module_base_vaddr, Arch arch, void *reg_block, U64 endt_us);
+internal CTRL_UnwindStepResult ctrl_unwind_step(CTRL_Handle process, CTRL_Handle module, U64 module_base_vaddr, Arch arch, void *reg_block, B32 rip_is_return_address, U64 endt_us);
 
 //- rjf: abstracted full unwind
 internal CTRL_Unwind ctrl_unwind_from_thread(Arena *arena, CTRL_EntityCtx *ctx, CTRL_Handle thread, U64 endt_us);
@@ -988,6 +1149,10 @@ internal B32 ctrl_eval_space_read(E_Space space, void *out, Rng1U64 vaddr_range)
 internal CTRL_EvalScope *ctrl_thread__eval_scope_begin(Arena *arena, CTRL_UserBreakpointList *user_bps, CTRL_Entity *thread);
 internal void ctrl_thread__eval_scope_end(CTRL_EvalScope *scope);
 
+//- rjf: breakpoint condition cache
+internal void ctrl_thread__bp_cond_cache_reset(void);
+internal E_Interpretation ctrl_thread__bp_cond_interpretation(CTRL_UserBreakpointList *user_bps, CTRL_Entity *thread, U64 vaddr, String8 condition);
+
 //- rjf: log flusher
 internal void ctrl_thread__end_and_flush_log(void);
 
@@ -1000,14 +1165,25 @@ internal void ctrl_thread__detach(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg);
 internal void ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg);
 internal void ctrl_thread__single_step(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg);
 
+////////////////////////////////
+//~ rjf: Process Memory Page Generation Functions
+
+internal U64 ctrl_page_mem_gen(CTRL_Handle process, U64 page_vaddr, B32 *clean_since_last_stop_out);
+internal U64 ctrl_mem_gen_from_process_vaddr_range(CTRL_Handle process, Rng1U64 range, B32 zero_terminated, B32 *clean_since_last_stop_out);
+internal void ctrl_page_gen_cache_mark_dirty(CTRL_Handle process, Rng1U64 range);
+internal int ctrl_page_gen_sweep_entry_compare(CTRL_PageGenSweepEntry *a, CTRL_PageGenSweepEntry *b);
+internal void ctrl_thread__page_gen_cache_sweep(void);
+
 ////////////////////////////////
 //~ rjf: Process Memory Artifact Cache Hooks / Lookups
 
-internal AC_Artifact ctrl_memory_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out);
+internal AC_Artifact ctrl_memory_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out);
 internal void ctrl_memory_artifact_destroy(AC_Artifact artifact);
 internal C_Key ctrl_key_from_process_vaddr_range(CTRL_Handle process, Rng1U64 vaddr_range, B32 zero_terminated, B32 wait_for_fresh, U64 endt_us, B32 *out_is_stale);
 
 //- rjf: process memory reading helpers
+internal void ctrl_bit_flags_fill(U64 *flags, Rng1U64 bit_range);
+internal void ctrl_bit_flags_from_byte_diff(U64 *flags, U64 flags_bit_off, String8 last_data, String8 data);
 internal CTRL_ProcessMemorySlice ctrl_process_memory_slice_from_vaddr_range(Arena *arena, CTRL_Handle process, Rng1U64 range, B32 wait_for_fresh, U64 endt_us);
 internal B32 ctrl_process_memory_read(CTRL_Handle process, Rng1U64 range, B32 *is_stale_out, void *out, U64 endt_us);
 #define ctrl_process_memory_read_struct(process, vaddr, is_stale_out, ptr, endt_us) ctrl_process_memory_read((process), r1u64((vaddr), (vaddr)+(sizeof(*(ptr)))), (is_stale_out), (ptr), (endt_us))
@@ -1018,15 +1194,32 @@ internal B32 ctrl_process_write(CTRL_Handle process, Rng1U64 range, void *src);
 ////////////////////////////////
 //~ rjf: Call Stack Artifact Cache Hooks / Lookups
 
-internal AC_Artifact ctrl_call_stack_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out);
+internal AC_Artifact ctrl_call_stack_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out);
 internal void ctrl_call_stack_artifact_destroy(AC_Artifact artifact);
 internal CTRL_CallStack ctrl_call_stack_from_thread(Access *access, CTRL_Handle thread_handle, B32 high_priority, U64 endt_us);
 
 ////////////////////////////////
 //~ rjf: Call Stack Tree Artifact Cache Hooks / Lookups
 
-internal AC_Artifact ctrl_call_stack_tree_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out);
+internal AC_Artifact ctrl_call_stack_tree_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out);
 internal void ctrl_call_stack_tree_artifact_destroy(AC_Artifact artifact);
 internal CTRL_CallStackTree ctrl_call_stack_tree(Access *access, U64 endt_us);
 
+////////////////////////////////
+//~ rjf: ELF Unwind Table Artifact Cache Hooks / Lookups
+
+//- rjf: helpers
+internal DW_Reg ctrl_dw_reg_from_elf_unwind_reg_x64(CTRL_ElfUnwindRegX64 reg);
+internal int ctrl_elf_unwind_row_compare(CTRL_ElfUnwindRow *a, CTRL_ElfUnwindRow *b);
+internal DW_DECODE_PTR(ctrl_elf_unwind_decode_ptr);
+internal B32 ctrl_elf_unwind_cie_from_eh_frame_off(String8 eh_frame, U64 off, EH_PtrCtx *ptr_ctx, DW_CIE *cie_out, EH_Augmentation *aug_out);
+
+//- rjf: .eh_frame -> compiled unwind table
+internal CTRL_ElfUnwindTable ctrl_elf_unwind_table_from_eh_frame(Arena *arena, String8 eh_frame, U64 eh_frame_vaddr, U64 module_base_vaddr);
+
+//- rjf: artifact cache hooks
+internal AC_Artifact ctrl_elf_unwind_table_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out);
+internal void ctrl_elf_unwind_table_artifact_destroy(AC_Artifact artifact);
+internal CTRL_ElfUnwindTable *ctrl_elf_unwind_table_from_module(Access *access, CTRL_Handle process, CTRL_Handle module, U64 module_base_vaddr, U64 endt_us);
+
 #endif // CTRL_CORE_H
@@ -328,6 +328,7 @@ di_close(DI_Key key, B32 force_closed)
   FileProperties file_props = {0};
   void *file_base = 0;
   Arena *arena = 0;
+  DI_LazyRDI *lazy = 0;
   RWMutexScope(stripe->rw_mutex, 1)
   {
     DI_Node *node = 0;
@@ -364,6 +365,7 @@ di_close(DI_Key key, B32 force_closed)
             file_props = node->file_props;
             file_base = node->file_base;
             arena = node->arena;
+            lazy = (DI_LazyRDI *)node->rdi.section_fault_user_data;
             break;
           }
           cond_var_wait_rw(stripe->cv, stripe->rw_mutex, 1, max_U64);
@@ -380,6 +382,10 @@ di_close(DI_Key key, B32 force_closed)
     os_file_map_view_close(file_map, file_base, r1u64(0, file_props.size));
     os_file_map_close(file_map);
     os_file_close(file);
+    if(lazy != 0)
+    {
+      di_lazy_rdi_release(lazy);
+    }
     if(arena != 0)
     {
       arena_release(arena);
@@ -527,6 +533,69 @@ di_get_events(Arena *arena)
   return dst;
 }
 
+////////////////////////////////
+//~ Lazy Decompression
+
+internal DI_LazyRDI *
+di_lazy_rdi_alloc(Arena *arena, RDI_Parsed *compressed, RDI_Parsed *decompressed_out)
+{
+  // NOTE: the whole decompressed layout is reserved up front, but only the
+  // header & section table are committed; each section is committed and
+  // decoded by the section fault on its first access.
+  DI_LazyRDI *lazy = push_array(arena, DI_LazyRDI, 1);
+  lazy->compressed = *compressed;
+  lazy->decompressed_size = rdi_decompressed_size_from_parsed(compressed);
+  lazy->decompressed_data = (U8 *)os_reserve(lazy->decompressed_size);
+  lazy->section_states = push_array(arena, U32, compressed->sections_count);
+  RDI_Header *header = (RDI_Header *)compressed->raw_data;
+  U64 header_size = header->data_section_off + sizeof(RDI_Section)*compressed->sections_count;
+  os_commit(lazy->decompressed_data, header_size);
+  rdi_decompress_parsed_header(lazy->decompressed_data, lazy->decompressed_size, compressed);
+  RDI_ParseStatus parse_status = rdi_parse(lazy->decompressed_data, lazy->decompressed_size, decompressed_out);
+  (void)parse_status;
+  decompressed_out->section_fault = di_lazy_rdi_section_fault;
+  decompressed_out->section_fault_user_data = lazy;
+  return lazy;
+}
+
+internal void
+di_lazy_rdi_release(DI_LazyRDI *lazy)
+{
+  os_release(lazy->decompressed_data, lazy->decompressed_size);
+}
+
+internal void
+di_lazy_rdi_section_fault(RDI_Parsed *rdi, RDI_SectionKind kind)
+{
+  DI_LazyRDI *lazy = (DI_LazyRDI *)rdi->section_fault_user_data;
+  U32 *state = &lazy->section_states[kind];
+  if(ins_atomic_u32_eval(state) != DI_LazySectionState_Decoded)
+  {
+    if(ins_atomic_u32_eval_cond_assign(state, DI_LazySectionState_Decoding, DI_LazySectionState_Encoded) == DI_LazySectionState_Encoded)
+    {
+      ProfBegin("decode section %I64u", (U64)kind);
+      RDI_Section *section = &rdi->sections[kind];
+      if(section->unpacked_size != 0)
+      {
+        U64 page_size = os_get_system_info()->page_size;
+        U64 commit_min = AlignDownPow2(section->off, page_size);
+        U64 commit_max = AlignPow2(section->off + section->unpacked_size, page_size);
+        os_commit(lazy->decompressed_data + commit_min, commit_max - commit_min);
+        rdi_decompress_section(&lazy->compressed, kind, lazy->decompressed_data + section->off);
+      }
+      ins_atomic_u32_eval_assign(state, DI_LazySectionState_Decoded);
+      ProfEnd();
+    }
+    else
+    {
+      for(;ins_atomic_u32_eval(state) != DI_LazySectionState_Decoded;)
+      {
+        os_sleep_milliseconds(0);
+      }
+    }
+  }
+}
+
 ////////////////////////////////
 //~ rjf: Asynchronous Tick
 
@@ -691,9 +760,23 @@ di_async_tick(void)
             t->og_is_rdi = 1;
           }
           os_file_close(file);
+          
+          // rjf: O.G. debug info missing, but the linker deferred it (/DEBUG:FASTLINK)
+          // and left a manifest next to it -> linker can materialize it on demand
+          if(t->og_size == 0)
+          {
+            String8 rfl_path = str8f(scratch.arena, "%S.rfl", str8_chop_last_dot(og_path));
+            FileProperties rfl_props = os_properties_from_file_path(rfl_path);
+            if(rfl_props.size != 0)
+            {
+              t->og_is_deferred = 1;
+              t->og_size = rfl_props.size;
+            }
+          }
         }
         U64 og_size = t->og_size;
         B32 og_is_rdi = t->og_is_rdi;
+        B32 og_is_deferred = t->og_is_deferred;
         B32 og_is_good = (og_size > 0);
         
         //- rjf: compute key's RDI path
@@ -743,6 +826,7 @@ di_async_tick(void)
           }
           {
             if(0){}
+            else if(og_is_deferred)     {thread_count = max_thread_count/2;}
             else if(og_size <= MB(4))   {thread_count = 1;}
             else if(og_size <= MB(256)) {thread_count = max_thread_count/4;}
             else if(og_size <= MB(512)) {thread_count = max_thread_count/3;}
@@ -786,7 +870,35 @@ di_async_tick(void)
         }
         
         //- rjf: launch conversion processes
-        if(og_is_good && ready_to_launch_conversion)
+        if(og_is_good && og_is_deferred && ready_to_launch_conversion)
+        {
+          String8 rfl_path = str8f(scratch.arena, "%S.rfl", str8_chop_last_dot(og_path));
+          OS_ProcessLaunchParams params = {0};
+          params.path = os_get_process_info()->binary_path;
+          params.inherit_env = 1;
+          params.consoleless = 1;
+          str8_list_pushf(scratch.arena, &params.cmd_line, "radlink");
+          str8_list_pushf(scratch.arena, &params.cmd_line, "/RAD_MATERIALIZE_DEBUG_INFO:%S", rfl_path);
+          str8_list_pushf(scratch.arena, &params.cmd_line, "/RAD_DEBUG");
+          str8_list_pushf(scratch.arena, &params.cmd_line, "/RAD_DEBUG_NAME:%S", rdi_path);
+          str8_list_pushf(scratch.arena, &params.cmd_line, "/RAD_WORKERS:%I64u", t->thread_count);
+          ProfMsg("launch materialization for %.*s", str8_varg(rdi_path));
+          t->process = os_process_launch(&params);
+          t->status = DI_LoadTaskStatus_Active;
+          di_shared->conversion_process_count += 1;
+          di_shared->conversion_thread_count += t->thread_count;
+          
+          // rjf: send event
+          MutexScope(di_shared->event_mutex)
+          {
+            DI_EventNode *n = push_array(di_shared->event_arena, DI_EventNode, 1);
+            SLLQueuePush(di_shared->events.first, di_shared->events.last, n);
+            di_shared->events.count += 1;
+            n->v.kind = DI_EventKind_ConversionStarted;
+            n->v.string = str8_copy(di_shared->event_arena, rdi_path);
+          }
+        }
+        else if(og_is_good && ready_to_launch_conversion)
         {
           B32 should_compress = 0;
           OS_ProcessLaunchParams params = {0};
@@ -955,18 +1067,16 @@ di_async_tick(void)
         (void)parse_status;
       }
       
-      //- rjf: decompress & re-parse, if necessary
+      //- rjf: set up lazy decompression, if necessary; sections are decoded on first access
       Arena *rdi_parsed_arena = 0;
+      DI_LazyRDI *rdi_lazy = 0;
       RDI_Parsed rdi_parsed = rdi_parsed_maybe_compressed;
       {
         U64 decompressed_size = rdi_decompressed_size_from_parsed(&rdi_parsed_maybe_compressed);
         if(decompressed_size > file_props.size)
         {
           rdi_parsed_arena = arena_alloc();
-          U8 *decompressed_data = push_array_no_zero(rdi_parsed_arena, U8, decompressed_size);
-          rdi_decompress_parsed(decompressed_data, decompressed_size, &rdi_parsed_maybe_compressed);
-          RDI_ParseStatus parse_status = rdi_parse(decompressed_data, decompressed_size, &rdi_parsed);
-          (void)parse_status;
+          rdi_lazy = di_lazy_rdi_alloc(rdi_parsed_arena, &rdi_parsed_maybe_compressed, &rdi_parsed);
         }
       }
       
@@ -1006,6 +1116,10 @@ di_async_tick(void)
           }
           else
           {
+            if(rdi_lazy != 0)
+            {
+              di_lazy_rdi_release(rdi_lazy);
+            }
             if(rdi_parsed_arena != 0)
             {
               arena_release(rdi_parsed_arena);
@@ -1069,11 +1183,291 @@ di_conversion_completion_signal_receiver_thread_entry_point(void *p)
   }
 }
 
+////////////////////////////////
+//~ Search Index Artifact Cache Hooks / Lookups
+
+internal String8
+di_search_name_from_element(Arena *arena, RDI_Parsed *rdi, RDI_SectionKind section_kind, U64 element_idx)
+{
+  U64 element_count = 0;
+  void *table_base = rdi_section_raw_table_from_kind(rdi, section_kind, &element_count);
+  U64 element_size = rdi_section_element_size_table[section_kind];
+  void *element = (U8 *)table_base + element_size*element_idx;
+  String8 name = {0};
+  switch(section_kind)
+  {
+    default:{}break;
+    case RDI_SectionKind_Procedures:
+    {
+      RDI_Procedure *procedure = (RDI_Procedure *)element;
+      name.str = rdi_string_from_idx(rdi, procedure->name_string_idx, &name.size);
+    }break;
+    case RDI_SectionKind_GlobalVariables:
+    {
+      RDI_GlobalVariable *global_variable = (RDI_GlobalVariable *)element;
+      name.str = rdi_string_from_idx(rdi, global_variable->name_string_idx, &name.size);
+    }break;
+    case RDI_SectionKind_ThreadVariables:
+    {
+      RDI_ThreadVariable *thread_variable = (RDI_ThreadVariable *)element;
+      name.str = rdi_string_from_idx(rdi, thread_variable->name_string_idx, &name.size);
+    }break;
+    case RDI_SectionKind_UDTs:
+    {
+      // NOTE(rjf): name must be determined from self_type_idx
+      RDI_UDT *udt = (RDI_UDT *)element;
+      RDI_TypeNode *type_node = rdi_element_from_name_idx(rdi, TypeNodes, udt->self_type_idx);
+      name.str = rdi_string_from_idx(rdi, type_node->user_defined.name_string_idx, &name.size);
+      name = str8_copy(arena, name);
+    }break;
+    case RDI_SectionKind_SourceFiles:
+    {
+      // NOTE(rjf): name must be determined from file path node chain
+      Temp scratch = scratch_begin(&arena, 1);
+      RDI_SourceFile *file = (RDI_SourceFile *)element;
+      String8List path_parts = {0};
+      for(RDI_FilePathNode *fpn = rdi_element_from_name_idx(rdi, FilePathNodes, file->file_path_node_idx);
+          fpn != rdi_element_from_name_idx(rdi, FilePathNodes, 0);
+          fpn = rdi_element_from_name_idx(rdi, FilePathNodes, fpn->parent_path_node))
+      {
+        String8 path_part = {0};
+        path_part.str = rdi_string_from_idx(rdi, fpn->name_string_idx, &path_part.size);
+        str8_list_push_front(scratch.arena, &path_parts, path_part);
+      }
+      StringJoin join = {0};
+      join.sep = str8_lit("/");
+      name = str8_list_join(arena, &path_parts, &join);
+      scratch_end(scratch);
+    }break;
+  }
+  return name;
+}
+
+internal U64
+di_search_index_bucket_from_trigram(U8 *trigram)
+{
+  // NOTE: folded the same way fuzzy matching compares characters, so every
+  // name that matches a needle also shares the needle's trigram buckets
+  U32 a = correct_slash_from_char(upper_from_char(trigram[0]));
+  U32 b = correct_slash_from_char(upper_from_char(trigram[1]));
+  U32 c = correct_slash_from_char(upper_from_char(trigram[2]));
+  U32 packed = (a << 16) | (b << 8) | c;
+  U64 bucket = (U32)(packed * 2654435761u) >> (32 - DI_SEARCH_INDEX_BUCKET_BITS);
+  return bucket;
+}
+
+internal AC_Artifact
+di_search_index_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out)
+{
+  ProfBeginFunction();
+  Access *access = access_open();
+  Temp scratch = scratch_begin(0, 0);
+  AC_Artifact artifact = {0};
+  {
+    //- unpack key
+    DI_Key dbgi_key = {0};
+    RDI_SectionKind section_kind = RDI_SectionKind_NULL;
+    {
+      U64 key_read_off = 0;
+      key_read_off += str8_deserial_read_struct(key, key_read_off, &dbgi_key);
+      key_read_off += str8_deserial_read_struct(key, key_read_off, &section_kind);
+    }
+    
+    //- map debug info key -> RDI
+    RDI_Parsed *rdi = 0;
+    if(lane_idx() == 0)
+    {
+      rdi = di_rdi_from_key(access, dbgi_key, 0, 0);
+    }
+    lane_sync_u64(&rdi, 0);
+    U64 element_count = 0;
+    rdi_section_raw_table_from_kind(rdi, section_kind, &element_count);
+    
+    //- debug info not loaded -> no index; searches fall back to full scans
+    if(rdi == &rdi_parsed_nil)
+    {
+      goto end;
+    }
+    
+    //- set up per-lane bucket counts; stamps dedup buckets within one name
+    U64 bucket_count = DI_SEARCH_INDEX_BUCKET_COUNT;
+    U32 **lanes_bucket_counts = 0;
+    U64 **lanes_bucket_offs = 0;
+    if(lane_idx() == 0)
+    {
+      lanes_bucket_counts = push_array(scratch.arena, U32 *, lane_count());
+      lanes_bucket_offs = push_array(scratch.arena, U64 *, lane_count());
+    }
+    lane_sync_u64(&lanes_bucket_counts, 0);
+    lane_sync_u64(&lanes_bucket_offs, 0);
+    lanes_bucket_counts[lane_idx()] = push_array(scratch.arena, U32, bucket_count);
+    lanes_bucket_offs[lane_idx()] = push_array(scratch.arena, U64, bucket_count);
+    U32 *stamps = push_array(scratch.arena, U32, bucket_count);
+    Rng1U64 range = lane_range(element_count);
+    
+    //- count (bucket, element) pairs
+    ProfScope("count (bucket, element) pairs")
+    {
+      U32 *bucket_counts = lanes_bucket_counts[lane_idx()];
+      for EachInRange(idx, range)
+      {
+        Temp temp = temp_begin(scratch.arena);
+        String8 name = di_search_name_from_element(temp.arena, rdi, section_kind, idx);
+        for(U64 off = 0; off+3 <= name.size; off += 1)
+        {
+          U64 bucket = di_search_index_bucket_from_trigram(name.str + off);
+          if(stamps[bucket] != idx+1)
+          {
+            stamps[bucket] = idx+1;
+            bucket_counts[bucket] += 1;
+          }
+        }
+        temp_end(temp);
+      }
+    }
+    lane_sync();
+    
+    //- allocate index
+    Arena *arena = 0;
+    DI_SearchIndex *index = 0;
+    if(lane_idx() == 0)
+    {
+      arena = arena_alloc();
+      index = push_array(arena, DI_SearchIndex, 1);
+      index->bucket_offs = push_array(arena, U64, bucket_count+1);
+    }
+    lane_sync_u64(&arena, 0);
+    lane_sync_u64(&index, 0);
+    
+    //- compute bucket totals & lane offsets relative to bucket start
+    {
+      Rng1U64 bucket_range = lane_range(bucket_count);
+      for EachInRange(bucket, bucket_range)
+      {
+        U64 layout_off = 0;
+        for EachIndex(lidx, lane_count())
+        {
+          lanes_bucket_offs[lidx][bucket] = layout_off;
+          layout_off += lanes_bucket_counts[lidx][bucket];
+        }
+        index->bucket_offs[bucket+1] = layout_off;
+      }
+    }
+    lane_sync();
+    
+    //- bucket totals -> absolute bucket offsets
+    if(lane_idx() == 0)
+    {
+      for EachIndex(bucket, bucket_count)
+      {
+        index->bucket_offs[bucket+1] += index->bucket_offs[bucket];
+      }
+      index->postings_count = index->bucket_offs[bucket_count];
+      index->postings = push_array_no_zero(arena, U32, index->postings_count);
+    }
+    lane_sync();
+    
+    //- fill postings; lanes own ascending element ranges, so each bucket ends up sorted
+    ProfScope("fill postings")
+    {
+      U64 *bucket_offs = lanes_bucket_offs[lane_idx()];
+      MemoryZero(stamps, sizeof(stamps[0])*bucket_count);
+      for EachInRange(idx, range)
+      {
+        Temp temp = temp_begin(scratch.arena);
+        String8 name = di_search_name_from_element(temp.arena, rdi, section_kind, idx);
+        for(U64 off = 0; off+3 <= name.size; off += 1)
+        {
+          U64 bucket = di_search_index_bucket_from_trigram(name.str + off);
+          if(stamps[bucket] != idx+1)
+          {
+            stamps[bucket] = idx+1;
+            index->postings[index->bucket_offs[bucket] + bucket_offs[bucket]] = (U32)idx;
+            bucket_offs[bucket] += 1;
+          }
+        }
+        temp_end(temp);
+      }
+    }
+    lane_sync();
+    
+    //- bundle as artifact
+    artifact.u64[0] = (U64)arena;
+    artifact.u64[1] = (U64)index;
+    size_out[0] = arena_pos(arena);
+  }
+  end:;
+  scratch_end(scratch);
+  access_close(access);
+  ProfEnd();
+  return artifact;
+}
+
+internal void
+di_search_index_artifact_destroy(AC_Artifact artifact)
+{
+  Arena *arena = (Arena *)artifact.u64[0];
+  if(arena != 0)
+  {
+    arena_release(arena);
+  }
+}
+
+internal DI_SearchIndex *
+di_search_index_from_key_section(Access *access, DI_Key key, RDI_SectionKind section_kind, U64 endt_us)
+{
+  DI_SearchIndex *result = 0;
+  {
+    Temp scratch = scratch_begin(0, 0);
+    
+    // form key
+    String8List key_parts = {0};
+    str8_list_push(scratch.arena, &key_parts, str8_struct(&key));
+    str8_list_push(scratch.arena, &key_parts, str8_struct(&section_kind));
+    String8 artifact_key = str8_list_join(scratch.arena, &key_parts, 0);
+    
+    // get artifact
+    AC_Artifact artifact = ac_artifact_from_key(access, artifact_key, di_search_index_artifact_create, di_search_index_artifact_destroy, endt_us, .gen = di_load_gen(), .flags = AC_Flag_Wide, .evict_threshold_us = 60000000);
+    result = (DI_SearchIndex *)artifact.u64[1];
+    
+    scratch_end(scratch);
+  }
+  return result;
+}
+
+internal B32
+di_search_index_candidates_from_query(DI_SearchIndex *index, String8 query, U32Array *candidates_out)
+{
+  // NOTE: every needle part must occur in a matching name, so the smallest
+  // posting list over all trigrams of all parts bounds the candidate set
+  B32 found_trigram = 0;
+  U64 part_off = 0;
+  for(U64 off = 0; off <= query.size; off += 1)
+  {
+    if(off == query.size || query.str[off] == ' ')
+    {
+      for(U64 tri_off = part_off; tri_off+3 <= off; tri_off += 1)
+      {
+        U64 bucket = di_search_index_bucket_from_trigram(query.str + tri_off);
+        U64 count = index->bucket_offs[bucket+1] - index->bucket_offs[bucket];
+        if(!found_trigram || count < candidates_out->count)
+        {
+          found_trigram = 1;
+          candidates_out->v = index->postings + index->bucket_offs[bucket];
+          candidates_out->count = count;
+        }
+      }
+      part_off = off+1;
+    }
+  }
+  return found_trigram;
+}
+
 ////////////////////////////////
 //~ rjf: Search Artifact Cache Hooks / Lookups
 
 internal AC_Artifact
-di_search_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out)
+di_search_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out)
 {
   ProfBeginFunction();
   Access *access = access_open();
@@ -1149,83 +1543,33 @@ di_search_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *
           
           // rjf: unpack table info
           U64 element_count = 0;
-          void *table_base = rdi_section_raw_table_from_kind(rdi, section_kind, &element_count);
-          U64 element_size = rdi_section_element_size_table[section_kind];
+          rdi_section_raw_table_from_kind(rdi, section_kind, &element_count);
           
-          // rjf: determine name string index offset, depending on table kind
-          U64 element_name_idx_off = 0;
-          switch(section_kind)
+          // rjf: narrow candidates via trigram index, if one is ready; otherwise scan entire table
+          B32 use_index = 0;
+          U32Array candidates = {0};
+          if(lane_idx() == 0)
           {
-            default:{}break;
-            case RDI_SectionKind_Procedures:
-            {
-              element_name_idx_off = OffsetOf(RDI_Procedure, name_string_idx);
-            }break;
-            case RDI_SectionKind_GlobalVariables:
-            {
-              element_name_idx_off = OffsetOf(RDI_GlobalVariable, name_string_idx);
-            }break;
-            case RDI_SectionKind_ThreadVariables:
-            {
-              element_name_idx_off = OffsetOf(RDI_ThreadVariable, name_string_idx);
-            }break;
-            case RDI_SectionKind_UDTs:
-            {
-              // NOTE(rjf): name must be determined from self_type_idx
-            }break;
-            case RDI_SectionKind_SourceFiles:
-            {
-              // NOTE(rjf): name must be determined from file path node chain
-            }break;
+            DI_SearchIndex *index = (rdi != &rdi_parsed_nil ? di_search_index_from_key_section(access, key, section_kind, 0) : 0);
+            use_index = (index != 0 && di_search_index_candidates_from_query(index, query, &candidates));
           }
+          lane_sync_u64(&use_index, 0);
+          lane_sync_u64(&candidates.v, 0);
+          lane_sync_u64(&candidates.count, 0);
+          U64 candidate_count = use_index ? candidates.count : element_count;
           
-          Rng1U64 range = lane_range(element_count);
-          for EachInRange(idx, range)
+          Rng1U64 range = lane_range(candidate_count);
+          for EachInRange(candidate_idx, range)
           {
             //- rjf: every so often, check if we need to cancel, and cancel
-            if(idx%10000 == 0 && !!ins_atomic_u32_eval(cancel_signal))
+            if(candidate_idx%10000 == 0 && !!ins_atomic_u32_eval(cancel_signal))
             {
               break;
             }
             
             //- rjf: get element, map to string; if empty, continue to next element
-            void *element = (U8 *)table_base + element_size*idx;
-            String8 name = {0};
-            switch(section_kind)
-            {
-              case RDI_SectionKind_UDTs:
-              {
-                RDI_UDT *udt = (RDI_UDT *)element;
-                RDI_TypeNode *type_node = rdi_element_from_name_idx(rdi, TypeNodes, udt->self_type_idx);
-                name.str = rdi_string_from_idx(rdi, type_node->user_defined.name_string_idx, &name.size);
-                name = str8_copy(arena, name);
-              }break;
-              case RDI_SectionKind_SourceFiles:
-              {
-                Temp scratch = scratch_begin(&arena, 1);
-                RDI_SourceFile *file = (RDI_SourceFile *)element;
-                String8List path_parts = {0};
-                for(RDI_FilePathNode *fpn = rdi_element_from_name_idx(rdi, FilePathNodes, file->file_path_node_idx);
-                    fpn != rdi_element_from_name_idx(rdi, FilePathNodes, 0);
-                    fpn = rdi_element_from_name_idx(rdi, FilePathNodes, fpn->parent_path_node))
-                {
-                  String8 path_part = {0};
-                  path_part.str = rdi_string_from_idx(rdi, fpn->name_string_idx, &path_part.size);
-                  str8_list_push_front(scratch.arena, &path_parts, path_part);
-                }
-                StringJoin join = {0};
-                join.sep = str8_lit("/");
-                name = str8_list_join(arena, &path_parts, &join);
-                scratch_end(scratch);
-              }break;
-              default:
-              {
-                U32 name_idx = *(U32 *)((U8 *)element + element_name_idx_off);
-                U64 name_size = 0;
-                U8 *name_base = rdi_string_from_idx(rdi, name_idx, &name_size);
-                name = str8(name_base, name_size);
-              }break;
-            }
+            U64 idx = use_index ? candidates.v[candidate_idx] : candidate_idx;
+            String8 name = di_search_name_from_element(arena, rdi, section_kind, idx);
             if(name.size == 0) { continue; }
             
             //- rjf: fuzzy match against query
@@ -1457,6 +1801,10 @@ di_search_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *
       artifact.u64[1] = arenas_count;
       artifact.u64[2] = (U64)items.v;
       artifact.u64[3] = items.count;
+      for EachIndex(idx, arenas_count)
+      {
+        size_out[0] += arena_pos(arenas[idx]);
+      }
     }
     
     //- rjf: release results on cancel
@@ -1519,7 +1867,7 @@ di_search_item_array_from_target_query(Access *access, RDI_SectionKind target, S
 //~ rjf: Match Artifact Cache Hooks / Lookups
 
 internal AC_Artifact
-di_match_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out)
+di_match_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out)
 {
   ProfBeginFunction();
   Temp scratch = scratch_begin(0, 0);
@@ -55,6 +55,26 @@ struct DI_KeySlot
   DI_KeyPathNode *last;
 };
 
+////////////////////////////////
+//~ Lazily-Decompressed Debug Info Types
+
+typedef enum DI_LazySectionState
+{
+  DI_LazySectionState_Encoded,
+  DI_LazySectionState_Decoding,
+  DI_LazySectionState_Decoded,
+}
+DI_LazySectionState;
+
+typedef struct DI_LazyRDI DI_LazyRDI;
+struct DI_LazyRDI
+{
+  RDI_Parsed compressed;
+  U8 *decompressed_data;
+  U64 decompressed_size;
+  U32 *section_states;
+};
+
 ////////////////////////////////
 //~ rjf: Debug Info Cache Types
 
@@ -139,6 +159,7 @@ struct DI_LoadTask
   
   B32 og_analyzed;
   B32 og_is_rdi;
+  B32 og_is_deferred;
   U64 og_size;
   
   B32 rdi_analyzed;
@@ -193,6 +214,20 @@ struct DI_SearchItemArray
   U64 count;
 };
 
+// NOTE: trigram postings for one (debug info, section) pair; trigrams are
+// hashed into buckets, and each bucket lists ascending element indices whose
+// names contain some trigram of that bucket
+#define DI_SEARCH_INDEX_BUCKET_BITS  16
+#define DI_SEARCH_INDEX_BUCKET_COUNT (1 << DI_SEARCH_INDEX_BUCKET_BITS)
+
+typedef struct DI_SearchIndex DI_SearchIndex;
+struct DI_SearchIndex
+{
+  U64 *bucket_offs; // [DI_SEARCH_INDEX_BUCKET_COUNT+1]
+  U32 *postings;
+  U64 postings_count;
+};
+
 ////////////////////////////////
 //~ rjf: Match Types
 
@@ -333,6 +368,13 @@ internal U64 di_load_count(void);
 internal DI_KeyArray di_push_all_loaded_keys(Arena *arena);
 internal RDI_Parsed *di_rdi_from_key(Access *access, DI_Key key, B32 high_priority, U64 endt_us);
 
+////////////////////////////////
+//~ Lazy Decompression
+
+internal DI_LazyRDI *di_lazy_rdi_alloc(Arena *arena, RDI_Parsed *compressed, RDI_Parsed *decompressed_out);
+internal void di_lazy_rdi_release(DI_LazyRDI *lazy);
+internal void di_lazy_rdi_section_fault(RDI_Parsed *rdi, RDI_SectionKind kind);
+
 ////////////////////////////////
 //~ rjf: Events
 
@@ -349,17 +391,27 @@ internal void di_async_tick(void);
 internal void di_signal_completion(void);
 internal void di_conversion_completion_signal_receiver_thread_entry_point(void *p);
 
+////////////////////////////////
+//~ Search Index Artifact Cache Hooks / Lookups
+
+internal String8 di_search_name_from_element(Arena *arena, RDI_Parsed *rdi, RDI_SectionKind section_kind, U64 element_idx);
+internal U64 di_search_index_bucket_from_trigram(U8 *trigram);
+internal AC_Artifact di_search_index_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out);
+internal void di_search_index_artifact_destroy(AC_Artifact artifact);
+internal DI_SearchIndex *di_search_index_from_key_section(Access *access, DI_Key key, RDI_SectionKind section_kind, U64 endt_us);
+internal B32 di_search_index_candidates_from_query(DI_SearchIndex *index, String8 query, U32Array *candidates_out);
+
 ////////////////////////////////
 //~ rjf: Search Artifact Cache Hooks / Lookups
 
-internal AC_Artifact di_search_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out);
+internal AC_Artifact di_search_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out);
 internal void di_search_artifact_destroy(AC_Artifact artifact);
 internal DI_SearchItemArray di_search_item_array_from_target_query(Access *access, RDI_SectionKind target, String8 query, U64 endt_us, B32 *stale_out);
 
 ////////////////////////////////
 //~ rjf: Match Artifact Cache Hooks / Lookups
 
-internal AC_Artifact di_match_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out);
+internal AC_Artifact di_match_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out);
 internal DI_Match di_match_from_string(String8 string, U64 index, DI_Key preferred_dbgi_key, U64 endt_us);
 
 #endif // DBG_INFO_H
@@ -165,6 +165,13 @@ struct DMN_ProcessInfo
   U32 pid;
 };
 
+////////////////////////////////
+//~ rjf: Dirty Page Tracking Constants
+
+// NOTE: dirty page queries report one bit per page of this size; a set
+// bit means the page may have been written since the last clear.
+#define DMN_DIRTY_PAGE_SIZE KB(4)
+
 ////////////////////////////////
 //~ rjf: Basic Type Functions (Helpers, Implemented Once)
 
@@ -238,6 +245,11 @@ internal B32 dmn_process_write(DMN_Handle process, Rng1U64 range, void *src);
 #define dmn_process_read_struct(process, vaddr, ptr) dmn_process_read((process), r1u64((vaddr), (vaddr)+(sizeof(*ptr))), ptr)
 #define dmn_process_write_struct(process, vaddr, ptr) dmn_process_write((process), r1u64((vaddr), (vaddr)+(sizeof(*ptr))), ptr)
 
+//- rjf: process dirty page tracking (DMN_DIRTY_PAGE_SIZE-granularity; both
+// return 0 if the backend cannot track writes for this process)
+internal B32 dmn_process_clear_dirty_pages(DMN_Handle process);
+internal B32 dmn_process_read_dirty_pages(DMN_Handle process, Rng1U64 range, U64 *dirty_flags_out);
+
 //- rjf: threads
 internal Arch dmn_arch_from_thread(DMN_Handle handle);
 internal U64 dmn_stack_base_vaddr_from_thread(DMN_Handle handle);
@@ -50,6 +50,93 @@ dmn_lnx_write(int memory_fd, Rng1U64 range, void *src)
   return result;
 }
 
+//- rjf: batched memory reading/writing helpers
+//
+// NOTE: each batch of up to DMN_LNX_IOV_MAX ranges is transferred with one
+// process_vm_readv/process_vm_writev. those only partially complete at the
+// granularity of whole ranges, and they respect page protections, so
+// process_vm_writev fails outright on read-only code pages. whenever a call
+// makes no progress, the rest of its batch goes through /proc/pid/mem, one
+// pread/pwrite per range.
+
+internal void
+dmn_lnx_read_batch(pid_t pid, int memory_fd, U64 count, Rng1U64 *ranges, U8 **dsts, B32 *goods_out)
+{
+  Temp scratch = scratch_begin(0, 0);
+  struct iovec *local_iovs = push_array(scratch.arena, struct iovec, DMN_LNX_IOV_MAX);
+  struct iovec *remote_iovs = push_array(scratch.arena, struct iovec, DMN_LNX_IOV_MAX);
+  for(U64 batch_first_idx = 0; batch_first_idx < count;)
+  {
+    U64 batch_count = Min(count - batch_first_idx, DMN_LNX_IOV_MAX);
+    for EachIndex(batch_idx, batch_count)
+    {
+      Rng1U64 range = ranges[batch_first_idx + batch_idx];
+      local_iovs[batch_idx].iov_base  = dsts[batch_first_idx + batch_idx];
+      local_iovs[batch_idx].iov_len   = dim_1u64(range);
+      remote_iovs[batch_idx].iov_base = (void *)range.min;
+      remote_iovs[batch_idx].iov_len  = dim_1u64(range);
+    }
+    ssize_t bytes_read = syscall(SYS_process_vm_readv, pid, local_iovs, batch_count, remote_iovs, batch_count, 0);
+    U64 bytes_left = (bytes_read > 0 ? (U64)bytes_read : 0);
+    U64 done_count = 0;
+    for(;done_count < batch_count && bytes_left >= local_iovs[done_count].iov_len; done_count += 1)
+    {
+      goods_out[batch_first_idx + done_count] = 1;
+      bytes_left -= local_iovs[done_count].iov_len;
+    }
+    if(done_count == 0)
+    {
+      for EachIndex(batch_idx, batch_count)
+      {
+        U64 idx = batch_first_idx + batch_idx;
+        goods_out[idx] = (dmn_lnx_read(memory_fd, ranges[idx], dsts[idx]) == dim_1u64(ranges[idx]));
+      }
+      done_count = batch_count;
+    }
+    batch_first_idx += done_count;
+  }
+  scratch_end(scratch);
+}
+
+internal void
+dmn_lnx_write_batch(pid_t pid, int memory_fd, U64 count, Rng1U64 *ranges, U8 **srcs, B32 *goods_out)
+{
+  Temp scratch = scratch_begin(0, 0);
+  struct iovec *local_iovs = push_array(scratch.arena, struct iovec, DMN_LNX_IOV_MAX);
+  struct iovec *remote_iovs = push_array(scratch.arena, struct iovec, DMN_LNX_IOV_MAX);
+  for(U64 batch_first_idx = 0; batch_first_idx < count;)
+  {
+    U64 batch_count = Min(count - batch_first_idx, DMN_LNX_IOV_MAX);
+    for EachIndex(batch_idx, batch_count)
+    {
+      Rng1U64 range = ranges[batch_first_idx + batch_idx];
+      local_iovs[batch_idx].iov_base  = srcs[batch_first_idx + batch_idx];
+      local_iovs[batch_idx].iov_len   = dim_1u64(range);
+      remote_iovs[batch_idx].iov_base = (void *)range.min;
+      remote_iovs[batch_idx].iov_len  = dim_1u64(range);
+    }
+    ssize_t bytes_written = syscall(SYS_process_vm_writev, pid, local_iovs, batch_count, remote_iovs, batch_count, 0);
+    U64 bytes_left = (bytes_written > 0 ? (U64)bytes_written : 0);
+    U64 done_count = 0;
+    for(;done_count < batch_count && bytes_left >= local_iovs[done_count].iov_len; done_count += 1)
+    {
+      goods_out[batch_first_idx + done_count] = 1;
+      bytes_left -= local_iovs[done_count].iov_len;
+    }
+    if(done_count == 0)
+    {
+      for EachIndex(batch_idx, batch_count)
+      {
+        U64 idx = batch_first_idx + batch_idx;
+        goods_out[idx] = dmn_lnx_write(memory_fd, ranges[idx], srcs[idx]);
+      }
+      done_count = batch_count;
+    }
+    batch_first_idx += done_count;
+  }
+  scratch_end(scratch);
+}
+
 internal String8
 dmn_lnx_read_string(Arena *arena, int memory_fd, U64 base_vaddr)
 {
@@ -437,6 +524,39 @@ dmn_lnx_module_info_list_from_process(Arena *arena, DMN_LNX_Entity *process)
   return list;
 }
 
+//- rjf: soft-dirty page tracking
+
+internal B32
+dmn_lnx_soft_dirty_supported_from_self(void)
+{
+  // NOTE: kernels built without CONFIG_MEM_SOFT_DIRTY accept writes to
+  // clear_refs, but never set the soft-dirty bit - so they would report
+  // every page as clean. freshly-faulted pages are always soft-dirty when
+  // the feature exists, so probe one of our own.
+  B32 result = 0;
+  U64 page_size = os_get_system_info()->page_size;
+  if(page_size == DMN_DIRTY_PAGE_SIZE)
+  {
+    volatile U8 *page = (volatile U8 *)mmap(0, page_size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if(page != MAP_FAILED)
+    {
+      page[0] = 1;
+      int pagemap_fd = open("/proc/self/pagemap", O_RDONLY);
+      if(pagemap_fd >= 0)
+      {
+        U64 entry = 0;
+        if(pread(pagemap_fd, &entry, sizeof(entry), ((U64)page/page_size)*sizeof(entry)) == sizeof(entry))
+        {
+          result = !!(entry & DMN_LNX_PAGEMAP_SOFT_DIRTY);
+        }
+        close(pagemap_fd);
+      }
+      munmap((void *)page, page_size);
+    }
+  }
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Entity Functions
 
@@ -479,6 +599,12 @@ dmn_lnx_entity_release(DMN_LNX_Entity *entity)
     DMN_LNX_EntityNode *first_task = &start_task;
     for(DMN_LNX_EntityNode *t = first_task; t != 0; t = t->next)
     {
+      if(t->v->trap_shadow_arena != 0)
+      {
+        dmn_lnx_trap_shadow_clear(t->v);
+        arena_release(t->v->trap_shadow_arena);
+        t->v->trap_shadow_arena = 0;
+      }
       SLLStackPush(dmn_lnx_state->free_entity, t->v);
       for(DMN_LNX_Entity *child = t->v->first; child != &dmn_lnx_nil_entity; child = child->next)
       {
@@ -892,6 +1018,295 @@ dmn_lnx_thread_write_reg_block(DMN_LNX_Entity *thread, void *reg_block)
   return result;
 }
 
+////////////////////////////////
+//~ rjf: Trap Shadow Functions
+
+internal int
+dmn_lnx_qsort_compare_u64(U64 *a, U64 *b)
+{
+  int result = 0;
+  if(*a < *b)
+  {
+    result = -1;
+  }
+  else if(*a > *b)
+  {
+    result = +1;
+  }
+  return result;
+}
+
+internal U64
+dmn_lnx_trap_shadow_idx_from_vaddr(DMN_LNX_Entity *process, U64 vaddr)
+{
+  // rjf: index of first shadowed trap at or after vaddr
+  U64 lo = 0;
+  U64 hi = process->trap_shadow_count;
+  for(;lo < hi;)
+  {
+    U64 mid = lo + (hi - lo)/2;
+    if(process->trap_shadow_vaddrs[mid] < vaddr)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+internal void
+dmn_lnx_trap_shadow_clear(DMN_LNX_Entity *process)
+{
+  // NOTE: drops the shadow without touching memory, for address spaces
+  // which no longer hold our traps (exec, exit)
+  MutexScopeW(dmn_lnx_state->trap_shadow_rw_mutex)
+  {
+    process->trap_shadow_count = 0;
+    process->trap_shadow_vaddrs = 0;
+    process->trap_shadow_og_bytes = 0;
+    if(process->trap_shadow_arena != 0)
+    {
+      arena_clear(process->trap_shadow_arena);
+    }
+  }
+}
+
+internal void
+dmn_lnx_trap_shadow_sync(DMN_LNX_Entity *process, U64 *trap_vaddrs, U64 trap_count)
+{
+  Temp scratch = scratch_begin(0, 0);
+  U64 page_size = os_get_system_info()->page_size;
+  rw_mutex_take_w(dmn_lnx_state->trap_shadow_rw_mutex);
+  
+  //- rjf: verify resident traps are still in memory - pages may have been
+  // unmapped (munmap, dlclose) & the vaddr reused since the last sync, in
+  // which case the trap is gone & its recorded original byte is stale
+  B32 shadow_is_dirty = 0;
+  if(process->trap_shadow_count != 0)
+  {
+    U64 resident_spans_count = 0;
+    Rng1U64 *resident_spans = push_array(scratch.arena, Rng1U64, process->trap_shadow_count);
+    for EachIndex(idx, process->trap_shadow_count)
+    {
+      U64 vaddr = process->trap_shadow_vaddrs[idx];
+      if(resident_spans_count != 0 && resident_spans[resident_spans_count-1].min/page_size == vaddr/page_size)
+      {
+        resident_spans[resident_spans_count-1].max = vaddr + 1;
+      }
+      else
+      {
+        resident_spans[resident_spans_count] = r1u64(vaddr, vaddr + 1);
+        resident_spans_count += 1;
+      }
+    }
+    U8 **resident_span_datas = push_array(scratch.arena, U8 *, resident_spans_count);
+    B32 *resident_span_goods = push_array(scratch.arena, B32, resident_spans_count);
+    for EachIndex(span_idx, resident_spans_count)
+    {
+      resident_span_datas[span_idx] = push_array_no_zero(scratch.arena, U8, dim_1u64(resident_spans[span_idx]));
+    }
+    dmn_lnx_read_batch((pid_t)process->id, process->fd, resident_spans_count, resident_spans, resident_span_datas, resident_span_goods);
+    U64 verified_count = 0;
+    for(U64 idx = 0, span_idx = 0; idx < process->trap_shadow_count; idx += 1)
+    {
+      U64 vaddr = process->trap_shadow_vaddrs[idx];
+      for(;vaddr >= resident_spans[span_idx].max; span_idx += 1);
+      if(resident_span_goods[span_idx] && resident_span_datas[span_idx][vaddr - resident_spans[span_idx].min] == 0xCC)
+      {
+        process->trap_shadow_vaddrs[verified_count] = vaddr;
+        process->trap_shadow_og_bytes[verified_count] = process->trap_shadow_og_bytes[idx];
+        verified_count += 1;
+      }
+    }
+    shadow_is_dirty = (verified_count != process->trap_shadow_count);
+    process->trap_shadow_count = verified_count;
+  }
+  
+  //- rjf: diff requested traps (sorted, unique) against resident traps
+  typedef struct DMN_LNX_TrapChange DMN_LNX_TrapChange;
+  struct DMN_LNX_TrapChange
+  {
+    U64 vaddr;
+    B32 install;
+    U8 og_byte;
+  };
+  U64 changes_count = 0;
+  DMN_LNX_TrapChange *changes = push_array(scratch.arena, DMN_LNX_TrapChange, trap_count + process->trap_shadow_count);
+  U64 new_count = 0;
+  U64 *new_vaddrs = push_array(scratch.arena, U64, trap_count);
+  U8 *new_og_bytes = push_array(scratch.arena, U8, trap_count);
+  {
+    U64 old_idx = 0;
+    U64 req_idx = 0;
+    for(;old_idx < process->trap_shadow_count || req_idx < trap_count;)
+    {
+      U64 old_vaddr = (old_idx < process->trap_shadow_count ? process->trap_shadow_vaddrs[old_idx] : max_U64);
+      U64 req_vaddr = (req_idx < trap_count ? trap_vaddrs[req_idx] : max_U64);
+      if(old_vaddr == req_vaddr)
+      {
+        new_vaddrs[new_count] = old_vaddr;
+        new_og_bytes[new_count] = process->trap_shadow_og_bytes[old_idx];
+        new_count += 1;
+        old_idx += 1;
+        req_idx += 1;
+      }
+      else if(old_vaddr < req_vaddr)
+      {
+        DMN_LNX_TrapChange *change = &changes[changes_count];
+        changes_count += 1;
+        change->vaddr = old_vaddr;
+        change->install = 0;
+        change->og_byte = process->trap_shadow_og_bytes[old_idx];
+        old_idx += 1;
+      }
+      else
+      {
+        DMN_LNX_TrapChange *change = &changes[changes_count];
+        changes_count += 1;
+        change->vaddr = req_vaddr;
+        change->install = 1;
+        req_idx += 1;
+      }
+    }
+  }
+  
+  //- rjf: group changes into per-page spans
+  U64 spans_count = 0;
+  Rng1U64 *spans = push_array(scratch.arena, Rng1U64, changes_count);
+  U64 *span_first_change_idxs = push_array(scratch.arena, U64, changes_count + 1);
+  for EachIndex(change_idx, changes_count)
+  {
+    U64 vaddr = changes[change_idx].vaddr;
+    if(spans_count != 0 && spans[spans_count-1].min/page_size == vaddr/page_size)
+    {
+      spans[spans_count-1].max = vaddr + 1;
+    }
+    else
+    {
+      spans[spans_count] = r1u64(vaddr, vaddr + 1);
+      span_first_change_idxs[spans_count] = change_idx;
+      spans_count += 1;
+    }
+  }
+  span_first_change_idxs[spans_count] = changes_count;
+  
+  //- rjf: read all spans, patch in traps / original bytes, write all spans
+  if(spans_count != 0)
+  {
+    U8 **span_datas = push_array(scratch.arena, U8 *, spans_count);
+    B32 *span_read_goods = push_array(scratch.arena, B32, spans_count);
+    B32 *span_write_goods = push_array(scratch.arena, B32, spans_count);
+    for EachIndex(span_idx, spans_count)
+    {
+      span_datas[span_idx] = push_array_no_zero(scratch.arena, U8, dim_1u64(spans[span_idx]));
+    }
+    dmn_lnx_read_batch((pid_t)process->id, process->fd, spans_count, spans, span_datas, span_read_goods);
+    for EachIndex(span_idx, spans_count)
+    {
+      for(U64 change_idx = span_first_change_idxs[span_idx]; change_idx < span_first_change_idxs[span_idx+1]; change_idx += 1)
+      {
+        DMN_LNX_TrapChange *change = &changes[change_idx];
+        U8 *byte = &span_datas[span_idx][change->vaddr - spans[span_idx].min];
+        if(change->install)
+        {
+          change->og_byte = *byte;
+          *byte = 0xCC;
+        }
+        else
+        {
+          *byte = change->og_byte;
+        }
+      }
+    }
+    
+    // rjf: spans which could not be read are not written (their traps are dropped)
+    U64 write_spans_count = 0;
+    Rng1U64 *write_spans = push_array(scratch.arena, Rng1U64, spans_count);
+    U8 **write_span_datas = push_array(scratch.arena, U8 *, spans_count);
+    U64 *write_span_idxs = push_array(scratch.arena, U64, spans_count);
+    for EachIndex(span_idx, spans_count)
+    {
+      if(span_read_goods[span_idx])
+      {
+        write_spans[write_spans_count] = spans[span_idx];
+        write_span_datas[write_spans_count] = span_datas[span_idx];
+        write_span_idxs[write_spans_count] = span_idx;
+        write_spans_count += 1;
+      }
+    }
+    B32 *write_goods = push_array(scratch.arena, B32, write_spans_count);
+    dmn_lnx_write_batch((pid_t)process->id, process->fd, write_spans_count, write_spans, write_span_datas, write_goods);
+    for EachIndex(write_span_idx, write_spans_count)
+    {
+      span_write_goods[write_span_idxs[write_span_idx]] = write_goods[write_span_idx];
+    }
+    
+    //- rjf: record newly installed traps
+    U64 installed_count = 0;
+    U64 *installed_vaddrs = push_array(scratch.arena, U64, changes_count);
+    U8 *installed_og_bytes = push_array(scratch.arena, U8, changes_count);
+    for EachIndex(span_idx, spans_count)
+    {
+      if(span_write_goods[span_idx])
+      {
+        for(U64 change_idx = span_first_change_idxs[span_idx]; change_idx < span_first_change_idxs[span_idx+1]; change_idx += 1)
+        {
+          if(changes[change_idx].install)
+          {
+            installed_vaddrs[installed_count] = changes[change_idx].vaddr;
+            installed_og_bytes[installed_count] = changes[change_idx].og_byte;
+            installed_count += 1;
+          }
+        }
+      }
+    }
+    
+    //- rjf: merge kept & installed traps (both sorted)
+    U64 merged_count = 0;
+    U64 *merged_vaddrs = push_array(scratch.arena, U64, new_count + installed_count);
+    U8 *merged_og_bytes = push_array(scratch.arena, U8, new_count + installed_count);
+    for(U64 kept_idx = 0, installed_idx = 0; kept_idx < new_count || installed_idx < installed_count; merged_count += 1)
+    {
+      if(installed_idx >= installed_count || (kept_idx < new_count && new_vaddrs[kept_idx] < installed_vaddrs[installed_idx]))
+      {
+        merged_vaddrs[merged_count] = new_vaddrs[kept_idx];
+        merged_og_bytes[merged_count] = new_og_bytes[kept_idx];
+        kept_idx += 1;
+      }
+      else
+      {
+        merged_vaddrs[merged_count] = installed_vaddrs[installed_idx];
+        merged_og_bytes[merged_count] = installed_og_bytes[installed_idx];
+        installed_idx += 1;
+      }
+    }
+    new_count = merged_count;
+    new_vaddrs = merged_vaddrs;
+    new_og_bytes = merged_og_bytes;
+  }
+  
+  //- rjf: store new shadow
+  if(spans_count != 0 || shadow_is_dirty)
+  {
+    if(process->trap_shadow_arena == 0)
+    {
+      process->trap_shadow_arena = arena_alloc();
+    }
+    arena_clear(process->trap_shadow_arena);
+    process->trap_shadow_count = new_count;
+    process->trap_shadow_vaddrs = push_array_no_zero(process->trap_shadow_arena, U64, new_count);
+    process->trap_shadow_og_bytes = push_array_no_zero(process->trap_shadow_arena, U8, new_count);
+    MemoryCopy(process->trap_shadow_vaddrs, new_vaddrs, sizeof(new_vaddrs[0])*new_count);
+    MemoryCopy(process->trap_shadow_og_bytes, new_og_bytes, sizeof(new_og_bytes[0])*new_count);
+  }
+  
+  rw_mutex_drop_w(dmn_lnx_state->trap_shadow_rw_mutex);
+  scratch_end(scratch);
+}
+
 ////////////////////////////////
 //~ rjf: @dmn_os_hooks Main Layer Initialization (Implemented Per-OS)
 
@@ -906,6 +1321,8 @@ dmn_init(void)
   dmn_lnx_state->entities_base = push_array(dmn_lnx_state->entities_arena, DMN_LNX_Entity, 0);
   dmn_lnx_entity_alloc(&dmn_lnx_nil_entity, DMN_LNX_EntityKind_Root);
   dmn_lnx_state->access_mutex = mutex_alloc();
+  dmn_lnx_state->trap_shadow_rw_mutex = rw_mutex_alloc();
+  dmn_lnx_state->soft_dirty_supported = dmn_lnx_soft_dirty_supported_from_self();
 }
 
 ////////////////////////////////
@@ -1174,6 +1591,10 @@ dmn_ctrl_detach(DMN_CtrlCtx *ctx, DMN_Handle process)
 {
   B32 result = 0;
   DMN_LNX_Entity *process_entity = dmn_lnx_entity_from_handle(process);
+  if(process_entity != &dmn_lnx_nil_entity)
+  {
+    dmn_lnx_trap_shadow_sync(process_entity, 0, 0);
+  }
   if(process_entity != &dmn_lnx_nil_entity &&
      ptrace(PTRACE_DETACH, process_entity->id, 0, 0) != -1)
   {
@@ -1225,25 +1646,47 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
     B32 need_wait_on_events = (evts.count == 0);
     
     ////////////////////////////
-    //- rjf: write all traps into memory
+    //- rjf: sync each process' resident traps with the requested traps
+    //
+    // NOTE: traps stay in memory across runs (reads/writes go through the
+    // trap shadow), so only traps which were added or removed since the last
+    // run touch memory, batched per page.
     //
-    U8 *trap_swap_bytes = push_array_no_zero(scratch.arena, U8, ctrls->traps.trap_count);
-    ProfScope("write all traps into memory")
+    ProfScope("sync resident traps")
     {
-      U64 trap_idx = 0;
-      for(DMN_TrapChunkNode *n = ctrls->traps.first; n != 0; n = n->next)
+      for(DMN_LNX_Entity *process = dmn_lnx_state->entities_base->first;
+          process != &dmn_lnx_nil_entity;
+          process = process->next)
       {
-        for(U64 n_idx = 0; n_idx < n->count; n_idx += 1, trap_idx += 1)
+        if(process->kind != DMN_LNX_EntityKind_Process)
+        {
+          continue;
+        }
+        U64 trap_count = 0;
+        U64 *trap_vaddrs = push_array_no_zero(scratch.arena, U64, ctrls->traps.trap_count);
+        for(DMN_TrapChunkNode *n = ctrls->traps.first; n != 0; n = n->next)
+        {
+          for(U64 n_idx = 0; n_idx < n->count; n_idx += 1)
+          {
+            DMN_Trap *trap = n->v+n_idx;
+            if(trap->flags == 0 && dmn_lnx_entity_from_handle(trap->process) == process)
+            {
+              trap_vaddrs[trap_count] = trap->vaddr;
+              trap_count += 1;
+            }
+          }
+        }
+        quick_sort(trap_vaddrs, trap_count, sizeof(trap_vaddrs[0]), dmn_lnx_qsort_compare_u64);
+        U64 unique_trap_count = 0;
+        for EachIndex(idx, trap_count)
         {
-          DMN_Trap *trap = n->v+n_idx;
-          if(trap->flags == 0)
+          if(unique_trap_count == 0 || trap_vaddrs[unique_trap_count-1] != trap_vaddrs[idx])
           {
-            trap_swap_bytes[trap_idx] = 0xCC;
-            dmn_process_read(trap->process, r1u64(trap->vaddr, trap->vaddr+1), trap_swap_bytes+trap_idx);
-            U8 int3 = 0xCC;
-            dmn_process_write(trap->process, r1u64(trap->vaddr, trap->vaddr+1), &int3);
+            trap_vaddrs[unique_trap_count] = trap_vaddrs[idx];
+            unique_trap_count += 1;
           }
         }
+        dmn_lnx_trap_shadow_sync(process, trap_vaddrs, unique_trap_count);
       }
     }
     
@@ -1427,6 +1870,18 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
         thread_exit = 1;
       }
       
+      //- rjf: SIGTRAP:PTRACE_EVENT_EXEC -> address space was replaced, so
+      // resident traps are gone; report as the plain post-exec SIGTRAP was
+      else if(wifstopped && wstopsig == SIGTRAP && ptrace_event_code == PTRACE_EVENT_EXEC)
+      {
+        dmn_lnx_trap_shadow_clear(process);
+        DMN_Event *e = dmn_event_list_push(arena, &evts);
+        e->kind                = DMN_EventKind_Trap;
+        e->process             = dmn_lnx_handle_from_entity(process);
+        e->thread              = dmn_lnx_handle_from_entity(thread);
+        e->instruction_pointer = rip;
+      }
+      
       //- rjf: SIGTRAP:PTRACE_EVENT_CLONE
       else if(wifstopped && wstopsig == SIGTRAP && ptrace_event_code == PTRACE_EVENT_CLONE)
       {
@@ -1584,29 +2039,6 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
       }
     }
     
-    //////////////////////////
-    //- rjf: restore original memory at trap locations
-    //
-    ProfScope("restore original memory at trap locations")
-    {
-      U64 trap_idx = 0;
-      for(DMN_TrapChunkNode *n = ctrls->traps.first; n != 0; n = n->next)
-      {
-        for(U64 n_idx = 0; n_idx < n->count; n_idx += 1, trap_idx += 1)
-        {
-          DMN_Trap *trap = n->v+n_idx;
-          if(trap->flags == 0)
-          {
-            U8 og_byte = trap_swap_bytes[trap_idx];
-            if(og_byte != 0xCC)
-            {
-              dmn_process_write(trap->process, r1u64(trap->vaddr, trap->vaddr+1), &og_byte);
-            }
-          }
-        }
-      }
-    }
-    
     scratch_end(scratch);
   }
   return evts;
@@ -1696,7 +2128,20 @@ internal U64
 dmn_process_read(DMN_Handle process, Rng1U64 range, void *dst)
 {
   DMN_LNX_Entity *entity = dmn_lnx_entity_from_handle(process);
-  U64 result = dmn_lnx_read(entity->fd, range, dst);
+  U64 result = 0;
+  
+  //- rjf: read & hide resident traps; under the shadow lock, so a concurrent
+  // sync can't leave a trap byte in `dst` which the shadow doesn't cover yet
+  MutexScopeR(dmn_lnx_state->trap_shadow_rw_mutex)
+  {
+    result = dmn_lnx_read(entity->fd, range, dst);
+    for(U64 idx = dmn_lnx_trap_shadow_idx_from_vaddr(entity, range.min);
+        idx < entity->trap_shadow_count && entity->trap_shadow_vaddrs[idx] < range.min + result;
+        idx += 1)
+    {
+      ((U8 *)dst)[entity->trap_shadow_vaddrs[idx] - range.min] = entity->trap_shadow_og_bytes[idx];
+    }
+  }
   return result;
 }
 
@@ -1704,7 +2149,101 @@ internal B32
 dmn_process_write(DMN_Handle process, Rng1U64 range, void *src)
 {
   DMN_LNX_Entity *entity = dmn_lnx_entity_from_handle(process);
-  B32 result = dmn_lnx_write(entity->fd, range, src);
+  B32 result = 0;
+  rw_mutex_take_w(dmn_lnx_state->trap_shadow_rw_mutex);
+  
+  //- rjf: writes over resident traps update the shadow's original bytes, & keep the traps
+  U64 first_trap_idx = dmn_lnx_trap_shadow_idx_from_vaddr(entity, range.min);
+  if(first_trap_idx < entity->trap_shadow_count && entity->trap_shadow_vaddrs[first_trap_idx] < range.max)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    U8 *patched = push_array_no_zero(scratch.arena, U8, dim_1u64(range));
+    MemoryCopy(patched, src, dim_1u64(range));
+    for(U64 idx = first_trap_idx; idx < entity->trap_shadow_count && entity->trap_shadow_vaddrs[idx] < range.max; idx += 1)
+    {
+      patched[entity->trap_shadow_vaddrs[idx] - range.min] = 0xCC;
+    }
+    result = dmn_lnx_write(entity->fd, range, patched);
+    if(result)
+    {
+      for(U64 idx = first_trap_idx; idx < entity->trap_shadow_count && entity->trap_shadow_vaddrs[idx] < range.max; idx += 1)
+      {
+        entity->trap_shadow_og_bytes[idx] = ((U8 *)src)[entity->trap_shadow_vaddrs[idx] - range.min];
+      }
+    }
+    scratch_end(scratch);
+  }
+  else
+  {
+    result = dmn_lnx_write(entity->fd, range, src);
+  }
+  rw_mutex_drop_w(dmn_lnx_state->trap_shadow_rw_mutex);
+  return result;
+}
+
+internal B32
+dmn_process_clear_dirty_pages(DMN_Handle process)
+{
+  DMN_LNX_Entity *entity = dmn_lnx_entity_from_handle(process);
+  B32 result = 0;
+  if(dmn_lnx_state->soft_dirty_supported && entity->kind == DMN_LNX_EntityKind_Process)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    int clear_refs_fd = open((char *)str8f(scratch.arena, "/proc/%d/clear_refs", (pid_t)entity->id).str, O_WRONLY);
+    if(clear_refs_fd >= 0)
+    {
+      result = (write(clear_refs_fd, "4", 1) == 1);
+      close(clear_refs_fd);
+    }
+    scratch_end(scratch);
+  }
+  return result;
+}
+
+internal B32
+dmn_process_read_dirty_pages(DMN_Handle process, Rng1U64 range, U64 *dirty_flags_out)
+{
+  DMN_LNX_Entity *entity = dmn_lnx_entity_from_handle(process);
+  B32 result = 0;
+  if(dmn_lnx_state->soft_dirty_supported && entity->kind == DMN_LNX_EntityKind_Process)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    int pagemap_fd = open((char *)str8f(scratch.arena, "/proc/%d/pagemap", (pid_t)entity->id).str, O_RDONLY);
+    if(pagemap_fd >= 0)
+    {
+      result = 1;
+      U64 first_page_idx = range.min/DMN_DIRTY_PAGE_SIZE;
+      U64 page_count = (AlignPow2(range.max, DMN_DIRTY_PAGE_SIZE)/DMN_DIRTY_PAGE_SIZE) - first_page_idx;
+      U64 *entries = push_array(scratch.arena, U64, page_count);
+      U64 bytes_read = dmn_lnx_read(pagemap_fd, r1u64(first_page_idx*sizeof(U64), (first_page_idx+page_count)*sizeof(U64)), entries);
+      U64 entries_read = bytes_read/sizeof(U64);
+      for EachIndex(idx, page_count)
+      {
+        // rjf: only call a page clean if it is backed, was not written since
+        // the last clear, and is anonymous. file pages (including private
+        // ones which were never copied-on-write) show the page cache, which
+        // can be written through any other mapping of the file, or by write()
+        B32 is_clean = 0;
+        if(idx < entries_read)
+        {
+          U64 entry = entries[idx];
+          is_clean = ((entry & (DMN_LNX_PAGEMAP_PRESENT|DMN_LNX_PAGEMAP_SWAPPED)) != 0 &&
+                      (entry & DMN_LNX_PAGEMAP_SOFT_DIRTY) == 0 &&
+                      (entry & DMN_LNX_PAGEMAP_FILE_SHARED) == 0);
+        }
+        if(is_clean)
+        {
+          dirty_flags_out[idx/64] &= ~(1ull<<(idx%64));
+        }
+        else
+        {
+          dirty_flags_out[idx/64] |= (1ull<<(idx%64));
+        }
+      }
+      close(pagemap_fd);
+    }
+    scratch_end(scratch);
+  }
   return result;
 }
 
@@ -11,6 +11,7 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/uio.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 #include <elf.h>
 #include <dirent.h>
@@ -20,11 +21,25 @@
 //~ rjf: ptrace options
 
 #define DMN_LNX_PTRACE_OPTIONS (PTRACE_O_TRACEEXIT|\
+PTRACE_O_TRACEEXEC|\
 PTRACE_O_EXITKILL|\
 PTRACE_O_TRACEFORK|\
 PTRACE_O_TRACEVFORK|\
 PTRACE_O_TRACECLONE)
 
+////////////////////////////////
+//~ rjf: Batched Memory Access Limits
+
+#define DMN_LNX_IOV_MAX 1024
+
+////////////////////////////////
+//~ rjf: /proc/pid/pagemap Entry Bits
+
+#define DMN_LNX_PAGEMAP_SOFT_DIRTY  (1ull<<55)
+#define DMN_LNX_PAGEMAP_FILE_SHARED (1ull<<61)
+#define DMN_LNX_PAGEMAP_SWAPPED     (1ull<<62)
+#define DMN_LNX_PAGEMAP_PRESENT     (1ull<<63)
+
 ////////////////////////////////
 //~ rjf: Register Layouts
 //
@@ -261,6 +276,14 @@ struct DMN_LNX_Entity
   U64 id;
   int fd;
   B32 expecting_dummy_sigstop;
+  
+  // rjf: process trap shadow - traps stay resident in memory across runs;
+  // this records the original byte under each one, sorted by vaddr. read by
+  // memory reads on any thread, so guarded by `trap_shadow_rw_mutex`.
+  Arena *trap_shadow_arena;
+  U64 trap_shadow_count;
+  U64 *trap_shadow_vaddrs;
+  U8 *trap_shadow_og_bytes;
 };
 
 typedef struct DMN_LNX_EntityNode DMN_LNX_EntityNode;
@@ -296,6 +319,13 @@ struct DMN_LNX_State
   B32 has_halt_injection;
   U64 halt_code;
   U64 halt_user_data;
+  
+  // rjf: soft-dirty page tracking support
+  B32 soft_dirty_supported;
+  
+  // rjf: trap shadow locking (memory reads from artifact threads vs. trap
+  // syncs & memory writes on the ctrl thread)
+  RWMutex trap_shadow_rw_mutex;
 };
 
 read_only global DMN_LNX_Entity dmn_lnx_nil_entity = {&dmn_lnx_nil_entity, &dmn_lnx_nil_entity, &dmn_lnx_nil_entity, &dmn_lnx_nil_entity, &dmn_lnx_nil_entity};
@@ -312,6 +342,10 @@ internal B32 dmn_lnx_write(int memory_fd, Rng1U64 range, void *src);
 #define dmn_lnx_write_struct(fd, vaddr, ptr) dmn_lnx_write((fd), r1u64((vaddr), (vaddr)+sizeof(*(ptr))), (ptr))
 internal String8 dmn_lnx_read_string(Arena *arena, int memory_fd, U64 base_vaddr);
 
+//- rjf: batched memory reading/writing helpers
+internal void dmn_lnx_read_batch(pid_t pid, int memory_fd, U64 count, Rng1U64 *ranges, U8 **dsts, B32 *goods_out);
+internal void dmn_lnx_write_batch(pid_t pid, int memory_fd, U64 count, Rng1U64 *ranges, U8 **srcs, B32 *goods_out);
+
 //- rjf: pid => info extraction
 internal String8 dmn_lnx_exe_path_from_pid(Arena *arena, pid_t pid);
 internal Arch dmn_lnx_arch_from_pid(pid_t pid);
@@ -323,6 +357,9 @@ internal DMN_LNX_PhdrInfo dmn_lnx_phdr_info_from_memory(int memory_fd, B32 is_32
 //- rjf: process entity => info extraction
 internal DMN_LNX_ModuleInfoList dmn_lnx_module_info_list_from_process(Arena *arena, DMN_LNX_Entity *process);
 
+//- rjf: soft-dirty page tracking
+internal B32 dmn_lnx_soft_dirty_supported_from_self(void);
+
 ////////////////////////////////
 //~ rjf: Entity Functions
 
@@ -334,4 +371,12 @@ internal DMN_LNX_Entity *dmn_lnx_thread_from_pid(pid_t pid);
 internal B32 dmn_lnx_thread_read_reg_block(DMN_LNX_Entity *thread, void *reg_block);
 internal B32 dmn_lnx_thread_write_reg_block(DMN_LNX_Entity *thread, void *reg_block);
 
+////////////////////////////////
+//~ rjf: Trap Shadow Functions
+
+internal int dmn_lnx_qsort_compare_u64(U64 *a, U64 *b);
+internal U64 dmn_lnx_trap_shadow_idx_from_vaddr(DMN_LNX_Entity *process, U64 vaddr);
+internal void dmn_lnx_trap_shadow_sync(DMN_LNX_Entity *process, U64 *trap_vaddrs, U64 trap_count);
+internal void dmn_lnx_trap_shadow_clear(DMN_LNX_Entity *process);
+
 #endif // DEMON_CORE_LINUX_H
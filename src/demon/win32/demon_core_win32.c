@@ -3106,6 +3106,22 @@ dmn_process_write(DMN_Handle process, Rng1U64 range, void *src)
   return result;
 }
 
+internal B32
+dmn_process_clear_dirty_pages(DMN_Handle process)
+{
+  // NOTE: Windows offers no per-page write tracking for another process'
+  // existing memory (GetWriteWatch only covers MEM_WRITE_WATCH allocations,
+  // made by the process itself) - so no process is tracked, and every page
+  // shares the global memory generation.
+  return 0;
+}
+
+internal B32
+dmn_process_read_dirty_pages(DMN_Handle process, Rng1U64 range, U64 *dirty_flags_out)
+{
+  return 0;
+}
+
 //- rjf: threads
 
 internal Arch
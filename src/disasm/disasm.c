@@ -266,7 +266,7 @@ struct DASM_Artifact
 };
 
 internal AC_Artifact
-dasm_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out)
+dasm_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out)
 {
   DASM_Artifact *artifact = 0;
   if(lane_idx() == 0)
@@ -443,6 +443,7 @@ dasm_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_o
     //- rjf: artifacts -> value bundle
     Arena *info_arena = 0;
     DASM_Info info = {0};
+    U64 text_size = 0;
     if(!stale)
     {
       //- rjf: produce joined text
@@ -450,6 +451,7 @@ dasm_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_o
       StringJoin text_join = {0};
       text_join.sep = str8_lit("\n");
       String8 text = str8_list_join(text_arena, &inst_strings, &text_join);
+      text_size = text.size;
       
       //- rjf: produce unique key for this disassembly's text
       C_Key text_key = c_key_make(c_root_alloc(), c_id_make(0, 0));
@@ -479,6 +481,7 @@ dasm_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_o
       artifact->arena = info_arena;
       artifact->info = info;
       artifact->data_hash = hash;
+      size_out[0] = arena_pos(info_arena) + text_size;
     }
     
     access_close(access);
@@ -218,6 +218,7 @@ dr_begin_frame(FNT_Tag icon_font)
 internal void
 dr_submit_bucket(OS_Handle os_window, R_Handle r_window, DR_Bucket *bucket)
 {
+  fnt_atlas_uploads_flush();
   r_window_submit(os_window, r_window, &bucket->passes);
 }
 
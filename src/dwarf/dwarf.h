@@ -1356,23 +1356,24 @@ X(AdvanceLoc1,    0x2,  DW_CFA_OperandType_Value)
 X(AdvanceLoc2,    0x3,  DW_CFA_OperandType_Value)                                   \
 X(AdvanceLoc4,    0x4,  DW_CFA_OperandType_Value)                                   \
 X(OffsetExt,      0x5,  DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
-X(RestoreExt,     0x6)                                                              \
+X(RestoreExt,     0x6,  DW_CFA_OperandType_Register)                                \
 X(Undefined,      0x7,  DW_CFA_OperandType_Register)                                \
 X(SameValue,      0x8,  DW_CFA_OperandType_Register)                                \
-X(Register,       0x9,  DW_CFA_OperandType_Register)                                \
+X(Register,       0x9,  DW_CFA_OperandType_Register, DW_CFA_OperandType_Register)   \
 X(RememberState,  0xa)                                                              \
 X(RestoreState,   0xb)                                                              \
 X(DefCfa,         0xc,  DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
 X(DefCfaRegister, 0xd,  DW_CFA_OperandType_Register)                                \
 X(DefCfaOffset,   0xe,  DW_CFA_OperandType_Value)                                   \
 X(DefCfaExpr,     0xf,  DW_CFA_OperandType_Expression)                              \
-X(Expr,           0x10, DW_CFA_OperandType_Expression)                              \
+X(Expr,           0x10, DW_CFA_OperandType_Register, DW_CFA_OperandType_Expression) \
 X(OffsetExtSf,    0x11, DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
 X(DefCfaSf,       0x12, DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
 X(DefCfaOffsetSf, 0x13, DW_CFA_OperandType_Value)                                   \
 X(ValOffset,      0x14, DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
 X(ValOffsetSf,    0x15, DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
 X(ValExpr,        0x16, DW_CFA_OperandType_Register, DW_CFA_OperandType_Expression) \
+X(GnuArgsSize,    0x2e, DW_CFA_OperandType_Value)                                   \
 X(AdvanceLoc,     0x40, DW_CFA_OperandType_Value)                                   \
 X(Offset,         0x80, DW_CFA_OperandType_Register, DW_CFA_OperandType_Value)      \
 X(Restore,        0xc0, DW_CFA_OperandType_Register)
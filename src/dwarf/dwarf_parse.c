@@ -3550,6 +3550,7 @@ dw_parse_cfa_inst(String8        data,
     U32 delta = 0;
     U64 delta_size = str8_deserial_read_struct(data, cursor, &delta);
     if (delta_size == 0) { error_code = DW_CFA_ParseErrorCode_OutOfData; goto exit; }
+    cursor += delta_size;
     operands[0].u64 = delta * code_align_factor;
   } break;
   case DW_CFA_DefCfa: {
@@ -3597,12 +3598,12 @@ dw_parse_cfa_inst(String8        data,
     operands[0].u64 = offset;
   } break;
   case DW_CFA_DefCfaOffsetSf: {
-    U64 offset = 0;
-    U64 offset_size = str8_deserial_read_uleb128(data, cursor, &offset);
+    S64 offset = 0;
+    U64 offset_size = str8_deserial_read_sleb128(data, cursor, &offset);
     if (offset_size == 0) { error_code = DW_CFA_ParseErrorCode_OutOfData; goto exit; }
     cursor += offset_size;
 
-    operands[0].u64 = offset * data_align_factor;
+    operands[0].s64 = offset * data_align_factor;
   } break;
   case DW_CFA_DefCfaExpr: {
     U64 expr_size = 0;
@@ -3695,7 +3696,7 @@ dw_parse_cfa_inst(String8        data,
     cursor += offset_size;
 
     operands[0].u64 = val;
-    operands[1].s64 = offset;
+    operands[1].s64 = offset * data_align_factor;
   } break;
   case DW_CFA_Register: {
     U64 dst_reg = 0;
@@ -3726,7 +3727,8 @@ dw_parse_cfa_inst(String8        data,
     String8 expr = str8_prefix(str8_skip(data, cursor), expr_size);
     cursor += expr_size;
 
-    operands[0].block = expr;
+    operands[0].u64   = reg;
+    operands[1].block = expr;
   } break;
   case DW_CFA_ValExpr: {
     U64 val = 0;
@@ -3749,10 +3751,25 @@ dw_parse_cfa_inst(String8        data,
   case DW_CFA_Restore: {
     operands[0].u64 = implicit_operand;
   } break;
-  case DW_CFA_RestoreExt: {} break;
+  case DW_CFA_RestoreExt: {
+    U64 reg = 0;
+    U64 reg_size = str8_deserial_read_uleb128(data, cursor, &reg);
+    if (reg_size == 0) { error_code = DW_CFA_ParseErrorCode_OutOfData; goto exit; }
+    cursor += reg_size;
+
+    operands[0].u64 = reg;
+  } break;
   case DW_CFA_RememberState: {} break;
   case DW_CFA_RestoreState: {} break;
   case DW_CFA_Nop: {} break;
+  case DW_CFA_GnuArgsSize: {
+    U64 size = 0;
+    U64 size_size = str8_deserial_read_uleb128(data, cursor, &size);
+    if (size_size == 0) { error_code = DW_CFA_ParseErrorCode_OutOfData; goto exit; }
+    cursor += size_size;
+
+    operands[0].u64 = size;
+  } break;
   default: { NotImplemented; goto exit; } break;
   }
 
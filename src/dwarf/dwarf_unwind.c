@@ -160,7 +160,7 @@ dw_cfi_next_row(Arena *arena, DW_CFI_Unwind *uw)
       SLLStackPush(uw->row, new_row);
     } break;
     case DW_CFA_RestoreState: {
-      if (uw->row == 0) { goto exit; } // TODO: report error: unbalanced number of pushes and pops
+      if (uw->row->next == 0) { goto exit; } // TODO: report error: unbalanced number of pushes and pops
       DW_CFA_Row *free_row = uw->row;
       SLLStackPop(uw->row);
       SLLStackPush(uw->free_rows, free_row);
@@ -168,6 +168,9 @@ dw_cfi_next_row(Arena *arena, DW_CFI_Unwind *uw)
 
     case DW_CFA_Nop: {} break;
 
+    // GNU Extensions
+    case DW_CFA_GnuArgsSize: {} break; // only describes outgoing argument area, does not affect the row
+
     default: { NotImplemented; } break; // TODO: report error: unknown CFA opcode
     }
 
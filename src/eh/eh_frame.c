@@ -58,7 +58,7 @@ eh_read_ptr(String8 frame_base, U64 off, EH_PtrCtx *ptr_ctx, EH_PtrEnc encoding,
     }
 
     if (ptr_out) {
-      *ptr_out = raw_ptr;
+      *ptr_out = ptr;
     }
   }
 
@@ -74,7 +74,7 @@ eh_parse_aug_data(String8 aug_string, String8 aug_data, EH_PtrCtx *ptr_ctx, EH_A
   // Reference: https://refspecs.linuxfoundation.org/LSB_3.0.0/LSB-PDA/LSB-PDA/ehframechpt.html
   // Reference doc doesn't clarify structure for EH Data though
 
-  U64 cursor = 0;
+  U64 aug_cursor = 0;
 
   EH_AugFlags aug_flags        = 0;
   EH_PtrEnc lsda_encoding    = EH_PtrEnc_Omit;
@@ -82,8 +82,7 @@ eh_parse_aug_data(String8 aug_string, String8 aug_data, EH_PtrCtx *ptr_ctx, EH_A
   EH_PtrEnc handler_encoding = EH_PtrEnc_Omit;
   U64         handler_ip       = 0;
   if (str8_match(str8_prefix(aug_string, 1), str8_lit("z"), 0)) {
-    U64 aug_cursor = 0;
-    for (U8 *ptr = aug_string.str; ptr < (aug_string.str+aug_string.size); ptr += 1) {
+    for (U8 *ptr = aug_string.str+1; ptr < (aug_string.str+aug_string.size); ptr += 1) {
       switch (*ptr) {
       case 'L': {
         aug_cursor += str8_deserial_read_struct(aug_data, aug_cursor, &lsda_encoding);
@@ -98,21 +97,25 @@ eh_parse_aug_data(String8 aug_string, String8 aug_data, EH_PtrCtx *ptr_ctx, EH_A
         aug_cursor += str8_deserial_read_struct(aug_data, aug_cursor, &addr_encoding);
         aug_flags |= EH_AugFlag_HasAddrEnc;
       } break;
-      default: { Assert(!"failed to parse augmentation string"); goto exit; } break;
+      case 'S': {
+        aug_flags |= EH_AugFlag_IsSignalFrame;
+      } break;
+      // unknown augmentations end parsing, aug data size from 'z' lets the caller skip the rest
+      default: { goto exit; } break;
       }
     }
   }
 
+exit:;
   if (aug_out) {
     aug_out->handler_ip       = handler_ip;
     aug_out->handler_encoding = handler_encoding;
-    aug_out->lsda_encoding    = handler_encoding;
+    aug_out->lsda_encoding    = lsda_encoding;
     aug_out->addr_encoding    = addr_encoding;
     aug_out->flags            = aug_flags;
   }
 
-exit:;
-  U64 parse_size = cursor; 
+  U64 parse_size = aug_cursor;
   return parse_size;
 }
 
@@ -50,9 +50,10 @@ typedef struct EH_PtrCtx
 typedef U8 EH_AugFlags;
 enum
 {
-  EH_AugFlag_HasLSDA    = (1 << 0),
-  EH_AugFlag_HasHandler = (1 << 1),
-  EH_AugFlag_HasAddrEnc = (1 << 2),
+  EH_AugFlag_HasLSDA       = (1 << 0),
+  EH_AugFlag_HasHandler    = (1 << 1),
+  EH_AugFlag_HasAddrEnc    = (1 << 2),
+  EH_AugFlag_IsSignalFrame = (1 << 3),
 };
 
 typedef struct EH_Augmentation
@@ -735,6 +735,19 @@ e_select_base_ctx(E_BaseCtx *ctx)
   e_cache->string_id_map->hash_slots = push_array(e_cache->arena, E_StringIDSlot, e_cache->string_id_map->hash_slots_count);
 }
 
+internal void
+e_reselect_base_ctx(E_BaseCtx *ctx)
+{
+  // NOTE: unlike e_select_base_ctx, this does not reset the evaluation
+  // cache - it is only for re-interpreting bytecode which was already produced
+  // under this context.
+  if(ctx->modules == 0)          { ctx->modules = &e_module_nil; }
+  if(ctx->primary_module == 0)   { ctx->primary_module = &e_module_nil; }
+  if(ctx->dbg_infos == 0)        { ctx->dbg_infos = &e_dbg_info_nil; }
+  if(ctx->primary_dbg_info == 0) { ctx->primary_dbg_info = &e_dbg_info_nil; }
+  e_base_ctx = ctx;
+}
+
 internal void
 e_select_ir_ctx(E_IRCtx *ctx)
 {
@@ -1217,6 +1217,7 @@ internal void e_select_cache(E_Cache *cache);
 //~ rjf: Evaluation Phase Markers
 
 internal void e_select_base_ctx(E_BaseCtx *ctx);
+internal void e_reselect_base_ctx(E_BaseCtx *ctx);
 internal void e_select_ir_ctx(E_IRCtx *ctx);
 
 ////////////////////////////////
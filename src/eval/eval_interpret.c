@@ -83,14 +83,7 @@ e_space_read(E_Space space, void *out, Rng1U64 range)
         U128 hash = c_hash_from_key(key, 0);
         Access *access = access_open();
         {
-          String8 data = c_data_from_hash(access, hash);
-          Rng1U64 legal_range = r1u64(0, data.size);
-          Rng1U64 read_range = intersect_1u64(range, legal_range);
-          if(read_range.min < read_range.max)
-          {
-            result = 1;
-            MemoryCopy(out, data.str + read_range.min, dim_1u64(read_range));
-          }
+          result = (c_read_from_hash(access, hash, range, out) != 0);
         }
         access_close(access);
       }break;
@@ -2582,7 +2582,7 @@ E_TYPE_EXPAND_RANGE_FUNCTION_DEF(array)
 //~ rjf: (Built-In Type Hooks) `list` lens
 
 internal AC_Artifact
-e_list_gather_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out)
+e_list_gather_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out)
 {
   Temp scratch = scratch_begin(0, 0);
   
@@ -2715,6 +2715,10 @@ e_list_gather_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U
     artifact.u64[0] = (U64)arena;
     artifact.u64[1] = (U64)node_offs;
     artifact.u64[2] = node_offs_count;
+    if(arena != 0)
+    {
+      size_out[0] = arena_pos(arena);
+    }
   }
   
   scratch_end(scratch);
@@ -17,6 +17,7 @@ fs_init(void)
   fs_shared->slots_count = 1024;
   fs_shared->slots = push_array(arena, FS_Slot, fs_shared->slots_count);
   fs_shared->stripes = stripe_array_alloc(arena);
+  fs_shared->watcher = os_file_watcher_alloc();
 }
 
 ////////////////////////////////
@@ -32,7 +33,7 @@ fs_change_gen(void)
 //~ rjf: Cache Interaction
 
 internal AC_Artifact
-fs_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out)
+fs_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out)
 {
   ProfBeginFunction();
   Temp scratch = scratch_begin(0, 0);
@@ -48,6 +49,15 @@ fs_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out
     key_read_off += str8_deserial_read_struct(key, key_read_off, &range);
   }
   
+  //- rjf: watch path's folder for changes - *before* measuring, so that no
+  // modification made after the measurement is missed (changes reported
+  // before this path's node exists are caught by the re-measure below)
+  B32 path_is_watched = 0;
+  if(lane_idx() == 0)
+  {
+    path_is_watched = os_file_watcher_add_file(fs_shared->watcher, path);
+  }
+  
   //- rjf: measure file properties *before* read
   B32 file_is_good = 0;
   FileProperties pre_props = {0};
@@ -58,8 +68,22 @@ fs_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out
   }
   lane_sync_u64(&file_is_good, 0);
   
-  //- rjf: setup output data
+  //- rjf: open file
+  OS_Handle file = {0};
+  if(file_is_good)
+  {
+    if(lane_idx() == 0)
+    {
+      file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead|OS_AccessFlag_ShareWrite, path);
+    }
+    lane_sync_u64(&file, 0);
+  }
+  B32 file_handle_is_valid = !os_handle_match(os_handle_zero(), file);
+  
+  //- rjf: setup output data; large files are mapped, rather than copied
   Arena *data_arena = 0;
+  C_FileMap file_map = {0};
+  B32 data_is_mapped = 0;
   U64 data_buffer_size = 0;
   U8 *data_buffer = 0;
   if(file_is_good)
@@ -68,32 +92,67 @@ fs_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out
     {
       U64 range_size = dim_1u64(range);
       U64 read_size = Min(pre_props.size - range.min, range_size);
-      U64 data_arena_size = read_size+ARENA_HEADER_SIZE;
-      data_arena_size += KB(4)-1;
-      data_arena_size -= data_arena_size%KB(4);
-      data_arena = arena_alloc(.reserve_size = data_arena_size, .commit_size = data_arena_size);
-      data_buffer_size = read_size;
-      data_buffer = push_array_no_zero(data_arena, U8, data_buffer_size);
+      if(file_handle_is_valid && range.min == 0 && read_size >= FS_MAP_SIZE_THRESHOLD &&
+         pre_props.flags & FilePropertyFlag_IsReadOnly)
+      {
+        OS_Handle map = os_file_map_open(OS_AccessFlag_Read, file);
+        void *view = os_file_map_view_open(map, OS_AccessFlag_Read, r1u64(0, read_size));
+        if(view != 0)
+        {
+          file_map.file = file;
+          file_map.map = map;
+          data_is_mapped = 1;
+          data_buffer_size = read_size;
+          data_buffer = (U8 *)view;
+        }
+        else
+        {
+          os_file_map_close(map);
+        }
+      }
+      if(!data_is_mapped)
+      {
+        U64 data_arena_size = read_size+ARENA_HEADER_SIZE;
+        data_arena_size += KB(4)-1;
+        data_arena_size -= data_arena_size%KB(4);
+        data_arena = arena_alloc(.reserve_size = data_arena_size, .commit_size = data_arena_size);
+        data_buffer_size = read_size;
+        data_buffer = push_array_no_zero(data_arena, U8, data_buffer_size);
+      }
     }
+    lane_sync_u64(&data_is_mapped, 0);
     lane_sync_u64(&data_buffer, 0);
     lane_sync_u64(&data_buffer_size, 0);
   }
   
-  //- rjf: open file
-  OS_Handle file = {0};
-  if(file_is_good)
+  //- rjf: mapped -> fault in & hash chunks of the view
+  U64 total_bytes_read = 0;
+  U128 *chunk_hashes = 0;
+  U64 chunk_count = 0;
+  if(file_handle_is_valid && data_is_mapped)
   {
+    chunk_count = (data_buffer_size + C_MAPPED_BLOB_CHUNK_SIZE - 1) / C_MAPPED_BLOB_CHUNK_SIZE;
     if(lane_idx() == 0)
     {
-      file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead|OS_AccessFlag_ShareWrite, path);
+      chunk_hashes = push_array_no_zero(scratch.arena, U128, chunk_count);
     }
-    lane_sync_u64(&file, 0);
+    lane_sync_u64(&chunk_hashes, 0);
+    ProfScope("hash mapped \"%.*s\" [0x%I64x, 0x%I64x)", str8_varg(path), range.min, range.max)
+    {
+      String8 data = str8(data_buffer, data_buffer_size);
+      Rng1U64 lane_chunk_range = lane_range(chunk_count);
+      for EachInRange(chunk_idx, lane_chunk_range)
+      {
+        Rng1U64 chunk_range = r1u64(chunk_idx*C_MAPPED_BLOB_CHUNK_SIZE, (chunk_idx+1)*C_MAPPED_BLOB_CHUNK_SIZE);
+        chunk_hashes[chunk_idx] = u128_hash_from_str8(str8_substr(data, chunk_range));
+      }
+    }
+    lane_sync();
+    total_bytes_read = data_buffer_size;
   }
-  B32 file_handle_is_valid = !os_handle_match(os_handle_zero(), file);
   
-  //- rjf: do read
-  U64 total_bytes_read = 0;
-  if(file_handle_is_valid)
+  //- rjf: not mapped -> do read
+  else if(file_handle_is_valid)
   {
     U64 *total_bytes_read_ptr = 0;
     if(lane_idx() == 0)
@@ -111,8 +170,8 @@ fs_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out
     lane_sync_u64(&total_bytes_read, 0);
   }
   
-  //- rjf: close file
-  if(file_handle_is_valid)
+  //- rjf: close file (mapped files stay open for as long as the view lives)
+  if(file_handle_is_valid && !data_is_mapped)
   {
     if(lane_idx() == 0)
     {
@@ -149,16 +208,36 @@ fs_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out
         retry_out[0] = 1;
         ProfScope("abort")
         {
-          arena_release(data_arena);
+          if(data_is_mapped)
+          {
+            c_file_map_release(&file_map, str8(data_buffer, data_buffer_size));
+          }
+          else
+          {
+            arena_release(data_arena);
+          }
           MemoryZeroStruct(&content_key);
         }
       }
+      else if(data_is_mapped)
+      {
+        ProfScope("submit mapped")
+        {
+          U128 hash = c_hash_from_mapped_chunk_hashes(chunk_hashes, chunk_count);
+          c_submit_mapped_data(content_key, &file_map, str8(data_buffer, data_buffer_size), hash);
+        }
+        
+        // rjf: a mapped view's pages belong to the OS' file cache, which
+        // reclaims them itself - they do not count against the cache budget
+        size_out[0] = 0;
+      }
       else
       {
         ProfScope("submit")
         {
           c_submit_data(content_key, &data_arena, str8(data_buffer, data_buffer_size));
         }
+        size_out[0] = data_buffer_size;
       }
     }
     lane_sync();
@@ -196,9 +275,32 @@ fs_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out
         MemoryZeroStruct(node);
         node->path = str8_copy(stripe->arena, path);
         SLLQueuePush(slot->first, slot->last, node);
+        ins_atomic_u64_inc_eval(&fs_shared->unwatched_node_count);
       }
       node->last_modified_timestamp = pre_props.modified;
       node->size = pre_props.size;
+      if(node->is_watched != path_is_watched)
+      {
+        node->is_watched = path_is_watched;
+        if(path_is_watched)
+        {
+          ins_atomic_u64_dec_eval(&fs_shared->unwatched_node_count);
+        }
+        else
+        {
+          ins_atomic_u64_inc_eval(&fs_shared->unwatched_node_count);
+        }
+      }
+      
+      // rjf: a change notification which arrived after the watch was added,
+      // but before this node existed, was dropped by the async tick - so
+      // re-measure now that the node can receive notifications
+      FileProperties node_props = os_properties_from_file_path(path);
+      if(node_props.modified != pre_props.modified)
+      {
+        node->gen += 1;
+        ins_atomic_u64_inc_eval(&fs_shared->change_gen);
+      }
     }
   }
   lane_sync();
@@ -288,8 +390,61 @@ internal void
 fs_async_tick(void)
 {
   ProfBeginFunction();
+  Temp scratch = scratch_begin(0, 0);
   
-  //- rjf: detect changed timestamps for active paths
+  //- rjf: gather change notifications
+  String8Array changed_paths = {0};
+  B32 rescan = 0;
+  if(lane_idx() == 0)
+  {
+    String8List changed_paths_list = os_file_watcher_changed_paths(scratch.arena, fs_shared->watcher, &rescan);
+    changed_paths = str8_array_from_list(scratch.arena, &changed_paths_list);
+  }
+  lane_sync_u64(&changed_paths.v, 0);
+  lane_sync_u64(&changed_paths.count, 0);
+  lane_sync_u64(&rescan, 0);
+  
+  //- rjf: detect changed timestamps for paths with reported changes
+  {
+    Rng1U64 range = lane_range(changed_paths.count);
+    for EachInRange(idx, range)
+    {
+      String8 path = changed_paths.v[idx];
+      U64 slot_idx = u64_hash_from_str8(path)%fs_shared->slots_count;
+      FS_Slot *slot = &fs_shared->slots[slot_idx];
+      Stripe *stripe = stripe_from_slot_idx(&fs_shared->stripes, slot_idx);
+      FS_Node *node = 0;
+      U64 last_modified_timestamp = 0;
+      RWMutexScope(stripe->rw_mutex, 0)
+      {
+        for(FS_Node *n = slot->first; n != 0; n = n->next)
+        {
+          if(str8_match(n->path, path, 0))
+          {
+            node = n;
+            last_modified_timestamp = n->last_modified_timestamp;
+            break;
+          }
+        }
+      }
+      if(node != 0)
+      {
+        FileProperties props = os_properties_from_file_path(path);
+        if(props.modified != last_modified_timestamp)
+        {
+          RWMutexScope(stripe->rw_mutex, 1)
+          {
+            node->gen += 1;
+            ins_atomic_u64_inc_eval(&fs_shared->change_gen);
+          }
+        }
+      }
+    }
+  }
+  
+  //- rjf: detect changed timestamps for active paths which we can't watch -
+  // or, if change notifications were missed, for all paths (re-watching them)
+  if(rescan || ins_atomic_u64_eval(&fs_shared->unwatched_node_count) != 0)
   {
     Rng1U64 range = lane_range(fs_shared->slots_count);
     for EachInRange(slot_idx, range)
@@ -298,11 +453,31 @@ fs_async_tick(void)
       Stripe *stripe = stripe_from_slot_idx(&fs_shared->stripes, slot_idx);
       for(B32 write_mode = 0; write_mode <= 1; write_mode += 1)
       {
-        B32 found_work = 0;
+        B32 found_work = (rescan && slot->first != 0);
         RWMutexScope(stripe->rw_mutex, write_mode)
         {
-          for(FS_Node *n = slot->first; n != 0; n = n->next)
+          for(FS_Node *n = slot->first; n != 0 && !(rescan && !write_mode); n = n->next)
           {
+            if(!rescan && n->is_watched)
+            {
+              continue;
+            }
+            if(rescan && write_mode)
+            {
+              B32 is_watched = os_file_watcher_add_file(fs_shared->watcher, n->path);
+              if(n->is_watched != is_watched)
+              {
+                n->is_watched = is_watched;
+                if(is_watched)
+                {
+                  ins_atomic_u64_dec_eval(&fs_shared->unwatched_node_count);
+                }
+                else
+                {
+                  ins_atomic_u64_inc_eval(&fs_shared->unwatched_node_count);
+                }
+              }
+            }
             FileProperties props = os_properties_from_file_path(n->path);
             if(props.modified != n->last_modified_timestamp)
             {
@@ -323,5 +498,7 @@ fs_async_tick(void)
     }
   }
   
+  lane_sync();
+  scratch_end(scratch);
   ProfEnd();
 }
@@ -4,6 +4,16 @@
 #ifndef FILE_STREAM_H
 #define FILE_STREAM_H
 
+////////////////////////////////
+//~ rjf: Read Parameters
+
+// NOTE: whole-file reads at least this large, of read-only files, are
+// submitted to the hash store as views of the mapped file, rather than copies
+// of its data. Writable files are always copied: a view of a file which is
+// truncated faults on access, and one which is rewritten in place silently
+// changes the bytes behind its content-addressed hash.
+#define FS_MAP_SIZE_THRESHOLD MB(64)
+
 ////////////////////////////////
 //~ rjf: Path Cache
 
@@ -15,6 +25,7 @@ struct FS_Node
   U64 gen;
   U64 last_modified_timestamp;
   U64 size;
+  B32 is_watched;
 };
 
 typedef struct FS_Slot FS_Slot;
@@ -35,6 +46,10 @@ struct FS_Shared
   U64 slots_count;
   FS_Slot *slots;
   StripeArray stripes;
+  
+  // rjf: change notifications (paths without a watch are polled)
+  OS_Handle watcher;
+  U64 unwatched_node_count;
 };
 
 ////////////////////////////////
@@ -55,7 +70,7 @@ internal U64 fs_change_gen(void);
 ////////////////////////////////
 //~ rjf: Artifact Cache Hooks / Accessing API
 
-internal AC_Artifact fs_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out);
+internal AC_Artifact fs_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out);
 internal void fs_artifact_destroy(AC_Artifact artifact);
 
 internal C_Key fs_key_from_path_range(String8 path, Rng1U64 range, U64 endt_us);
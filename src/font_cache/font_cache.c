@@ -143,14 +143,24 @@ fnt_tag_from_path(String8 path)
   //- rjf: allocate & push new node if we don't have an existing one
   if(existing_node == 0)
   {
-    FP_Handle handle = fp_font_open(path);
+    Temp scratch = scratch_begin(0, 0);
+    FP_Handle handle = {0};
+    FP_Metrics metrics = {0};
+    MutexScope(fnt_state->provider_mutex)
+    {
+      handle = fp_font_open(path);
+      metrics = fp_metrics_from_font(handle);
+    }
+    FileProperties props = os_properties_from_file_path(path);
     FNT_FontHashSlot *slot = &fnt_state->font_hash_table[slot_idx];
     existing_node = push_array(fnt_state->permanent_arena, FNT_FontHashNode, 1);
     existing_node->tag = result;
     existing_node->handle = handle;
-    existing_node->metrics = fp_metrics_from_font(existing_node->handle);
+    existing_node->metrics = metrics;
     existing_node->path = push_str8_copy(fnt_state->permanent_arena, path);
+    existing_node->content_hash = fnt_hash_from_string(push_str8f(scratch.arena, "%S|%I64x|%I64x", path, props.modified, props.size));
     SLLQueuePush_N(slot->first, slot->last, existing_node, hash_next);
+    scratch_end(scratch);
   }
   
   //- rjf: tag result must be zero if this is not a valid font
@@ -200,9 +210,13 @@ fnt_tag_from_static_data_string(String8 *data_ptr)
     FNT_FontHashSlot *slot = &fnt_state->font_hash_table[slot_idx];
     new_node = push_array(fnt_state->permanent_arena, FNT_FontHashNode, 1);
     new_node->tag = result;
-    new_node->handle = fp_font_open_from_static_data_string(data_ptr);
-    new_node->metrics = fp_metrics_from_font(new_node->handle);
+    MutexScope(fnt_state->provider_mutex)
+    {
+      new_node->handle = fp_font_open_from_static_data_string(data_ptr);
+      new_node->metrics = fp_metrics_from_font(new_node->handle);
+    }
     new_node->path = str8_lit("");
+    new_node->content_hash = fnt_hash_from_string(*data_ptr);
     SLLQueuePush_N(slot->first, slot->last, new_node, hash_next);
   }
   
@@ -432,7 +446,8 @@ fnt_atlas_region_release(FNT_Atlas *atlas, Rng2S16 region)
     {
       node->parent->max_free_size[node_corner] = calc_region_size;
     }
-    for(FNT_AtlasRegionNode *p = node->parent; p != 0; p = p->parent)
+    Vec2S16 p_size = v2s16(calc_region_size.x*2, calc_region_size.y*2);
+    for(FNT_AtlasRegionNode *p = node->parent; p != 0; p = p->parent, p_size = v2s16(p_size.x*2, p_size.y*2))
     {
       p->num_allocated_descendants -= 1;
       FNT_AtlasRegionNode *parent = p->parent;
@@ -447,19 +462,476 @@ fnt_atlas_region_release(FNT_Atlas *atlas, Rng2S16 region)
         {
           InvalidPath;
         }
-        parent->max_free_size[p_corner].x = Max(Max(p->max_free_size[Corner_00].x,
-                                                    p->max_free_size[Corner_01].x),
-                                                Max(p->max_free_size[Corner_10].x,
-                                                    p->max_free_size[Corner_11].x));
-        parent->max_free_size[p_corner].y = Max(Max(p->max_free_size[Corner_00].y,
-                                                    p->max_free_size[Corner_01].y),
-                                                Max(p->max_free_size[Corner_10].y,
-                                                    p->max_free_size[Corner_11].y));
+        
+        // rjf: nothing allocated under `p` anymore => all of `p` is free again,
+        // so it can be handed out whole (otherwise released regions could only
+        // ever be reused at their old, smaller granularity)
+        if(p->num_allocated_descendants == 0)
+        {
+          parent->max_free_size[p_corner] = p_size;
+        }
+        else
+        {
+          parent->max_free_size[p_corner].x = Max(Max(p->max_free_size[Corner_00].x,
+                                                      p->max_free_size[Corner_01].x),
+                                                  Max(p->max_free_size[Corner_10].x,
+                                                      p->max_free_size[Corner_11].x));
+          parent->max_free_size[p_corner].y = Max(Max(p->max_free_size[Corner_00].y,
+                                                      p->max_free_size[Corner_01].y),
+                                                  Max(p->max_free_size[Corner_10].y,
+                                                      p->max_free_size[Corner_11].y));
+        }
+      }
+    }
+  }
+}
+
+internal FNT_Atlas *
+fnt_atlas_alloc(Vec2S16 dim)
+{
+  Arena *arena = arena_alloc();
+  FNT_Atlas *atlas = push_array(arena, FNT_Atlas, 1);
+  atlas->arena = arena;
+  atlas->root_dim = dim;
+  atlas->root = push_array(arena, FNT_AtlasRegionNode, 1);
+  atlas->root->max_free_size[Corner_00] =
+    atlas->root->max_free_size[Corner_01] =
+    atlas->root->max_free_size[Corner_10] =
+    atlas->root->max_free_size[Corner_11] = v2s16(dim.x/2, dim.y/2);
+  atlas->texture = r_tex2d_alloc(R_ResourceKind_Dynamic, v2s32((S32)dim.x, (S32)dim.y), R_Tex2DFormat_RGBA8, 0);
+  atlas->alloc_frame_index = fnt_state->frame_index;
+  DLLPushBack(fnt_state->first_atlas, fnt_state->last_atlas, atlas);
+  return atlas;
+}
+
+internal void
+fnt_atlas_release(FNT_Atlas *atlas)
+{
+  //- rjf: drop pending uploads into this atlas
+  {
+    FNT_AtlasUploadNode *first = 0;
+    FNT_AtlasUploadNode *last = 0;
+    for(FNT_AtlasUploadNode *n = fnt_state->first_upload, *next = 0; n != 0; n = next)
+    {
+      next = n->next;
+      if(n->atlas == atlas)
+      {
+        fnt_state->upload_count -= 1;
+      }
+      else
+      {
+        SLLQueuePush(first, last, n);
+      }
+    }
+    fnt_state->first_upload = first;
+    fnt_state->last_upload = last;
+  }
+  
+  //- rjf: release atlas
+  DLLRemove(fnt_state->first_atlas, fnt_state->last_atlas, atlas);
+  r_tex2d_release(atlas->texture);
+  arena_release(atlas->arena);
+}
+
+internal void
+fnt_atlas_upload_push(FNT_Atlas *atlas, Rng2S32 subregion, void *data)
+{
+  U64 data_size = (U64)(subregion.x1 - subregion.x0) * (U64)(subregion.y1 - subregion.y0) * 4;
+  FNT_AtlasUploadNode *n = push_array(fnt_state->upload_arena, FNT_AtlasUploadNode, 1);
+  n->atlas = atlas;
+  n->subregion = subregion;
+  n->data = push_array_no_zero(fnt_state->upload_arena, U8, data_size);
+  MemoryCopy(n->data, data, data_size);
+  SLLQueuePush(fnt_state->first_upload, fnt_state->last_upload, n);
+  fnt_state->upload_count += 1;
+}
+
+internal void
+fnt_atlas_uploads_flush(void)
+{
+  if(fnt_state->upload_count != 0) ProfScope("flush %I64u atlas uploads", fnt_state->upload_count)
+  {
+    // rjf: issue uploads grouped by atlas, so each texture is touched in one burst
+    for(FNT_Atlas *atlas = fnt_state->first_atlas; atlas != 0; atlas = atlas->next)
+    {
+      for(FNT_AtlasUploadNode *n = fnt_state->first_upload; n != 0; n = n->next)
+      {
+        if(n->atlas == atlas)
+        {
+          r_fill_tex2d_region(atlas->texture, n->subregion, n->data);
+        }
       }
     }
+    fnt_state->first_upload = fnt_state->last_upload = 0;
+    fnt_state->upload_count = 0;
+    arena_clear(fnt_state->upload_arena);
   }
 }
 
+////////////////////////////////
+//~ rjf: On-Disk Glyph Cache
+
+internal void
+fnt_disk_folder_trim(void)
+{
+  Temp scratch = scratch_begin(0, 0);
+  
+  //- rjf: gather cache files
+  typedef struct FileNode FileNode;
+  struct FileNode
+  {
+    FileNode *next;
+    String8 path;
+    U64 size;
+    DenseTime modified;
+  };
+  FileNode *first = 0;
+  U64 count = 0;
+  U64 total_size = 0;
+  OS_FileIter *it = os_file_iter_begin(scratch.arena, fnt_state->disk_folder, OS_FileIterFlag_SkipFolders);
+  for(OS_FileInfo info = {0}; os_file_iter_next(scratch.arena, it, &info);)
+  {
+    if(str8_ends_with(info.name, str8_lit(".raddbg_glyphs"), 0))
+    {
+      FileNode *n = push_array(scratch.arena, FileNode, 1);
+      n->path = push_str8f(scratch.arena, "%S/%S", fnt_state->disk_folder, info.name);
+      n->size = info.props.size;
+      n->modified = info.props.modified;
+      SLLStackPush(first, n);
+      count += 1;
+      total_size += n->size;
+    }
+  }
+  os_file_iter_end(it);
+  
+  //- rjf: over the cap -> delete least-recently-written files until under it
+  // (files held open by another instance may fail to delete; skip those)
+  if(total_size > FNT_GLYPH_CACHE_FOLDER_SIZE_MAX)
+  {
+    FileNode **files = push_array(scratch.arena, FileNode *, count);
+    {
+      U64 idx = 0;
+      for(FileNode *n = first; n != 0; n = n->next, idx += 1)
+      {
+        files[idx] = n;
+      }
+    }
+    for(U64 remaining = count; remaining > 0 && total_size > FNT_GLYPH_CACHE_FOLDER_SIZE_MAX; remaining -= 1)
+    {
+      U64 oldest_idx = 0;
+      for(U64 idx = 1; idx < remaining; idx += 1)
+      {
+        if(files[idx]->modified < files[oldest_idx]->modified)
+        {
+          oldest_idx = idx;
+        }
+      }
+      FileNode *oldest = files[oldest_idx];
+      files[oldest_idx] = files[remaining-1];
+      if(os_delete_file_at_path(oldest->path))
+      {
+        total_size -= oldest->size;
+      }
+    }
+  }
+  
+  scratch_end(scratch);
+}
+
+internal U128
+fnt_disk_record_hash(FNT_GlyphCacheRecord *record, String8 string, String8 atlas)
+{
+  Temp scratch = scratch_begin(0, 0);
+  String8List parts = {0};
+  str8_list_push(scratch.arena, &parts, str8_struct(&record->string_size));
+  str8_list_push(scratch.arena, &parts, str8_struct(&record->atlas_dim));
+  str8_list_push(scratch.arena, &parts, str8_struct(&record->advance));
+  str8_list_push(scratch.arena, &parts, string);
+  str8_list_push(scratch.arena, &parts, atlas);
+  U128 hash = fnt_hash_from_string(str8_list_join(scratch.arena, &parts, 0));
+  scratch_end(scratch);
+  return hash;
+}
+
+internal FNT_DiskStyleNode *
+fnt_disk_style_from_raster_key(FNT_RasterKey *key)
+{
+  // NOTE: must be called with fnt_state->disk_mutex held.
+  
+  //- rjf: (font hash, size, flags) -> style hash
+  U128 hash = {0};
+  {
+    F64 size_f64 = key->size;
+    U64 buffer[] =
+    {
+      key->font_hash.u64[0],
+      key->font_hash.u64[1],
+      *(U64 *)(&size_f64),
+      (U64)key->flags,
+    };
+    hash = fnt_hash_from_string(str8((U8 *)buffer, sizeof(buffer)));
+  }
+  
+  //- rjf: find existing style
+  U64 slot_idx = hash.u64[1]%fnt_state->disk_style_slots_count;
+  FNT_DiskStyleNode *style = 0;
+  for(FNT_DiskStyleNode *n = fnt_state->disk_style_slots[slot_idx]; n != 0; n = n->next)
+  {
+    if(u128_match(n->hash, hash))
+    {
+      style = n;
+      break;
+    }
+  }
+  
+  //- rjf: no style? -> build index of this style's cache file
+  if(style == 0) ProfScope("load glyph cache file")
+  {
+    Temp scratch = scratch_begin(0, 0);
+    Arena *arena = fnt_state->disk_arena;
+    style = push_array(arena, FNT_DiskStyleNode, 1);
+    SLLStackPush(fnt_state->disk_style_slots[slot_idx], style);
+    style->hash = hash;
+    style->path = push_str8f(arena, "%S/%016I64x%016I64x_v%I64u.raddbg_glyphs", fnt_state->disk_folder, hash.u64[1], hash.u64[0], (U64)FNT_GLYPH_CACHE_VERSION);
+    style->glyph_slots_count = 1024;
+    style->glyph_slots = push_array(arena, FNT_DiskGlyphNode *, style->glyph_slots_count);
+    
+    //- rjf: missing or empty file -> start it with a header. if another
+    // instance does the same, the second header is skipped as foreign bytes
+    String8 data = os_data_from_file_path(scratch.arena, style->path);
+    if(data.size == 0)
+    {
+      FNT_GlyphCacheHeader new_header = {FNT_GLYPH_CACHE_MAGIC, FNT_GLYPH_CACHE_VERSION};
+      os_append_data_to_file_path(style->path, str8_struct(&new_header));
+      data = os_data_from_file_path(scratch.arena, style->path);
+    }
+    
+    //- rjf: parse records; skip over torn or foreign bytes to the next record
+    // which checks out. never rewrite the file - other instances may be
+    // appending to it.
+    FNT_GlyphCacheHeader header = {0};
+    U64 off = str8_deserial_read_struct(data, 0, &header);
+    B32 header_good = (off == sizeof(header) && header.magic == FNT_GLYPH_CACHE_MAGIC && header.version == FNT_GLYPH_CACHE_VERSION);
+    style->is_writable = (header_good && data.size < FNT_GLYPH_CACHE_FILE_SIZE_MAX);
+    if(header_good)
+    {
+      for(;off + sizeof(FNT_GlyphCacheRecord) <= data.size;)
+      {
+        FNT_GlyphCacheRecord record = {0};
+        str8_deserial_read_struct(data, off, &record);
+        U64 atlas_size = (U64)Max(0, record.atlas_dim.x) * (U64)Max(0, record.atlas_dim.y) * 4;
+        U64 string_off = off + sizeof(record);
+        U64 atlas_off = string_off + record.string_size;
+        B32 record_good = (record.magic == FNT_GLYPH_CACHE_RECORD_MAGIC && atlas_off + atlas_size <= data.size);
+        String8 string = {0};
+        if(record_good)
+        {
+          string = str8_substr(data, r1u64(string_off, atlas_off));
+          String8 atlas = str8_substr(data, r1u64(atlas_off, atlas_off + atlas_size));
+          record_good = u128_match(record.hash, fnt_disk_record_hash(&record, string, atlas));
+        }
+        if(!record_good)
+        {
+          off += 1;
+          continue;
+        }
+        FNT_DiskGlyphNode *glyph = push_array(arena, FNT_DiskGlyphNode, 1);
+        U64 glyph_slot_idx = fnt_little_hash_from_string(5381, string)%style->glyph_slots_count;
+        SLLStackPush(style->glyph_slots[glyph_slot_idx], glyph);
+        glyph->string     = push_str8_copy(arena, string);
+        glyph->atlas_dim  = record.atlas_dim;
+        glyph->advance    = record.advance;
+        glyph->record_off = off;
+        off = atlas_off + atlas_size;
+      }
+    }
+    scratch_end(scratch);
+  }
+  
+  return style;
+}
+
+internal FNT_DiskGlyphNode *
+fnt_disk_glyph_from_style_string(FNT_DiskStyleNode *style, String8 string)
+{
+  // NOTE: must be called with fnt_state->disk_mutex held.
+  FNT_DiskGlyphNode *result = 0;
+  U64 slot_idx = fnt_little_hash_from_string(5381, string)%style->glyph_slots_count;
+  for(FNT_DiskGlyphNode *n = style->glyph_slots[slot_idx]; n != 0; n = n->next)
+  {
+    if(str8_match(n->string, string, 0))
+    {
+      result = n;
+      break;
+    }
+  }
+  return result;
+}
+
+internal B32
+fnt_disk_glyph_read(Arena *arena, FNT_DiskStyleNode *style, FNT_DiskGlyphNode *glyph, void **atlas_out)
+{
+  // NOTE: must be called with fnt_state->disk_mutex held. re-checks the
+  // record's contents, so a bad index entry is a miss, never a wrong glyph.
+  Temp scratch = scratch_begin(&arena, 1);
+  U64 atlas_size = (U64)Max(0, glyph->atlas_dim.x) * (U64)Max(0, glyph->atlas_dim.y) * 4;
+  U64 record_size = sizeof(FNT_GlyphCacheRecord) + glyph->string.size + atlas_size;
+  U8 *record_data = push_array_no_zero(scratch.arena, U8, record_size);
+  OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead|OS_AccessFlag_ShareWrite, style->path);
+  U64 read_size = os_file_read(file, r1u64(glyph->record_off, glyph->record_off + record_size), record_data);
+  os_file_close(file);
+  B32 good = 0;
+  if(read_size == record_size)
+  {
+    FNT_GlyphCacheRecord record = {0};
+    MemoryCopyStruct(&record, (FNT_GlyphCacheRecord *)record_data);
+    String8 string = str8(record_data + sizeof(record), glyph->string.size);
+    String8 atlas = str8(string.str + string.size, atlas_size);
+    good = (record.magic == FNT_GLYPH_CACHE_RECORD_MAGIC &&
+            record.string_size == glyph->string.size &&
+            record.atlas_dim.x == glyph->atlas_dim.x &&
+            record.atlas_dim.y == glyph->atlas_dim.y &&
+            str8_match(string, glyph->string, 0) &&
+            u128_match(record.hash, fnt_disk_record_hash(&record, string, atlas)));
+    if(good)
+    {
+      atlas_out[0] = push_array_no_zero(arena, U8, atlas_size);
+      MemoryCopy(atlas_out[0], atlas.str, atlas_size);
+    }
+  }
+  scratch_end(scratch);
+  return good;
+}
+
+internal void
+fnt_disk_glyph_push(FNT_DiskStyleNode *style, String8 string, Vec2S16 atlas_dim, F32 advance, void *atlas)
+{
+  // NOTE: must be called with fnt_state->disk_mutex held.
+  if(!style->is_writable)
+  {
+    return;
+  }
+  Temp scratch = scratch_begin(0, 0);
+  U64 atlas_size = (U64)Max(0, atlas_dim.x) * (U64)Max(0, atlas_dim.y) * 4;
+  
+  //- rjf: build record
+  FNT_GlyphCacheRecord record = {0};
+  record.magic       = FNT_GLYPH_CACHE_RECORD_MAGIC;
+  record.string_size = (U32)string.size;
+  record.atlas_dim   = atlas_dim;
+  record.advance     = advance;
+  record.hash        = fnt_disk_record_hash(&record, string, str8((U8 *)atlas, atlas_size));
+  String8List parts = {0};
+  str8_list_push(scratch.arena, &parts, str8_struct(&record));
+  str8_list_push(scratch.arena, &parts, string);
+  str8_list_push(scratch.arena, &parts, str8((U8 *)atlas, atlas_size));
+  String8 data = str8_list_join(scratch.arena, &parts, 0);
+  
+  //- rjf: append in one write, at whatever offset the append lands on
+  U64 record_off = 0;
+  B32 good = 0;
+  OS_Handle file = os_file_open(OS_AccessFlag_Write|OS_AccessFlag_Append|OS_AccessFlag_ShareRead|OS_AccessFlag_ShareWrite, style->path);
+  if(!os_handle_match(file, os_handle_zero()))
+  {
+    good = os_file_append(file, data, &record_off);
+    if(record_off + data.size >= FNT_GLYPH_CACHE_FILE_SIZE_MAX)
+    {
+      style->is_writable = 0;
+    }
+    os_file_close(file);
+  }
+  
+  //- rjf: index it
+  if(good)
+  {
+    FNT_DiskGlyphNode *glyph = push_array(fnt_state->disk_arena, FNT_DiskGlyphNode, 1);
+    U64 slot_idx = fnt_little_hash_from_string(5381, string)%style->glyph_slots_count;
+    SLLStackPush(style->glyph_slots[slot_idx], glyph);
+    glyph->string     = push_str8_copy(fnt_state->disk_arena, string);
+    glyph->atlas_dim  = atlas_dim;
+    glyph->advance    = advance;
+    glyph->record_off = record_off;
+  }
+  scratch_end(scratch);
+}
+
+////////////////////////////////
+//~ rjf: Asynchronous Rasterization
+
+internal AC_Artifact
+fnt_raster_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out)
+{
+  ProfBeginFunction();
+  
+  //- rjf: unpack key
+  FNT_RasterKey raster_key = {0};
+  str8_deserial_read_struct(key, 0, &raster_key);
+  String8 string = str8_skip(key, sizeof(raster_key));
+  
+  //- rjf: set up artifact
+  Arena *arena = arena_alloc();
+  FNT_RasterArtifact *artifact = push_array(arena, FNT_RasterArtifact, 1);
+  artifact->arena = arena;
+  
+  //- rjf: try on-disk cache first
+  B32 found_on_disk = 0;
+  FNT_DiskStyleNode *style = 0;
+  MutexScope(fnt_state->disk_mutex)
+  {
+    style = fnt_disk_style_from_raster_key(&raster_key);
+    FNT_DiskGlyphNode *glyph = fnt_disk_glyph_from_style_string(style, string);
+    void *atlas = 0;
+    if(glyph != 0 && fnt_disk_glyph_read(arena, style, glyph, &atlas))
+    {
+      found_on_disk = 1;
+      artifact->atlas_dim = glyph->atlas_dim;
+      artifact->atlas     = atlas;
+      artifact->advance   = glyph->advance;
+    }
+  }
+  
+  //- rjf: not on disk -> rasterize & persist
+  if(!found_on_disk)
+  {
+    FP_RasterFlags fp_flags = 0;
+    if(raster_key.flags & FNT_RasterFlag_Smooth) { fp_flags |= FP_RasterFlag_Smooth; }
+    if(raster_key.flags & FNT_RasterFlag_Hinted) { fp_flags |= FP_RasterFlag_Hinted; }
+    FP_RasterResult raster = {0};
+    MutexScope(fnt_state->provider_mutex)
+    {
+      raster = fp_raster(arena, raster_key.font_handle, raster_key.size, fp_flags, string);
+    }
+    artifact->atlas_dim = raster.atlas_dim;
+    artifact->atlas     = raster.atlas;
+    artifact->advance   = raster.advance;
+    MutexScope(fnt_state->disk_mutex)
+    {
+      fnt_disk_glyph_push(style, string, raster.atlas_dim, raster.advance, raster.atlas);
+    }
+  }
+  
+  //- rjf: bundle
+  size_out[0] = arena_pos(arena);
+  AC_Artifact result = {0};
+  result.u64[0] = (U64)artifact;
+  ProfEnd();
+  return result;
+}
+
+internal void
+fnt_raster_artifact_destroy(AC_Artifact artifact)
+{
+  FNT_RasterArtifact *raster = (FNT_RasterArtifact *)artifact.u64[0];
+  if(raster == 0) { return; }
+  arena_release(raster->arena);
+}
+
+internal B32
+fnt_raster_pending(void)
+{
+  return (fnt_state->raster_pending_count != 0);
+}
+
 ////////////////////////////////
 //~ rjf: Piece Type Functions
 
@@ -551,20 +1023,53 @@ fnt_hash2style_from_tag_size_flags(FNT_Tag tag, F32 size, FNT_RasterFlags flags)
     if(Unlikely(hash2style_node == 0))
     {
       FNT_Metrics metrics = fnt_metrics_from_tag_size(tag, size);
-      hash2style_node = push_array(fnt_state->raster_arena, FNT_Hash2StyleRasterCacheNode, 1);
+      hash2style_node = fnt_state->free_hash2style_node;
+      if(hash2style_node != 0)
+      {
+        // NOTE: evicted styles have no glyphs left, so their direct map
+        // & info slots are already empty & can be reused as-is.
+        SLLStackPop_N(fnt_state->free_hash2style_node, hash_next);
+        FNT_RasterCacheInfo *utf8_class1_direct_map = hash2style_node->utf8_class1_direct_map;
+        U64 hash2info_slots_count = hash2style_node->hash2info_slots_count;
+        FNT_Hash2InfoRasterCacheSlot *hash2info_slots = hash2style_node->hash2info_slots;
+        MemoryZeroStruct(hash2style_node);
+        hash2style_node->utf8_class1_direct_map = utf8_class1_direct_map;
+        hash2style_node->hash2info_slots_count = hash2info_slots_count;
+        hash2style_node->hash2info_slots = hash2info_slots;
+      }
+      else
+      {
+        hash2style_node = push_array(fnt_state->raster_arena, FNT_Hash2StyleRasterCacheNode, 1);
+        hash2style_node->utf8_class1_direct_map = push_array_no_zero(fnt_state->raster_arena, FNT_RasterCacheInfo, 256);
+        hash2style_node->hash2info_slots_count = 1024;
+        hash2style_node->hash2info_slots = push_array(fnt_state->raster_arena, FNT_Hash2InfoRasterCacheSlot, hash2style_node->hash2info_slots_count);
+      }
       DLLPushBack_NP(slot->first, slot->last, hash2style_node, hash_next, hash_prev);
       hash2style_node->style_hash = style_hash;
       hash2style_node->ascent   = metrics.ascent;
       hash2style_node->descent  = metrics.descent;
-      hash2style_node->utf8_class1_direct_map = push_array_no_zero(fnt_state->raster_arena, FNT_RasterCacheInfo, 256);
-      hash2style_node->hash2info_slots_count = 1024;
-      hash2style_node->hash2info_slots = push_array(fnt_state->raster_arena, FNT_Hash2InfoRasterCacheSlot, hash2style_node->hash2info_slots_count);
     }
   }
   
+  //- rjf: touch
+  hash2style_node->last_used_frame_index = fnt_state->frame_index;
+  
   return hash2style_node;
 }
 
+internal void
+fnt_raster_cache_info_release(FNT_RasterCacheInfo *info)
+{
+  FNT_Atlas *atlas = info->atlas;
+  if(atlas != 0)
+  {
+    fnt_atlas_region_release(atlas, info->subrect);
+    atlas->used_area -= (U64)(info->subrect.x1 - info->subrect.x0) * (U64)(info->subrect.y1 - info->subrect.y0);
+    atlas->glyph_count -= 1;
+  }
+  MemoryZeroStruct(info);
+}
+
 internal FNT_Run
 fnt_run_from_string(FNT_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, FNT_RasterFlags flags, String8 string)
 {
@@ -611,6 +1116,8 @@ fnt_run_from_string(FNT_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F
     Vec2F32 dim = {0};
     B32 font_handle_mapped_on_miss = 0;
     FP_Handle font_handle = {0};
+    U128 font_hash = {0};
+    Access *access = 0;
     U64 piece_substring_start_idx = 0;
     U64 piece_substring_end_idx = 0;
     for(U64 idx = 0; idx <= string.size;)
@@ -685,7 +1192,8 @@ fnt_run_from_string(FNT_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F
         }
       }
       
-      //- rjf: no info found -> miss... fill this hash in the cache
+      //- rjf: no info found -> miss... request rasterization on async threads
+      FNT_RasterCacheInfo placeholder_info = {0};
       if(info == 0)
       {
         Temp scratch = scratch_begin(0, 0);
@@ -715,96 +1223,130 @@ fnt_run_from_string(FNT_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F
           if(existing_node != 0)
           {
             font_handle = existing_node->handle;
+            font_hash = existing_node->content_hash;
           }
         }
         
-        // rjf: call into font provider to rasterize this substring
-        FP_RasterResult raster = {0};
+        // rjf: request rasterization of this substring
+        FNT_RasterArtifact *raster = 0;
         if(size > 0)
         {
-          FP_RasterFlags fp_flags = 0;
-          if(flags & FNT_RasterFlag_Smooth) { fp_flags |= FP_RasterFlag_Smooth; }
-          if(flags & FNT_RasterFlag_Hinted) { fp_flags |= FP_RasterFlag_Hinted; }
-          raster = fp_raster(scratch.arena, font_handle, floor_f32(size), flags, piece_substring);
-        }
-        
-        // rjf: allocate portion of an atlas to upload the rasterization
-        S16 chosen_atlas_num = 0;
-        FNT_Atlas *chosen_atlas = 0;
-        Rng2S16 chosen_atlas_region = {0};
-        if(raster.atlas_dim.x != 0 && raster.atlas_dim.y != 0)
-        {
-          U64 num_atlases = 0;
-          for(FNT_Atlas *atlas = fnt_state->first_atlas;; atlas = atlas->next, num_atlases += 1)
+          if(access == 0)
           {
-            // rjf: create atlas if needed
-            if(atlas == 0 && num_atlases < 64)
-            {
-              atlas = push_array(fnt_state->raster_arena, FNT_Atlas, 1);
-              DLLPushBack(fnt_state->first_atlas, fnt_state->last_atlas, atlas);
-              atlas->root_dim = v2s16(1024, 1024);
-              atlas->root = push_array(fnt_state->raster_arena, FNT_AtlasRegionNode, 1);
-              atlas->root->max_free_size[Corner_00] =
-                atlas->root->max_free_size[Corner_01] =
-                atlas->root->max_free_size[Corner_10] =
-                atlas->root->max_free_size[Corner_11] = v2s16(atlas->root_dim.x/2, atlas->root_dim.y/2);
-              atlas->texture = r_tex2d_alloc(R_ResourceKind_Dynamic, v2s32((S32)atlas->root_dim.x, (S32)atlas->root_dim.y), R_Tex2DFormat_RGBA8, 0);
-            }
-            
-            // rjf: allocate from atlas
-            if(atlas != 0)
-            {
-              Vec2S16 needed_dimensions = v2s16(raster.atlas_dim.x + 2, raster.atlas_dim.y + 2);
-              chosen_atlas_region = fnt_atlas_region_alloc(fnt_state->raster_arena, atlas, needed_dimensions);
-              if(chosen_atlas_region.x1 != chosen_atlas_region.x0)
-              {
-                chosen_atlas = atlas;
-                chosen_atlas_num = (S32)num_atlases;
-                break;
-              }
-            }
-            else
-            {
-              break;
-            }
+            access = access_open();
           }
+          FNT_RasterKey raster_key = {font_hash, font_handle, floor_f32(size), flags};
+          String8List key_parts = {0};
+          str8_list_push(scratch.arena, &key_parts, str8_struct(&raster_key));
+          str8_list_push(scratch.arena, &key_parts, piece_substring);
+          String8 key = str8_list_join(scratch.arena, &key_parts, 0);
+          AC_Artifact artifact = ac_artifact_from_key(access, key, fnt_raster_artifact_create, fnt_raster_artifact_destroy, 0);
+          raster = (FNT_RasterArtifact *)artifact.u64[0];
         }
         
-        // rjf: upload rasterization to allocated region of atlas texture memory
-        if(chosen_atlas != 0)
+        // rjf: not ready yet -> use placeholder metrics for this frame; don't
+        // cache anything, so that we pick up the real glyph once it arrives
+        if(size > 0 && raster == 0)
         {
-          Rng2S32 subregion =
+          run_is_cacheable = 0;
+          fnt_state->raster_pending_count += 1;
+          F32 narrow_advance = floor_f32(floor_f32(size) * (96.f/72.f) * 0.5f);
+          if(hash2style_node->utf8_class1_direct_map_mask['H'/64] & (1ull<<('H'%64)))
+          {
+            narrow_advance = hash2style_node->utf8_class1_direct_map['H'].advance;
+          }
+          for(U64 off = 0; off < piece_substring.size;)
           {
-            chosen_atlas_region.x0,
-            chosen_atlas_region.y0,
-            chosen_atlas_region.x0 + raster.atlas_dim.x,
-            chosen_atlas_region.y0 + raster.atlas_dim.y
-          };
-          r_fill_tex2d_region(chosen_atlas->texture, subregion, raster.atlas);
+            UnicodeDecode decode = utf8_decode(piece_substring.str+off, piece_substring.size-off);
+            off += Max(1, decode.inc);
+            placeholder_info.advance += (decode.codepoint >= 0x1100 ? 2*narrow_advance : narrow_advance);
+          }
+          info = &placeholder_info;
         }
         
-        // rjf: allocate & fill & push node
+        // rjf: ready (or nothing to rasterize) -> allocate atlas region, queue upload, fill cache
+        else
         {
-          if(piece_substring.size == 1)
+          Vec2S16 raster_dim = raster ? raster->atlas_dim : v2s16(0, 0);
+          
+          // rjf: allocate portion of an atlas to upload the rasterization
+          FNT_Atlas *chosen_atlas = 0;
+          Rng2S16 chosen_atlas_region = {0};
+          if(raster_dim.x != 0 && raster_dim.y != 0)
           {
-            info = &hash2style_node->utf8_class1_direct_map[piece_substring.str[0]];
-            hash2style_node->utf8_class1_direct_map_mask[piece_substring.str[0]/64] |= (1ull<<(piece_substring.str[0]%64));
+            U64 num_atlases = 0;
+            for(FNT_Atlas *atlas = fnt_state->first_atlas;; atlas = atlas->next, num_atlases += 1)
+            {
+              // rjf: create atlas if needed
+              if(atlas == 0 && num_atlases < 64)
+              {
+                atlas = fnt_atlas_alloc(v2s16(1024, 1024));
+              }
+              
+              // rjf: allocate from atlas
+              if(atlas != 0)
+              {
+                Vec2S16 needed_dimensions = v2s16(raster_dim.x + 2, raster_dim.y + 2);
+                chosen_atlas_region = fnt_atlas_region_alloc(atlas->arena, atlas, needed_dimensions);
+                if(chosen_atlas_region.x1 != chosen_atlas_region.x0)
+                {
+                  chosen_atlas = atlas;
+                  chosen_atlas->used_area += (U64)(chosen_atlas_region.x1 - chosen_atlas_region.x0) * (U64)(chosen_atlas_region.y1 - chosen_atlas_region.y0);
+                  chosen_atlas->glyph_count += 1;
+                  break;
+                }
+              }
+              else
+              {
+                break;
+              }
+            }
           }
-          else
+          
+          // rjf: queue upload of rasterization to allocated region of atlas texture memory
+          if(chosen_atlas != 0)
           {
-            U64 slot_idx = piece_hash%hash2style_node->hash2info_slots_count;
-            FNT_Hash2InfoRasterCacheSlot *slot = &hash2style_node->hash2info_slots[slot_idx];
-            FNT_Hash2InfoRasterCacheNode *node = push_array_no_zero(fnt_state->raster_arena, FNT_Hash2InfoRasterCacheNode, 1);
-            DLLPushBack_NP(slot->first, slot->last, node, hash_next, hash_prev);
-            node->hash = piece_hash;
-            info = &node->info;
+            Rng2S32 subregion =
+            {
+              chosen_atlas_region.x0,
+              chosen_atlas_region.y0,
+              chosen_atlas_region.x0 + raster_dim.x,
+              chosen_atlas_region.y0 + raster_dim.y
+            };
+            fnt_atlas_upload_push(chosen_atlas, subregion, raster->atlas);
           }
-          if(info != 0)
+          
+          // rjf: allocate & fill & push node
           {
-            info->subrect    = chosen_atlas_region;
-            info->atlas_num  = chosen_atlas_num;
-            info->raster_dim = raster.atlas_dim;
-            info->advance    = raster.advance;
+            if(piece_substring.size == 1)
+            {
+              info = &hash2style_node->utf8_class1_direct_map[piece_substring.str[0]];
+              hash2style_node->utf8_class1_direct_map_mask[piece_substring.str[0]/64] |= (1ull<<(piece_substring.str[0]%64));
+            }
+            else
+            {
+              U64 slot_idx = piece_hash%hash2style_node->hash2info_slots_count;
+              FNT_Hash2InfoRasterCacheSlot *slot = &hash2style_node->hash2info_slots[slot_idx];
+              FNT_Hash2InfoRasterCacheNode *node = fnt_state->free_hash2info_node;
+              if(node != 0)
+              {
+                SLLStackPop_N(fnt_state->free_hash2info_node, hash_next);
+              }
+              else
+              {
+                node = push_array_no_zero(fnt_state->raster_arena, FNT_Hash2InfoRasterCacheNode, 1);
+              }
+              DLLPushBack_NP(slot->first, slot->last, node, hash_next, hash_prev);
+              node->hash = piece_hash;
+              info = &node->info;
+            }
+            if(info != 0)
+            {
+              info->atlas      = chosen_atlas;
+              info->subrect    = chosen_atlas_region;
+              info->raster_dim = raster_dim;
+              info->advance    = raster ? raster->advance : 0;
+            }
           }
         }
         
@@ -814,22 +1356,9 @@ fnt_run_from_string(FNT_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F
       //- rjf: push piece for this raster portion
       if(info != 0)
       {
-        // rjf: find atlas
-        FNT_Atlas *atlas = 0;
-        {
-          if(info->subrect.x1 != 0 && info->subrect.y1 != 0)
-          {
-            S32 num = 0;
-            for(FNT_Atlas *a = fnt_state->first_atlas; a != 0; a = a->next, num += 1)
-            {
-              if(info->atlas_num == num)
-              {
-                atlas = a;
-                break;
-              }
-            }
-          }
-        }
+        // rjf: touch & find atlas
+        info->last_used_frame_index = fnt_state->frame_index;
+        FNT_Atlas *atlas = info->atlas;
         
         // rjf: on tabs -> expand advance
         F32 advance = info->advance;
@@ -858,6 +1387,12 @@ fnt_run_from_string(FNT_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F
       }
     }
     
+    //- rjf: release artifacts - anything we needed from them is already copied
+    if(access != 0)
+    {
+      access_close(access);
+    }
+    
     //- rjf: tighten & fill
     {
       if(piece_chunks.node_count == 1)
@@ -1093,6 +1628,20 @@ fnt_init(void)
   fnt_state->permanent_arena = arena;
   fnt_state->raster_arena = arena_alloc();
   fnt_state->frame_arena = arena_alloc();
+  fnt_state->upload_arena = arena_alloc();
+  fnt_state->provider_mutex = mutex_alloc();
+  fnt_state->disk_mutex = mutex_alloc();
+  fnt_state->disk_arena = arena_alloc();
+  fnt_state->disk_style_slots_count = 256;
+  fnt_state->disk_style_slots = push_array(fnt_state->disk_arena, FNT_DiskStyleNode *, fnt_state->disk_style_slots_count);
+  {
+    String8 user_program_data_path = os_get_process_info()->user_program_data_path;
+    String8 raddbg_folder = push_str8f(fnt_state->permanent_arena, "%S/raddbg", user_program_data_path);
+    fnt_state->disk_folder = push_str8f(fnt_state->permanent_arena, "%S/glyph_cache", raddbg_folder);
+    os_make_directory(raddbg_folder);
+    os_make_directory(fnt_state->disk_folder);
+    fnt_disk_folder_trim();
+  }
   fnt_state->font_hash_table_size = 64;
   fnt_state->font_hash_table = push_array(fnt_state->permanent_arena, FNT_FontHashSlot, fnt_state->font_hash_table_size);
   fnt_reset();
@@ -1101,19 +1650,125 @@ fnt_init(void)
 internal void
 fnt_reset(void)
 {
-  for(FNT_Atlas *a = fnt_state->first_atlas; a != 0; a = a->next)
+  for(FNT_Atlas *a = fnt_state->first_atlas, *next = 0; a != 0; a = next)
   {
+    next = a->next;
     r_tex2d_release(a->texture);
+    arena_release(a->arena);
   }
   fnt_state->first_atlas = fnt_state->last_atlas = 0;
+  fnt_state->free_hash2style_node = 0;
+  fnt_state->free_hash2info_node = 0;
+  fnt_state->first_upload = fnt_state->last_upload = 0;
+  fnt_state->upload_count = 0;
+  arena_clear(fnt_state->upload_arena);
   arena_clear(fnt_state->raster_arena);
   fnt_state->hash2style_slots_count = 1024;
   fnt_state->hash2style_slots = push_array(fnt_state->raster_arena, FNT_Hash2StyleRasterCacheSlot, fnt_state->hash2style_slots_count);
 }
 
+internal void
+fnt_evict(void)
+{
+  ProfBeginFunction();
+  U64 frame_index = fnt_state->frame_index;
+  
+  //- rjf: pick the emptiest atlas to compact away, if its glyphs would fit
+  // comfortably in the free space of the others
+  FNT_Atlas *compact_atlas = 0;
+  if(fnt_state->first_atlas != fnt_state->last_atlas)
+  {
+    FNT_Atlas *emptiest = 0;
+    U64 total_free_area = 0;
+    for(FNT_Atlas *a = fnt_state->first_atlas; a != 0; a = a->next)
+    {
+      U64 capacity = (U64)a->root_dim.x * (U64)a->root_dim.y;
+      total_free_area += capacity - a->used_area;
+      if(emptiest == 0 || a->used_area < emptiest->used_area)
+      {
+        emptiest = a;
+      }
+    }
+    U64 capacity = (U64)emptiest->root_dim.x * (U64)emptiest->root_dim.y;
+    U64 other_free_area = total_free_area - (capacity - emptiest->used_area);
+    if(emptiest->alloc_frame_index + FNT_EVICT_AGE_FRAMES < frame_index &&
+       emptiest->used_area*100 < capacity*FNT_COMPACT_OCCUPANCY_PCT &&
+       emptiest->used_area*2 <= other_free_area)
+    {
+      compact_atlas = emptiest;
+    }
+  }
+  
+  //- rjf: evict cold glyphs, glyphs in the compacted atlas, & cold styles
+  for EachIndex(slot_idx, fnt_state->hash2style_slots_count)
+  {
+    FNT_Hash2StyleRasterCacheSlot *slot = &fnt_state->hash2style_slots[slot_idx];
+    for(FNT_Hash2StyleRasterCacheNode *style = slot->first, *next_style = 0; style != 0; style = next_style)
+    {
+      next_style = style->hash_next;
+      B32 style_is_cold = (style->last_used_frame_index + FNT_EVICT_AGE_FRAMES < frame_index);
+      
+      // rjf: direct-mapped glyphs
+      for EachIndex(byte, 256)
+      {
+        if(style->utf8_class1_direct_map_mask[byte/64] & (1ull<<(byte%64)))
+        {
+          FNT_RasterCacheInfo *info = &style->utf8_class1_direct_map[byte];
+          if(style_is_cold ||
+             info->last_used_frame_index + FNT_EVICT_AGE_FRAMES < frame_index ||
+             (compact_atlas != 0 && info->atlas == compact_atlas))
+          {
+            fnt_raster_cache_info_release(info);
+            style->utf8_class1_direct_map_mask[byte/64] &= ~(1ull<<(byte%64));
+          }
+        }
+      }
+      
+      // rjf: hashed glyphs
+      for EachIndex(info_slot_idx, style->hash2info_slots_count)
+      {
+        FNT_Hash2InfoRasterCacheSlot *info_slot = &style->hash2info_slots[info_slot_idx];
+        for(FNT_Hash2InfoRasterCacheNode *n = info_slot->first, *next = 0; n != 0; n = next)
+        {
+          next = n->hash_next;
+          if(style_is_cold ||
+             n->info.last_used_frame_index + FNT_EVICT_AGE_FRAMES < frame_index ||
+             (compact_atlas != 0 && n->info.atlas == compact_atlas))
+          {
+            fnt_raster_cache_info_release(&n->info);
+            DLLRemove_NP(info_slot->first, info_slot->last, n, hash_next, hash_prev);
+            SLLStackPush_N(fnt_state->free_hash2info_node, n, hash_next);
+          }
+        }
+      }
+      
+      // rjf: cold style => recycle node
+      if(style_is_cold)
+      {
+        DLLRemove_NP(slot->first, slot->last, style, hash_next, hash_prev);
+        SLLStackPush_N(fnt_state->free_hash2style_node, style, hash_next);
+      }
+    }
+  }
+  
+  //- rjf: release compacted atlas
+  if(compact_atlas != 0)
+  {
+    fnt_atlas_release(compact_atlas);
+  }
+  
+  ProfEnd();
+}
+
 internal void
 fnt_frame(void)
 {
   fnt_state->frame_index += 1;
+  fnt_state->raster_pending_count = 0;
   arena_clear(fnt_state->frame_arena);
+  if(fnt_state->last_evict_frame_index + FNT_EVICT_PERIOD_FRAMES <= fnt_state->frame_index)
+  {
+    fnt_state->last_evict_frame_index = fnt_state->frame_index;
+    fnt_evict();
+  }
 }
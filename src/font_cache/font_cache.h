@@ -81,6 +81,7 @@ struct FNT_FontHashNode
   FP_Handle handle;
   FP_Metrics metrics;
   String8 path;
+  U128 content_hash;
 };
 
 typedef struct FNT_FontHashSlot FNT_FontHashSlot;
@@ -98,10 +99,11 @@ struct FNT_FontHashSlot
 typedef struct FNT_RasterCacheInfo FNT_RasterCacheInfo;
 struct FNT_RasterCacheInfo
 {
+  struct FNT_Atlas *atlas;
   Rng2S16 subrect;
   Vec2S16 raster_dim;
-  S16 atlas_num;
   F32 advance;
+  U64 last_used_frame_index;
 };
 
 typedef struct FNT_Hash2InfoRasterCacheNode FNT_Hash2InfoRasterCacheNode;
@@ -155,6 +157,7 @@ struct FNT_Hash2StyleRasterCacheNode
   U64 run_slots_count;
   FNT_RunCacheSlot *run_slots;
   U64 run_slots_frame_index;
+  U64 last_used_frame_index;
 };
 
 typedef struct FNT_Hash2StyleRasterCacheSlot FNT_Hash2StyleRasterCacheSlot;
@@ -164,6 +167,94 @@ struct FNT_Hash2StyleRasterCacheSlot
   FNT_Hash2StyleRasterCacheNode *last;
 };
 
+////////////////////////////////
+//~ rjf: Asynchronous Rasterization Types
+//
+// NOTE: glyph rasterization happens on async threads, as artifacts keyed
+// by (font handle, font content hash, size, flags, substring). until a glyph's
+// artifact is ready, runs are built with placeholder metrics for it.
+
+typedef struct FNT_RasterKey FNT_RasterKey;
+struct FNT_RasterKey
+{
+  U128 font_hash;
+  FP_Handle font_handle;
+  F32 size;
+  FNT_RasterFlags flags;
+};
+
+typedef struct FNT_RasterArtifact FNT_RasterArtifact;
+struct FNT_RasterArtifact
+{
+  Arena *arena;
+  Vec2S16 atlas_dim;
+  void *atlas;
+  F32 advance;
+};
+
+////////////////////////////////
+//~ rjf: On-Disk Glyph Cache Types
+//
+// NOTE: one file per (font content hash, size, flags, format version),
+// holding a header followed by appended glyph records:
+//
+//   [FNT_GlyphCacheHeader]
+//   [FNT_GlyphCacheRecord] [string bytes] [atlas_dim.x*atlas_dim.y*4 bytes]
+//   ...
+//
+// several instances may append to the same file at once. each record is
+// appended in one write, and is indexed at the offset that write reports.
+// records carry a hash of their contents, which is checked on every read -
+// torn or foreign bytes are skipped, rather than truncated, since another
+// instance may still be appending. appends stop once a file reaches
+// FNT_GLYPH_CACHE_FILE_SIZE_MAX, and at startup, the least-recently-written
+// files are deleted until the folder is under FNT_GLYPH_CACHE_FOLDER_SIZE_MAX.
+
+#define FNT_GLYPH_CACHE_MAGIC           0x73796c6764646172ull // "raddglys"
+#define FNT_GLYPH_CACHE_RECORD_MAGIC    0x6c796c6764646172ull // "raddglyl"
+#define FNT_GLYPH_CACHE_VERSION         2
+#define FNT_GLYPH_CACHE_FILE_SIZE_MAX   MB(16)
+#define FNT_GLYPH_CACHE_FOLDER_SIZE_MAX MB(128)
+
+typedef struct FNT_GlyphCacheHeader FNT_GlyphCacheHeader;
+struct FNT_GlyphCacheHeader
+{
+  U64 magic;
+  U64 version;
+};
+
+typedef struct FNT_GlyphCacheRecord FNT_GlyphCacheRecord;
+struct FNT_GlyphCacheRecord
+{
+  U64 magic;
+  U128 hash; // of the fields below, the string, & the atlas
+  U32 string_size;
+  Vec2S16 atlas_dim;
+  F32 advance;
+  U32 _pad;
+};
+
+typedef struct FNT_DiskGlyphNode FNT_DiskGlyphNode;
+struct FNT_DiskGlyphNode
+{
+  FNT_DiskGlyphNode *next;
+  String8 string;
+  Vec2S16 atlas_dim;
+  F32 advance;
+  U64 record_off;
+};
+
+typedef struct FNT_DiskStyleNode FNT_DiskStyleNode;
+struct FNT_DiskStyleNode
+{
+  FNT_DiskStyleNode *next;
+  U128 hash;
+  String8 path;
+  B32 is_writable;
+  U64 glyph_slots_count;
+  FNT_DiskGlyphNode **glyph_slots;
+};
+
 ////////////////////////////////
 //~ rjf: Atlas Types
 
@@ -188,11 +279,38 @@ struct FNT_Atlas
 {
   FNT_Atlas *next;
   FNT_Atlas *prev;
+  Arena *arena;
   R_Handle texture;
   Vec2S16 root_dim;
   FNT_AtlasRegionNode *root;
+  U64 used_area;
+  U64 glyph_count;
+  U64 alloc_frame_index;
 };
 
+typedef struct FNT_AtlasUploadNode FNT_AtlasUploadNode;
+struct FNT_AtlasUploadNode
+{
+  FNT_AtlasUploadNode *next;
+  FNT_Atlas *atlas;
+  Rng2S32 subregion;
+  void *data;
+};
+
+////////////////////////////////
+//~ rjf: Eviction & Compaction Constants
+//
+// NOTE: every FNT_EVICT_PERIOD_FRAMES frames, glyphs & styles which have
+// not been drawn for FNT_EVICT_AGE_FRAMES frames have their atlas regions
+// returned to the allocator. in the same pass, if the emptiest atlas is below
+// FNT_COMPACT_OCCUPANCY_PCT occupancy & its glyphs fit in the other atlases'
+// free space, its glyphs are dropped (to be re-packed from the raster
+// artifact / on-disk caches on their next use) & its texture is released.
+
+#define FNT_EVICT_PERIOD_FRAMES   64
+#define FNT_EVICT_AGE_FRAMES      1024
+#define FNT_COMPACT_OCCUPANCY_PCT 25
+
 ////////////////////////////////
 //~ rjf: Metrics
 
@@ -223,10 +341,30 @@ struct FNT_State
   // rjf: hash -> raster cache table
   U64 hash2style_slots_count;
   FNT_Hash2StyleRasterCacheSlot *hash2style_slots;
+  FNT_Hash2StyleRasterCacheNode *free_hash2style_node;
+  FNT_Hash2InfoRasterCacheNode *free_hash2info_node;
+  U64 last_evict_frame_index;
   
   // rjf: atlas list
   FNT_Atlas *first_atlas;
   FNT_Atlas *last_atlas;
+  
+  // rjf: pending atlas uploads (flushed once per frame)
+  Arena *upload_arena;
+  FNT_AtlasUploadNode *first_upload;
+  FNT_AtlasUploadNode *last_upload;
+  U64 upload_count;
+  
+  // rjf: asynchronous rasterization
+  Mutex provider_mutex;
+  U64 raster_pending_count;
+  
+  // rjf: on-disk glyph cache
+  Mutex disk_mutex;
+  Arena *disk_arena;
+  String8 disk_folder;
+  U64 disk_style_slots_count;
+  FNT_DiskStyleNode **disk_style_slots;
 };
 
 ////////////////////////////////
@@ -257,6 +395,27 @@ internal String8 fnt_path_from_tag(FNT_Tag tag);
 
 internal Rng2S16 fnt_atlas_region_alloc(Arena *arena, FNT_Atlas *atlas, Vec2S16 needed_size);
 internal void fnt_atlas_region_release(FNT_Atlas *atlas, Rng2S16 region);
+internal FNT_Atlas *fnt_atlas_alloc(Vec2S16 dim);
+internal void fnt_atlas_release(FNT_Atlas *atlas);
+internal void fnt_atlas_upload_push(FNT_Atlas *atlas, Rng2S32 subregion, void *data);
+internal void fnt_atlas_uploads_flush(void);
+
+////////////////////////////////
+//~ rjf: On-Disk Glyph Cache
+
+internal void fnt_disk_folder_trim(void);
+internal U128 fnt_disk_record_hash(FNT_GlyphCacheRecord *record, String8 string, String8 atlas);
+internal FNT_DiskStyleNode *fnt_disk_style_from_raster_key(FNT_RasterKey *key);
+internal FNT_DiskGlyphNode *fnt_disk_glyph_from_style_string(FNT_DiskStyleNode *style, String8 string);
+internal B32 fnt_disk_glyph_read(Arena *arena, FNT_DiskStyleNode *style, FNT_DiskGlyphNode *glyph, void **atlas_out);
+internal void fnt_disk_glyph_push(FNT_DiskStyleNode *style, String8 string, Vec2S16 atlas_dim, F32 advance, void *atlas);
+
+////////////////////////////////
+//~ rjf: Asynchronous Rasterization
+
+internal AC_Artifact fnt_raster_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out);
+internal void fnt_raster_artifact_destroy(AC_Artifact artifact);
+internal B32 fnt_raster_pending(void);
 
 ////////////////////////////////
 //~ rjf: Piece Type Functions
@@ -271,6 +430,7 @@ internal FNT_PieceArray fnt_piece_array_copy(Arena *arena, FNT_PieceArray *src);
 
 //- rjf: base cache lookups
 internal FNT_Hash2StyleRasterCacheNode *fnt_hash2style_from_tag_size_flags(FNT_Tag tag, F32 size, FNT_RasterFlags flags);
+internal void fnt_raster_cache_info_release(FNT_RasterCacheInfo *info);
 internal FNT_Run fnt_run_from_string(FNT_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, FNT_RasterFlags flags, String8 string);
 
 //- rjf: helpers
@@ -291,6 +451,7 @@ internal F32 fnt_line_height_from_metrics(FNT_Metrics *metrics);
 
 internal void fnt_init(void);
 internal void fnt_reset(void);
+internal void fnt_evict(void);
 internal void fnt_frame(void);
 
 #endif // FONT_CACHE_H
@@ -230,6 +230,10 @@ rdi_section_raw_data_from_kind(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_Sectio
   result = &rdi_nil_element_union;
   *size_out = rdi_section_element_size_table[kind];
 #endif
+  if(rdi->section_fault != 0 && 0 <= kind && kind < rdi->sections_count)
+  {
+    rdi->section_fault(rdi, kind);
+  }
   if(0 <= kind && kind < rdi->sections_count &&
      rdi->sections[kind].off < rdi->raw_data_size)
   {
@@ -286,8 +290,84 @@ rdi_decompressed_size_from_parsed(RDI_Parsed *rdi)
 
 //- decompression
 
+internal RDI_LZBBlock *
+rdi_lzb_blocks_from_section(RDI_Parsed *rdi, RDI_Section *section, U64 *count_out)
+{
+  RDI_LZBBlock *blocks = 0;
+  U64 count = 0;
+  if(section->encoding == RDI_SectionEncoding_LZBBlocks &&
+     sizeof(RDI_U64) <= section->encoded_size &&
+     section->off + section->encoded_size <= rdi->raw_data_size)
+  {
+    U8 *section_base = rdi->raw_data + section->off;
+    U64 block_count = *(RDI_U64 *)section_base;
+    if(block_count <= (section->encoded_size - sizeof(RDI_U64)) / sizeof(RDI_LZBBlock))
+    {
+      blocks = (RDI_LZBBlock *)(section_base + sizeof(RDI_U64));
+      count = block_count;
+    }
+  }
+  *count_out = count;
+  return blocks;
+}
+
+internal U64
+rdi_decompress_block_count_from_section_kind(RDI_Parsed *og_rdi, RDI_SectionKind kind)
+{
+  U64 block_count = 1;
+  if(og_rdi->sections[kind].encoding == RDI_SectionEncoding_LZBBlocks)
+  {
+    rdi_lzb_blocks_from_section(og_rdi, &og_rdi->sections[kind], &block_count);
+  }
+  return block_count;
+}
+
 internal void
-rdi_decompress_parsed(U8 *decompressed_data, U64 decompressed_size, RDI_Parsed *og_rdi)
+rdi_decompress_section_block(RDI_Parsed *og_rdi, RDI_SectionKind kind, U64 block_idx, U8 *dst)
+{
+  RDI_Section *src = &og_rdi->sections[kind];
+  U8 *src_data = (U8 *)og_rdi->raw_data + src->off;
+  switch(src->encoding)
+  {
+    default:{}break;
+    case RDI_SectionEncoding_Unpacked:
+    {
+      MemoryCopy(dst, src_data, Min(src->encoded_size, src->unpacked_size));
+    }break;
+    case RDI_SectionEncoding_LZB:
+    {
+      rr_lzb_simple_decode(src_data, src->encoded_size, dst, src->unpacked_size);
+    }break;
+    case RDI_SectionEncoding_LZBBlocks:
+    {
+      U64 block_count = 0;
+      RDI_LZBBlock *blocks = rdi_lzb_blocks_from_section(og_rdi, src, &block_count);
+      if(block_idx < block_count)
+      {
+        RDI_LZBBlock *block = &blocks[block_idx];
+        if(block->off + block->encoded_size <= src->encoded_size &&
+           block->unpacked_off + block->unpacked_size <= src->unpacked_size)
+        {
+          rr_lzb_simple_decode(src_data + block->off, block->encoded_size,
+                               dst      + block->unpacked_off, block->unpacked_size);
+        }
+      }
+    }break;
+  }
+}
+
+internal void
+rdi_decompress_section(RDI_Parsed *og_rdi, RDI_SectionKind kind, U8 *dst)
+{
+  U64 block_count = rdi_decompress_block_count_from_section_kind(og_rdi, kind);
+  for(U64 block_idx = 0; block_idx < block_count; block_idx += 1)
+  {
+    rdi_decompress_section_block(og_rdi, kind, block_idx, dst);
+  }
+}
+
+internal void
+rdi_decompress_parsed_header(U8 *decompressed_data, U64 decompressed_size, RDI_Parsed *og_rdi)
 {
   // rjf: copy header
   RDI_Header *src_header = (RDI_Header *)og_rdi->raw_data;
@@ -314,22 +394,53 @@ rdi_decompress_parsed(U8 *decompressed_data, U64 decompressed_size, RDI_Parsed *
       off -= off%8;
     }
   }
+}
+
+internal void
+rdi_decompress_parsed(U8 *decompressed_data, U64 decompressed_size, RDI_Parsed *og_rdi)
+{
+  rdi_decompress_parsed_header(decompressed_data, decompressed_size, og_rdi);
   
   // rjf: decompress sections into new decompressed file buffer
-  if(og_rdi->sections_count != 0)
+  RDI_Header *dst_header = (RDI_Header *)decompressed_data;
+  RDI_Section *dst_first = (RDI_Section *)(decompressed_data + dst_header->data_section_off);
+  for(U64 idx = 0; idx < og_rdi->sections_count; idx += 1)
+  {
+    rdi_decompress_section(og_rdi, (RDI_SectionKind)idx, decompressed_data + dst_first[idx].off);
+  }
+}
+
+internal void
+rdi_decompress_parsed_wide(U8 *decompressed_data, U64 decompressed_size, RDI_Parsed *og_rdi)
+{
+  if(lane_idx() == 0)
+  {
+    rdi_decompress_parsed_header(decompressed_data, decompressed_size, og_rdi);
+  }
+  lane_sync();
+  
+  // NOTE: every block of every section is an independent unit of work
+  RDI_Header *dst_header = (RDI_Header *)decompressed_data;
+  RDI_Section *dst_first = (RDI_Section *)(decompressed_data + dst_header->data_section_off);
+  U64 block_count = 0;
+  for(U64 idx = 0; idx < og_rdi->sections_count; idx += 1)
+  {
+    block_count += rdi_decompress_block_count_from_section_kind(og_rdi, (RDI_SectionKind)idx);
+  }
+  Rng1U64 range = lane_range(block_count);
+  U64 section_block_base = 0;
+  for(U64 idx = 0; idx < og_rdi->sections_count && section_block_base < range.max; idx += 1)
   {
-    RDI_Section *src_first = og_rdi->sections;
-    RDI_Section *dst_first = (RDI_Section *)(decompressed_data + dst_header->data_section_off);
-    RDI_Section *src_opl = src_first + og_rdi->sections_count;
-    RDI_Section *dst_opl = dst_first + og_rdi->sections_count;
-    for(RDI_Section *src = src_first, *dst = dst_first;
-        src < src_opl && dst < dst_opl;
-        src += 1, dst += 1)
+    U64 section_block_count = rdi_decompress_block_count_from_section_kind(og_rdi, (RDI_SectionKind)idx);
+    U64 first = Max(range.min, section_block_base);
+    U64 opl = Min(range.max, section_block_base + section_block_count);
+    for(U64 block_idx = first; block_idx < opl; block_idx += 1)
     {
-      rr_lzb_simple_decode((U8*)og_rdi->raw_data + src->off, src->encoded_size,
-                           decompressed_data     + dst->off, dst->unpacked_size);
+      rdi_decompress_section_block(og_rdi, (RDI_SectionKind)idx, block_idx - section_block_base, decompressed_data + dst_first[idx].off);
     }
+    section_block_base += section_block_count;
   }
+  lane_sync();
 }
 
 //- strings
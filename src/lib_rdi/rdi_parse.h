@@ -54,12 +54,18 @@ typedef enum RDI_ParseStatus
 RDI_ParseStatus;
 
 typedef struct RDI_Parsed RDI_Parsed;
+typedef void RDI_SectionFaultFunctionType(RDI_Parsed *rdi, RDI_SectionKind kind);
 struct RDI_Parsed
 {
   RDI_U8 *raw_data;
   RDI_U64 raw_data_size;
   RDI_Section *sections;
   RDI_U64 sections_count;
+  
+  // NOTE: optional; if set, called before a section's data is read, so that
+  // lazily-decompressed parses can decode each section on first access
+  RDI_SectionFaultFunctionType *section_fault;
+  void *section_fault_user_data;
 };
 
 typedef struct RDI_ParsedLineTable RDI_ParsedLineTable;
@@ -152,7 +158,13 @@ RDI_PROC void *rdi_section_raw_element_from_kind_idx(RDI_Parsed *rdi, RDI_Sectio
 RDI_PROC RDI_U64 rdi_decompressed_size_from_parsed(RDI_Parsed *rdi);
 
 //- decompression
+internal RDI_LZBBlock *rdi_lzb_blocks_from_section(RDI_Parsed *rdi, RDI_Section *section, U64 *count_out);
+internal U64 rdi_decompress_block_count_from_section_kind(RDI_Parsed *og_rdi, RDI_SectionKind kind);
+internal void rdi_decompress_section_block(RDI_Parsed *og_rdi, RDI_SectionKind kind, U64 block_idx, U8 *dst);
+internal void rdi_decompress_section(RDI_Parsed *og_rdi, RDI_SectionKind kind, U8 *dst);
+internal void rdi_decompress_parsed_header(U8 *decompressed_data, U64 decompressed_size, RDI_Parsed *og_rdi);
 internal void rdi_decompress_parsed(U8 *decompressed_data, U64 decompressed_size, RDI_Parsed *og_rdi);
+internal void rdi_decompress_parsed_wide(U8 *decompressed_data, U64 decompressed_size, RDI_Parsed *og_rdi);
 
 //- strings
 RDI_PROC RDI_U8 *rdi_string_from_idx(RDI_Parsed *rdi, RDI_U32 idx, RDI_U64 *len_out);
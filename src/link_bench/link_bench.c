@@ -0,0 +1,909 @@
+// Copyright (c) Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+// Build Options
+
+#define BUILD_CONSOLE_INTERFACE 1
+#define BUILD_TITLE "LINK_BENCH"
+
+////////////////////////////////
+
+#include "third_party/xxHash/xxhash.c"
+#include "third_party/xxHash/xxhash.h"
+#include "third_party/radsort/radsort.h"
+
+////////////////////////////////
+
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "coff/coff.h"
+#include "coff/coff_parse.h"
+#include "coff/coff_obj_writer.h"
+#include "coff/coff_lib_writer.h"
+#include "codeview/codeview.h"
+#include "pe/pe.h"
+#include "pe/pe_section_flags.h"
+#include "linker/base_ext/base_core.h"
+#include "linker/base_ext/base_arena.h"
+#include "linker/base_ext/base_arrays.h"
+#include "linker/hash_table.h"
+
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "coff/coff.c"
+#include "coff/coff_parse.c"
+#include "coff/coff_obj_writer.c"
+#include "coff/coff_lib_writer.c"
+#include "codeview/codeview.c"
+#include "pe/pe.c"
+#include "linker/hash_table.c"
+#include "linker/base_ext/base_core.c"
+#include "linker/base_ext/base_arena.c"
+#include "linker/base_ext/base_arrays.c"
+
+////////////////////////////////
+
+typedef enum
+{
+  LB_Phase_Total, // wall clock of the linker process, measured by the benchmark
+  LB_Phase_Image,
+  LB_Phase_Pdb,
+  LB_Phase_Rdi,
+  LB_Phase_Lib,
+  LB_Phase_Debug,
+  LB_Phase_Count
+} LB_Phase;
+
+typedef struct
+{
+  U64 seed;
+  U64 obj_count;
+  U64 func_count;        // COMDAT functions unique to each obj
+  U64 shared_func_count; // COMDAT functions every obj defines, linker keeps one copy
+  U64 reloc_count;       // calls per function
+  U64 type_count;        // structs per obj in .debug$T
+  U64 shared_type_pct;   // percent of structs that are identical across objs
+  U64 member_count;      // fields per struct
+  U64 lib_count;
+  U64 lib_obj_pct;       // percent of objs archived into libs
+  B32 debug_info;
+  B32 rad_debug_info;
+} LB_Workload;
+
+typedef struct
+{
+  U64  worker_count_count;
+  U64 *worker_counts;
+  U64  run_count;
+  U64 *us; // [worker_count_count][LB_Phase_Count][run_count], max_U64 when linker didn't report the phase
+} LB_Report;
+
+global String8 g_linker;
+global String8 g_wdir;
+global String8 g_out = str8_lit_comp("link_bench");
+global B32     g_verbose;
+
+#define LB_RSP_NAME   "bench.rsp"
+#define LB_IMAGE_NAME "bench.exe"
+
+// phases shorter than this are dominated by noise and aren't compared against baseline
+#define LB_MIN_COMPARABLE_US 1000
+
+internal String8
+lb_string_from_phase(LB_Phase phase)
+{
+  switch (phase) {
+  case LB_Phase_Total: return str8_lit("Total");
+  case LB_Phase_Image: return str8_lit("Image");
+  case LB_Phase_Pdb:   return str8_lit("PDB");
+  case LB_Phase_Rdi:   return str8_lit("RDI");
+  case LB_Phase_Lib:   return str8_lit("Lib");
+  case LB_Phase_Debug: return str8_lit("Debug");
+  case LB_Phase_Count: break;
+  }
+  return str8_zero();
+}
+
+internal LB_Phase
+lb_phase_from_string(String8 string)
+{
+  for (U64 phase = 0; phase < LB_Phase_Count; phase += 1) {
+    if (str8_match(lb_string_from_phase(phase), string, StringMatchFlag_CaseInsensitive)) {
+      return phase;
+    }
+  }
+  return LB_Phase_Count;
+}
+
+internal U64 *
+lb_report_runs(LB_Report *report, U64 worker_idx, LB_Phase phase)
+{
+  return report->us + (worker_idx * LB_Phase_Count + phase) * report->run_count;
+}
+
+////////////////////////////////
+// Deterministic Random
+
+internal U64
+lb_rand_u64(U64 *state)
+{
+  // splitmix64
+  *state += 0x9E3779B97F4A7C15ull;
+  U64 z = *state;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+internal U64
+lb_rand_range(U64 *state, U64 count)
+{
+  return count > 0 ? lb_rand_u64(state) % count : 0;
+}
+
+internal U64
+lb_rand_seed(U64 seed, U64 stream, U64 idx)
+{
+  U64 state = seed ^ (stream << 56) ^ idx;
+  return lb_rand_u64(&state);
+}
+
+////////////////////////////////
+// File Helpers
+
+internal String8
+lb_make_file_path(Arena *arena, String8 name)
+{
+  return push_str8f(arena, "%S/%S", g_wdir, name);
+}
+
+internal B32
+lb_write_file(String8 name, String8 data)
+{
+  Temp scratch = scratch_begin(0,0);
+  String8 path = lb_make_file_path(scratch.arena, name);
+  B32 is_written = os_write_data_to_file_path(path, data);
+  if (!is_written) {
+    fprintf(stderr, "ERROR: unable to write \"%.*s\"\n", str8_varg(path));
+  }
+  scratch_end(scratch);
+  return is_written;
+}
+
+////////////////////////////////
+// CodeView Encoding
+
+internal void
+lb_push_leaf_pad(Arena *arena, String8List *srl)
+{
+  // LF_PAD bytes encode number of bytes left to the next record
+  U64 pad_size = AlignPadPow2(srl->total_size, 4);
+  for (U64 i = pad_size; i > 0; i -= 1) {
+    str8_serial_push_u8(arena, srl, (U8)(0xF0 | i));
+  }
+}
+
+internal void
+lb_push_leaf(Arena *arena, String8List *srl, CV_LeafKind kind, String8 data)
+{
+  U64 size = sizeof(kind) + data.size;
+  size += AlignPadPow2(sizeof(U16) + size, 4);
+  str8_serial_push_u16(arena, srl, safe_cast_u16(size));
+  str8_serial_push_u16(arena, srl, kind);
+  str8_serial_push_string(arena, srl, data);
+  lb_push_leaf_pad(arena, srl);
+}
+
+internal void
+lb_push_symbol(Arena *arena, String8List *srl, CV_SymKind kind, String8 data)
+{
+  U64 size = sizeof(kind) + data.size;
+  size += AlignPadPow2(sizeof(U16) + size, 4);
+  str8_serial_push_u16(arena, srl, safe_cast_u16(size));
+  str8_serial_push_u16(arena, srl, kind);
+  str8_serial_push_string(arena, srl, data);
+  str8_serial_push_align(arena, srl, 4);
+}
+
+internal String8
+lb_make_debug_s(Arena *arena, String8List symbols)
+{
+  String8List srl = {0};
+  str8_serial_begin(arena, &srl);
+  str8_serial_push_u32(arena, &srl, CV_Signature_C13);
+  str8_serial_push_u32(arena, &srl, CV_C13SubSectionKind_Symbols);
+  str8_serial_push_u32(arena, &srl, safe_cast_u32(symbols.total_size));
+  str8_list_concat_in_place(&srl, &symbols);
+  return str8_serial_end(arena, &srl);
+}
+
+#define LB_ARGLIST_ITYPE   (CV_MinComplexTypeIndex + 0)
+#define LB_PROCEDURE_ITYPE (CV_MinComplexTypeIndex + 1)
+
+internal String8
+lb_make_debug_t(Arena *arena, LB_Workload *workload, U64 obj_idx)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+
+  String8List srl = {0};
+  str8_serial_begin(scratch.arena, &srl);
+  str8_serial_push_u32(scratch.arena, &srl, CV_Signature_C13);
+
+  // int (void)
+  {
+    CV_LeafArgList arglist = {0};
+    lb_push_leaf(scratch.arena, &srl, CV_LeafKind_ARGLIST, str8_struct(&arglist));
+
+    CV_LeafProcedure proc = {0};
+    proc.ret_itype = CV_BasicType_INT32;
+    proc.arg_itype = LB_ARGLIST_ITYPE;
+    lb_push_leaf(scratch.arena, &srl, CV_LeafKind_PROCEDURE, str8_struct(&proc));
+  }
+
+  U64 shared_type_count = (workload->type_count * workload->shared_type_pct) / 100;
+  U64 member_count      = Min(workload->member_count, 0x7FFF / sizeof(U32));
+  CV_TypeIndex itype    = LB_PROCEDURE_ITYPE + 1;
+  for (U64 type_idx = 0; type_idx < workload->type_count; type_idx += 1) {
+    // shared structs have identical names and layouts in every obj so type merge folds them
+    B32     is_shared = type_idx < shared_type_count;
+    String8 name      = is_shared ? push_str8f(scratch.arena, "Shared%I64u", type_idx) : push_str8f(scratch.arena, "Obj%I64u_Type%I64u", obj_idx, type_idx);
+
+    String8List fields = {0};
+    str8_serial_begin(scratch.arena, &fields);
+    for (U64 member_idx = 0; member_idx < member_count; member_idx += 1) {
+      CV_LeafMember member = {0};
+      member.attribs       = CV_MemberAccess_Public;
+      member.itype         = CV_BasicType_INT32;
+      str8_serial_push_u16(scratch.arena, &fields, CV_LeafKind_MEMBER);
+      str8_serial_push_struct(scratch.arena, &fields, &member);
+      str8_serial_push_u16(scratch.arena, &fields, safe_cast_u16(member_idx * sizeof(U32)));
+      str8_serial_push_cstr(scratch.arena, &fields, push_str8f(scratch.arena, "m%I64u", member_idx));
+      lb_push_leaf_pad(scratch.arena, &fields);
+    }
+    lb_push_leaf(scratch.arena, &srl, CV_LeafKind_FIELDLIST, str8_serial_end(scratch.arena, &fields));
+    CV_TypeIndex field_itype = itype++;
+
+    String8List udt = {0};
+    str8_serial_begin(scratch.arena, &udt);
+    CV_LeafStruct lf_struct = {0};
+    lf_struct.count         = safe_cast_u16(member_count);
+    lf_struct.field_itype   = field_itype;
+    str8_serial_push_struct(scratch.arena, &udt, &lf_struct);
+    str8_serial_push_u16(scratch.arena, &udt, safe_cast_u16(member_count * sizeof(U32)));
+    str8_serial_push_cstr(scratch.arena, &udt, name);
+    lb_push_leaf(scratch.arena, &srl, CV_LeafKind_STRUCTURE, str8_serial_end(scratch.arena, &udt));
+    itype += 1;
+  }
+
+  String8 debug_t = str8_serial_end(arena, &srl);
+  scratch_end(scratch);
+  return debug_t;
+}
+
+////////////////////////////////
+// Workload Generation
+
+// functions are indexed globally: shared functions come first, followed by
+// func_count functions for each obj
+internal U64
+lb_total_func_count(LB_Workload *workload)
+{
+  return workload->shared_func_count + workload->obj_count * workload->func_count;
+}
+
+internal String8
+lb_func_name(Arena *arena, LB_Workload *workload, U64 func_idx)
+{
+  if (func_idx < workload->shared_func_count) {
+    return push_str8f(arena, "shared_%I64u", func_idx);
+  }
+  U64 local_idx = func_idx - workload->shared_func_count;
+  return push_str8f(arena, "obj%I64u_func%I64u", local_idx / workload->func_count, local_idx % workload->func_count);
+}
+
+internal B32
+lb_is_func_defined_in_obj(LB_Workload *workload, U64 func_idx, U64 obj_idx)
+{
+  if (func_idx < workload->shared_func_count) {
+    return 1;
+  }
+  return (func_idx - workload->shared_func_count) / workload->func_count == obj_idx;
+}
+
+internal B32
+lb_is_obj_in_lib(LB_Workload *workload, U64 obj_idx)
+{
+  // entry obj references first function of every obj so all lib members are pulled in
+  U64 lib_obj_count = workload->lib_count ? (workload->obj_count * workload->lib_obj_pct) / 100 : 0;
+  return obj_idx >= workload->obj_count - lib_obj_count;
+}
+
+internal COFF_ObjSymbol *
+lb_func_symbol(COFF_ObjWriter *obj_writer, HashTable *symbol_ht, LB_Workload *workload, U64 func_idx)
+{
+  COFF_ObjSymbol *symbol = hash_table_search_u64_raw(symbol_ht, func_idx);
+  if (symbol == 0) {
+    String8 name = lb_func_name(obj_writer->arena, workload, func_idx);
+    symbol = coff_obj_writer_push_symbol_undef_func(obj_writer, name);
+    hash_table_push_u64_raw(obj_writer->arena, symbol_ht, func_idx, symbol);
+  }
+  return symbol;
+}
+
+internal String8
+lb_make_obj(Arena *arena, LB_Workload *workload, U64 obj_idx)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+
+  COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+  HashTable      *symbol_ht  = hash_table_init(scratch.arena, (workload->func_count + workload->shared_func_count) * 2 + 1);
+
+  // every function is a run of relative calls followed by a ret
+  U64 text_size = workload->reloc_count * 5 + 1;
+  U8 *text      = push_array(scratch.arena, U8, text_size);
+  for (U64 call_idx = 0; call_idx < workload->reloc_count; call_idx += 1) {
+    text[call_idx * 5] = 0xE8; // call rel32
+  }
+  text[text_size - 1] = 0xC3; // ret
+
+  if (workload->debug_info) {
+    String8List symbols = {0};
+    str8_serial_begin(scratch.arena, &symbols);
+    CV_SymObjName objname = {0};
+    String8List objname_data = {0};
+    str8_serial_begin(scratch.arena, &objname_data);
+    str8_serial_push_struct(scratch.arena, &objname_data, &objname);
+    str8_serial_push_cstr(scratch.arena, &objname_data, push_str8f(scratch.arena, "obj%I64u.obj", obj_idx));
+    lb_push_symbol(scratch.arena, &symbols, CV_SymKind_OBJNAME, str8_serial_end(scratch.arena, &objname_data));
+    coff_obj_writer_push_section(obj_writer, str8_lit(".debug$S"), PE_DEBUG_SECTION_FLAGS|COFF_SectionFlag_Align4Bytes, lb_make_debug_s(obj_writer->arena, symbols));
+
+    String8 debug_t = lb_make_debug_t(obj_writer->arena, workload, obj_idx);
+    coff_obj_writer_push_section(obj_writer, str8_lit(".debug$T"), PE_DEBUG_SECTION_FLAGS|COFF_SectionFlag_Align4Bytes, debug_t);
+  }
+
+  // define shared functions and functions owned by this obj
+  U64 local_func_count = workload->shared_func_count + workload->func_count;
+  U64 first_local_func = workload->shared_func_count + obj_idx * workload->func_count;
+  for (U64 i = 0; i < local_func_count; i += 1) {
+    U64 func_idx = i < workload->shared_func_count ? i : first_local_func + (i - workload->shared_func_count);
+
+    COFF_ObjSection *text_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".text$mn"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_LnkCOMDAT|COFF_SectionFlag_Align16Bytes, str8(text, text_size));
+    coff_obj_writer_push_symbol_secdef(obj_writer, text_sect, COFF_ComdatSelect_Any);
+    COFF_ObjSymbol *func_symbol = coff_obj_writer_push_symbol_extern_func(obj_writer, lb_func_name(obj_writer->arena, workload, func_idx), 0, text_sect);
+    hash_table_push_u64_raw(obj_writer->arena, symbol_ht, func_idx, func_symbol);
+
+    if (workload->debug_info) {
+      Temp temp = temp_begin(scratch.arena);
+
+      String8List symbols = {0};
+      str8_serial_begin(temp.arena, &symbols);
+
+      CV_SymProc32 proc = {0};
+      proc.len          = safe_cast_u32(text_size);
+      proc.dbg_end      = safe_cast_u32(text_size - 1);
+      proc.itype        = LB_PROCEDURE_ITYPE;
+      String8List proc_data = {0};
+      str8_serial_begin(temp.arena, &proc_data);
+      str8_serial_push_struct(temp.arena, &proc_data, &proc);
+      str8_serial_push_cstr(temp.arena, &proc_data, func_symbol->name);
+      lb_push_symbol(temp.arena, &symbols, CV_SymKind_GPROC32, str8_serial_end(temp.arena, &proc_data));
+      lb_push_symbol(temp.arena, &symbols, CV_SymKind_END, str8_zero());
+
+      // per-function debug info is associated with its COMDAT and goes away with it
+      String8          debug_s      = lb_make_debug_s(obj_writer->arena, symbols);
+      COFF_ObjSection *debug_s_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".debug$S"), PE_DEBUG_SECTION_FLAGS|COFF_SectionFlag_LnkCOMDAT|COFF_SectionFlag_Align4Bytes, debug_s);
+      coff_obj_writer_push_symbol_associative(obj_writer, debug_s_sect, text_sect);
+
+      U64 proc_off = sizeof(CV_Signature) + sizeof(CV_C13SubSectionHeader) + sizeof(U16)*2;
+      coff_obj_writer_section_push_reloc(obj_writer, debug_s_sect, proc_off + OffsetOf(CV_SymProc32, off), func_symbol, COFF_Reloc_X64_SecRel);
+      coff_obj_writer_section_push_reloc(obj_writer, debug_s_sect, proc_off + OffsetOf(CV_SymProc32, sec), func_symbol, COFF_Reloc_X64_Section);
+
+      temp_end(temp);
+    }
+  }
+
+  // wire up calls, shared functions only call other shared functions so
+  // their copies are identical in every obj
+  U64 total_func_count = lb_total_func_count(workload);
+  U64 text_sect_idx    = 0;
+  for (COFF_ObjSectionNode *sect_n = obj_writer->sect_first; sect_n != 0; sect_n = sect_n->next) {
+    COFF_ObjSection *sect = &sect_n->v;
+    if (!str8_match(sect->name, str8_lit(".text$mn"), 0)) { continue; }
+
+    U64 i        = text_sect_idx++;
+    B32 shared   = i < workload->shared_func_count;
+    U64 func_idx = shared ? i : first_local_func + (i - workload->shared_func_count);
+    U64 rand     = lb_rand_seed(workload->seed, 1, func_idx);
+    for (U64 call_idx = 0; call_idx < workload->reloc_count; call_idx += 1) {
+      U64 target_idx = shared ? lb_rand_range(&rand, workload->shared_func_count) : lb_rand_range(&rand, total_func_count);
+      COFF_ObjSymbol *target = lb_func_symbol(obj_writer, symbol_ht, workload, target_idx);
+      coff_obj_writer_section_push_reloc(obj_writer, sect, call_idx * 5 + 1, target, COFF_Reloc_X64_Rel32);
+    }
+  }
+
+  String8 obj = coff_obj_writer_serialize(arena, obj_writer);
+  coff_obj_writer_release(&obj_writer);
+  scratch_end(scratch);
+  return obj;
+}
+
+internal String8
+lb_make_entry_obj(Arena *arena, LB_Workload *workload)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+
+  U64 text_size = workload->obj_count * 5 + 1;
+  U8 *text      = push_array(scratch.arena, U8, text_size);
+  for (U64 obj_idx = 0; obj_idx < workload->obj_count; obj_idx += 1) {
+    text[obj_idx * 5] = 0xE8; // call rel32
+  }
+  text[text_size - 1] = 0xC3; // ret
+
+  COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+  COFF_ObjSection *text_sect  = coff_obj_writer_push_section(obj_writer, str8_lit(".text"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_Align16Bytes, str8(text, text_size));
+  coff_obj_writer_push_symbol_extern_func(obj_writer, str8_lit("entry"), 0, text_sect);
+  for (U64 obj_idx = 0; obj_idx < workload->obj_count; obj_idx += 1) {
+    if (workload->func_count == 0) { break; }
+    U64             func_idx = workload->shared_func_count + obj_idx * workload->func_count;
+    COFF_ObjSymbol *target   = coff_obj_writer_push_symbol_undef_func(obj_writer, lb_func_name(obj_writer->arena, workload, func_idx));
+    coff_obj_writer_section_push_reloc(obj_writer, text_sect, obj_idx * 5 + 1, target, COFF_Reloc_X64_Rel32);
+  }
+
+  String8 obj = coff_obj_writer_serialize(arena, obj_writer);
+  coff_obj_writer_release(&obj_writer);
+  scratch_end(scratch);
+  return obj;
+}
+
+internal B32
+lb_generate_workload(LB_Workload *workload)
+{
+  Temp scratch = scratch_begin(0,0);
+  B32 is_generated = 0;
+
+  String8List rsp = {0};
+  str8_list_pushf(scratch.arena, &rsp, "entry.obj");
+  if (!lb_write_file(str8_lit("entry.obj"), lb_make_entry_obj(scratch.arena, workload))) { goto exit; }
+
+  COFF_LibWriter **lib_writers = push_array(scratch.arena, COFF_LibWriter *, workload->lib_count);
+  for (U64 lib_idx = 0; lib_idx < workload->lib_count; lib_idx += 1) {
+    lib_writers[lib_idx] = coff_lib_writer_alloc();
+  }
+
+  for (U64 obj_idx = 0; obj_idx < workload->obj_count; obj_idx += 1) {
+    String8 obj_name = push_str8f(scratch.arena, "obj%I64u.obj", obj_idx);
+    if (lb_is_obj_in_lib(workload, obj_idx)) {
+      // lib writer keeps references to member data, so obj has to outlive it
+      COFF_LibWriter *lib_writer = lib_writers[obj_idx % workload->lib_count];
+      coff_lib_writer_push_obj(lib_writer, obj_name, lb_make_obj(scratch.arena, workload, obj_idx));
+    } else {
+      Temp temp = temp_begin(scratch.arena);
+      B32 is_written = lb_write_file(obj_name, lb_make_obj(temp.arena, workload, obj_idx));
+      temp_end(temp);
+      if (!is_written) { goto exit; }
+      str8_list_push(scratch.arena, &rsp, obj_name);
+    }
+  }
+
+  for (U64 lib_idx = 0; lib_idx < workload->lib_count; lib_idx += 1) {
+    String8 lib_name = push_str8f(scratch.arena, "lib%I64u.lib", lib_idx);
+    String8 lib      = coff_lib_writer_serialize(scratch.arena, lib_writers[lib_idx], 0, 0, 1);
+    coff_lib_writer_release(&lib_writers[lib_idx]);
+    if (!lb_write_file(lib_name, lib)) { goto exit; }
+    str8_list_push(scratch.arena, &rsp, lib_name);
+  }
+
+  StringJoin rsp_join = { .sep = str8_lit_comp("\n"), .post = str8_lit_comp("\n") };
+  if (!lb_write_file(str8_lit(LB_RSP_NAME), str8_list_join(scratch.arena, &rsp, &rsp_join))) { goto exit; }
+
+  is_generated = 1;
+exit:;
+  scratch_end(scratch);
+  return is_generated;
+}
+
+////////////////////////////////
+// Linker Invocation
+
+internal int
+lb_invoke_linker(LB_Workload *workload, U64 worker_count, String8 stdout_name, U64 *wall_us_out)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  String8   stdout_path     = lb_make_file_path(scratch.arena, stdout_name);
+  OS_Handle output_redirect = os_file_open(OS_AccessFlag_Write|OS_AccessFlag_ShareRead|OS_AccessFlag_ShareWrite|OS_AccessFlag_Inherited, stdout_path);
+
+  OS_ProcessLaunchParams launch_opts = {0};
+  launch_opts.path                   = g_wdir;
+  launch_opts.inherit_env            = 1;
+  launch_opts.stdout_file            = output_redirect;
+  launch_opts.stderr_file            = output_redirect;
+  str8_list_push (scratch.arena, &launch_opts.cmd_line, g_linker);
+  str8_list_push (scratch.arena, &launch_opts.cmd_line, str8_lit("/nologo"));
+  str8_list_push (scratch.arena, &launch_opts.cmd_line, str8_lit("/subsystem:console"));
+  str8_list_push (scratch.arena, &launch_opts.cmd_line, str8_lit("/entry:entry"));
+  str8_list_push (scratch.arena, &launch_opts.cmd_line, str8_lit("/out:" LB_IMAGE_NAME));
+  str8_list_push (scratch.arena, &launch_opts.cmd_line, str8_lit("/rad_log:timers"));
+  str8_list_pushf(scratch.arena, &launch_opts.cmd_line, "/rad_workers:%I64u", worker_count);
+  if (workload->debug_info) {
+    str8_list_push(scratch.arena, &launch_opts.cmd_line, str8_lit("/debug:full"));
+  }
+  if (workload->rad_debug_info) {
+    str8_list_push(scratch.arena, &launch_opts.cmd_line, str8_lit("/rad_debug"));
+  }
+  str8_list_push(scratch.arena, &launch_opts.cmd_line, str8_lit("@" LB_RSP_NAME));
+
+  if (g_verbose) {
+    String8 full_cmd_line = str8_list_join(scratch.arena, &launch_opts.cmd_line, &(StringJoin){ .sep = str8_lit(" ") });
+    fprintf(stdout, "Command Line: %.*s\n", str8_varg(full_cmd_line));
+  }
+
+  int exit_code = -1;
+  U64 begin_us  = os_now_microseconds();
+  OS_Handle linker_handle = os_process_launch(&launch_opts);
+  if (os_handle_match(linker_handle, os_handle_zero())) {
+    fprintf(stderr, "ERROR: unable to start process: %.*s\n", str8_varg(g_linker));
+  } else {
+    U64 exit_code_u64 = 0;
+    os_process_join(linker_handle, max_U64, &exit_code_u64);
+    os_process_detach(linker_handle);
+    exit_code = (int)exit_code_u64;
+  }
+  *wall_us_out = os_now_microseconds() - begin_us;
+
+  os_file_close(output_redirect);
+  scratch_end(scratch);
+  return exit_code;
+}
+
+// parses "[Nd ]H:M:S:MS ms" produced by string_from_elapsed_time
+internal U64
+lb_us_from_elapsed_time_string(String8 string)
+{
+  Temp scratch = scratch_begin(0,0);
+  U64 days = 0;
+  U64 ms   = 0;
+  String8List tokens = str8_split(scratch.arena, string, (U8 *)" ", 1, 0);
+  for (String8Node *token_n = tokens.first; token_n != 0; token_n = token_n->next) {
+    String8 token = token_n->string;
+    if (str8_match(str8_postfix(token, 1), str8_lit("d"), 0)) {
+      days = u64_from_str8(str8_chop(token, 1), 10);
+    } else if (str8_find_needle(token, 0, str8_lit(":"), 0) < token.size) {
+      String8List parts = str8_split(scratch.arena, token, (U8 *)":", 1, 0);
+      if (parts.node_count == 4) {
+        U64 h   = u64_from_str8(parts.first->string, 10);
+        U64 m   = u64_from_str8(parts.first->next->string, 10);
+        U64 s   = u64_from_str8(parts.first->next->next->string, 10);
+        U64 msc = u64_from_str8(parts.last->string, 10);
+        ms = ((h * 60 + m) * 60 + s) * 1000 + msc;
+      }
+    }
+  }
+  scratch_end(scratch);
+  return (days * 24 * 60 * 60 * 1000 + ms) * 1000;
+}
+
+// picks up per-phase timers from /RAD_LOG:TIMERS output
+internal void
+lb_parse_linker_timers(String8 output, U64 *run_us[LB_Phase_Count], U64 run_idx)
+{
+  Temp scratch = scratch_begin(0,0);
+  String8List lines = str8_split(scratch.arena, output, (U8 *)"\r\n", 2, 0);
+  for (String8Node *line_n = lines.first; line_n != 0; line_n = line_n->next) {
+    String8 line    = str8_skip_chop_whitespace(line_n->string);
+    U64     time_at = str8_find_needle(line, 0, str8_lit(" Time:"), 0);
+    if (time_at >= line.size) { continue; }
+
+    String8  name  = str8_skip_chop_whitespace(str8_prefix(line, time_at));
+    LB_Phase phase = lb_phase_from_string(name);
+    if (phase == LB_Phase_Count || phase == LB_Phase_Total) { continue; }
+
+    String8 value = str8_skip_chop_whitespace(str8_skip(line, time_at + str8_lit(" Time:").size));
+    run_us[phase][run_idx] = lb_us_from_elapsed_time_string(value);
+  }
+  scratch_end(scratch);
+}
+
+////////////////////////////////
+// Report
+
+internal U64
+lb_median_us(U64 *runs, U64 run_count)
+{
+  Temp scratch = scratch_begin(0,0);
+  U64 *sorted = push_array(scratch.arena, U64, run_count);
+  U64  count  = 0;
+  for (U64 i = 0; i < run_count; i += 1) {
+    if (runs[i] == max_U64) { continue; }
+    U64 k = count++;
+    for (; k > 0 && sorted[k-1] > runs[i]; k -= 1) { sorted[k] = sorted[k-1]; }
+    sorted[k] = runs[i];
+  }
+  U64 median = count > 0 ? sorted[count / 2] : max_U64;
+  scratch_end(scratch);
+  return median;
+}
+
+internal String8List
+lb_csv_from_report(Arena *arena, LB_Workload *workload, LB_Report *report)
+{
+  String8List csv = {0};
+  str8_list_pushf(arena, &csv, "# seed=%I64u objs=%I64u funcs=%I64u shared_funcs=%I64u relocs=%I64u types=%I64u shared_types=%I64u members=%I64u libs=%I64u lib_objs=%I64u debug=%u rdi=%u",
+                  workload->seed, workload->obj_count, workload->func_count, workload->shared_func_count, workload->reloc_count,
+                  workload->type_count, workload->shared_type_pct, workload->member_count, workload->lib_count, workload->lib_obj_pct,
+                  workload->debug_info, workload->rad_debug_info);
+  str8_list_pushf(arena, &csv, "workers,phase,run,us");
+  for (U64 worker_idx = 0; worker_idx < report->worker_count_count; worker_idx += 1) {
+    for (U64 phase = 0; phase < LB_Phase_Count; phase += 1) {
+      U64 *runs = lb_report_runs(report, worker_idx, phase);
+      for (U64 run_idx = 0; run_idx < report->run_count; run_idx += 1) {
+        if (runs[run_idx] == max_U64) { continue; }
+        str8_list_pushf(arena, &csv, "%I64u,%S,%I64u,%I64u", report->worker_counts[worker_idx], lb_string_from_phase(phase), run_idx, runs[run_idx]);
+      }
+    }
+  }
+  return csv;
+}
+
+// median of a phase from a previously written report, max_U64 when missing
+internal U64
+lb_median_us_from_csv(String8 csv, U64 worker_count, LB_Phase phase)
+{
+  Temp scratch = scratch_begin(0,0);
+  U64List runs = {0};
+  String8List lines = str8_split(scratch.arena, csv, (U8 *)"\r\n", 2, 0);
+  for (String8Node *line_n = lines.first; line_n != 0; line_n = line_n->next) {
+    String8List fields = str8_split(scratch.arena, line_n->string, (U8 *)",", 1, StringSplitFlag_KeepEmpties);
+    if (fields.node_count != 4)                                                     { continue; }
+    if (!str8_is_integer(fields.first->string, 10))                                 { continue; }
+    if (u64_from_str8(fields.first->string, 10) != worker_count)                    { continue; }
+    if (lb_phase_from_string(fields.first->next->string) != phase)                  { continue; }
+    u64_list_push(scratch.arena, &runs, u64_from_str8(fields.last->string, 10));
+  }
+  U64Array arr    = u64_array_from_list(scratch.arena, &runs);
+  U64      median = lb_median_us(arr.v, arr.count);
+  scratch_end(scratch);
+  return median;
+}
+
+////////////////////////////////
+
+internal U64
+lb_u64_from_opt(CmdLine *cmdline, String8 name, U64 default_value)
+{
+  CmdLineOpt *opt = cmd_line_opt_from_string(cmdline, name);
+  if (opt == 0) {
+    return default_value;
+  }
+  if (opt->value_strings.node_count != 1 || !str8_is_integer(opt->value_string, 10)) {
+    fprintf(stderr, "ERROR: -%.*s expects a number\n", str8_varg(name));
+    os_abort(1);
+  }
+  return u64_from_str8(opt->value_string, 10);
+}
+
+internal void
+entry_point(CmdLine *cmdline)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  //
+  // Handle -help
+  //
+  {
+    B32 print_help = cmd_line_has_flag(cmdline, str8_lit("help")) ||
+                     cmd_line_has_flag(cmdline, str8_lit("h"));
+    if (print_help) {
+      fprintf(stderr, "--- Help -----------------------------------------------------------------------\n");
+      fprintf(stderr, " %s\n\n", BUILD_TITLE_STRING_LITERAL);
+      fprintf(stderr, " Generates a deterministic synthetic workload and times linker over it.\n\n");
+      fprintf(stderr, " Usage: link_bench [Options]\n\n");
+      fprintf(stderr, " Workload Options:\n");
+      fprintf(stderr, "   -seed:#               Seed for the workload generator (default 1)\n");
+      fprintf(stderr, "   -objs:#               Number of objs (default 256)\n");
+      fprintf(stderr, "   -funcs:#              COMDAT functions unique to each obj (default 128)\n");
+      fprintf(stderr, "   -shared_funcs:#       COMDAT functions defined in every obj (default 32)\n");
+      fprintf(stderr, "   -relocs:#             Calls per function (default 8)\n");
+      fprintf(stderr, "   -types:#              Structs per obj in .debug$T (default 64)\n");
+      fprintf(stderr, "   -shared_types:#       Percent of structs identical across objs (default 50)\n");
+      fprintf(stderr, "   -members:#            Fields per struct (default 8)\n");
+      fprintf(stderr, "   -libs:#               Number of libs objs are archived into (default 4)\n");
+      fprintf(stderr, "   -lib_objs:#           Percent of objs archived into libs (default 50)\n");
+      fprintf(stderr, "   -no_debug             Don't emit .debug$S/.debug$T and link without /DEBUG\n");
+      fprintf(stderr, "   -rdi                  Also build RAD debug info\n");
+      fprintf(stderr, "\n");
+      fprintf(stderr, " Run Options:\n");
+      fprintf(stderr, "   -linker:{path}        Path to radlink (default \"radlink\")\n");
+      fprintf(stderr, "   -workers:{#[,#]}      Worker counts to link with (default powers of two up to core count)\n");
+      fprintf(stderr, "   -runs:#               Links per worker count (default 3)\n");
+      fprintf(stderr, "   -out:{path}           Directory for workload and outputs (default \"%.*s\")\n", str8_varg(g_out));
+      fprintf(stderr, "   -report:{path}        Path for CSV report (default \"{out}/report.csv\")\n");
+      fprintf(stderr, "   -baseline:{path}      CSV report to compare against, exit code is number of regressed phases\n");
+      fprintf(stderr, "   -threshold:#          Percent slowdown of a phase median counted as regression (default 10)\n");
+      fprintf(stderr, "   -gen_only             Generate workload and exit\n");
+      fprintf(stderr, "   -verbose              Enable verbose mode\n");
+      fprintf(stderr, "   -help                 Print help menu and exit\n");
+      os_abort(0);
+    }
+  }
+
+  //
+  // Workload Options
+  //
+  LB_Workload workload       = {0};
+  workload.seed              = lb_u64_from_opt(cmdline, str8_lit("seed"),         1);
+  workload.obj_count         = lb_u64_from_opt(cmdline, str8_lit("objs"),         256);
+  workload.func_count        = lb_u64_from_opt(cmdline, str8_lit("funcs"),        128);
+  workload.shared_func_count = lb_u64_from_opt(cmdline, str8_lit("shared_funcs"), 32);
+  workload.reloc_count       = lb_u64_from_opt(cmdline, str8_lit("relocs"),       8);
+  workload.type_count        = lb_u64_from_opt(cmdline, str8_lit("types"),        64);
+  workload.shared_type_pct   = Min(lb_u64_from_opt(cmdline, str8_lit("shared_types"), 50), 100);
+  workload.member_count      = lb_u64_from_opt(cmdline, str8_lit("members"),      8);
+  workload.lib_count         = lb_u64_from_opt(cmdline, str8_lit("libs"),         4);
+  workload.lib_obj_pct       = Min(lb_u64_from_opt(cmdline, str8_lit("lib_objs"), 50), 100);
+  workload.debug_info        = !cmd_line_has_flag(cmdline, str8_lit("no_debug"));
+  workload.rad_debug_info    = cmd_line_has_flag(cmdline, str8_lit("rdi"));
+  if (workload.obj_count == 0 || workload.func_count == 0) {
+    fprintf(stderr, "ERROR: -objs and -funcs must be greater than zero\n");
+    os_abort(1);
+  }
+
+  //
+  // Run Options
+  //
+  g_linker = cmd_line_string(cmdline, str8_lit("linker"));
+  if (g_linker.size == 0) {
+    g_linker = str8_lit("radlink");
+  }
+  {
+    String8 out = cmd_line_string(cmdline, str8_lit("out"));
+    if (out.size) { g_out = out; }
+  }
+  g_verbose = cmd_line_has_flag(cmdline, str8_lit("verbose"));
+
+  U64 run_count = Max(lb_u64_from_opt(cmdline, str8_lit("runs"), 3), 1);
+  U64 threshold = lb_u64_from_opt(cmdline, str8_lit("threshold"), 10);
+
+  U64List worker_counts = {0};
+  {
+    CmdLineOpt *workers_opt = cmd_line_opt_from_string(cmdline, str8_lit("workers"));
+    if (workers_opt) {
+      for (String8Node *value_n = workers_opt->value_strings.first; value_n != 0; value_n = value_n->next) {
+        if (!str8_is_integer(value_n->string, 10) || u64_from_str8(value_n->string, 10) == 0) {
+          fprintf(stderr, "ERROR: invalid worker count \"%.*s\"\n", str8_varg(value_n->string));
+          os_abort(1);
+        }
+        u64_list_push(scratch.arena, &worker_counts, u64_from_str8(value_n->string, 10));
+      }
+    } else {
+      U64 core_count = Max(os_get_system_info()->logical_processor_count, 1);
+      for (U64 worker_count = 1; worker_count < core_count; worker_count *= 2) {
+        u64_list_push(scratch.arena, &worker_counts, worker_count);
+      }
+      u64_list_push(scratch.arena, &worker_counts, core_count);
+    }
+  }
+
+  //
+  // Make Output Directory
+  //
+  os_make_directory(g_out);
+  if (!os_folder_path_exists(g_out)) {
+    fprintf(stderr, "ERROR: unable to create output directory \"%.*s\"\n", str8_varg(g_out));
+    os_abort(1);
+  }
+  g_wdir = os_full_path_from_path(scratch.arena, g_out);
+
+  String8 report_path = cmd_line_string(cmdline, str8_lit("report"));
+  if (report_path.size == 0) {
+    report_path = lb_make_file_path(scratch.arena, str8_lit("report.csv"));
+  }
+
+  //
+  // Generate Workload
+  //
+  {
+    U64 begin_us = os_now_microseconds();
+    if (!lb_generate_workload(&workload)) {
+      fprintf(stderr, "ERROR: unable to generate workload\n");
+      os_abort(1);
+    }
+    String8 msg = push_str8f(scratch.arena, "Generated %I64u objs, %I64u functions in %.3f ms\n", workload.obj_count, lb_total_func_count(&workload), (F64)(os_now_microseconds() - begin_us) / 1000.0);
+    fprintf(stdout, "%.*s", str8_varg(msg));
+  }
+  if (cmd_line_has_flag(cmdline, str8_lit("gen_only"))) {
+    os_abort(0);
+  }
+
+  //
+  // Run Links
+  //
+  LB_Report report          = {0};
+  U64Array  worker_count_arr = u64_array_from_list(scratch.arena, &worker_counts);
+  report.worker_count_count = worker_count_arr.count;
+  report.worker_counts      = worker_count_arr.v;
+  report.run_count          = run_count;
+  report.us                 = push_array_no_zero(scratch.arena, U64, report.worker_count_count * LB_Phase_Count * run_count);
+  MemorySet(report.us, 0xFF, sizeof(report.us[0]) * report.worker_count_count * LB_Phase_Count * run_count);
+
+  for (U64 worker_idx = 0; worker_idx < report.worker_count_count; worker_idx += 1) {
+    U64  worker_count = report.worker_counts[worker_idx];
+    U64 *run_us[LB_Phase_Count];
+    for (U64 phase = 0; phase < LB_Phase_Count; phase += 1) { run_us[phase] = lb_report_runs(&report, worker_idx, phase); }
+
+    for (U64 run_idx = 0; run_idx < run_count; run_idx += 1) {
+      Temp    temp        = temp_begin(scratch.arena);
+      String8 stdout_name = push_str8f(temp.arena, "link_w%I64u_r%I64u.out", worker_count, run_idx);
+      int     exit_code   = lb_invoke_linker(&workload, worker_count, stdout_name, &run_us[LB_Phase_Total][run_idx]);
+      if (exit_code != 0) {
+        fprintf(stderr, "ERROR: linker exited with code %d, see \"%.*s\"\n", exit_code, str8_varg(lb_make_file_path(temp.arena, stdout_name)));
+        os_abort(1);
+      }
+
+      String8 output = os_data_from_file_path(temp.arena, lb_make_file_path(temp.arena, stdout_name));
+      lb_parse_linker_timers(output, run_us, run_idx);
+
+      String8 msg = push_str8f(temp.arena, "[workers %3I64u, run %2I64u/%2I64u] %.3f ms\n", worker_count, run_idx+1, run_count, (F64)run_us[LB_Phase_Total][run_idx] / 1000.0);
+      fprintf(stdout, "%.*s", str8_varg(msg));
+      temp_end(temp);
+    }
+  }
+
+  //
+  // Write Report
+  //
+  {
+    String8List csv      = lb_csv_from_report(scratch.arena, &workload, &report);
+    StringJoin  csv_join = { .sep = str8_lit_comp("\n"), .post = str8_lit_comp("\n") };
+    if (!os_write_data_to_file_path(report_path, str8_list_join(scratch.arena, &csv, &csv_join))) {
+      fprintf(stderr, "ERROR: unable to write report \"%.*s\"\n", str8_varg(report_path));
+    }
+  }
+
+  //
+  // Print Medians and Compare with Baseline
+  //
+  U64 regression_count = 0;
+  {
+    String8 baseline_path = cmd_line_string(cmdline, str8_lit("baseline"));
+    String8 baseline      = str8_zero();
+    if (baseline_path.size) {
+      baseline = os_data_from_file_path(scratch.arena, baseline_path);
+      if (baseline.size == 0) {
+        fprintf(stderr, "ERROR: unable to read baseline \"%.*s\"\n", str8_varg(baseline_path));
+        os_abort(1);
+      }
+    }
+
+    fprintf(stdout, "--- Medians (ms) ---------------------------------------------------------------\n");
+    for (U64 worker_idx = 0; worker_idx < report.worker_count_count; worker_idx += 1) {
+      U64 worker_count = report.worker_counts[worker_idx];
+      for (U64 phase = 0; phase < LB_Phase_Count; phase += 1) {
+        U64 median_us = lb_median_us(lb_report_runs(&report, worker_idx, phase), run_count);
+        if (median_us == max_U64) { continue; }
+
+        String8 phase_name = lb_string_from_phase(phase);
+        String8 msg        = push_str8f(scratch.arena, "  workers %3I64u  %-5.*s %10.3f", worker_count, str8_varg(phase_name), (F64)median_us / 1000.0);
+        fprintf(stdout, "%.*s", str8_varg(msg));
+
+        U64 baseline_us = baseline.size ? lb_median_us_from_csv(baseline, worker_count, phase) : max_U64;
+        if (baseline_us != max_U64 && baseline_us > 0) {
+          F64 delta_pct    = ((F64)median_us - (F64)baseline_us) * 100.0 / (F64)baseline_us;
+          B32 is_regressed = baseline_us >= LB_MIN_COMPARABLE_US && delta_pct > (F64)threshold;
+          fprintf(stdout, "  baseline %10.3f  %+7.2f%%%s", (F64)baseline_us / 1000.0, delta_pct, is_regressed ? "  REGRESSION" : "");
+          regression_count += is_regressed;
+        }
+        fprintf(stdout, "\n");
+      }
+    }
+    fprintf(stdout, "Report: %.*s\n", str8_varg(report_path));
+  }
+
+  if (regression_count) {
+    fflush(stdout);
+    os_abort(regression_count);
+  }
+
+  scratch_end(scratch);
+}
@@ -107,7 +107,9 @@
 #include "lnk_obj.h"
 #include "lnk_lib.h"
 #include "lnk_debug_info.h"
+#include "lnk_order.h"
 #include "lnk.h"
+#include "lnk_incremental.h"
 
 #include "lnk_error.c"
 #include "lnk_log.c"
@@ -121,6 +123,8 @@
 #include "lnk_debug_helper.c"
 #include "lnk_lib.c"
 #include "lnk_debug_info.c"
+#include "lnk_order.c"
+#include "lnk_incremental.c"
 
 // -----------------------------------------------------------------------------
 
@@ -141,6 +145,18 @@ lnk_config_from_argcv(Arena *arena, int argc, char **argv)
   String8List unwrapped_cmd_line = lnk_unwrap_rsp(scratch.arena, raw_cmd_line);
   LNK_CmdLine cmd_line           = lnk_cmd_line_parse_windows_rules(scratch.arena, unwrapped_cmd_line);
 
+  // replay link recorded by /DEBUG:FASTLINK, does not return
+  {
+    LNK_CmdOption *materialize_opt = lnk_cmd_line_option_from_string(cmd_line, lnk_string_from_cmd_switch_type(LNK_CmdSwitch_Rad_MaterializeDebugInfo));
+    if (materialize_opt) {
+      if (materialize_opt->value_strings.node_count != 1) {
+        lnk_error_cmd_switch_invalid_param_count(LNK_Error_Cmdl, 0, LNK_CmdSwitch_Rad_MaterializeDebugInfo);
+      }
+      String8 rfl_path = os_full_path_from_path(scratch.arena, materialize_opt->value_strings.first->string);
+      lnk_materialize_debug_info(str8_cstring(argv[0]), rfl_path, unwrapped_cmd_line);
+    }
+  }
+
   // setup default flags
   lnk_cmd_line_push_option_if_not_presentf(scratch.arena, &cmd_line, LNK_CmdSwitch_Align,     "%u", KB(4));
   lnk_cmd_line_push_option_if_not_presentf(scratch.arena, &cmd_line, LNK_CmdSwitch_Debug,     "none");
@@ -1225,6 +1241,11 @@ lnk_load_objs(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *
   // load obj inputer from disk
   LNK_InputPtrArray new_input_objs = lnk_inputer_flush(arena->v[0], tp, inputer, config->io_flags, &inputer->objs, &inputer->new_objs);
 
+  // link state records objs as they are on disk, hash them before linker patches them in memory
+  if (config->incremental == LNK_SwitchState_Yes) {
+    lnk_hash_inputs(tp, new_input_objs);
+  }
+
   if (lnk_get_log_status(LNK_Log_InputObj) && new_input_objs.count) {
     U64 input_size = 0;
     for EachIndex(i, new_input_objs.count) { input_size += new_input_objs.v[i]->data.size; }
@@ -1273,6 +1294,10 @@ lnk_load_libs(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *
 
     LNK_InputPtrArray new_input_libs = lnk_inputer_flush(arena->v[0], tp, inputer, config->io_flags, &inputer->libs, &inputer->new_libs[input_source]);
 
+    if (config->incremental == LNK_SwitchState_Yes) {
+      lnk_hash_inputs(tp, new_input_libs);
+    }
+
     if (lnk_get_log_status(LNK_Log_InputLib) && new_input_libs.count) {
       U64 input_size = 0;
       for EachIndex(i, new_input_libs.count) { input_size += new_input_libs.v[i]->data.size; }
@@ -2136,6 +2161,13 @@ lnk_link_image(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer
     lnk_opt_ref(tp, symtab, config, link->objs);
   }
 
+  //
+  // fold identical COMDATs
+  //
+  if (config->opt_icf == LNK_SwitchState_Yes) {
+    lnk_opt_icf(tp, arena->v[0], symtab, config, link->objs);
+  }
+
   //
   // infer minimal padding size for functions from the target machine
   //
@@ -2519,6 +2551,422 @@ lnk_resolve_symbol(LNK_SymbolTable *symtab, LNK_ObjSymbolRef symbol, LNK_ObjSymb
   return is_resolved;
 }
 
+internal B32
+lnk_icf_is_group_section(COFF_SectionHeader *section_header)
+{
+  return !(section_header->flags & (COFF_SectionFlag_LnkRemove | COFF_SectionFlag_LnkInfo | LNK_SECTION_FLAG_DEBUG));
+}
+
+internal U32
+lnk_icf_group_idx_from_section_number(LNK_Obj *obj, U32 leader_section_number, U32 section_number)
+{
+  if (section_number == leader_section_number) {
+    return 0;
+  }
+  U32 group_idx = 1;
+  for EachNode(section_number_n, U32Node, obj->associated_sections[leader_section_number]) {
+    COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(obj, section_number_n->data);
+    if (!lnk_icf_is_group_section(section_header)) { continue; }
+    if (section_number_n->data == section_number) {
+      return group_idx;
+    }
+    group_idx += 1;
+  }
+  return max_U32;
+}
+
+internal LNK_ICFReloc
+lnk_icf_reloc_from_coff_reloc(LNK_OptICFTask *task, LNK_Obj *obj, U32 section_number, U32 group_idx, COFF_Reloc *reloc)
+{
+  LNK_ICFReloc result = {0};
+  result.group_idx = group_idx;
+  result.apply_off = reloc->apply_off;
+  result.type      = reloc->type;
+
+  LNK_ObjSymbolRef           symbol        = { .obj = obj, .symbol_idx = reloc->isymbol };
+  COFF_ParsedSymbol          symbol_parsed = lnk_parsed_symbol_from_coff_symbol_idx(obj, reloc->isymbol);
+  COFF_SymbolValueInterpType symbol_interp = coff_interp_from_parsed_symbol(symbol_parsed);
+
+  // relocations against live sections are resolved to the section directly so static
+  // labels keep their offsets, everything else goes through the symbol table
+  LNK_ObjSymbolRef target = {0};
+  if (symbol_interp == COFF_SymbolValueInterp_Regular &&
+      ~lnk_coff_section_header_from_section_number(obj, symbol_parsed.section_number)->flags & COFF_SectionFlag_LnkRemove) {
+    target = symbol;
+  } else if (!lnk_resolve_symbol(task->symtab, symbol, &target)) {
+    result.kind   = LNK_ICFRelocTarget_Symbol;
+    result.target = XXH3_64bits(symbol_parsed.name.str, symbol_parsed.name.size);
+    return result;
+  }
+
+  COFF_ParsedSymbol          target_parsed = lnk_parsed_symbol_from_coff_symbol_idx(target.obj, target.symbol_idx);
+  COFF_SymbolValueInterpType target_interp = coff_interp_from_parsed_symbol(target_parsed);
+  if (target_interp == COFF_SymbolValueInterp_Regular) {
+    U32 target_group_idx = target.obj == obj ? lnk_icf_group_idx_from_section_number(obj, section_number, target_parsed.section_number) : max_U32;
+    U32 candidate_idx    = task->candidate_map[target.obj->input_idx][target_parsed.section_number];
+    result.value = target_parsed.value;
+    if (candidate_idx != max_U32) {
+      result.kind   = LNK_ICFRelocTarget_Candidate;
+      result.target = candidate_idx;
+    } else if (target_group_idx != max_U32) {
+      result.kind   = LNK_ICFRelocTarget_Group;
+      result.target = target_group_idx;
+    } else {
+      result.kind   = LNK_ICFRelocTarget_Section;
+      result.target = Compose64Bit(target.obj->input_idx, target_parsed.section_number);
+    }
+  } else if (target_interp == COFF_SymbolValueInterp_Abs) {
+    result.kind  = LNK_ICFRelocTarget_Abs;
+    result.value = target_parsed.value;
+  } else {
+    result.kind   = LNK_ICFRelocTarget_Symbol;
+    result.target = Compose64Bit(target.obj->input_idx, target.symbol_idx);
+  }
+
+  return result;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_icf_hash_sections_task)
+{
+  LNK_OptICFTask *task  = raw_task;
+  Rng1U64         range = task->ranges[task_id];
+
+  for EachInRange(candidate_idx, range) {
+    LNK_ICFSection *section = &task->sections[candidate_idx];
+    LNK_Obj        *obj     = section->obj;
+    String8         string_table = lnk_coff_string_table_from_obj(obj);
+
+    U32Node group_first = { .data = section->section_number, .next = obj->associated_sections[section->section_number] };
+
+    XXH3_state_t state;
+    XXH3_64bits_reset(&state);
+
+    U32 group_idx    = 0;
+    U32 relocs_count = 0;
+    for EachNode(section_number_n, U32Node, &group_first) {
+      COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(obj, section_number_n->data);
+      if (!lnk_icf_is_group_section(section_header)) { continue; }
+
+      // hash section name, flags and contents
+      String8           name  = coff_name_from_section_header(string_table, section_header);
+      COFF_SectionFlags flags = section_header->flags & ~COFF_SectionFlags_LnkFlags;
+      U64               align = coff_align_size_from_section_flags(section_header->flags);
+      XXH3_64bits_update(&state, name.str, name.size);
+      XXH3_64bits_update(&state, &flags, sizeof(flags));
+      XXH3_64bits_update(&state, &align, sizeof(align));
+      XXH3_64bits_update(&state, &section_header->fsize, sizeof(section_header->fsize));
+      if (~section_header->flags & COFF_SectionFlag_CntUninitializedData) {
+        String8 data = str8_substr(obj->data, rng_1u64(section_header->foff, section_header->foff + section_header->fsize));
+        XXH3_64bits_update(&state, data.str, data.size);
+      }
+
+      // resolve relocation targets and hash everything except classes of other candidates
+      COFF_RelocArray relocs = lnk_coff_relocs_from_section_header(obj, section_header);
+      for EachIndex(reloc_idx, relocs.count) {
+        LNK_ICFReloc *reloc = &section->relocs[relocs_count++];
+        *reloc = lnk_icf_reloc_from_coff_reloc(task, obj, section->section_number, group_idx, &relocs.v[reloc_idx]);
+        XXH3_64bits_update(&state, &reloc->group_idx, sizeof(reloc->group_idx));
+        XXH3_64bits_update(&state, &reloc->apply_off, sizeof(reloc->apply_off));
+        XXH3_64bits_update(&state, &reloc->type,      sizeof(reloc->type));
+        XXH3_64bits_update(&state, &reloc->kind,      sizeof(reloc->kind));
+        XXH3_64bits_update(&state, &reloc->value,     sizeof(reloc->value));
+        if (reloc->kind != LNK_ICFRelocTarget_Candidate) {
+          XXH3_64bits_update(&state, &reloc->target, sizeof(reloc->target));
+        }
+      }
+
+      group_idx += 1;
+    }
+    Assert(relocs_count == section->relocs_count);
+
+    task->classes[candidate_idx] = XXH3_64bits_digest(&state);
+  }
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_icf_propagate_classes_task)
+{
+  LNK_OptICFTask *task  = raw_task;
+  Rng1U64         range = task->ranges[task_id];
+
+  for EachInRange(candidate_idx, range) {
+    LNK_ICFSection *section = &task->sections[candidate_idx];
+
+    XXH3_state_t state;
+    XXH3_64bits_reset(&state);
+    XXH3_64bits_update(&state, &task->classes[candidate_idx], sizeof(task->classes[candidate_idx]));
+    for EachIndex(reloc_idx, section->relocs_count) {
+      LNK_ICFReloc *reloc = &section->relocs[reloc_idx];
+      if (reloc->kind == LNK_ICFRelocTarget_Candidate) {
+        XXH3_64bits_update(&state, &task->classes[reloc->target], sizeof(task->classes[reloc->target]));
+      }
+    }
+
+    task->next_classes[candidate_idx] = XXH3_64bits_digest(&state);
+  }
+}
+
+internal B32
+lnk_icf_sections_are_equal(LNK_OptICFTask *task, LNK_ICFSection *a, LNK_ICFSection *b)
+{
+  if (a->relocs_count != b->relocs_count) { return 0; }
+
+  // compare relocations, candidates are equal when they ended up in the same class
+  for EachIndex(reloc_idx, a->relocs_count) {
+    LNK_ICFReloc *reloc_a = &a->relocs[reloc_idx];
+    LNK_ICFReloc *reloc_b = &b->relocs[reloc_idx];
+    if (reloc_a->group_idx != reloc_b->group_idx) { return 0; }
+    if (reloc_a->apply_off != reloc_b->apply_off) { return 0; }
+    if (reloc_a->type      != reloc_b->type)      { return 0; }
+    if (reloc_a->kind      != reloc_b->kind)      { return 0; }
+    if (reloc_a->value     != reloc_b->value)     { return 0; }
+    if (reloc_a->kind == LNK_ICFRelocTarget_Candidate) {
+      if (task->classes[reloc_a->target] != task->classes[reloc_b->target]) { return 0; }
+    } else {
+      if (reloc_a->target != reloc_b->target) { return 0; }
+    }
+  }
+
+  // compare section headers and contents
+  String8 string_table_a = lnk_coff_string_table_from_obj(a->obj);
+  String8 string_table_b = lnk_coff_string_table_from_obj(b->obj);
+  U32Node group_a        = { .data = a->section_number, .next = a->obj->associated_sections[a->section_number] };
+  U32Node group_b        = { .data = b->section_number, .next = b->obj->associated_sections[b->section_number] };
+  U32Node *node_a = &group_a, *node_b = &group_b;
+  for (;;) {
+    for (; node_a && !lnk_icf_is_group_section(lnk_coff_section_header_from_section_number(a->obj, node_a->data)); node_a = node_a->next);
+    for (; node_b && !lnk_icf_is_group_section(lnk_coff_section_header_from_section_number(b->obj, node_b->data)); node_b = node_b->next);
+    if (node_a == 0 || node_b == 0) { return node_a == node_b; }
+
+    COFF_SectionHeader *header_a = lnk_coff_section_header_from_section_number(a->obj, node_a->data);
+    COFF_SectionHeader *header_b = lnk_coff_section_header_from_section_number(b->obj, node_b->data);
+    if ((header_a->flags & ~LNK_SECTION_FLAG_LIVE & ~LNK_SECTION_FLAG_DEBUG & ~COFF_SectionFlag_LnkCOMDAT) !=
+        (header_b->flags & ~LNK_SECTION_FLAG_LIVE & ~LNK_SECTION_FLAG_DEBUG & ~COFF_SectionFlag_LnkCOMDAT)) {
+      return 0;
+    }
+    if (header_a->fsize != header_b->fsize) { return 0; }
+    if (!str8_match(coff_name_from_section_header(string_table_a, header_a), coff_name_from_section_header(string_table_b, header_b), 0)) { return 0; }
+    if (~header_a->flags & COFF_SectionFlag_CntUninitializedData) {
+      String8 data_a = str8_substr(a->obj->data, rng_1u64(header_a->foff, header_a->foff + header_a->fsize));
+      String8 data_b = str8_substr(b->obj->data, rng_1u64(header_b->foff, header_b->foff + header_b->fsize));
+      if (!str8_match(data_a, data_b, 0)) { return 0; }
+    }
+
+    node_a = node_a->next;
+    node_b = node_b->next;
+  }
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_icf_verify_folds_task)
+{
+  LNK_OptICFTask *task  = raw_task;
+  Rng1U64         range = task->ranges[task_id];
+
+  for EachInRange(candidate_idx, range) {
+    U32 leader_idx = task->fold_leaders[candidate_idx];
+    if (leader_idx == max_U32) { continue; }
+
+    // on the off chance of a hash collision leave section as is
+    if (!lnk_icf_sections_are_equal(task, &task->sections[leader_idx], &task->sections[candidate_idx])) {
+      task->fold_leaders[candidate_idx] = max_U32;
+    }
+  }
+}
+
+internal int
+lnk_icf_class_is_before(void *raw_a, void *raw_b)
+{
+  PairU64 *a = raw_a, *b = raw_b;
+  if (a->v0 == b->v0) {
+    return a->v1 < b->v1;
+  }
+  return a->v0 < b->v0;
+}
+
+internal U64
+lnk_icf_sort_classes(U64 candidates_count, U64 *classes, PairU64 *sorted)
+{
+  ProfBeginFunction();
+  for EachIndex(candidate_idx, candidates_count) {
+    sorted[candidate_idx].v0 = classes[candidate_idx];
+    sorted[candidate_idx].v1 = candidate_idx;
+  }
+  radsort(sorted, candidates_count, lnk_icf_class_is_before);
+
+  U64 class_count = 0;
+  for EachIndex(i, candidates_count) {
+    if (i == 0 || sorted[i-1].v0 != sorted[i].v0) {
+      class_count += 1;
+    }
+  }
+  ProfEnd();
+  return class_count;
+}
+
+internal void
+lnk_opt_icf(TP_Context *tp, Arena *arena, LNK_SymbolTable *symtab, LNK_Config *config, LNK_ObjList objs)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+
+  LNK_Obj **obj_arr = lnk_array_from_obj_list(scratch.arena, objs);
+
+  //
+  // pick sections that are eligible for folding
+  //
+  ProfBegin("Gather Candidates");
+  U64    candidates_count = 0;
+  U64    relocs_count     = 0;
+  U32  **candidate_map    = push_array(scratch.arena, U32 *, objs.count);
+  for EachIndex(obj_idx, objs.count) {
+    LNK_Obj *obj = obj_arr[obj_idx];
+    candidate_map[obj_idx] = push_array_no_zero(scratch.arena, U32, obj->header.section_count_no_null + 1);
+    MemorySet(candidate_map[obj_idx], 0xff, sizeof(candidate_map[obj_idx][0]) * (obj->header.section_count_no_null + 1));
+
+    for EachIndex(sect_idx, obj->header.section_count_no_null) {
+      U32                 section_number = sect_idx+1;
+      COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(obj, section_number);
+
+      if (~section_header->flags & COFF_SectionFlag_LnkCOMDAT)             { continue; }
+      if (section_header->flags & COFF_SectionFlag_LnkRemove)              { continue; }
+      if (section_header->flags & COFF_SectionFlag_LnkInfo)                { continue; }
+      if (section_header->flags & LNK_SECTION_FLAG_DEBUG)                  { continue; }
+      if (section_header->flags & COFF_SectionFlag_MemWrite)               { continue; }
+      if (section_header->flags & COFF_SectionFlag_CntUninitializedData)   { continue; }
+      if (section_header->fsize == 0)                                      { continue; }
+
+      // associative sections are folded together with their parent
+      COFF_ComdatSelectType select;
+      if (lnk_try_comdat_props_from_section_number(obj, section_number, &select, 0, 0, 0)) {
+        if (select == COFF_ComdatSelect_Associative) { continue; }
+      }
+
+      candidate_map[obj_idx][section_number] = safe_cast_u32(candidates_count);
+      candidates_count += 1;
+    }
+  }
+
+  LNK_ICFSection *sections = push_array(scratch.arena, LNK_ICFSection, candidates_count);
+  for EachIndex(obj_idx, objs.count) {
+    LNK_Obj *obj = obj_arr[obj_idx];
+    for EachIndex(sect_idx, obj->header.section_count_no_null) {
+      U32 section_number = sect_idx+1;
+      U32 candidate_idx  = candidate_map[obj_idx][section_number];
+      if (candidate_idx == max_U32) { continue; }
+
+      LNK_ICFSection *section = &sections[candidate_idx];
+      section->obj            = obj;
+      section->section_number = section_number;
+
+      U32Node group_first = { .data = section_number, .next = obj->associated_sections[section_number] };
+      for EachNode(section_number_n, U32Node, &group_first) {
+        COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(obj, section_number_n->data);
+        if (!lnk_icf_is_group_section(section_header)) { continue; }
+        section->relocs_count += lnk_coff_relocs_from_section_header(obj, section_header).count;
+      }
+      relocs_count += section->relocs_count;
+    }
+  }
+
+  LNK_ICFReloc *relocs = push_array_no_zero(scratch.arena, LNK_ICFReloc, relocs_count);
+  for (U64 candidate_idx = 0, cursor = 0; candidate_idx < candidates_count; candidate_idx += 1) {
+    sections[candidate_idx].relocs = relocs + cursor;
+    cursor += sections[candidate_idx].relocs_count;
+  }
+  ProfEnd();
+
+  if (candidates_count > 1) {
+    LNK_OptICFTask task = {0};
+    task.symtab         = symtab;
+    task.candidate_map  = candidate_map;
+    task.sections       = sections;
+    task.ranges         = tp_divide_work(scratch.arena, candidates_count, tp->worker_count);
+    task.classes        = push_array_no_zero(scratch.arena, U64, candidates_count);
+    task.next_classes   = push_array_no_zero(scratch.arena, U64, candidates_count);
+    task.fold_leaders   = push_array_no_zero(scratch.arena, U32, candidates_count);
+
+    //
+    // initial classes from section contents and relocations
+    //
+    tp_for_parallel_prof(tp, 0, tp->worker_count, lnk_icf_hash_sections_task, &task, "Hash Sections");
+
+    //
+    // refine classes with classes of relocation targets until partition stops changing
+    //
+    PairU64 *sorted      = push_array_no_zero(scratch.arena, PairU64, candidates_count);
+    U64      class_count = lnk_icf_sort_classes(candidates_count, task.classes, sorted);
+    U64      iter_count  = 0;
+    for (;;) {
+      if (config->opt_iter_count > 0 && iter_count >= config->opt_iter_count) { break; }
+
+      tp_for_parallel_prof(tp, 0, tp->worker_count, lnk_icf_propagate_classes_task, &task, "Propagate Classes");
+      Swap(U64 *, task.classes, task.next_classes);
+      iter_count += 1;
+
+      U64 new_class_count = lnk_icf_sort_classes(candidates_count, task.classes, sorted);
+      if (new_class_count == class_count) { break; }
+      class_count = new_class_count;
+    }
+
+    //
+    // pick leader for each class, lowest input index wins to keep output deterministic
+    //
+    ProfBegin("Pick Leaders");
+    for (U64 run_start = 0; run_start < candidates_count; ) {
+      U64 run_end = run_start + 1;
+      for (; run_end < candidates_count && sorted[run_end].v0 == sorted[run_start].v0; run_end += 1);
+      task.fold_leaders[sorted[run_start].v1] = max_U32;
+      for (U64 i = run_start + 1; i < run_end; i += 1) {
+        task.fold_leaders[sorted[i].v1] = safe_cast_u32(sorted[run_start].v1);
+      }
+      run_start = run_end;
+    }
+    ProfEnd();
+
+    tp_for_parallel_prof(tp, 0, tp->worker_count, lnk_icf_verify_folds_task, &task, "Verify Folds");
+
+    //
+    // fold sections into leaders
+    //
+    ProfBegin("Fold Sections");
+    U64 fold_count = 0;
+    U64 fold_size  = 0;
+    for EachIndex(candidate_idx, candidates_count) {
+      U32 leader_idx = task.fold_leaders[candidate_idx];
+      if (leader_idx == max_U32) { continue; }
+
+      LNK_ICFSection *section = &sections[candidate_idx];
+      LNK_ICFSection *leader  = &sections[leader_idx];
+      LNK_Obj        *obj     = section->obj;
+
+      if (obj->folds == 0) {
+        obj->folds = push_array(arena, LNK_SectionFold, obj->header.section_count_no_null + 1);
+      }
+      obj->folds[section->section_number].obj            = leader->obj;
+      obj->folds[section->section_number].section_number = leader->section_number;
+
+      // folded section and its associates are replaced with leader's
+      COFF_SectionHeader *section_header = lnk_coff_section_header_from_section_number(obj, section->section_number);
+      section_header->flags |= COFF_SectionFlag_LnkRemove;
+      for EachNode(section_number_n, U32Node, obj->associated_sections[section->section_number]) {
+        COFF_SectionHeader *associated_header = lnk_coff_section_header_from_section_number(obj, section_number_n->data);
+        associated_header->flags |= COFF_SectionFlag_LnkRemove;
+      }
+
+      fold_count += 1;
+      fold_size  += section_header->fsize;
+    }
+    ProfEnd();
+
+    lnk_log(LNK_Log_LinkStats, "[ICF Folded %llu Sections (%M) in %llu Iterations]", fold_count, fold_size, iter_count);
+  }
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
 internal
 THREAD_POOL_TASK_FUNC(lnk_gather_section_definitions_task)
 {
@@ -2616,6 +3064,24 @@ THREAD_POOL_TASK_FUNC(lnk_gather_section_contribs_task)
   scratch_end(scratch);
 }
 
+internal
+THREAD_POOL_TASK_FUNC(lnk_set_folded_contribs_task)
+{
+  LNK_BuildImageTask *task    = raw_task;
+  U64                 obj_idx = task_id;
+  LNK_Obj            *obj     = task->objs[obj_idx];
+
+  if (obj->folds) {
+    ProfBeginV("Set Folded Section Contribs [%S]", obj->path);
+    for EachIndex(sect_idx, obj->header.section_count_no_null) {
+      LNK_SectionFold *fold = &obj->folds[sect_idx+1];
+      if (fold->obj == 0) { continue; }
+      task->sect_map[obj_idx][sect_idx] = task->sect_map[fold->obj->input_idx][fold->section_number - 1];
+    }
+    ProfEnd();
+  }
+}
+
 internal
 THREAD_POOL_TASK_FUNC(lnk_set_comdat_leaders_contribs_task)
 {
@@ -2732,6 +3198,9 @@ THREAD_POOL_TASK_FUNC(lnk_sort_contribs_task)
   LNK_SectionContribChunk *chunk = task->u.sort_contribs.chunks[task_id];
   ProfBeginV("[%llu]", chunk->count);
   radsort(chunk->v, chunk->count, lnk_section_contrib_ptr_is_before);
+  if (task->u.sort_contribs.ranks) {
+    lnk_order_section_contribs(chunk, task->u.sort_contribs.ranks);
+  }
   ProfEnd();
 }
 
@@ -2975,115 +3444,141 @@ lnk_compute_win32_image_header_size(LNK_Config *config, U64 sect_count)
   return image_header_size;
 }
 
-internal
-THREAD_POOL_TASK_FUNC(lnk_obj_reloc_patcher)
+internal void
+lnk_patch_section_relocs(LNK_ObjRelocPatcher *task, LNK_Obj *obj, U64 sect_idx)
 {
-  ProfBeginFunction();
-
-  LNK_ObjRelocPatcher *task = raw_task;
-  LNK_Obj             *obj  = task->objs[task_id];
-
-  COFF_FileHeaderInfo  obj_header    = obj->header;
-  COFF_SectionHeader  *section_table = lnk_coff_section_table_from_obj(obj);
-  String8              symbol_table  = lnk_coff_symbol_table_from_obj(obj);
-  String8              string_table  = lnk_coff_string_table_from_obj(obj);
+  COFF_FileHeaderInfo  obj_header     = obj->header;
+  COFF_SectionHeader  *section_table  = lnk_coff_section_table_from_obj(obj);
+  String8              string_table   = lnk_coff_string_table_from_obj(obj);
+  COFF_SectionHeader  *section_header = &section_table[sect_idx];
+
+  if (section_header->flags & COFF_SectionFlag_LnkInfo)              { return; }
+  if (section_header->flags & COFF_SectionFlag_LnkRemove)            { return; }
+  if (section_header->flags & COFF_SectionFlag_CntUninitializedData) { return; }
+
+  // get section bytes (special case debug info because it is not copied to the image)
+  String8 data           = section_header->flags & LNK_SECTION_FLAG_DEBUG ? obj->data : task->image_data;
+  Rng1U64 section_frange = rng_1u64(section_header->foff, section_header->foff + section_header->fsize);
+  String8 section_data   = str8_substr(data, section_frange);
+
+  // apply relocs
+  COFF_RelocArray relocs = lnk_coff_relocs_from_section_header(obj, section_header);
+  for EachIndex(reloc_idx, relocs.count) {
+    COFF_Reloc *reloc = &relocs.v[reloc_idx];
+
+    // error check relocation
+    if (obj->header.machine == COFF_MachineType_X64) {
+      if (reloc->type > COFF_Reloc_X64_Last) {
+        lnk_error_obj(LNK_Error_IllegalRelocation, obj, "unknown relocation type 0x%x", reloc->type);
+      }
+    } else if (obj->header.machine != COFF_MachineType_Unknown) {
+      lnk_not_implemented("relocation patching is not implemented for %S", coff_string_from_machine_type(obj->header.machine));
+      continue;
+    }
 
-  U32 closest_sect  = 0;
-  U32 closest_reloc = 0;
-  U32 closest_foff  = max_U32;
+    // compute virtual offsets
+    U64 reloc_voff = section_header->voff + reloc->apply_off;
 
-  for EachIndex(sect_idx, obj_header.section_count_no_null) {
-    COFF_SectionHeader *section_header = &section_table[sect_idx];
-
-    if (section_header->flags & COFF_SectionFlag_LnkInfo)              { continue; }
-    if (section_header->flags & COFF_SectionFlag_LnkRemove)            { continue; }
-    if (section_header->flags & COFF_SectionFlag_CntUninitializedData) { continue; }
+    // compute symbol location values
+    U32 symbol_secnum = 0;
+    U32 symbol_secoff = 0;
+    S64 symbol_voff   = 0;
+    {
+      COFF_ParsedSymbol          symbol = lnk_parsed_symbol_from_coff_symbol_idx(obj, reloc->isymbol);
+      COFF_SymbolValueInterpType interp = coff_interp_from_parsed_symbol(symbol);
+      if (interp == COFF_SymbolValueInterp_Regular) {
+        if (symbol.section_number == lnk_obj_get_removed_section_number(obj)) {
+          if (~section_header->flags & LNK_SECTION_FLAG_DEBUG) {
+            String8 sect_name = coff_name_from_section_header(string_table, &section_table[sect_idx]);
+            lnk_error_obj(LNK_Error_RelocationAgainstRemovedSection, obj, "relocating against symbol that is in a removed section (symbol: %S, reloc-section: %S 0x%llx, reloc-index: 0x%llx)", symbol.name, sect_name, sect_idx+1, reloc_idx);
+          }
+          continue;
+        }
+        symbol_secnum = symbol.section_number;
+        symbol_secoff = symbol.value;
+        symbol_voff   = safe_cast_u32((U64)task->image_section_table[symbol.section_number]->voff + (U64)symbol_secoff);
+      } else if (interp == COFF_SymbolValueInterp_Abs) {
+        // There aren't enough bits in COFF symbol to store full image base address,
+        // so we special case __ImageBase. A better solution would be to add
+        // a 64-bit symbol format to COFF.
+        if (str8_match(symbol.name, str8_lit("__ImageBase"), 0)) {
+          symbol.value = task->image_base;
+        }
+        symbol_secnum = 0;
+        symbol_secoff = 0;
+        symbol_voff   = (S64)symbol.value - (S64)task->image_base;
+      } else if (interp == COFF_SymbolValueInterp_Weak) {
+        // unresolved weak
+      } else if (interp == COFF_SymbolValueInterp_Undefined) {
+        // unresolved undefined
+      } else {
+        InvalidPath;
+      }
+    }
 
-    // get section bytes (special case debug info because it is not copied to the image)
-    String8 data           = section_header->flags & LNK_SECTION_FLAG_DEBUG ? obj->data : task->image_data;
-    Rng1U64 section_frange = rng_1u64(section_header->foff, section_header->foff + section_header->fsize);
-    String8 section_data   = str8_substr(data, section_frange);
+    // pick reloc value
+    COFF_RelocValue reloc_value = {0};
+    switch (obj_header.machine) {
+    case COFF_MachineType_Unknown: {} break;
+    case COFF_MachineType_X64: { reloc_value = coff_pick_reloc_value_x64(reloc->type, task->image_base, reloc_voff, symbol_secnum, symbol_secoff, symbol_voff); } break;
+    default: { NotImplemented; } break;
+    }
 
-    // apply relocs
-    COFF_RelocArray relocs = lnk_coff_relocs_from_section_header(obj, section_header);
-    for EachIndex(reloc_idx, relocs.count) {
-      COFF_Reloc *reloc = &relocs.v[reloc_idx];
+    // read addend
+    Assert(reloc_value.size <= section_data.size);
+    U64 raw_addend = 0;
+    str8_deserial_read(section_data, reloc->apply_off, &raw_addend, reloc_value.size, 1);
 
-      // error check relocation
-      if (obj->header.machine == COFF_MachineType_X64) {
-        if (reloc->type > COFF_Reloc_X64_Last) {
-          lnk_error_obj(LNK_Error_IllegalRelocation, obj, "unknown relocation type 0x%x", reloc->type);
-        }
-      } else if (obj->header.machine != COFF_MachineType_Unknown) {
-        lnk_not_implemented("relocation patching is not implemented for %S", coff_string_from_machine_type(obj->header.machine));
-        continue;
-      }
+    // compute new reloc value
+    S64 addend       = extend_sign64(raw_addend, reloc_value.size);
+    U64 reloc_result = reloc_value.value + addend;
 
-      // compute virtual offsets
-      U64 reloc_voff = section_header->voff + reloc->apply_off;
+    // commit new reloc value
+    MemoryCopy(section_data.str + reloc->apply_off, &reloc_result, reloc_value.size);
+  }
+}
 
-      // compute symbol location values
-      U32 symbol_secnum = 0;
-      U32 symbol_secoff = 0;
-      S64 symbol_voff   = 0;
-      {
-        COFF_ParsedSymbol          symbol = lnk_parsed_symbol_from_coff_symbol_idx(obj, reloc->isymbol);
-        COFF_SymbolValueInterpType interp = coff_interp_from_parsed_symbol(symbol);
-        if (interp == COFF_SymbolValueInterp_Regular) {
-          if (symbol.section_number == lnk_obj_get_removed_section_number(obj)) {
-            if (~section_header->flags & LNK_SECTION_FLAG_DEBUG) {
-              String8 sect_name = coff_name_from_section_header(string_table, &section_table[sect_idx]);
-              lnk_error_obj(LNK_Error_RelocationAgainstRemovedSection, obj, "relocating against symbol that is in a removed section (symbol: %S, reloc-section: %S 0x%llx, reloc-index: 0x%llx)", symbol.name, sect_name, sect_idx+1, reloc_idx);
-            }
-            continue;
-          }
-          symbol_secnum = symbol.section_number;
-          symbol_secoff = symbol.value;
-          symbol_voff   = safe_cast_u32((U64)task->image_section_table[symbol.section_number]->voff + (U64)symbol_secoff);
-        } else if (interp == COFF_SymbolValueInterp_Abs) {
-          // There aren't enough bits in COFF symbol to store full image base address,
-          // so we special case __ImageBase. A better solution would be to add
-          // a 64-bit symbol format to COFF.
-          if (str8_match(symbol.name, str8_lit("__ImageBase"), 0)) {
-            symbol.value = task->image_base;
-          }
-          symbol_secnum = 0;
-          symbol_secoff = 0;
-          symbol_voff   = (S64)symbol.value - (S64)task->image_base;
-        } else if (interp == COFF_SymbolValueInterp_Weak) {
-          // unresolved weak
-        } else if (interp == COFF_SymbolValueInterp_Undefined) {
-          // unresolved undefined
-        } else {
-          InvalidPath;
-        }
-      }
+internal
+THREAD_POOL_TASK_FUNC(lnk_obj_section_reloc_patcher)
+{
+  LNK_ObjSectionRelocPatcher *task = raw_task;
+  lnk_patch_section_relocs(task->patcher, task->obj, task_id);
+}
 
-      // pick reloc value
-      COFF_RelocValue reloc_value = {0};
-      switch (obj_header.machine) {
-      case COFF_MachineType_Unknown: {} break;
-      case COFF_MachineType_X64: { reloc_value = coff_pick_reloc_value_x64(reloc->type, task->image_base, reloc_voff, symbol_secnum, symbol_secoff, symbol_voff); } break;
-      default: { NotImplemented; } break;
-      }
+internal
+THREAD_POOL_TASK_FUNC(lnk_obj_reloc_patcher)
+{
+  ProfBeginFunction();
 
-      // read addend
-      Assert(reloc_value.size <= section_data.size);
-      U64 raw_addend = 0;
-      str8_deserial_read(section_data, reloc->apply_off, &raw_addend, reloc_value.size, 1);
+  LNK_ObjRelocPatcher *task = raw_task;
+  LNK_Obj             *obj  = task->objs[task_id];
 
-      // compute new reloc value
-      S64 addend       = extend_sign64(raw_addend, reloc_value.size);
-      U64 reloc_result = reloc_value.value + addend;
+  COFF_SectionHeader *section_table = lnk_coff_section_table_from_obj(obj);
+  U64                 reloc_count   = 0;
+  for EachIndex(sect_idx, obj->header.section_count_no_null) {
+    reloc_count += lnk_coff_relocs_from_section_header(obj, &section_table[sect_idx]).count;
+  }
 
-      // commit new reloc value
-      MemoryCopy(section_data.str + reloc->apply_off, &reloc_result, reloc_value.size);
+  // spawn per-section tasks for objs with lots of relocations so other workers can steal them
+  if (reloc_count >= LNK_RELOC_PATCH_SPLIT_THRESHOLD && obj->header.section_count_no_null > 1) {
+    LNK_ObjSectionRelocPatcher section_task = { .patcher = task, .obj = obj };
+    tp_for_parallel(task->tp, 0, obj->header.section_count_no_null, lnk_obj_section_reloc_patcher, &section_task);
+  } else {
+    for EachIndex(sect_idx, obj->header.section_count_no_null) {
+      lnk_patch_section_relocs(task, obj, sect_idx);
     }
   }
 
   ProfEnd();
 }
 
+internal void
+lnk_patch_relocs(TP_Context *tp, String8 image_data, U64 image_base, COFF_SectionHeader **image_section_table, U64 objs_count, LNK_Obj **objs)
+{
+  LNK_ObjRelocPatcher task = { .tp = tp, .image_data = image_data, .objs = objs, .image_base = image_base, .image_section_table = image_section_table };
+  tp_for_parallel_prof(tp, 0, objs_count, lnk_obj_reloc_patcher, &task, "Patch Relocs");
+}
+
 internal int
 lnk_section_definition_is_before(void *raw_a, void *raw_b)
 {
@@ -3155,6 +3650,30 @@ THREAD_POOL_TASK_FUNC(lnk_flag_hotpatch_contribs_task)
   }
 }
 
+internal
+THREAD_POOL_TASK_FUNC(lnk_pad_incremental_contribs_task)
+{
+  LNK_BuildImageTask *task    = raw_task;
+  U64                 obj_idx = task_id;
+  LNK_Obj            *obj     = task->objs[obj_idx];
+
+  // only objs from the command line are patched in place
+  if (obj->link_member) {
+    return;
+  }
+
+  COFF_SectionHeader *section_table = lnk_coff_section_table_from_obj(obj);
+  for EachIndex(sect_idx, obj->header.section_count_no_null) {
+    COFF_SectionHeader *section_header = &section_table[sect_idx];
+    LNK_SectionContrib *sc             = task->sect_map[obj_idx][sect_idx];
+    if (sc == task->null_sc) { continue; }
+    if (sc->u.obj_idx != obj_idx || sc->u.obj_sect_idx != sect_idx) { continue; }
+    if (section_header->flags & COFF_SectionFlag_CntCode) {
+      sc->incremental_pad = lnk_incremental_pad_from_size(section_header->fsize);
+    }
+  }
+}
+
 internal void
 lnk_push_coff_symbols_from_data(Arena *arena, LNK_SymbolList *symbol_list, String8 data, LNK_SymbolArray obj_symbols)
 {
@@ -4052,6 +4571,15 @@ lnk_build_win32_header(Arena *arena, LNK_SymbolTable *symtab, LNK_Config *config
   return result;
 }
 
+internal
+THREAD_POOL_TASK_FUNC(lnk_build_pdb_publics_task)
+{
+  ProfBeginFunction();
+  LNK_PdbPublicsTask *task = raw_task;
+  lnk_build_pdb_public_symbols(task->tp, task->arena, task->symtab, task->psi);
+  ProfEnd();
+}
+
 internal LNK_ImageContext
 lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolTable *symtab, U64 objs_count, LNK_Obj **objs)
 {
@@ -4081,6 +4609,9 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
     .null_sc          = push_array(arena->v[0], LNK_SectionContrib, 1),
   };
 
+  LNK_PdbPublicsTask *pdb_publics     = 0;
+  TP_Job             *pdb_publics_job = 0;
+
   {
     ProfBegin("Define And Count Sections");
     TP_Temp temp = tp_temp_begin(arena);
@@ -4180,10 +4711,13 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
 
     tp_for_parallel_prof(tp, 0, objs_count, lnk_gather_section_contribs_task, &task, "Gather Section Contribs");
 
-    // ensure determinism by sorting section contribs in chunks by input index
+    // ensure determinism by sorting section contribs in chunks by input index,
+    // then move sections listed in /ORDER and /RAD_CALL_GRAPH_ORDER to the front
     {
       ProfBegin("Sort Section Contribs");
 
+      task.u.sort_contribs.ranks = lnk_section_ranks_from_order(scratch.arena, config, symtab, objs_count, objs);
+
       U64 total_chunk_count = 0;
       {
         for (LNK_SectionNode *sect_n = sectab->list.first; sect_n != 0; sect_n = sect_n->next) {
@@ -4207,6 +4741,8 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
       ProfEnd();
     }
 
+    // folded sections must be redirected first, COMDAT leaders might be folded too
+    tp_for_parallel_prof(tp, 0, objs_count, lnk_set_folded_contribs_task,         &task, "Update Section Map With Folded Contribs");
     tp_for_parallel_prof(tp, 0, objs_count, lnk_set_comdat_leaders_contribs_task, &task, "Update Section Map With COMDAT Leader Contribs");
 
     // build common block
@@ -4288,6 +4824,11 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
         tp_for_parallel_prof(tp, arena, objs_count, lnk_flag_hotpatch_contribs_task, &task, "Flag Hotpatch Section Contribs");
       }
 
+      // leave room after code so next /INCREMENTAL link can patch changed functions in place
+      if (config->incremental == LNK_SwitchState_Yes) {
+        tp_for_parallel_prof(tp, arena, objs_count, lnk_pad_incremental_contribs_task, &task, "Pad Incremental Section Contribs");
+      }
+
       // assign contribs offsets, sizes, and section indices
       for (LNK_SectionNode *sect_n = sectab->list.first; sect_n != 0; sect_n = sect_n->next) {
         lnk_finalize_section_layout(&sect_n->data, config->file_align, config->function_pad_min);
@@ -4364,6 +4905,20 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
     for EachIndex(sect_idx, task.image_sects.count) { lnk_assign_section_virtual_space(task.image_sects.v[sect_idx], config->sect_align, &voff_cursor); }
     tp_for_parallel_prof(tp, 0, task.objs_count, lnk_patch_virtual_offsets_and_sizes_in_obj_section_headers_task, &task, "Patch Virtual Offsets and Sizes in Obj Section Headers");
 
+    // symbols are patched to final section and offset, build PDB publics GSI while base relocs
+    // and image are put together, main thread waits only on its own jobs from here on
+    if (lnk_do_pdb(config) && tp->worker_count > 1) {
+      TP_Arena           *publics_arena = tp_arena_alloc(tp);
+      LNK_PdbPublicsTask *publics       = push_array(publics_arena->v[0], LNK_PdbPublicsTask, 1);
+      publics->tp     = tp;
+      publics->arena  = publics_arena;
+      publics->symtab = symtab;
+      publics->psi    = psi_alloc();
+      pdb_publics     = publics;
+      pdb_publics_job = tp_submit(tp, publics_arena->v[0], 0, 1, lnk_build_pdb_publics_task, publics, 0, 0);
+      tp_task_scope_begin(tp);
+    }
+
     // build base relocs
     if (~config->flags & LNK_ConfigFlag_Fixed) {
       String8 base_relocs_data = lnk_build_base_relocs(tp, arena, config, objs_count, objs);
@@ -4473,10 +5028,7 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
     COFF_SectionHeader **image_section_table = coff_section_table_from_data(scratch.arena, image_data, pe.section_table_range);
 
     // patch relocs
-    {
-      LNK_ObjRelocPatcher task = { .image_data = image_data, .objs = objs, .image_base = pe.image_base, .image_section_table = image_section_table };
-      tp_for_parallel_prof(tp, 0, objs_count, lnk_obj_reloc_patcher, &task, "Patch Relocs");
-    }
+    lnk_patch_relocs(tp, image_data, pe.image_base, image_section_table, objs_count, objs);
 
     // patch load config
     {
@@ -4680,9 +5232,15 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
     ProfEnd();
   }
 
+  if (pdb_publics_job) {
+    tp_task_scope_end(tp);
+  }
+
   LNK_ImageContext image_ctx = {0};
   image_ctx.image_data       = image_data;
   image_ctx.sectab           = sectab;
+  image_ctx.pdb_publics      = pdb_publics;
+  image_ctx.pdb_publics_job  = pdb_publics_job;
 
   lnk_timer_end(LNK_Timer_Image);
   ProfEnd(); // :EndImage
@@ -4918,6 +5476,69 @@ lnk_write_thread(void *raw_ctx)
   ProfEnd();
 }
 
+internal void
+lnk_write_rad_debug_info(TP_Context *tp, TP_Arena *arena, LNK_Config *config, String8 image_data, LNK_CodeViewInput *input, CV_DebugT *types)
+{
+  lnk_timer_begin(LNK_Timer_Rdi);
+
+  String8List rdi_data = lnk_build_rad_debug_info(tp,
+                                                  arena,
+                                                  config->target_os,
+                                                  rdi_arch_from_coff_machine(config->machine),
+                                                  config->image_name,
+                                                  image_data,
+                                                  input->count,
+                                                  input->obj_arr,
+                                                  input->debug_s_arr,
+                                                  input->total_symbol_input_count,
+                                                  input->symbol_inputs,
+                                                  input->parsed_symbols,
+                                                  types);
+
+  lnk_write_data_list_to_file_path(config->rad_debug_name, config->temp_rad_debug_name, rdi_data);
+
+  lnk_timer_end(LNK_Timer_Rdi);
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_rad_debug_info_task)
+{
+  ProfBeginFunction();
+  LNK_RadDebugInfoTask *task = raw_task;
+  lnk_write_rad_debug_info(task->tp, task->arena, task->config, task->image_data, task->input, task->types);
+  ProfEnd();
+}
+
+internal void
+lnk_write_pdb(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_SymbolTable *symtab, LNK_ImageContext *image_ctx, LNK_CodeViewInput *input, CV_DebugT *types)
+{
+  lnk_timer_begin(LNK_Timer_Pdb);
+
+  PDB_PsiContext *publics = 0;
+  if (image_ctx->pdb_publics_job) {
+    tp_wait(tp, image_ctx->pdb_publics_job);
+    publics = image_ctx->pdb_publics->psi;
+  }
+
+  String8List pdb_data = lnk_build_pdb(tp,
+                                       arena,
+                                       image_ctx->image_data,
+                                       config,
+                                       symtab,
+                                       input->count,
+                                       input->obj_arr,
+                                       input->debug_s_arr,
+                                       input->total_symbol_input_count,
+                                       input->symbol_inputs,
+                                       input->parsed_symbols,
+                                       types,
+                                       publics);
+
+  lnk_write_data_list_to_file_path(config->pdb_name, config->temp_pdb_name, pdb_data);
+
+  lnk_timer_end(LNK_Timer_Pdb);
+}
+
 internal void
 lnk_log_timers(void)
 {
@@ -4958,6 +5579,15 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
 
   Temp scratch = scratch_begin(arena->v, arena->count);
 
+  //
+  // Incremental
+  //
+  if (config->incremental == LNK_SwitchState_Yes) {
+    if (lnk_try_incremental_link(tp, config)) {
+      goto exit;
+    }
+  }
+
   //
   // Input Context
   //
@@ -4983,17 +5613,23 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
   //
   LNK_ImageContext image_ctx = lnk_build_image(arena, tp, config, symtab, objs_count, objs);
 
+  // materialize step links image in memory only to build debug info for it
+  B32 debug_info_only = !!(config->flags & LNK_ConfigFlag_DebugInfoOnly);
+
   // Write image in the background
-  LNK_WriteThreadContext *image_write_ctx = push_array(scratch.arena, LNK_WriteThreadContext, 1);
-  image_write_ctx->path      = config->image_name;
-  image_write_ctx->temp_path = config->temp_image_name;
-  image_write_ctx->data      = image_ctx.image_data;
-  Thread image_write_thread = thread_launch(lnk_write_thread, image_write_ctx);
+  Thread image_write_thread = {0};
+  if (!debug_info_only) {
+    LNK_WriteThreadContext *image_write_ctx = push_array(scratch.arena, LNK_WriteThreadContext, 1);
+    image_write_ctx->path      = config->image_name;
+    image_write_ctx->temp_path = config->temp_image_name;
+    image_write_ctx->data      = image_ctx.image_data;
+    image_write_thread = thread_launch(lnk_write_thread, image_write_ctx);
+  }
 
   //
   // RAD Map
   //
-  if (config->rad_chunk_map == LNK_SwitchState_Yes) {
+  if (config->rad_chunk_map == LNK_SwitchState_Yes && !debug_info_only) {
     String8List rad_map = lnk_build_rad_map(scratch.arena, image_ctx.image_data, config, objs_count, objs, libs_count, libs, image_ctx.sectab);
     lnk_write_data_list_to_file_path(config->rad_chunk_map_name, config->temp_rad_chunk_map_name, rad_map);
   }
@@ -5001,7 +5637,7 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
   //
   // Import Library
   //
-  if (config->build_imp_lib && (config->file_characteristics & PE_ImageFileCharacteristic_FILE_DLL)) {
+  if (config->build_imp_lib && (config->file_characteristics & PE_ImageFileCharacteristic_FILE_DLL) && !debug_info_only) {
     ProfBegin("Build Import Library");
     lnk_timer_begin(LNK_Timer_Lib);
     String8 linker_debug_symbols = lnk_make_linker_debug_symbols(scratch.arena, config->machine);
@@ -5011,10 +5647,21 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
     ProfEnd();
   }
 
+  //
+  // Deferred Debug Info
+  //
+  // /DEBUG:FASTLINK skips type merge and writes only a manifest, debugger
+  // materializes PDB and RDI on first load with /RAD_MATERIALIZE_DEBUG_INFO
+  if (lnk_do_debug_info(config) && config->debug_mode == LNK_DebugMode_FastLink) {
+    ProfBegin("Deferred Debug Info");
+    lnk_write_deferred_debug_info(config, inputer);
+    ProfEnd();
+  }
+
   //
   // Debug Info
   //
-  if (lnk_do_debug_info(config)) {
+  if (lnk_do_debug_info(config) && config->debug_mode != LNK_DebugMode_FastLink) {
     ProfBegin("Debug Info");
     lnk_timer_begin(LNK_Timer_Debug);
 
@@ -5029,61 +5676,65 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
     //
     // CodeView
     //
-    LNK_CodeViewInput input = lnk_make_code_view_input(tp, arena, config->io_flags, config->lib_dir_list, config->alt_pch_dirs, debug_info_objs_count, debug_info_objs);
-    CV_DebugT        *types = lnk_import_types(tp, arena, &input);
+    B32               use_ghash = config->debug_mode == LNK_DebugMode_GHash;
+    LNK_CodeViewInput input     = lnk_make_code_view_input(tp, arena, config->io_flags, config->lib_dir_list, config->alt_pch_dirs, use_ghash, debug_info_objs_count, debug_info_objs);
 
-    //
-    // RDI
-    //
-    if (config->rad_debug == LNK_SwitchState_Yes) {
-      lnk_timer_begin(LNK_Timer_Rdi);
-
-      String8List rdi_data = lnk_build_rad_debug_info(tp,
-                                                      arena,
-                                                      config->target_os,
-                                                      rdi_arch_from_coff_machine(config->machine),
-                                                      config->image_name,
-                                                      image_ctx.image_data,
-                                                      input.count,
-                                                      input.obj_arr,
-                                                      input.debug_s_arr,
-                                                      input.total_symbol_input_count,
-                                                      input.symbol_inputs,
-                                                      input.parsed_symbols,
-                                                      types);
+    LNK_TypeCache *type_cache = 0;
+    if (config->incremental == LNK_SwitchState_Yes) {
+      type_cache = lnk_type_cache_from_file(scratch.arena, config->type_cache_name);
+    }
 
-      lnk_write_data_list_to_file_path(config->rad_debug_name, config->temp_rad_debug_name, rdi_data);
+    CV_DebugT *types = lnk_import_types(tp, arena, &input, type_cache);
 
-      lnk_timer_end(LNK_Timer_Rdi);
+    if (type_cache) {
+      lnk_log(LNK_Log_Debug, "[Type Cache Hits %llu, Misses %llu, Type Index Map Hits %llu]", type_cache->hit_count, type_cache->miss_count, type_cache->map_hit_count);
+      lnk_write_type_cache(config->type_cache_name, type_cache);
     }
 
+    B32 build_rdi       = config->rad_debug == LNK_SwitchState_Yes;
+    B32 build_pdb       = lnk_do_pdb(config);
+    B32 hash_type_names = config->pdb_hash_type_names != LNK_TypeNameHashMode_Null && config->pdb_hash_type_names != LNK_TypeNameHashMode_None;
+
+    // both formats are built from the same merged types, PDB patches symbols and
+    // C13 data in place so it gets its own copy while RDI reads the originals
     //
-    // PDB
-    //
-    // TODO: Parallel debug info builds are currently blocked by the patch
-    // strings in $$FILE_CHECKSUM step in `lnk_process_c13_data_task`.
-    if (config->debug_mode == LNK_DebugMode_Full) {
-      lnk_timer_begin(LNK_Timer_Pdb);
+    // type name hashing rewrites merged types and forces serial build
+    B32 build_in_parallel = build_rdi && build_pdb && !hash_type_names && tp->worker_count > 1;
 
-      if (config->pdb_hash_type_names != LNK_TypeNameHashMode_Null && config->pdb_hash_type_names != LNK_TypeNameHashMode_None) {
-        lnk_replace_type_names_with_hashes(tp, arena, types[CV_TypeIndexSource_TPI], config->pdb_hash_type_names, config->pdb_hash_type_name_length, config->pdb_hash_type_name_map);
-      }
+    if (build_in_parallel) {
+      ProfBegin("RDI & PDB");
+
+      LNK_RadDebugInfoTask rdi_task = {0};
+      rdi_task.tp                   = tp;
+      rdi_task.arena                = tp_arena_alloc(tp);
+      rdi_task.config               = config;
+      rdi_task.image_data           = image_ctx.image_data;
+      rdi_task.input                = &input;
+      rdi_task.types                = types;
+
+      // main thread is marked as running a task so its waits on PDB jobs don't pick up RDI work
+      tp_task_scope_begin(tp);
 
-      String8List pdb_data = lnk_build_pdb(tp,
-                                           arena,
-                                           image_ctx.image_data,
-                                           config,
-                                           symtab,
-                                           input.count,
-                                           input.obj_arr,
-                                           input.debug_s_arr,
-                                           input.total_symbol_input_count,
-                                           input.symbol_inputs,
-                                           input.parsed_symbols,
-                                           types);
+      TP_Job *rdi_job = tp_submit(tp, scratch.arena, rdi_task.arena, 1, lnk_rad_debug_info_task, &rdi_task, 0, 0);
 
-      lnk_write_data_list_to_file_path(config->pdb_name, config->temp_pdb_name, pdb_data);
-      lnk_timer_end(LNK_Timer_Pdb);
+      LNK_CodeViewInput pdb_input = lnk_copy_code_view_input_for_pdb(tp, arena, &input);
+      lnk_write_pdb(tp, arena, config, symtab, &image_ctx, &pdb_input, types);
+      tp_wait(tp, rdi_job);
+
+      tp_task_scope_end(tp);
+
+      tp_arena_release(&rdi_task.arena);
+      ProfEnd();
+    } else {
+      if (build_rdi) {
+        lnk_write_rad_debug_info(tp, arena, config, image_ctx.image_data, &input, types);
+      }
+      if (build_pdb) {
+        if (hash_type_names) {
+          lnk_replace_type_names_with_hashes(tp, arena, types[CV_TypeIndexSource_TPI], config->pdb_hash_type_names, config->pdb_hash_type_name_length, config->pdb_hash_type_name_map);
+        }
+        lnk_write_pdb(tp, arena, config, symtab, &image_ctx, &input, types);
+      }
     }
 
     lnk_timer_end(LNK_Timer_Debug);
@@ -5091,7 +5742,16 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
   }
 
   // wait for the thread to finish writing image to disk
-  thread_join(image_write_thread, -1);
+  if (!debug_info_only) {
+    thread_join(image_write_thread, -1);
+  }
+
+  //
+  // Link State
+  //
+  if (config->incremental == LNK_SwitchState_Yes) {
+    lnk_write_link_state(tp, config, inputer, symtab, objs_count, objs, image_ctx.image_data);
+  }
 
   //
   // Timers
@@ -5100,6 +5760,7 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
     lnk_log_timers();
   }
   
+  exit:;
   scratch_end(scratch);
   ProfEnd();
 }
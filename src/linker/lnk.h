@@ -37,6 +37,7 @@ typedef struct LNK_Input
   B32               exclude_from_debug_info;
   LNK_LibMemberRef *link_member;
   void             *loaded_input;
+  U128              hash; // hash of data as it was read from disk, computed for /INCREMENTAL
 
   struct LNK_Input *next;
 } LNK_Input;
@@ -94,10 +95,20 @@ typedef struct LNK_Link
 #define LNK_REMOVED_SECTION_NUMBER_32 (U32)-3
 #define LNK_REMOVED_SECTION_NUMBER_16 (U16)-3
 
+typedef struct LNK_PdbPublicsTask
+{
+  TP_Context      *tp;
+  TP_Arena        *arena;
+  LNK_SymbolTable *symtab;
+  PDB_PsiContext  *psi;
+} LNK_PdbPublicsTask;
+
 typedef struct LNK_ImageContext
 {
-  String8           image_data;
-  LNK_SectionTable *sectab;
+  String8             image_data;
+  LNK_SectionTable   *sectab;
+  LNK_PdbPublicsTask *pdb_publics;     // PDB publics GSI built in the background, zero when PDB is not requested
+  TP_Job             *pdb_publics_job;
 } LNK_ImageContext;
 
 typedef struct LNK_SectionDefinition
@@ -148,6 +159,36 @@ typedef struct AlignType(16) LNK_RelocRefsList
   LNK_RelocRefsPointer head;
 } LNK_RelocRefsList;
 
+// --- ICF ---------------------------------------------------------------------
+
+typedef enum
+{
+  LNK_ICFRelocTarget_Null,
+  LNK_ICFRelocTarget_Candidate, // section eligible for folding, compared by equivalence class
+  LNK_ICFRelocTarget_Group,     // section from the candidate's associated sections, compared by group index
+  LNK_ICFRelocTarget_Section,   // section that is never folded, compared by identity
+  LNK_ICFRelocTarget_Abs,
+  LNK_ICFRelocTarget_Symbol,    // unresolved, common or weak symbol, compared by identity
+} LNK_ICFRelocTargetKind;
+
+typedef struct LNK_ICFReloc
+{
+  U32 group_idx;
+  U32 apply_off;
+  U32 type;
+  U32 kind;
+  U64 value;
+  U64 target;
+} LNK_ICFReloc;
+
+typedef struct LNK_ICFSection
+{
+  LNK_Obj      *obj;
+  U32           section_number;
+  U32           relocs_count;
+  LNK_ICFReloc *relocs;
+} LNK_ICFSection;
+
 // --- Base Reloc --------------------------------------------------------------
 
 typedef struct LNK_BaseRelocPage
@@ -196,12 +237,32 @@ typedef struct
 
 typedef struct
 {
+  LNK_SymbolTable  *symtab;
+  U32             **candidate_map;
+  LNK_ICFSection   *sections;
+  Rng1U64          *ranges;
+  U64              *classes;
+  U64              *next_classes;
+  U32              *fold_leaders;
+} LNK_OptICFTask;
+
+#define LNK_RELOC_PATCH_SPLIT_THRESHOLD 4096
+
+typedef struct
+{
+  TP_Context          *tp;
   String8              image_data;
   LNK_Obj            **objs;
   U64                  image_base;
   COFF_SectionHeader **image_section_table;
 } LNK_ObjRelocPatcher;
 
+typedef struct
+{
+  LNK_ObjRelocPatcher *patcher;
+  LNK_Obj             *obj;
+} LNK_ObjSectionRelocPatcher;
+
 typedef struct
 {
   U64 page_size;
@@ -253,6 +314,7 @@ typedef struct
     } common_block;
     struct {
       LNK_SectionContribChunk **chunks;
+      U32                     **ranks;
     } sort_contribs;
     struct {
       B8                        **was_symbol_patched;
@@ -275,6 +337,16 @@ typedef struct
   String8 data;
 } LNK_WriteThreadContext;
 
+typedef struct
+{
+  TP_Context        *tp;
+  TP_Arena          *arena;
+  LNK_Config        *config;
+  String8            image_data;
+  LNK_CodeViewInput *input;
+  CV_DebugT         *types;
+} LNK_RadDebugInfoTask;
+
 typedef struct
 {
   String8  data;
@@ -348,6 +420,7 @@ internal LNK_Link *    lnk_link_image (TP_Context *tp, TP_Arena *arena, LNK_Conf
 // --- Optimizations -----------------------------------------------------------
 
 internal void lnk_opt_ref(TP_Context *tp, LNK_SymbolTable *symtab, LNK_Config *config, LNK_ObjList objs);
+internal void lnk_opt_icf(TP_Context *tp, Arena *arena, LNK_SymbolTable *symtab, LNK_Config *config, LNK_ObjList objs);
 
 // --- Win32 Image -------------------------------------------------------------
 
@@ -356,6 +429,13 @@ internal String8          lnk_build_base_relocs(TP_Context *tp, TP_Arena *tp_tem
 internal String8List      lnk_build_win32_image_header(Arena *arena, LNK_SymbolTable *symtab, LNK_Config *config, LNK_SectionArray sect_arr, U64 expected_image_header_size);
 internal LNK_ImageContext lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolTable *symtab, U64 obj_count, LNK_Obj **objs);
 
+internal void lnk_patch_relocs(TP_Context *tp, String8 image_data, U64 image_base, COFF_SectionHeader **image_section_table, U64 objs_count, LNK_Obj **objs);
+
+// --- Debug Info --------------------------------------------------------------
+
+internal void lnk_write_rad_debug_info(TP_Context *tp, TP_Arena *arena, LNK_Config *config, String8 image_data, LNK_CodeViewInput *input, CV_DebugT *types);
+internal void lnk_write_pdb(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_SymbolTable *symtab, LNK_ImageContext *image_ctx, LNK_CodeViewInput *input, CV_DebugT *types);
+
 // --- Logger ------------------------------------------------------------------
 
 internal void lnk_log_link_stats(LNK_ObjList obj_list, LNK_LibList *lib_index, LNK_SectionTable *sectab);
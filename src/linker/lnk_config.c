@@ -58,7 +58,7 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   { LNK_CmdSwitch_NotImplemented,     0, "ILK",                  "", ""                                                                                                      },
   { LNK_CmdSwitch_ImpLib,             0, "IMPLIB",               ":FILENAME", ""                                                                                             },
   { LNK_CmdSwitch_Include,            1, "INCLUDE",              "", ""                                                                                                      },
-  { LNK_CmdSwitch_Incremental,        0, "INCREMENTAL",          "[:NO]", "Incremental linking is not supported."                                                            },
+  { LNK_CmdSwitch_Incremental,        0, "INCREMENTAL",          "[:NO]", "Patch changed objs into the previous image when they fit; otherwise link in full."                },
   { LNK_CmdSwitch_NotImplemented,     0, "INTEGRITYCHECK",       "", ""                                                                                                      },
   { LNK_CmdSwitch_InferAsanLibs,      1, "INFERASANLIBS",        "[:NO]", ""                                                                                                 },
   { LNK_CmdSwitch_InferAsanLibsNo,    1, "INFERASANLIBSNO",      "", "",                                                                                                     },
@@ -92,7 +92,7 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   { LNK_CmdSwitch_NoLogo,             0, "NOLOGO",               "", ""                                                                                                      },
   { LNK_CmdSwitch_NxCompat,           0, "NXCOMPAT",             "[:NO]", ""                                                                                                 },
   { LNK_CmdSwitch_Opt,                0, "OPT",                  "", ""                                                                                                      },
-  { LNK_CmdSwitch_NotImplemented,     0, "ORDER",                "", ""                                                                                                      },
+  { LNK_CmdSwitch_Order,              0, "ORDER",                ":@FILENAME", "Places listed functions first in their section, in the file order."                              },
   { LNK_CmdSwitch_Out,                0, "OUT",                  ":FILENAME", ""                                                                                             },
   { LNK_CmdSwitch_Pdb,                0, "PDB",                  ":FILENAME", ""                                                                                             },
   { LNK_CmdSwitch_PdbAltPath,         0, "PDBALTPATH",           "", ""                                                                                                      },
@@ -126,12 +126,15 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   { LNK_CmdSwitch_Rad_Age,                          0, "RAD_AGE",                              ":#",        "Age embeded in EXE and PDB, used to validate incremental build. Default is 1."    },
   { LNK_CmdSwitch_Rad_AltPchDir,                    0, "RAD_ALT_PCH_DIR",                      ":PATH",     "Alternative directory to search for PCH object files."                            },
   { LNK_CmdSwitch_Rad_BuildInfo,                    0, "RAD_BUILD_INFO",                       "",          "Print build info and exit."                                                       },
+  { LNK_CmdSwitch_Rad_CallGraphOrder,               0, "RAD_CALL_GRAPH_ORDER",                 ":FILENAME", "Clusters hot functions using \"CALLER CALLEE COUNT\" lines from a profile."        },
   { LNK_CmdSwitch_Rad_CheckUnusedDelayLoadDll,      0, "RAD_CHECK_UNUSED_DELAY_LOAD_DLL",      "[:NO]",     ""                                                                                 },
   { LNK_CmdSwitch_Rad_Map,                          0, "RAD_MAP",                              ":FILENAME", "Emit file with the output image's layout description."                            },
   { LNK_CmdSwitch_Rad_MapLinesForUnresolvedSymbols, 0, "RAD_MAP_LINES_FOR_UNRESOLVED_SYMBOLS", "[:NO]",     "Use debug info to print source file location for unresolved symbol"               },
+  { LNK_CmdSwitch_Rad_MaterializeDebugInfo,         0, "RAD_MATERIALIZE_DEBUG_INFO",           ":FILENAME", "Builds debug info for an image linked with /DEBUG:FASTLINK from its .rfl file."    },
   { LNK_CmdSwitch_Rad_MemoryMapFiles,               0, "RAD_MEMORY_MAP_FILES",                 "[:NO]",     "When enabled, files are memory-mapped instead of being read entirely on request." },
   { LNK_CmdSwitch_Rad_Debug,                        0, "RAD_DEBUG",                            "[:NO]",     "Emit RAD debug info file."                                                        },
   { LNK_CmdSwitch_Rad_DebugAltPath,                 0, "RAD_DEBUGALTPATH",                     "", ""                                                                                          },
+  { LNK_CmdSwitch_Rad_DebugInfoOnly,                0, "RAD_DEBUG_INFO_ONLY",                  "[:NO]",     "Link image in memory and write only debug info files."                           },
   { LNK_CmdSwitch_Rad_DebugName,                    0, "RAD_DEBUG_NAME",                       ":FILENAME", "Sets file name for RAD debug info file."                                          },
   { LNK_CmdSwitch_Rad_DelayBind,                    0, "RAD_DELAY_BIND",                       "[:NO]", ""                                                                                     },
   { LNK_CmdSwitch_Rad_DoMerge,                      0, "RAD_DO_MERGE",                         "[:NO]", ""                                                                                     },
@@ -934,6 +937,13 @@ lnk_do_debug_info(LNK_Config *config)
   return do_debug_info;
 }
 
+internal B32
+lnk_do_pdb(LNK_Config *config)
+{
+  B32 do_pdb = lnk_do_debug_info(config) && (config->debug_mode == LNK_DebugMode_Full || config->debug_mode == LNK_DebugMode_GHash);
+  return do_pdb;
+}
+
 internal B32
 lnk_is_thread_pool_shared(LNK_Config *config)
 {
@@ -1227,13 +1237,7 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
       config->debug_mode = LNK_DebugMode_Full;
     } else if (value_strings.node_count == 1) {
       LNK_DebugMode debug_mode = lnk_debug_mode_from_string(value_strings.first->string);
-      if (debug_mode == LNK_DebugMode_GHash) {
-        config->debug_mode = LNK_DebugMode_Full;
-        lnk_error_cmd_switch(LNK_Warning_Cmdl, obj, cmd_switch, "GHASH is not supported, switching to FULL");
-      } else if (debug_mode == LNK_DebugMode_FastLink) {
-        config->debug_mode = LNK_DebugMode_Full;
-        lnk_error_cmd_switch(LNK_Warning_Cmdl, obj, cmd_switch, "FASTLINK is not supported, switching to FULL");
-      } else if (debug_mode != LNK_DebugMode_Null) {
+      if (debug_mode != LNK_DebugMode_Null) {
         config->debug_mode = debug_mode;
       } else {
         lnk_error_cmd_switch(LNK_Error_Cmdl, obj, cmd_switch, "invalid parameter \"%S\"", value_strings.first->string);
@@ -1431,12 +1435,7 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
   } break;
 
   case LNK_CmdSwitch_Incremental: {
-    LNK_SwitchState state;
-    if (lnk_cmd_switch_parse_flag(obj, cmd_switch, value_strings, &state)) {
-      if (state == LNK_SwitchState_Yes) {
-        lnk_error_cmd_switch(LNK_Warning_Cmdl, obj, cmd_switch, "incremental linkage is not supported");
-      }
-    }
+    lnk_cmd_switch_parse_flag(obj, cmd_switch, value_strings, &config->incremental);
   } break;
 
   case LNK_CmdSwitch_LargeAddressAware: {
@@ -1680,6 +1679,17 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     }
   } break;
 
+  case LNK_CmdSwitch_Order: {
+    String8 order_file_name = {0};
+    if (lnk_cmd_switch_parse_string(obj, cmd_switch, value_strings, &order_file_name)) {
+      if (str8_match(str8_prefix(order_file_name, 1), str8_lit("@"), 0)) {
+        config->order_file_name = push_str8_copy(config->arena, str8_skip(order_file_name, 1));
+      } else {
+        lnk_error_cmd_switch(LNK_Error_Cmdl, obj, cmd_switch, "expected file name prefixed with @, got \"%S\"", order_file_name);
+      }
+    }
+  } break;
+
   case LNK_CmdSwitch_Out: {
     lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->image_name);
   } break;
@@ -1794,6 +1804,10 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     os_abort(0);
   } break;
 
+  case LNK_CmdSwitch_Rad_CallGraphOrder: {
+    lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->call_graph_file_name);
+  } break;
+
   case LNK_CmdSwitch_Rad_CheckUnusedDelayLoadDll: {
     lnk_cmd_switch_set_flag_64(obj, cmd_switch, value_strings, &config->flags, LNK_ConfigFlag_CheckUnusedDelayLoadDll);
   } break;
@@ -1820,6 +1834,14 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->rad_debug_name);
   } break;
 
+  case LNK_CmdSwitch_Rad_DebugInfoOnly: {
+    lnk_cmd_switch_set_flag_64(obj, cmd_switch, value_strings, &config->flags, LNK_ConfigFlag_DebugInfoOnly);
+  } break;
+
+  case LNK_CmdSwitch_Rad_MaterializeDebugInfo: {
+    // handled before config is created, command line is replaced with one from the .rfl file (:materialize_debug_info)
+  } break;
+
   case LNK_CmdSwitch_Rad_DebugAltPath: {
     lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->rad_debug_alt_path);
   } break;
@@ -1845,11 +1867,13 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
       if (str8_match_lit("imageblake3", value_strings.first->string, StringMatchFlag_CaseInsensitive)) {
         config->guid_type = Lnk_DebugInfoGuid_ImageBlake3;
       } else if (str8_match_lit("random", value_strings.first->string, StringMatchFlag_CaseInsensitive)) {
-        config->guid = os_make_guid();
+        config->guid      = os_make_guid();
+        config->guid_type = LNK_DebugInfoGuid_Null;
       } else {
         Guid guid;
         if (try_guid_from_string(value_strings.first->string, &guid)) {
-          config->guid = guid;
+          config->guid      = guid;
+          config->guid_type = LNK_DebugInfoGuid_Null;
         } else {
           lnk_error_cmd_switch(LNK_Error_Cmdl, obj, cmd_switch, "unable to parse \"%S\"", value_strings.first->string);
         }
@@ -2161,6 +2185,17 @@ lnk_config_from_cmd_line(String8List raw_cmd_line, LNK_CmdLine cmd_line)
         config->opt_icf = LNK_SwitchState_No;
       }
     }
+
+    // incremental link patches changed objs into slots from the previous link,
+    // removed and folded sections don't have slots
+    if (config->incremental == LNK_SwitchState_Yes) {
+      if (config->opt_ref == LNK_SwitchState_Null) {
+        config->opt_ref = LNK_SwitchState_No;
+      }
+      if (config->opt_icf == LNK_SwitchState_Null) {
+        config->opt_icf = LNK_SwitchState_No;
+      }
+    }
     
     // by default enable all optimizations
     if (config->opt_ref == LNK_SwitchState_Null) {
@@ -2246,6 +2281,13 @@ lnk_config_from_cmd_line(String8List raw_cmd_line, LNK_CmdLine cmd_line)
   config->imp_lib_name   = os_full_path_from_path(arena, config->imp_lib_name);
   config->manifest_name  = os_full_path_from_path(arena, config->manifest_name);
 
+  // incremental link state and type cache are stored next to the image
+  config->link_state_name = push_str8f(arena, "%S.rlk", config->image_name);
+  config->type_cache_name = push_str8f(arena, "%S.rlt", config->image_name);
+
+  // /DEBUG:FASTLINK writes a manifest next to the PDB, debugger finds it through the image debug directory
+  config->deferred_debug_info_name = path_replace_file_extension(arena, config->pdb_name, str8_lit("rfl"));
+
   // collect env vars
   HashTable *env_vars = hash_table_init(scratch.arena, 512);
   {
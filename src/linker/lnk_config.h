@@ -153,9 +153,11 @@ typedef enum
   LNK_CmdSwitch_Rad_Age,
   LNK_CmdSwitch_Rad_AltPchDir,
   LNK_CmdSwitch_Rad_BuildInfo,
+  LNK_CmdSwitch_Rad_CallGraphOrder,
   LNK_CmdSwitch_Rad_CheckUnusedDelayLoadDll,
   LNK_CmdSwitch_Rad_Debug,
   LNK_CmdSwitch_Rad_DebugAltPath,
+  LNK_CmdSwitch_Rad_DebugInfoOnly,
   LNK_CmdSwitch_Rad_DebugName,
   LNK_CmdSwitch_Rad_DelayBind,
   LNK_CmdSwitch_Rad_DoMerge,
@@ -168,6 +170,7 @@ typedef enum
   LNK_CmdSwitch_Rad_Logo,
   LNK_CmdSwitch_Rad_Map,
   LNK_CmdSwitch_Rad_MapLinesForUnresolvedSymbols,
+  LNK_CmdSwitch_Rad_MaterializeDebugInfo,
   LNK_CmdSwitch_Rad_MemoryMapFiles,
   LNK_CmdSwitch_Rad_MtPath,
   LNK_CmdSwitch_Rad_OsVer,
@@ -221,6 +224,7 @@ enum
   LNK_ConfigFlag_NoTsAware               = (1 << 6),
   LNK_ConfigFlag_WriteImageChecksum      = (1 << 8),
   LNK_ConfigFlag_ManifestEmbed           = (1 << 9),
+  LNK_ConfigFlag_DebugInfoOnly           = (1 << 10),
 };
 typedef U64 LNK_ConfigFlags;
 
@@ -331,6 +335,7 @@ typedef struct LNK_Config
   LNK_SwitchState             opt_ref;
   LNK_SwitchState             opt_icf;
   LNK_SwitchState             opt_lbr;
+  LNK_SwitchState             incremental;
   U64                         opt_iter_count;
   LNK_SwitchState             import_table_emit_biat;
   LNK_SwitchState             import_table_emit_uiat;
@@ -396,6 +401,9 @@ typedef struct LNK_Config
   String8                     rad_chunk_map_name;
   String8                     rad_debug_name;
   String8                     rad_debug_alt_path;
+  String8                     link_state_name;
+  String8                     deferred_debug_info_name;
+  String8                     type_cache_name;
   LNK_IncludeSymbolList       include_symbol_list;
   LNK_AltNameList             alt_name_list;
   LNK_MergeDirectiveList      merge_list;
@@ -409,6 +417,8 @@ typedef struct LNK_Config
   String8                     temp_rad_chunk_map_name;
   String8                     delay_load_helper_name;
   String8List                 remove_sections;
+  String8                     order_file_name;
+  String8                     call_graph_file_name;
   LNK_IO_Flags                io_flags;
   HashTable                  *export_ht;
   HashTable                  *alt_name_ht;
@@ -602,6 +612,7 @@ internal Version lnk_get_default_subsystem_version(PE_WindowsSubsystem subsystem
 internal Version lnk_get_min_subsystem_version    (PE_WindowsSubsystem subsystem, COFF_MachineType machine);
 
 internal B32 lnk_do_debug_info        (LNK_Config *config);
+internal B32 lnk_do_pdb               (LNK_Config *config);
 internal B32 lnk_is_thread_pool_shared(LNK_Config *config);
 internal B32 lnk_is_section_removed   (LNK_Config *config, String8 section_name);
 internal B32 lnk_is_dll_delay_load    (LNK_Config *config, String8 dll_name);
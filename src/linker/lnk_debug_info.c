@@ -1,6 +1,13 @@
 // Copyright (c) Epic Games Tools
 // Licensed under the MIT license (https://opensource.org/license/mit/)
 
+internal
+THREAD_POOL_TASK_FUNC(lnk_parse_obj_debug_s_task)
+{
+  LNK_ParseObjDebugSTaskData *task = raw_task;
+  task->debug_s_arr[task_id] = cv_parse_debug_s(arena, task->sect_arr[task_id]);
+}
+
 internal
 THREAD_POOL_TASK_FUNC(lnk_parse_debug_s_task)
 {
@@ -11,25 +18,41 @@ THREAD_POOL_TASK_FUNC(lnk_parse_debug_s_task)
   String8List sect_list = task->sect_list_arr[obj_idx];
   CV_DebugS  *debug_s   = &task->debug_s_arr[obj_idx];
 
-  for (String8Node *node = sect_list.first; node != 0; node = node->next) {
-    // parse & merge sub sections
-    CV_DebugS ds = cv_parse_debug_s(arena, node->string);
-    cv_debug_s_concat_in_place(debug_s, &ds);
+  // objs compiled with /Gy have a .debug$S per function, parse these on other workers
+  if (sect_list.node_count >= LNK_DEBUG_S_PARSE_SPLIT_THRESHOLD) {
+    Temp scratch = scratch_begin(&arena, 1);
 
-    // make sure there is one string table
-    String8List string_data_list = cv_sub_section_from_debug_s(*debug_s, CV_C13SubSectionKind_StringTable);
-    if (string_data_list.node_count > 1) {
-      // TODO: print section index
-      lnk_error_obj(LNK_Warning_IllData, obj, ".debug$S has %u string table sub-sections defined, picking first sub-section", string_data_list.node_count);
+    LNK_ParseObjDebugSTaskData obj_task = {0};
+    obj_task.sect_arr    = str8_array_from_list(scratch.arena, &sect_list).v;
+    obj_task.debug_s_arr = push_array(scratch.arena, CV_DebugS, sect_list.node_count);
+    tp_for_parallel(task->tp, task->arena, sect_list.node_count, lnk_parse_obj_debug_s_task, &obj_task);
+
+    // merge sub sections in section order
+    for EachIndex(sect_idx, sect_list.node_count) {
+      cv_debug_s_concat_in_place(debug_s, &obj_task.debug_s_arr[sect_idx]);
     }
 
-    // make sure there is one file checksum table
-    String8List checksum_data_list = cv_sub_section_from_debug_s(*debug_s, CV_C13SubSectionKind_FileChksms);
-    if (checksum_data_list.node_count > 1) {
-      // TODO: print section index
-      lnk_error_obj(LNK_Warning_IllData, obj, ".debug$S has %u file checksum sub-sections defined, picking first sub-section", checksum_data_list.node_count);
+    scratch_end(scratch);
+  } else {
+    for (String8Node *node = sect_list.first; node != 0; node = node->next) {
+      CV_DebugS ds = cv_parse_debug_s(arena, node->string);
+      cv_debug_s_concat_in_place(debug_s, &ds);
     }
   }
+
+  // make sure there is one string table
+  String8List string_data_list = cv_sub_section_from_debug_s(*debug_s, CV_C13SubSectionKind_StringTable);
+  if (string_data_list.node_count > 1) {
+    // TODO: print section index
+    lnk_error_obj(LNK_Warning_IllData, obj, ".debug$S has %u string table sub-sections defined, picking first sub-section", string_data_list.node_count);
+  }
+
+  // make sure there is one file checksum table
+  String8List checksum_data_list = cv_sub_section_from_debug_s(*debug_s, CV_C13SubSectionKind_FileChksms);
+  if (checksum_data_list.node_count > 1) {
+    // TODO: print section index
+    lnk_error_obj(LNK_Warning_IllData, obj, ".debug$S has %u file checksum sub-sections defined, picking first sub-section", checksum_data_list.node_count);
+  }
 }
 
 internal CV_DebugS *
@@ -38,6 +61,8 @@ lnk_parse_debug_s_sections(TP_Context *tp, TP_Arena *arena, U64 obj_count, LNK_O
   ProfBeginFunction();
 
   LNK_ParseDebugSTaskData task_data = {0};
+  task_data.tp                      = tp;
+  task_data.arena                   = arena;
   task_data.obj_arr                 = obj_arr;
   task_data.sect_list_arr           = sect_list_arr;
   task_data.debug_s_arr             = push_array(arena->v[0], CV_DebugS, obj_count);
@@ -368,7 +393,7 @@ lnk_merge_debug_t_and_debug_p(Arena *arena, U64 obj_count, CV_DebugT *debug_t_ar
 }
 
 internal LNK_CodeViewInput
-lnk_make_code_view_input(TP_Context *tp, TP_Arena *tp_arena, LNK_IO_Flags io_flags, String8List lib_dir_list, String8List alt_pch_dirs, U64 obj_count, LNK_Obj **obj_arr)
+lnk_make_code_view_input(TP_Context *tp, TP_Arena *tp_arena, LNK_IO_Flags io_flags, String8List lib_dir_list, String8List alt_pch_dirs, B32 use_ghash, U64 obj_count, LNK_Obj **obj_arr)
 {
   ProfBegin("Extract CodeView");
   Temp scratch = scratch_begin(0,0);
@@ -380,6 +405,10 @@ lnk_make_code_view_input(TP_Context *tp, TP_Arena *tp_arena, LNK_IO_Flags io_fla
   String8List *debug_s_list_arr = lnk_collect_obj_sections(tp, tp_arena, obj_count, obj_arr, str8_lit(".debug$S"), collect_discarded_flag);
   String8List *debug_p_list_arr = lnk_collect_obj_sections(tp, tp_arena, obj_count, obj_arr, str8_lit(".debug$P"), collect_discarded_flag);
   String8List *debug_t_list_arr = lnk_collect_obj_sections(tp, tp_arena, obj_count, obj_arr, str8_lit(".debug$T"), collect_discarded_flag);
+  String8List *debug_h_list_arr = 0;
+  if (use_ghash) {
+    debug_h_list_arr = lnk_collect_obj_sections(tp, tp_arena, obj_count, obj_arr, str8_lit(".debug$H"), collect_discarded_flag);
+  }
   ProfEnd();
 
   if (lnk_get_log_status(LNK_Log_Debug) || PROFILE_TELEMETRY) {
@@ -420,6 +449,7 @@ lnk_make_code_view_input(TP_Context *tp, TP_Arena *tp_arena, LNK_IO_Flags io_fla
   CV_DebugS *sorted_debug_s_arr = push_array_no_zero(tp_arena->v[0], CV_DebugS, obj_count);
   CV_DebugT *sorted_debug_t_arr = push_array_no_zero(tp_arena->v[0], CV_DebugT, obj_count);
   CV_DebugT *sorted_debug_p_arr = push_array_no_zero(tp_arena->v[0], CV_DebugT, obj_count);
+  String8   *sorted_debug_h_arr = push_array(tp_arena->v[0], String8, obj_count);
   for (U64 obj_idx = 0; obj_idx < obj_count; ++obj_idx) {
     B32 is_type_server = cv_debug_t_is_type_server(debug_t_arr[obj_idx]);
     if (is_type_server) {
@@ -443,6 +473,11 @@ lnk_make_code_view_input(TP_Context *tp, TP_Arena *tp_arena, LNK_IO_Flags io_fla
       sorted_debug_s_arr[slot_idx] = debug_s_arr[obj_idx];
       sorted_debug_t_arr[slot_idx] = debug_t_arr[obj_idx];
       sorted_debug_p_arr[slot_idx] = debug_p_arr[obj_idx];
+
+      // hashes are matched to leaves by index, so only take .debug$H that pairs with a single .debug$T
+      if (debug_h_list_arr && debug_h_list_arr[obj_idx].node_count == 1 && debug_t_list_arr[obj_idx].node_count == 1) {
+        sorted_debug_h_arr[slot_idx] = debug_h_list_arr[obj_idx].first->string;
+      }
     }
   }
 
@@ -457,6 +492,7 @@ lnk_make_code_view_input(TP_Context *tp, TP_Arena *tp_arena, LNK_IO_Flags io_fla
   CV_DebugT *external_debug_t_arr = sorted_debug_t_arr + internal_count;
   CV_DebugT *internal_debug_p_arr = sorted_debug_p_arr;
   CV_DebugT *external_debug_p_arr = sorted_debug_p_arr + internal_count;
+  String8   *internal_debug_h_arr = sorted_debug_h_arr;
 
   ProfBegin("Parse Symbols");
 
@@ -753,6 +789,8 @@ lnk_make_code_view_input(TP_Context *tp, TP_Arena *tp_arena, LNK_IO_Flags io_fla
   cv.debug_p_arr                       = sorted_debug_p_arr;
   cv.debug_t_arr                       = sorted_debug_t_arr;
   cv.merged_debug_t_p_arr              = merged_debug_t_p_arr;
+  cv.debug_h_arr                       = sorted_debug_h_arr;
+  cv.use_ghash                         = use_ghash;
   cv.total_symbol_input_count          = total_symbol_input_count;
   cv.symbol_inputs                     = symbol_inputs;
   cv.parsed_symbols                    = parsed_symbols;
@@ -763,6 +801,7 @@ lnk_make_code_view_input(TP_Context *tp, TP_Arena *tp_arena, LNK_IO_Flags io_fla
   cv.internal_debug_t_arr              = internal_debug_t_arr;
   cv.external_debug_t_arr              = external_debug_t_arr;
   cv.internal_debug_p_arr              = internal_debug_p_arr;
+  cv.internal_debug_h_arr              = internal_debug_h_arr;
   cv.external_debug_p_arr              = external_debug_p_arr;
   cv.internal_total_symbol_input_count = internal_total_symbol_input_count;
   cv.internal_symbol_inputs            = internal_symbol_inputs;
@@ -1130,6 +1169,22 @@ skip_type_index_compare:;
   return are_equal;
 }
 
+internal void
+lnk_error_leaf_forward_ref(LNK_CodeViewInput *input, LNK_LeafLocType loc_type, U32 loc_idx, CV_LeafKind leaf_kind, CV_TypeIndex curr_ti, CV_TypeIndex sub_ti, U64 ti_offset)
+{
+  Temp scratch = scratch_begin(0,0);
+  String8 leaf_kind_str = cv_string_from_leaf_kind(leaf_kind);
+  String8 leaf_info     = push_str8f(scratch.arena, "LF_%S(type_index: 0x%x) forward refs member type index 0x%x (leaf struct offset: 0x%llx)", leaf_kind_str, curr_ti, sub_ti, ti_offset);
+  if (loc_type == LNK_LeafLocType_Internal) {
+    lnk_error_obj(LNK_Error_InvalidTypeIndex, input->internal_obj_arr[loc_idx], "%S", leaf_info);
+  } else if (loc_type == LNK_LeafLocType_External) {
+    lnk_error(LNK_Error_InvalidTypeIndex, "%S: %S", input->type_server_path_arr[loc_idx], leaf_info);
+  } else {
+    InvalidPath;
+  }
+  scratch_end(scratch);
+}
+
 internal U128
 lnk_hash_cv_leaf(Arena               *arena,
                  LNK_CodeViewInput   *input,
@@ -1141,6 +1196,12 @@ lnk_hash_cv_leaf(Arena               *arena,
                  CV_Leaf              leaf,
                  CV_TypeIndexInfoList ti_info_list)
 {
+  // leaves from objs without .debug$H must hash the same way as clang does,
+  // otherwise they won't dedup with leaves that have global hashes
+  if (input->use_ghash) {
+    return lnk_ghash_cv_leaf(arena, input, hashes, loc_type, loc_idx, ti_ranges, curr_ti, leaf, ti_info_list);
+  }
+
   // init hasher
   blake3_hasher hasher; blake3_hasher_init(&hasher);
 
@@ -1198,17 +1259,7 @@ lnk_hash_cv_leaf(Arena               *arena,
         // mix-in sub hash
         blake3_hasher_update(&hasher, &sub_hash, sizeof sub_hash);
       } else {
-        Temp scratch = scratch_begin(0,0);
-        String8 leaf_kind_str = cv_string_from_leaf_kind(leaf.kind);
-        String8 leaf_info     = push_str8f(scratch.arena, "LF_%S(type_index: 0x%x) forward refs member type index 0x%x (leaf struct offset: 0x%llx)", leaf_kind_str, curr_ti, sub_ti, ti_n->offset);
-        if (loc_type == LNK_LeafLocType_Internal) {
-          lnk_error_obj(LNK_Error_InvalidTypeIndex, input->internal_obj_arr[loc_idx], "%S", leaf_info);
-        } else if (loc_type == LNK_LeafLocType_External) {
-          lnk_error(LNK_Error_InvalidTypeIndex, "%S: %S", input->type_server_path_arr[loc_idx], leaf_info);
-        } else {
-          InvalidPath;
-        }
-        scratch_end(scratch);
+        lnk_error_leaf_forward_ref(input, loc_type, loc_idx, leaf.kind, curr_ti, sub_ti, ti_n->offset);
       }
     }
     // simple indices are stable across compile units 
@@ -1223,6 +1274,85 @@ lnk_hash_cv_leaf(Arena               *arena,
   return hash;
 }
 
+internal U128
+lnk_ghash_cv_leaf(Arena               *arena,
+                  LNK_CodeViewInput   *input,
+                  LNK_LeafHashes      *hashes,
+                  LNK_LeafLocType      loc_type,
+                  U32                  loc_idx,
+                  Rng1U64             *ti_ranges,
+                  CV_TypeIndex         curr_ti,
+                  CV_Leaf              leaf,
+                  CV_TypeIndexInfoList ti_info_list)
+{
+  // init hasher
+  blake3_hasher hasher; blake3_hasher_init(&hasher);
+
+  // hash record prefix
+  CV_LeafHeader header = {0};
+  header.size = (CV_LeafSize)(sizeof(header.kind) + leaf.data.size);
+  header.kind = leaf.kind;
+  blake3_hasher_update(&hasher, &header, sizeof header);
+
+  // hash leaf bytes with complex type indices replaced by global hashes of the sub leaves
+  U64 cursor = 0;
+  for (CV_TypeIndexInfo *ti_n = ti_info_list.first; ti_n != 0; ti_n = ti_n->next) {
+    blake3_hasher_update(&hasher, leaf.data.str + cursor, ti_n->offset - cursor);
+    cursor = ti_n->offset + sizeof(CV_TypeIndex);
+
+    CV_TypeIndex sub_ti = *(CV_TypeIndex *) (leaf.data.str + ti_n->offset);
+    if (sub_ti >= ti_ranges[ti_n->source].min) {
+      if (sub_ti < curr_ti) {
+        LNK_LeafRef sub_leaf_ref = lnk_leaf_ref_from_loc_idx_and_ti(input, loc_type, ti_n->source, loc_idx, sub_ti);
+        U128        sub_hash     = lnk_hash_from_leaf_ref(hashes, sub_leaf_ref);
+
+        // make sure sub hash was computed (:zero_hash_array)
+        Assert(!u128_match(sub_hash, u128_zero()));
+
+        blake3_hasher_update(&hasher, &sub_hash, LNK_GHASH_SIZE);
+      } else {
+        lnk_error_leaf_forward_ref(input, loc_type, loc_idx, leaf.kind, curr_ti, sub_ti, ti_n->offset);
+      }
+    }
+    // simple indices are stable across compile units
+    else {
+      blake3_hasher_update(&hasher, &sub_ti, sizeof sub_ti);
+    }
+  }
+  blake3_hasher_update(&hasher, leaf.data.str + cursor, leaf.data.size - cursor);
+
+  // global hashes are truncated BLAKE3, upper bits stay zero
+  U128 hash = {0};
+  blake3_hasher_finalize(&hasher, (U8 *) &hash, LNK_GHASH_SIZE);
+
+  return hash;
+}
+
+internal String8
+lnk_ghashes_from_debug_h(LNK_Obj *obj, String8 debug_h, U64 leaf_count)
+{
+  String8 ghashes = str8_zero();
+
+  LNK_DebugHHeader *header = str8_deserial_get_raw_ptr(debug_h, 0, sizeof(*header));
+  if (header == 0) {
+    lnk_error_obj(LNK_Warning_IllData, obj, ".debug$H is too small to hold the header, hashing types instead");
+  } else if (header->magic != LNK_DEBUG_H_MAGIC) {
+    lnk_error_obj(LNK_Warning_IllData, obj, ".debug$H has unknown magic 0x%x, hashing types instead", header->magic);
+  } else if (header->version != LNK_DEBUG_H_VERSION || header->hash_alg != LNK_GHashAlg_Blake3) {
+    // SHA1 hashes from older toolchains don't match hashes we compute for objs
+    // without .debug$H, hash leaves in this obj to keep dedup consistent
+  } else {
+    String8 hash_data = str8_skip(debug_h, sizeof(*header));
+    if (hash_data.size != leaf_count * LNK_GHASH_SIZE) {
+      lnk_error_obj(LNK_Warning_IllData, obj, ".debug$H has %llu hashes for %llu leaves in .debug$T, hashing types instead", hash_data.size / LNK_GHASH_SIZE, leaf_count);
+    } else {
+      ghashes = hash_data;
+    }
+  }
+
+  return ghashes;
+}
+
 internal void
 lnk_hash_cv_leaf_deep(Arena               *arena,
                       LNK_CodeViewInput   *input,
@@ -1425,6 +1555,20 @@ lnk_leaf_hash_table_search(LNK_LeafHashTable *ht, LNK_CodeViewInput *input, LNK_
   return match;
 }
 
+internal CV_TypeIndex
+lnk_type_index_from_leaf_ht(LNK_LeafHashTable *leaf_ht_arr, CV_TypeIndex **type_index_maps, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, CV_TypeIndexSource ti_source, LNK_LeafRef leaf_ref)
+{
+  // objs with a type index map skip the hash table search
+  if (type_index_maps && lnk_loc_type_from_leaf_ref(leaf_ref) == LNK_LeafLocType_Internal) {
+    CV_TypeIndex *map = type_index_maps[leaf_ref.enc_loc_idx];
+    if (map) {
+      return map[leaf_ref.enc_leaf_idx];
+    }
+  }
+  LNK_LeafBucket *bucket = lnk_leaf_hash_table_search(&leaf_ht_arr[ti_source], input, hashes, leaf_ref);
+  return bucket->type_index;
+}
+
 internal
 THREAD_POOL_TASK_FUNC(lnk_count_per_source_leaf_task)
 {
@@ -1507,7 +1651,26 @@ THREAD_POOL_TASK_FUNC(lnk_hash_debug_t_task)
     ti_ranges[ti_source] = rng_1u64(task->input->pch_arr[obj_idx].ti_lo, task->input->pch_arr[obj_idx].ti_hi + debug_t.count);
   }
 
-  for (U64 leaf_idx = 0; leaf_idx < debug_t.count; ++leaf_idx) {
+  // leaf hashes were loaded from the type cache
+  U64 hash_count = debug_t.count;
+  if (task->is_obj_cached && task->is_obj_cached[obj_idx]) {
+    hash_count = 0;
+  }
+
+  // compiler emitted global hashes, copy them instead of hashing leaves;
+  // objs with precompiled types are hashed since their leaves point into .debug$P of another obj
+  if (hash_count && task->debug_h_arr && task->debug_h_arr[obj_idx].size && task->input->pch_arr[obj_idx].ti_lo == task->input->pch_arr[obj_idx].ti_hi) {
+    String8 ghashes = lnk_ghashes_from_debug_h(task->input->internal_obj_arr[obj_idx], task->debug_h_arr[obj_idx], debug_t.count);
+    if (ghashes.size) {
+      for (U64 leaf_idx = 0; leaf_idx < debug_t.count; ++leaf_idx) {
+        MemoryZeroStruct(&out_hashes.v[leaf_idx]);
+        MemoryCopy(&out_hashes.v[leaf_idx], ghashes.str + leaf_idx * LNK_GHASH_SIZE, LNK_GHASH_SIZE);
+      }
+      hash_count = 0;
+    }
+  }
+
+  for (U64 leaf_idx = 0; leaf_idx < hash_count; ++leaf_idx) {
     Temp temp = temp_begin(fixed_arena);
 
     // :debug_zero_hash_assert make sure we don't write same hash more than once
@@ -2005,12 +2168,10 @@ THREAD_POOL_TASK_FUNC(lnk_patch_symbols_task)
       for (CV_TypeIndexInfo *ti_info = ti_list.first; ti_info != 0; ti_info = ti_info->next) {
         CV_TypeIndex *ti_ptr = (CV_TypeIndex *) (symnode->data.data.str + ti_info->offset);
         if (*ti_ptr >= ti_lo_arr[ti_info->source]) {
-          LNK_LeafHashTable *leaf_ht     = &task->leaf_ht_arr[ti_info->source];
-          LNK_LeafRef        leaf_ref    = lnk_leaf_ref_from_loc_idx_and_ti(task->input, loc_type, ti_info->source, loc_idx, *ti_ptr);
-          LNK_LeafBucket    *leaf_bucket = lnk_leaf_hash_table_search(leaf_ht, task->input, task->hashes, leaf_ref);
+          LNK_LeafRef leaf_ref = lnk_leaf_ref_from_loc_idx_and_ti(task->input, loc_type, ti_info->source, loc_idx, *ti_ptr);
 
           // we overwrite section memory directly
-          *ti_ptr = leaf_bucket->type_index;
+          *ti_ptr = lnk_type_index_from_leaf_ht(task->leaf_ht_arr, task->type_index_maps, task->input, task->hashes, ti_info->source, leaf_ref);
         }
       }
 
@@ -2024,7 +2185,8 @@ internal void
 lnk_patch_symbols(TP_Context         *tp,
                   LNK_CodeViewInput  *input,
                   LNK_LeafHashes     *hashes,
-                  LNK_LeafHashTable  *leaf_ht_arr)
+                  LNK_LeafHashTable  *leaf_ht_arr,
+                  CV_TypeIndex      **type_index_maps)
 {
   ProfBeginFunction();
   Temp scratch = scratch_begin(0,0);
@@ -2036,6 +2198,7 @@ lnk_patch_symbols(TP_Context         *tp,
   task.input           = input;
   task.hashes          = hashes;
   task.leaf_ht_arr     = leaf_ht_arr;
+  task.type_index_maps = type_index_maps;
   task.arena_arr       = alloc_fixed_size_arena_array(scratch.arena, tp->worker_count, max_ti_list_size, max_ti_list_size);
   tp_for_parallel(tp, 0, tp->worker_count, lnk_patch_symbols_task, &task);
 
@@ -2065,11 +2228,10 @@ THREAD_POOL_TASK_FUNC(lnk_patch_inlines_task)
       CV_TypeIndex *ti_ptr = (CV_TypeIndex *) (inline_data_node->string.str + ti_info->offset);
       CV_TypeIndex  ti_lo  = lnk_ti_lo_from_loc(task->input, loc_type, loc_idx, ti_info->source);
       if (*ti_ptr >= ti_lo) {
-        LNK_LeafRef     leaf_ref    = lnk_leaf_ref_from_loc_idx_and_ti(task->input, loc_type, ti_info->source, loc_idx, *ti_ptr);
-        LNK_LeafBucket *leaf_bucket = lnk_leaf_hash_table_search(&task->leaf_ht_arr[ti_info->source], task->input, task->hashes, leaf_ref);
+        LNK_LeafRef leaf_ref = lnk_leaf_ref_from_loc_idx_and_ti(task->input, loc_type, ti_info->source, loc_idx, *ti_ptr);
         
         // patch index
-        *ti_ptr = leaf_bucket->type_index;
+        *ti_ptr = lnk_type_index_from_leaf_ht(task->leaf_ht_arr, task->type_index_maps, task->input, task->hashes, ti_info->source, leaf_ref);
       }
     }
 
@@ -2085,16 +2247,18 @@ lnk_patch_inlines(TP_Context         *tp,
                   LNK_CodeViewInput  *input,
                   LNK_LeafHashes     *hashes,
                   LNK_LeafHashTable  *leaf_ht_arr,
+                  CV_TypeIndex      **type_index_maps,
                   U64                 obj_count,
                   CV_DebugS          *debug_s_arr)
 {
   ProfBeginFunction();
   
   LNK_PatchInlinesTask task = {0};
-  task.input       = input;
-  task.hashes      = hashes;
-  task.leaf_ht_arr = leaf_ht_arr;
-  task.debug_s_arr = debug_s_arr;
+  task.input           = input;
+  task.hashes          = hashes;
+  task.leaf_ht_arr     = leaf_ht_arr;
+  task.type_index_maps = type_index_maps;
+  task.debug_s_arr     = debug_s_arr;
   tp_for_parallel(tp, 0, obj_count, lnk_patch_inlines_task, &task);
 
   ProfEnd();
@@ -2124,12 +2288,10 @@ THREAD_POOL_TASK_FUNC(lnk_patch_leaves_task)
     for (CV_TypeIndexInfo *ti_info = ti_info_list.first; ti_info != 0; ti_info = ti_info->next) {
       CV_TypeIndex *ti_ptr = (CV_TypeIndex *) (leaf.data.str + ti_info->offset);
       if (*ti_ptr >= ti_lo) {
-        LNK_LeafHashTable *leaf_ht         = &task->leaf_ht_arr[ti_info->source];
-        LNK_LeafRef        sub_leaf_ref    = lnk_leaf_ref_from_loc_idx_and_ti(task->input, loc_type, ti_info->source, loc_idx, *ti_ptr);
-        LNK_LeafBucket    *sub_leaf_bucket = lnk_leaf_hash_table_search(leaf_ht, task->input, task->hashes, sub_leaf_ref);
+        LNK_LeafRef sub_leaf_ref = lnk_leaf_ref_from_loc_idx_and_ti(task->input, loc_type, ti_info->source, loc_idx, *ti_ptr);
 
          // patch index
-        *ti_ptr = sub_leaf_bucket->type_index;
+        *ti_ptr = lnk_type_index_from_leaf_ht(task->leaf_ht_arr, task->type_index_maps, task->input, task->hashes, ti_info->source, sub_leaf_ref);
       }
     }
 
@@ -2140,7 +2302,7 @@ THREAD_POOL_TASK_FUNC(lnk_patch_leaves_task)
 }
 
 internal void
-lnk_patch_leaves(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, LNK_LeafBucketArray bucket_arr)
+lnk_patch_leaves(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, CV_TypeIndex **type_index_maps, LNK_LeafBucketArray bucket_arr)
 {
   ProfBeginFunction();
   Temp scratch = scratch_begin(0,0);
@@ -2149,6 +2311,7 @@ lnk_patch_leaves(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashe
   task.input           = input;
   task.hashes          = hashes;
   task.leaf_ht_arr     = leaf_ht_arr;
+  task.type_index_maps = type_index_maps;
   task.bucket_arr      = bucket_arr.v;
   task.range_arr       = tp_divide_work(scratch.arena, bucket_arr.count, tp->worker_count);
   task.fixed_arena_arr = alloc_fixed_size_arena_array(scratch.arena, tp->worker_count, MB(1), MB(1));
@@ -2244,11 +2407,304 @@ THREAD_POOL_TASK_FUNC(lnk_post_process_cv_symbols_task)
   }
 }
 
+internal LNK_TypeCache *
+lnk_type_cache_from_file(Arena *arena, String8 path)
+{
+  ProfBeginFunction();
+
+  LNK_TypeCache *type_cache = push_array(arena, LNK_TypeCache, 1);
+
+  String8 data        = lnk_read_data_from_file_path(arena, 0, path);
+  U64     off         = 0;
+  U64     magic       = 0;
+  U64     version     = 0;
+  U64     entry_count = 0;
+  off += str8_deserial_read_struct(data, off, &magic);
+  off += str8_deserial_read_struct(data, off, &version);
+  off += str8_deserial_read_struct(data, off, &entry_count);
+
+  // stale or corrupted cache is not an error, we just rebuild it from scratch
+  U64 min_entry_size = sizeof(U128)*3 + sizeof(U64)*3;
+  if (magic != LNK_TYPE_CACHE_MAGIC || version != LNK_TYPE_CACHE_VERSION || entry_count > (data.size - Min(off, data.size)) / min_entry_size) {
+    entry_count = 0;
+  }
+
+  type_cache->key_ht = hash_table_init(arena, Max(entry_count, 1) * 2);
+  for EachIndex(entry_idx, entry_count) {
+    LNK_TypeCacheEntry *entry     = push_array(arena, LNK_TypeCacheEntry, 1);
+    U64                 read_size = 0;
+    read_size += str8_deserial_read_struct(data, off + read_size, &entry->key);
+    read_size += str8_deserial_read_struct(data, off + read_size, &entry->modified);
+    read_size += str8_deserial_read_struct(data, off + read_size, &entry->file_size);
+    read_size += str8_deserial_read_struct(data, off + read_size, &entry->section_hash);
+    read_size += str8_deserial_read_struct(data, off + read_size, &entry->prefix_key);
+    read_size += str8_deserial_read_struct(data, off + read_size, &entry->leaf_count);
+    if (read_size != min_entry_size) {
+      break;
+    }
+    off = AlignPow2(off + read_size, 16);
+
+    U64 leaves_size = entry->leaf_count * (sizeof(entry->hashes[0]) + sizeof(entry->type_indices[0]));
+    if (entry->leaf_count > max_U32 || off > data.size || leaves_size > data.size - off) {
+      break;
+    }
+    entry->hashes       = (U128 *)(data.str + off);
+    entry->type_indices = (CV_TypeIndex *)(data.str + off + entry->leaf_count * sizeof(entry->hashes[0]));
+    off = AlignPow2(off + leaves_size, 16);
+
+    hash_table_push_string_raw(arena, type_cache->key_ht, str8_struct(&entry->key), entry);
+  }
+
+  ProfEnd();
+  return type_cache;
+}
+
+internal void
+lnk_write_type_cache(String8 path, LNK_TypeCache *type_cache)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
+
+  String8List srl = {0};
+  str8_serial_begin(scratch.arena, &srl);
+  str8_serial_push_u64(scratch.arena, &srl, LNK_TYPE_CACHE_MAGIC);
+  str8_serial_push_u64(scratch.arena, &srl, LNK_TYPE_CACHE_VERSION);
+  str8_serial_push_u64(scratch.arena, &srl, type_cache->new_entries.count);
+  for EachIndex(entry_idx, type_cache->new_entries.count) {
+    LNK_TypeCacheEntry *entry = &type_cache->new_entries.v[entry_idx];
+    str8_serial_push_struct(scratch.arena, &srl, &entry->key);
+    str8_serial_push_u64(scratch.arena, &srl, entry->modified);
+    str8_serial_push_u64(scratch.arena, &srl, entry->file_size);
+    str8_serial_push_struct(scratch.arena, &srl, &entry->section_hash);
+    str8_serial_push_struct(scratch.arena, &srl, &entry->prefix_key);
+    str8_serial_push_u64(scratch.arena, &srl, entry->leaf_count);
+    str8_serial_push_align(scratch.arena, &srl, 16);
+    str8_serial_push_data(scratch.arena, &srl, entry->hashes, entry->leaf_count * sizeof(entry->hashes[0]));
+    str8_serial_push_data(scratch.arena, &srl, entry->type_indices, entry->leaf_count * sizeof(entry->type_indices[0]));
+    str8_serial_push_align(scratch.arena, &srl, 16);
+  }
+  lnk_write_data_list_to_file_path(path, str8_zero(), srl);
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+internal U128
+lnk_type_cache_section_hash(CV_DebugT debug_t)
+{
+  XXH3_state_t state;
+  XXH3_128bits_reset(&state);
+  for EachIndex(leaf_idx, debug_t.count) {
+    String8 raw_leaf = cv_debug_t_get_raw_leaf(debug_t, leaf_idx);
+    XXH3_128bits_update(&state, raw_leaf.str, raw_leaf.size);
+  }
+  XXH128_hash_t hash   = XXH3_128bits_digest(&state);
+  U128          result = { hash.low64, hash.high64 };
+  return result;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_type_cache_lookup_task)
+{
+  ProfBeginFunction();
+
+  LNK_TypeCacheLookupTask *task    = raw_task;
+  U64                      obj_idx = task_id;
+  LNK_Obj                 *obj     = task->input->internal_obj_arr[obj_idx];
+  LNK_PchInfo              pch     = task->input->pch_arr[obj_idx];
+  CV_DebugT                debug_t = task->input->merged_debug_t_p_arr[obj_idx];
+
+  // leaf hashes of objs that use precompiled types mix in hashes from .debug$P
+  // of another obj, so they can't be keyed on their own .debug$T
+  if (debug_t.count > 0 && pch.ti_lo == pch.ti_hi) {
+    task->is_obj_cacheable[obj_idx] = 1;
+
+    // objs are keyed on where they were read from, lib members on lib path and member offset
+    String8 file_path  = obj->path;
+    U64     member_off = 0;
+    if (obj->link_member) {
+      file_path  = obj->link_member->lib->path;
+      member_off = obj->link_member->lib->member_offsets[obj->link_member->member_idx];
+    }
+    FileProperties file_props = os_properties_from_file_path(file_path);
+
+    // hashes from different hash kinds never dedup with each other, so kind is part of the key
+    LNK_TypeCacheEntry *new_entry = &task->new_entries[obj_idx];
+    {
+      blake3_hasher hasher; blake3_hasher_init(&hasher);
+      blake3_hasher_update(&hasher, &task->input->use_ghash, sizeof(task->input->use_ghash));
+      blake3_hasher_update(&hasher, file_path.str, file_path.size);
+      blake3_hasher_update(&hasher, obj->path.str, obj->path.size);
+      blake3_hasher_update(&hasher, &member_off, sizeof(member_off));
+      blake3_hasher_finalize(&hasher, (U8 *)new_entry->key.u64, sizeof(new_entry->key.u64));
+    }
+    new_entry->modified   = file_props.modified;
+    new_entry->file_size  = file_props.size;
+    new_entry->leaf_count = debug_t.count;
+    new_entry->hashes     = task->hashes->internal_hashes[obj_idx][CV_TypeIndexSource_TPI].v;
+
+    // unchanged time stamp and size are trusted, otherwise fall back to hashing leaves
+    // so a touched-but-identical obj still hits
+    LNK_TypeCacheEntry *entry    = hash_table_search_string_raw(task->type_cache->key_ht, str8_struct(&new_entry->key));
+    B32                 is_match = 0;
+    if (entry && entry->leaf_count == debug_t.count) {
+      if (file_props.modified != 0 && entry->modified == file_props.modified && entry->file_size == file_props.size) {
+        new_entry->section_hash = entry->section_hash;
+        is_match = 1;
+      }
+    }
+    if (!is_match) {
+      new_entry->section_hash = lnk_type_cache_section_hash(debug_t);
+      is_match = entry && entry->leaf_count == debug_t.count && u128_match(entry->section_hash, new_entry->section_hash);
+    }
+
+    if (is_match) {
+      MemoryCopyTyped(new_entry->hashes, entry->hashes, debug_t.count);
+      task->old_entries[obj_idx]   = entry;
+      task->is_obj_cached[obj_idx] = 1;
+    }
+  }
+
+  ProfEnd();
+}
+
+internal void
+lnk_type_cache_lookup(TP_Context *tp, LNK_TypeCache *type_cache, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_TypeCacheEntry *new_entries, B8 *is_obj_cacheable, B8 *is_obj_cached, CV_TypeIndex **type_index_maps)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
+
+  LNK_TypeCacheLookupTask task = {0};
+  task.input                   = input;
+  task.hashes                  = hashes;
+  task.type_cache              = type_cache;
+  task.new_entries             = new_entries;
+  task.old_entries             = push_array(scratch.arena, LNK_TypeCacheEntry *, input->internal_count);
+  task.is_obj_cacheable        = is_obj_cacheable;
+  task.is_obj_cached           = is_obj_cached;
+  tp_for_parallel(tp, 0, input->internal_count, lnk_type_cache_lookup_task, &task);
+
+  for EachIndex(obj_idx, input->internal_count) {
+    if (is_obj_cacheable[obj_idx]) {
+      if (is_obj_cached[obj_idx]) { type_cache->hit_count  += 1; }
+      else                        { type_cache->miss_count += 1; }
+    }
+  }
+
+  // Output type indices are assigned in { obj index, leaf index } order of the first
+  // occurrence of a leaf, so index of a leaf depends only on the objs up to the one
+  // where it first occurs. Type index maps are safe to reuse as long as every obj
+  // before and including the obj is unchanged, which is what the prefix key tracks.
+  // Objs with precompiled types aren't keyed and break the chain for objs after them.
+  {
+    U128 prefix_key      = {0};
+    B32  is_prefix_valid = 1;
+    for EachIndex(obj_idx, input->internal_count) {
+      if (input->merged_debug_t_p_arr[obj_idx].count == 0) { continue; }
+      if (!is_obj_cacheable[obj_idx]) { is_prefix_valid = 0; continue; }
+      if (!is_prefix_valid) { continue; }
+
+      LNK_TypeCacheEntry *new_entry = &new_entries[obj_idx];
+      blake3_hasher hasher; blake3_hasher_init(&hasher);
+      blake3_hasher_update(&hasher, &prefix_key, sizeof(prefix_key));
+      blake3_hasher_update(&hasher, &new_entry->key, sizeof(new_entry->key));
+      blake3_hasher_update(&hasher, &new_entry->section_hash, sizeof(new_entry->section_hash));
+      blake3_hasher_finalize(&hasher, (U8 *)prefix_key.u64, sizeof(prefix_key.u64));
+      new_entry->prefix_key = prefix_key;
+
+      LNK_TypeCacheEntry *old_entry = task.old_entries[obj_idx];
+      if (old_entry && u128_match(old_entry->prefix_key, prefix_key)) {
+        type_index_maps[obj_idx] = old_entry->type_indices;
+        type_cache->map_hit_count += 1;
+      }
+    }
+  }
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_type_cache_map_task)
+{
+  ProfBeginFunction();
+
+  LNK_TypeCacheMapTask *task    = raw_task;
+  U64                   obj_idx = task_id;
+
+  if (task->is_obj_cacheable[obj_idx] && task->type_index_maps[obj_idx] == 0) {
+    CV_DebugT     debug_t = task->input->merged_debug_t_p_arr[obj_idx];
+    CV_TypeIndex *map     = task->new_entries[obj_idx].type_indices;
+    for EachIndex(leaf_idx, debug_t.count) {
+      CV_LeafHeader      *leaf_header = cv_debug_t_get_leaf_header(debug_t, leaf_idx);
+      CV_TypeIndexSource  ti_source   = cv_type_index_source_from_leaf_kind(leaf_header->kind);
+      LNK_LeafBucket     *bucket      = lnk_leaf_hash_table_search(&task->leaf_ht_arr[ti_source], task->input, task->hashes, lnk_obj_leaf_ref(obj_idx, leaf_idx));
+      map[leaf_idx] = bucket->type_index;
+    }
+  }
+
+  ProfEnd();
+}
+
+internal void
+lnk_type_cache_build_maps(TP_Context *tp, Arena *arena, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, LNK_TypeCacheEntry *new_entries, B8 *is_obj_cacheable, CV_TypeIndex **type_index_maps)
+{
+  ProfBeginFunction();
+
+  for EachIndex(obj_idx, input->internal_count) {
+    if (!is_obj_cacheable[obj_idx]) { continue; }
+    if (type_index_maps[obj_idx]) {
+      new_entries[obj_idx].type_indices = type_index_maps[obj_idx];
+    } else {
+      new_entries[obj_idx].type_indices = push_array_no_zero(arena, CV_TypeIndex, new_entries[obj_idx].leaf_count);
+    }
+  }
+
+  LNK_TypeCacheMapTask task = {0};
+  task.input            = input;
+  task.hashes           = hashes;
+  task.leaf_ht_arr      = leaf_ht_arr;
+  task.new_entries      = new_entries;
+  task.is_obj_cacheable = is_obj_cacheable;
+  task.type_index_maps  = type_index_maps;
+  tp_for_parallel(tp, 0, input->internal_count, lnk_type_cache_map_task, &task);
+
+  // patching goes through the maps from here on
+  for EachIndex(obj_idx, input->internal_count) {
+    if (is_obj_cacheable[obj_idx]) {
+      type_index_maps[obj_idx] = new_entries[obj_idx].type_indices;
+    }
+  }
+
+  ProfEnd();
+}
+
+internal void
+lnk_type_cache_update(Arena *arena, LNK_TypeCache *type_cache, LNK_CodeViewInput *input, LNK_TypeCacheEntry *new_entries, B8 *is_obj_cacheable)
+{
+  ProfBeginFunction();
+
+  // cache keeps entries only for objs in the current link, so it doesn't grow unbounded
+  LNK_TypeCacheEntryArray entries = { .v = push_array(arena, LNK_TypeCacheEntry, input->internal_count) };
+  for EachIndex(obj_idx, input->internal_count) {
+    if (is_obj_cacheable[obj_idx]) {
+      entries.v[entries.count++] = new_entries[obj_idx];
+    }
+  }
+  type_cache->new_entries = entries;
+
+  ProfEnd();
+}
+
 internal CV_DebugT *
-lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input)
+lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input, LNK_TypeCache *type_cache)
 {
   ProfBegin("Import Types");
 
+  LNK_TypeCacheEntry  *cache_entries    = 0;
+  B8                  *is_obj_cacheable = 0;
+  CV_TypeIndex       **type_index_maps  = 0;
+
   ProfBegin("Hash Leaves");
   LNK_LeafHashes *hashes = push_array(tp_temp->v[0], LNK_LeafHashes, 1);
   {
@@ -2291,10 +2747,21 @@ lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input)
     }
     ProfEnd();
 
+    // objs with unchanged types pull leaf hashes from the cache and skip hashing
+    B8 *is_obj_cached = 0;
+    if (type_cache) {
+      cache_entries    = push_array(tp_temp->v[0], LNK_TypeCacheEntry, input->internal_count);
+      is_obj_cacheable = push_array(tp_temp->v[0], B8, input->internal_count);
+      is_obj_cached    = push_array(scratch.arena, B8, input->internal_count);
+      type_index_maps  = push_array(tp_temp->v[0], CV_TypeIndex *, input->internal_count);
+      lnk_type_cache_lookup(tp, type_cache, input, hashes, cache_entries, is_obj_cacheable, is_obj_cached, type_index_maps);
+    }
+
     LNK_LeafHasherTask task = {0};
-    task.input        = input;
-    task.hashes       = hashes;
-    task.fixed_arenas = alloc_fixed_size_arena_array(scratch.arena, tp->worker_count, MB(1), MB(1));
+    task.input         = input;
+    task.hashes        = hashes;
+    task.fixed_arenas  = alloc_fixed_size_arena_array(scratch.arena, tp->worker_count, MB(1), MB(1));
+    task.is_obj_cached = is_obj_cached;
 
     // hash .debug$P first so we can mix in hashes for precompiled sub leaves when hashing leaves in .debug$T
     ProfBeginDynamic("Hash .debug$P [Count: %llu]", input->internal_count);
@@ -2307,7 +2774,9 @@ lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input)
     ProfBegin("Hash .debug$T [Count: %.*s]", str8_varg(count_string));
 #endif
     task.debug_t_arr = input->internal_debug_t_arr;
+    task.debug_h_arr = input->internal_debug_h_arr;
     tp_for_parallel(tp, 0, input->internal_count, lnk_hash_debug_t_task, &task);
+    task.debug_h_arr = 0;
     ProfEnd();
 
     ProfBegin("Hash Type Server Leaves [Count: %.*s]", str8_varg(count_string));
@@ -2410,11 +2879,18 @@ lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input)
   lnk_assign_type_indices(tp, tpi_arr, CV_MinComplexTypeIndex);
   lnk_assign_type_indices(tp, ipi_arr, CV_MinComplexTypeIndex);
 
+  // cached objs reuse type index maps from the previous link, the rest are built
+  // before patching since patching rewrites leaves the hash table compares against
+  if (type_cache) {
+    lnk_type_cache_build_maps(tp, tp_temp->v[0], input, hashes, leaf_ht_arr, cache_entries, is_obj_cacheable, type_index_maps);
+    lnk_type_cache_update(tp_temp->v[0], type_cache, input, cache_entries, is_obj_cacheable);
+  }
+
   // patch indices in symbols, inline sites, and leaves
-  lnk_patch_symbols(tp, input, hashes, leaf_ht_arr);
-  lnk_patch_inlines(tp, input, hashes, leaf_ht_arr, input->count, input->debug_s_arr);
-  lnk_patch_leaves(tp, input, hashes, leaf_ht_arr, tpi_arr);
-  lnk_patch_leaves(tp, input, hashes, leaf_ht_arr, ipi_arr);
+  lnk_patch_symbols(tp, input, hashes, leaf_ht_arr, type_index_maps);
+  lnk_patch_inlines(tp, input, hashes, leaf_ht_arr, type_index_maps, input->count, input->debug_s_arr);
+  lnk_patch_leaves(tp, input, hashes, leaf_ht_arr, type_index_maps, tpi_arr);
+  lnk_patch_leaves(tp, input, hashes, leaf_ht_arr, type_index_maps, ipi_arr);
 
   CV_DebugT tpi_types = lnk_unbucket_leaf_array(tp, tp_temp->v[0], input, tpi_arr);
   CV_DebugT ipi_types = lnk_unbucket_leaf_array(tp, tp_temp->v[0], input, ipi_arr);
@@ -3005,6 +3481,16 @@ THREAD_POOL_TASK_FUNC(lnk_push_dbi_sec_contrib_task)
   }
 }
 
+internal int
+lnk_pub32_is_before(void *raw_a, void *raw_b)
+{
+  CV_SymbolNode **a = raw_a;
+  CV_SymbolNode **b = raw_b;
+  String8 a_name = cv_name_from_symbol((*a)->data.kind, (*a)->data.data);
+  String8 b_name = cv_name_from_symbol((*b)->data.kind, (*b)->data.data);
+  return str8_is_before(a_name, b_name);
+}
+
 internal
 THREAD_POOL_TASK_FUNC(lnk_build_pdb_public_symbols_defined_task)
 {
@@ -3057,6 +3543,84 @@ THREAD_POOL_TASK_FUNC(lnk_gsi_hash_cv_list_task)
   ProfEnd();
 }
 
+internal
+THREAD_POOL_TASK_FUNC(lnk_copy_pdb_debug_s_task)
+{
+  U64                   obj_idx = task_id;
+  LNK_CopyPdbInputTask *task    = raw_task;
+  CV_DebugS            *src     = &task->src_debug_s_arr[obj_idx];
+  CV_DebugS            *dst     = &task->dst_debug_s_arr[obj_idx];
+
+  // PDB patches string offsets in checksums and checksum offsets in lines and frame data
+  CV_C13SubSectionIdxKind checksums_idx  = cv_c13_sub_section_idx_from_kind(CV_C13SubSectionKind_FileChksms);
+  CV_C13SubSectionIdxKind lines_idx      = cv_c13_sub_section_idx_from_kind(CV_C13SubSectionKind_Lines);
+  CV_C13SubSectionIdxKind frame_data_idx = cv_c13_sub_section_idx_from_kind(CV_C13SubSectionKind_FrameData);
+
+  for EachIndex(idx, CV_C13SubSectionIdxKind_COUNT) {
+    B32 is_patched = idx == checksums_idx || idx == lines_idx || idx == frame_data_idx;
+    for (String8Node *data_n = src->data_list[idx].first; data_n != 0; data_n = data_n->next) {
+      String8 data = is_patched ? push_str8_copy(arena, data_n->string) : data_n->string;
+      str8_list_push(arena, &dst->data_list[idx], data);
+    }
+  }
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_copy_pdb_symbols_task)
+{
+  LNK_CopyPdbInputTask     *task = raw_task;
+  LNK_CodeViewSymbolsInput *src  = &task->src_symbol_inputs[task_id];
+  LNK_CodeViewSymbolsInput *dst  = &task->dst_symbol_inputs[task_id];
+
+  *dst             = *src;
+  dst->symbol_list = &task->dst_symbol_lists[task_id];
+  dst->symbol_list->signature = src->symbol_list->signature;
+
+  for (CV_SymbolNode *symbol_n = src->symbol_list->first; symbol_n != 0; symbol_n = symbol_n->next) {
+    CV_SymbolNode *copy = cv_symbol_list_push(arena, dst->symbol_list);
+    copy->data          = symbol_n->data;
+
+    // parent and end offsets are patched in place when PDB serializes symbols
+    if (cv_is_scope_symbol(symbol_n->data.kind)) {
+      copy->data.data = push_str8_copy(arena, symbol_n->data.data);
+    }
+  }
+}
+
+internal LNK_CodeViewInput
+lnk_copy_code_view_input_for_pdb(TP_Context *tp, TP_Arena *arena, LNK_CodeViewInput *input)
+{
+  ProfBeginFunction();
+
+  LNK_CopyPdbInputTask task = {0};
+  task.src_debug_s_arr      = input->debug_s_arr;
+  task.dst_debug_s_arr      = push_array(arena->v[0], CV_DebugS, input->count);
+  task.src_symbol_inputs    = input->symbol_inputs;
+  task.dst_symbol_inputs    = push_array_no_zero(arena->v[0], LNK_CodeViewSymbolsInput, input->total_symbol_input_count);
+  task.dst_symbol_lists     = push_array(arena->v[0], CV_SymbolList, input->total_symbol_input_count);
+  tp_for_parallel(tp, arena, input->count, lnk_copy_pdb_debug_s_task, &task);
+  tp_for_parallel(tp, arena, input->total_symbol_input_count, lnk_copy_pdb_symbols_task, &task);
+
+  // symbol lists are reserved in obj order, see lnk_make_code_view_input
+  CV_SymbolListArray *parsed_symbols = push_array_no_zero(arena->v[0], CV_SymbolListArray, input->count);
+  for (U64 obj_idx = 0, input_idx = 0; obj_idx < input->count; ++obj_idx) {
+    CV_SymbolListArray src = input->parsed_symbols[obj_idx];
+    Assert(src.count == 0 || src.v == input->symbol_inputs[input_idx].symbol_list);
+    parsed_symbols[obj_idx].count = src.count;
+    parsed_symbols[obj_idx].v     = src.count > 0 ? &task.dst_symbol_lists[input_idx] : 0;
+    input_idx += src.count;
+  }
+
+  // only inputs that PDB build mutates are replaced, the rest is shared with the source
+  LNK_CodeViewInput result = *input;
+  result.debug_s_arr       = task.dst_debug_s_arr;
+  result.symbol_inputs     = task.dst_symbol_inputs;
+  result.parsed_symbols    = parsed_symbols;
+
+  ProfEnd();
+  return result;
+}
+
 internal void
 lnk_build_pdb_public_symbols(TP_Context            *tp,
                              TP_Arena              *arena,
@@ -3075,6 +3639,12 @@ lnk_build_pdb_public_symbols(TP_Context            *tp,
 
   CV_SymbolPtrArray symbols = cv_symbol_ptr_array_from_list(scratch.arena, tp, tp->worker_count, task.pub_list_arr);
 
+  // symbol table chunks are filled by whichever worker inserted the symbol,
+  // sort so the publics stream doesn't change between links
+  ProfBegin("Sort");
+  radsort(symbols.v, symbols.count, lnk_pub32_is_before);
+  ProfEnd();
+
   ProfBegin("GSI Push");
   gsi_push_many_arr(tp, psi->gsi, symbols.count, symbols.v);
   ProfEnd();
@@ -3095,7 +3665,8 @@ lnk_build_pdb(TP_Context               *tp,
               U64                       total_symbol_input_count,
               LNK_CodeViewSymbolsInput *symbol_inputs,
               CV_SymbolListArray       *parsed_symbols,
-              CV_DebugT                 types[CV_TypeIndexSource_COUNT])
+              CV_DebugT                 types[CV_TypeIndexSource_COUNT],
+              PDB_PsiContext           *publics)
 {
   ProfBegin("PDB");
   Temp scratch = scratch_begin(tp_arena->v, tp_arena->count);
@@ -3307,7 +3878,13 @@ lnk_build_pdb(TP_Context               *tp,
   }
   ProfEnd();
   
-  lnk_build_pdb_public_symbols(tp, tp_arena, symtab, pdb->psi);
+  // publics may already be built in the background during image layout
+  if (publics) {
+    psi_release(&pdb->psi);
+    pdb->psi = publics;
+  } else {
+    lnk_build_pdb_public_symbols(tp, tp_arena, symtab, pdb->psi);
+  }
   
   pdb_build(tp, tp_arena, pdb, string_ht);
 
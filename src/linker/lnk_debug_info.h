@@ -34,6 +34,8 @@ typedef struct LNK_CodeViewInput
   CV_DebugT      *debug_p_arr;          // [count]
   CV_DebugT      *debug_t_arr;          // [count]
   CV_DebugT      *merged_debug_t_p_arr; // [count]
+  String8        *debug_h_arr;          // [count]
+  B32             use_ghash;
 
   U64                       total_symbol_input_count;
   LNK_CodeViewSymbolsInput *symbol_inputs;  // [total_symbol_input_count]
@@ -43,6 +45,7 @@ typedef struct LNK_CodeViewInput
   CV_DebugS                *internal_debug_s_arr;     // [internal_count]
   CV_DebugT                *internal_debug_t_arr;     // [internal_count]
   CV_DebugT                *internal_debug_p_arr;     // [internal_count]
+  String8                  *internal_debug_h_arr;     // [internal_count]
   U64                      internal_total_symbol_input_count;
   LNK_CodeViewSymbolsInput *internal_symbol_inputs;   // [internal_total_symbol_input_count]
   CV_SymbolListArray       *internal_parsed_symbols;  // [internal_count]
@@ -118,15 +121,79 @@ typedef union
   U128Array **v[CV_TypeIndexSource_COUNT];
 } LNK_LeafHashes;
 
+// --- Global Type Hashes ------------------------------------------------------
+
+// clang-cl /Z7 -gcodeview-ghash emits .debug$H next to .debug$T with one hash per leaf,
+// hash is computed over the leaf with type indices replaced by hashes of the referenced leaves
+#define LNK_DEBUG_H_MAGIC   0x133C9C5
+#define LNK_DEBUG_H_VERSION 0
+#define LNK_GHASH_SIZE      8
+
+typedef enum
+{
+  LNK_GHashAlg_Sha1   = 0,
+  LNK_GHashAlg_Sha1_8 = 1,
+  LNK_GHashAlg_Blake3 = 2,
+} LNK_GHashAlg;
+
+typedef struct LNK_DebugHHeader
+{
+  U32 magic;
+  U16 version;
+  U16 hash_alg;
+} LNK_DebugHHeader;
+
+// --- Type Cache --------------------------------------------------------------
+
+#define LNK_TYPE_CACHE_MAGIC   0x53455059544b4c52ull // RLKTYPES
+#define LNK_TYPE_CACHE_VERSION 3
+
+typedef struct LNK_TypeCacheEntry
+{
+  U128          key;          // blake3 of obj path, lib path and member offset, and leaf hash kind
+  U64           modified;     // time stamp of the file obj was read from
+  U64           file_size;
+  U128          section_hash; // xxhash of the raw leaves, checked only when time stamp or size changed
+  U128          prefix_key;   // chained keys of this and preceding objs, zero when chain is broken
+  U64           leaf_count;
+  U128         *hashes;
+  CV_TypeIndex *type_indices; // obj leaf index -> output type index
+} LNK_TypeCacheEntry;
+
+typedef struct LNK_TypeCacheEntryArray
+{
+  U64                 count;
+  LNK_TypeCacheEntry *v;
+} LNK_TypeCacheEntryArray;
+
+typedef struct LNK_TypeCache
+{
+  HashTable               *key_ht;      // key -> LNK_TypeCacheEntry *, entries loaded from disk
+  LNK_TypeCacheEntryArray  new_entries; // entries for objs in current link, written back to disk
+  U64                      hit_count;
+  U64                      miss_count;
+  U64                      map_hit_count;
+} LNK_TypeCache;
+
 // --- Symbol Parsing Tasks ----------------------------------------------------
 
+#define LNK_DEBUG_S_PARSE_SPLIT_THRESHOLD 256
+
 typedef struct
 {
+  TP_Context  *tp;
+  TP_Arena    *arena;
   LNK_Obj    **obj_arr;
   String8List *sect_list_arr;
   CV_DebugS   *debug_s_arr;
 } LNK_ParseDebugSTaskData;
 
+typedef struct
+{
+  String8   *sect_arr;
+  CV_DebugS *debug_s_arr;
+} LNK_ParseObjDebugSTaskData;
+
 typedef struct
 {
   LNK_Obj     **obj_arr;
@@ -169,8 +236,32 @@ typedef struct
   LNK_LeafHashes    *hashes;
   Arena            **fixed_arenas;
   CV_DebugT         *debug_t_arr;
+  String8           *debug_h_arr;
+  B8                *is_obj_cached;
 } LNK_LeafHasherTask;
 
+typedef struct
+{
+  LNK_CodeViewInput   *input;
+  LNK_LeafHashes      *hashes;
+  LNK_TypeCache       *type_cache;
+  LNK_TypeCacheEntry  *new_entries;
+  LNK_TypeCacheEntry **old_entries;
+  B8                  *is_obj_cacheable;
+  B8                  *is_obj_cached;
+} LNK_TypeCacheLookupTask;
+
+typedef struct
+{
+  LNK_CodeViewInput  *input;
+  LNK_LeafHashes     *hashes;
+  LNK_LeafHashTable  *leaf_ht_arr;
+  LNK_TypeCacheEntry *new_entries;
+  B8                 *is_obj_cacheable;
+  CV_TypeIndex      **type_index_maps;
+  Arena              *arena;
+} LNK_TypeCacheMapTask;
+
 typedef struct
 {
   LNK_CodeViewInput  *input;
@@ -240,6 +331,7 @@ typedef struct
   LNK_CodeViewInput  *input;
   LNK_LeafHashes     *hashes;
   LNK_LeafHashTable  *leaf_ht_arr;
+  CV_TypeIndex      **type_index_maps;
   CV_SymbolList      *symbol_list_arr;
   Arena             **arena_arr;
 } LNK_PatchSymbolTypesTask;
@@ -249,6 +341,7 @@ typedef struct
   LNK_CodeViewInput *input;
   LNK_LeafHashes    *hashes;
   LNK_LeafHashTable *leaf_ht_arr;
+  CV_TypeIndex     **type_index_maps;
   CV_DebugS         *debug_s_arr;
 } LNK_PatchInlinesTask;
 
@@ -257,6 +350,7 @@ typedef struct
   LNK_CodeViewInput  *input;
   LNK_LeafHashes     *hashes;
   LNK_LeafHashTable  *leaf_ht_arr;
+  CV_TypeIndex      **type_index_maps;
   LNK_LeafBucket    **bucket_arr;
   Rng1U64            *range_arr;
   Arena             **fixed_arena_arr;
@@ -311,6 +405,15 @@ typedef struct
   String8List    *globrefs_arr;
 } LNK_WriteModuleDataTask;
 
+typedef struct
+{
+  CV_DebugS                *src_debug_s_arr;
+  CV_DebugS                *dst_debug_s_arr;
+  LNK_CodeViewSymbolsInput *src_symbol_inputs;
+  LNK_CodeViewSymbolsInput *dst_symbol_inputs;
+  CV_SymbolList            *dst_symbol_lists;
+} LNK_CopyPdbInputTask;
+
 typedef struct
 {
   LNK_Obj                   **obj_arr;
@@ -499,7 +602,7 @@ internal CV_DebugT *       lnk_parse_debug_t_sections(TP_Context *tp, TP_Arena *
 internal CV_SymbolList *   lnk_cv_symbol_list_arr_from_debug_s_arr(TP_Context *tp, TP_Arena *arena, U64 obj_count, CV_DebugS *debug_s_arr);
 internal LNK_PchInfo *     lnk_setup_pch(Arena *arena, U64 obj_count, LNK_Obj **obj_arr, CV_DebugT *debug_t_arr, CV_DebugT *debug_p_arr, CV_SymbolListArray *parsed_symbols, String8List alt_pch_dirs);
 
-internal LNK_CodeViewInput lnk_make_code_view_input(TP_Context *tp, TP_Arena *tp_arena, LNK_IO_Flags io_flags, String8List lib_dir_list, String8List alt_pch_dirs, U64 objs_count, LNK_Obj **objs);
+internal LNK_CodeViewInput lnk_make_code_view_input(TP_Context *tp, TP_Arena *tp_arena, LNK_IO_Flags io_flags, String8List lib_dir_list, String8List alt_pch_dirs, B32 use_ghash, U64 objs_count, LNK_Obj **objs);
 
 internal LNK_LeafRef      lnk_leaf_ref(U32 idx, U32 leaf_idx);
 internal LNK_LeafRef      lnk_obj_leaf_ref(U32 obj_idx, U32 leaf_idx);
@@ -516,10 +619,14 @@ internal U128             lnk_hash_from_leaf_ref(LNK_LeafHashes *hashes, LNK_Lea
 internal LNK_LeafRef      lnk_leaf_ref_from_loc_idx_and_ti(LNK_CodeViewInput *input, LNK_LeafLocType loc_type, CV_TypeIndexSource ti_source, U64 loc_idx, CV_TypeIndex obj_ti);
 internal B32              lnk_match_leaf_ref(LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafRef a, LNK_LeafRef b);
 internal B32              lnk_match_leaf_ref_deep(Arena *arena, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafRef a, LNK_LeafRef b);
+internal void             lnk_error_leaf_forward_ref(LNK_CodeViewInput *input, LNK_LeafLocType loc_type, U32 loc_idx, CV_LeafKind leaf_kind, CV_TypeIndex curr_ti, CV_TypeIndex sub_ti, U64 ti_offset);
 internal U128             lnk_hash_cv_leaf(Arena *arena, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafLocType loc_type, U32 loc_idx, Rng1U64 *ti_ranges, CV_TypeIndex curr_ti, CV_Leaf leaf, CV_TypeIndexInfoList ti_info_list);
+internal U128             lnk_ghash_cv_leaf(Arena *arena, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafLocType loc_type, U32 loc_idx, Rng1U64 *ti_ranges, CV_TypeIndex curr_ti, CV_Leaf leaf, CV_TypeIndexInfoList ti_info_list);
+internal String8          lnk_ghashes_from_debug_h(LNK_Obj *obj, String8 debug_h, U64 leaf_count);
 internal void             lnk_hash_cv_leaf_deep(Arena *arena, LNK_CodeViewInput *input, Rng1U64 *ti_ranges, CV_DebugT *leaves, LNK_LeafHashes *hashes, LNK_LeafLocType loc_type, U32 loc_idx, CV_TypeIndexInfoList ti_info_list, String8 data);
 internal LNK_LeafBucket * lnk_leaf_hash_table_insert_or_update(LNK_LeafHashTable *leaf_ht, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, U128 hash, LNK_LeafBucket *new_bucket);
 internal LNK_LeafBucket * lnk_leaf_hash_table_search(LNK_LeafHashTable *ht, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafRef leaf_ref);
+internal CV_TypeIndex     lnk_type_index_from_leaf_ht(LNK_LeafHashTable *leaf_ht_arr, CV_TypeIndex **type_index_maps, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, CV_TypeIndexSource ti_source, LNK_LeafRef leaf_ref);
 
 internal void                lnk_cv_debug_t_count_leaves_per_source(TP_Context *tp, U64 count, CV_DebugT *debug_t_arr, U64 *per_source_count_arr);
 internal void                lnk_hash_debug_t_arr(TP_Context *tp, Arena *arena, U64 obj_count, CV_DebugT *debug_t_arr, U128Array *hash_arr_arr);
@@ -527,11 +634,14 @@ internal LNK_LeafBucketArray lnk_present_bucket_array_from_leaf_hash_table(TP_Co
 internal void                lnk_leaf_bucket_array_sort_radix_subset_parallel(TP_Context *tp, U64 bucket_count, U64 loc_idx_max, LNK_LeafBucket **dst, LNK_LeafBucket **src);
 internal void                lnk_leaf_bucket_array_sort_radix_parallel(TP_Context *tp, LNK_LeafBucketArray arr, U64 obj_count, U64 type_server_count);
 internal void                lnk_assign_type_indices(TP_Context *tp, LNK_LeafBucketArray bucket_arr, CV_TypeIndex min_type_index);
-internal void                lnk_patch_symbols(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr);
-internal void                lnk_patch_inlines(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, U64 obj_count, CV_DebugS *debug_s_arr);
-internal void                lnk_patch_leaves(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, LNK_LeafBucketArray bucket_arr);
+internal void                lnk_patch_symbols(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, CV_TypeIndex **type_index_maps);
+internal void                lnk_patch_inlines(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, CV_TypeIndex **type_index_maps, U64 obj_count, CV_DebugS *debug_s_arr);
+internal void                lnk_patch_leaves(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, CV_TypeIndex **type_index_maps, LNK_LeafBucketArray bucket_arr);
 internal String8Node *       lnk_copy_raw_leaf_arr_to_type_server(TP_Context *tp, CV_DebugT types, PDB_TypeServer *type_server);
-internal CV_DebugT *         lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input);
+internal CV_DebugT *         lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input, LNK_TypeCache *type_cache);
+
+internal LNK_TypeCache * lnk_type_cache_from_file(Arena *arena, String8 path);
+internal void            lnk_write_type_cache(String8 path, LNK_TypeCache *type_cache);
 
 internal void lnk_replace_type_names_with_hashes(TP_Context *tp, TP_Arena *arena, CV_DebugT debug_t, LNK_TypeNameHashMode mode, U64 hash_length, String8 map_name);
 
@@ -570,6 +680,9 @@ internal CV_SymbolPtrArray            lnk_dedup_gsi_symbols(TP_Context *tp, Aren
 
 internal void lnk_build_pdb_public_symbols(TP_Context *tp, TP_Arena *arena, LNK_SymbolTable *symtab, PDB_PsiContext *psi);
 
+// copies inputs that PDB build patches in place so RDI can read the originals concurrently
+internal LNK_CodeViewInput lnk_copy_code_view_input_for_pdb(TP_Context *tp, TP_Arena *arena, LNK_CodeViewInput *input);
+
 internal String8List lnk_build_pdb(TP_Context               *tp,
                                    TP_Arena                 *tp_arena,
                                    String8                   image_data,
@@ -581,7 +694,8 @@ internal String8List lnk_build_pdb(TP_Context               *tp,
                                    U64                       total_symbol_input_count,
                                    LNK_CodeViewSymbolsInput *symbol_inputs,
                                    CV_SymbolListArray       *parsed_symbols,
-                                   CV_DebugT                 types[CV_TypeIndexSource_COUNT]);
+                                   CV_DebugT                 types[CV_TypeIndexSource_COUNT],
+                                   PDB_PsiContext           *publics);
 
 // --- RAD Debug Info ----------------------------------------------------------
 
@@ -40,6 +40,7 @@ typedef enum
   LNK_Error_AssociativeLoop,
   LNK_Error_AlternateNameConflict,
   LNK_Error_RelocationAgainstRemovedSection,
+  LNK_Error_StaleDeferredDebugInfo,
   LNK_Error_StopLast,
   
   LNK_Error_First,
@@ -91,6 +92,7 @@ typedef enum
   LNK_Warning_DirectiveSectionWithRelocs,
   LNK_Warning_NoLargeAddressAwarenessForDll,
   LNK_Warning_TryingToExportEntryPoint,
+  LNK_Warning_UnorderableSymbol,
   LNK_Warning_Last,
   
   LNK_Error_Count
@@ -0,0 +1,1050 @@
+// Copyright (c) Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+internal void
+lnk_blake3_update_string(blake3_hasher *hasher, String8 string)
+{
+  blake3_hasher_update(hasher, &string.size, sizeof(string.size));
+  blake3_hasher_update(hasher, string.str, string.size);
+}
+
+internal U128
+lnk_link_state_config_hash(LNK_Config *config)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  // response files are unwrapped so edits to them invalidate the state too
+  String8List cmd_line = lnk_unwrap_rsp(scratch.arena, config->raw_cmd_line);
+
+  blake3_hasher hasher; blake3_hasher_init(&hasher);
+  lnk_blake3_update_string(&hasher, str8_lit(BUILD_TITLE_STRING_LITERAL));
+  lnk_blake3_update_string(&hasher, config->work_dir);
+  for EachNode(n, String8Node, cmd_line.first)            { lnk_blake3_update_string(&hasher, n->string); }
+  for EachNode(n, String8Node, config->lib_dir_list.first) { lnk_blake3_update_string(&hasher, n->string); }
+  U128 result;
+  blake3_hasher_finalize(&hasher, (U8 *)result.u64, sizeof(result.u64));
+
+  scratch_end(scratch);
+  return result;
+}
+
+internal String8List
+lnk_link_state_output_paths(Arena *arena, LNK_Config *config)
+{
+  String8List result = {0};
+  str8_list_push(arena, &result, config->image_name);
+  if (lnk_do_debug_info(config)) {
+    if (config->debug_mode == LNK_DebugMode_FastLink) {
+      // PDB and RDI are deferred to the materialize step
+      str8_list_push(arena, &result, config->deferred_debug_info_name);
+    } else {
+      if (config->debug_mode == LNK_DebugMode_Full || config->debug_mode == LNK_DebugMode_GHash) {
+        str8_list_push(arena, &result, config->pdb_name);
+      }
+      if (config->rad_debug == LNK_SwitchState_Yes) {
+        str8_list_push(arena, &result, config->rad_debug_name);
+      }
+    }
+  }
+  if (config->rad_chunk_map == LNK_SwitchState_Yes) {
+    str8_list_push(arena, &result, config->rad_chunk_map_name);
+  }
+  if (config->build_imp_lib && (config->file_characteristics & PE_ImageFileCharacteristic_FILE_DLL)) {
+    str8_list_push(arena, &result, config->imp_lib_name);
+  }
+  return result;
+}
+
+internal void
+lnk_serialize_link_state_files(Arena *arena, String8List *srl, LNK_LinkStateFileArray files)
+{
+  str8_serial_push_u64(arena, srl, files.count);
+  for EachIndex(i, files.count) {
+    LNK_LinkStateFile *file = &files.v[i];
+    str8_serial_push_u64(arena, srl, file->size);
+    str8_serial_push_u64(arena, srl, file->modified);
+    str8_serial_push_struct(arena, srl, &file->hash);
+    str8_serial_push_u64(arena, srl, file->path.size);
+    str8_serial_push_data(arena, srl, file->path.str, file->path.size);
+  }
+}
+
+internal void
+lnk_serialize_link_state_objs(Arena *arena, String8List *srl, LNK_LinkStateObjArray objs)
+{
+  str8_serial_push_u64(arena, srl, objs.count);
+  for EachIndex(i, objs.count) {
+    LNK_LinkStateObj *obj = &objs.v[i];
+    str8_serial_push_u64(arena, srl, obj->input_idx);
+    str8_serial_push_u64(arena, srl, obj->defined_symbol_count);
+    str8_serial_push_struct(arena, srl, &obj->directives_hash);
+    str8_serial_push_struct(arena, srl, &obj->base_relocs_hash);
+    str8_serial_push_u64(arena, srl, obj->sect_count);
+    str8_serial_push_data(arena, srl, obj->sects, sizeof(obj->sects[0]) * obj->sect_count);
+  }
+}
+
+internal void
+lnk_serialize_link_state_symbols(Arena *arena, String8List *srl, LNK_LinkStateSymbolArray symbols)
+{
+  str8_serial_push_u64(arena, srl, symbols.count);
+  for EachIndex(i, symbols.count) {
+    LNK_LinkStateSymbol *symbol = &symbols.v[i];
+    str8_serial_push_u32(arena, srl, symbol->obj_idx);
+    str8_serial_push_u32(arena, srl, symbol->section_number);
+    str8_serial_push_u32(arena, srl, symbol->value);
+    str8_serial_push_u64(arena, srl, symbol->name.size);
+    str8_serial_push_data(arena, srl, symbol->name.str, symbol->name.size);
+  }
+}
+
+internal String8List
+lnk_serialize_link_state(Arena *arena, LNK_LinkState state)
+{
+  String8List srl = {0};
+  str8_serial_begin(arena, &srl);
+  str8_serial_push_u64(arena, &srl, LNK_LINK_STATE_MAGIC);
+  str8_serial_push_u64(arena, &srl, LNK_LINK_STATE_VERSION);
+  str8_serial_push_struct(arena, &srl, &state.config_hash);
+  lnk_serialize_link_state_files(arena, &srl, state.inputs);
+  lnk_serialize_link_state_files(arena, &srl, state.outputs);
+  lnk_serialize_link_state_objs(arena, &srl, state.objs);
+  lnk_serialize_link_state_symbols(arena, &srl, state.symbols);
+  return srl;
+}
+
+internal U64
+lnk_deserialize_link_state_files(Arena *arena, String8 data, U64 off, LNK_LinkStateFileArray *files_out)
+{
+  U64 count = 0;
+  off += str8_deserial_read_struct(data, off, &count);
+
+  // reject counts that can't possibly fit in the remaining data
+  U64 min_file_size = sizeof(U64)*3 + sizeof(U128);
+  if (count > (data.size - Min(off, data.size)) / min_file_size) {
+    return 0;
+  }
+
+  LNK_LinkStateFileArray files = { .count = count, .v = push_array(arena, LNK_LinkStateFile, count) };
+  for EachIndex(i, count) {
+    LNK_LinkStateFile *file      = &files.v[i];
+    U64                path_size = 0;
+    U64                read_size = 0;
+    read_size += str8_deserial_read_struct(data, off + read_size, &file->size);
+    read_size += str8_deserial_read_struct(data, off + read_size, &file->modified);
+    read_size += str8_deserial_read_struct(data, off + read_size, &file->hash);
+    read_size += str8_deserial_read_struct(data, off + read_size, &path_size);
+    read_size += str8_deserial_read_block(data, off + read_size, path_size, &file->path);
+    if (read_size != min_file_size + path_size) {
+      return 0;
+    }
+    off += read_size;
+  }
+
+  *files_out = files;
+  return off;
+}
+
+internal U64
+lnk_deserialize_link_state_objs(Arena *arena, String8 data, U64 off, U64 inputs_count, LNK_LinkStateObjArray *objs_out)
+{
+  U64 count = 0;
+  off += str8_deserial_read_struct(data, off, &count);
+
+  U64 min_obj_size = sizeof(U64)*3 + sizeof(U128)*2;
+  if (count > (data.size - Min(off, data.size)) / min_obj_size) {
+    return 0;
+  }
+
+  LNK_LinkStateObjArray objs = { .count = count, .v = push_array(arena, LNK_LinkStateObj, count) };
+  for EachIndex(i, count) {
+    LNK_LinkStateObj *obj       = &objs.v[i];
+    U64               read_size = 0;
+    read_size += str8_deserial_read_struct(data, off + read_size, &obj->input_idx);
+    read_size += str8_deserial_read_struct(data, off + read_size, &obj->defined_symbol_count);
+    read_size += str8_deserial_read_struct(data, off + read_size, &obj->directives_hash);
+    read_size += str8_deserial_read_struct(data, off + read_size, &obj->base_relocs_hash);
+    read_size += str8_deserial_read_struct(data, off + read_size, &obj->sect_count);
+    if (read_size != min_obj_size || obj->input_idx >= inputs_count) {
+      return 0;
+    }
+    if (obj->sect_count > (data.size - Min(off + read_size, data.size)) / sizeof(obj->sects[0])) {
+      return 0;
+    }
+
+    String8 sects_data = {0};
+    read_size += str8_deserial_read_block(data, off + read_size, sizeof(obj->sects[0]) * obj->sect_count, &sects_data);
+    obj->sects = push_array_no_zero(arena, LNK_LinkStateSect, obj->sect_count);
+    MemoryCopyStr8(obj->sects, sects_data);
+
+    off += read_size;
+  }
+
+  *objs_out = objs;
+  return off;
+}
+
+internal U64
+lnk_deserialize_link_state_symbols(Arena *arena, String8 data, U64 off, U64 objs_count, LNK_LinkStateSymbolArray *symbols_out)
+{
+  U64 count = 0;
+  off += str8_deserial_read_struct(data, off, &count);
+
+  U64 min_symbol_size = sizeof(U32)*3 + sizeof(U64);
+  if (count > (data.size - Min(off, data.size)) / min_symbol_size) {
+    return 0;
+  }
+
+  LNK_LinkStateSymbolArray symbols = { .count = count, .v = push_array(arena, LNK_LinkStateSymbol, count) };
+  for EachIndex(i, count) {
+    LNK_LinkStateSymbol *symbol    = &symbols.v[i];
+    U64                  name_size = 0;
+    U64                  read_size = 0;
+    read_size += str8_deserial_read_struct(data, off + read_size, &symbol->obj_idx);
+    read_size += str8_deserial_read_struct(data, off + read_size, &symbol->section_number);
+    read_size += str8_deserial_read_struct(data, off + read_size, &symbol->value);
+    read_size += str8_deserial_read_struct(data, off + read_size, &name_size);
+    read_size += str8_deserial_read_block(data, off + read_size, name_size, &symbol->name);
+    if (read_size != min_symbol_size + name_size) {
+      return 0;
+    }
+    if (symbol->obj_idx != max_U32 && symbol->obj_idx >= objs_count) {
+      return 0;
+    }
+    off += read_size;
+  }
+
+  *symbols_out = symbols;
+  return off;
+}
+
+internal B32
+lnk_deserialize_link_state(Arena *arena, String8 data, LNK_LinkState *state_out)
+{
+  U64 off     = 0;
+  U64 magic   = 0;
+  U64 version = 0;
+  off += str8_deserial_read_struct(data, off, &magic);
+  off += str8_deserial_read_struct(data, off, &version);
+  if (magic != LNK_LINK_STATE_MAGIC || version != LNK_LINK_STATE_VERSION) {
+    return 0;
+  }
+
+  LNK_LinkState state = {0};
+  off += str8_deserial_read_struct(data, off, &state.config_hash);
+  off  = lnk_deserialize_link_state_files(arena, data, off, &state.inputs);
+  if (off == 0) { return 0; }
+  off  = lnk_deserialize_link_state_files(arena, data, off, &state.outputs);
+  if (off == 0) { return 0; }
+  off  = lnk_deserialize_link_state_objs(arena, data, off, state.inputs.count, &state.objs);
+  if (off == 0) { return 0; }
+  off  = lnk_deserialize_link_state_symbols(arena, data, off, state.objs.count, &state.symbols);
+  if (off == 0) { return 0; }
+
+  *state_out = state;
+  return 1;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_hash_link_state_files_task)
+{
+  LNK_LinkStateHasher *task = raw_task;
+  String8              data = task->datas.v[task_id];
+  blake3(task->files[task_id].hash.u64, sizeof(task->files[task_id].hash.u64), data.str, data.size);
+}
+
+internal void
+lnk_hash_link_state_files(TP_Context *tp, String8Array datas, LNK_LinkStateFile *files)
+{
+  ProfBeginFunction();
+  LNK_LinkStateHasher task = { .datas = datas, .files = files };
+  tp_for_parallel(tp, 0, datas.count, lnk_hash_link_state_files_task, &task);
+  ProfEnd();
+}
+
+internal LNK_LinkStateFile
+lnk_link_state_file_from_path(String8 path)
+{
+  FileProperties    props = os_properties_from_file_path(path);
+  LNK_LinkStateFile file  = { .path = path, .size = props.size, .modified = props.modified };
+  return file;
+}
+
+internal U64
+lnk_incremental_pad_from_size(U64 size)
+{
+  return Max(LNK_INCREMENTAL_PAD_MIN, size / 8);
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_hash_inputs_task)
+{
+  LNK_Input **inputs = raw_task;
+  LNK_Input  *input  = inputs[task_id];
+  if (input->is_thin && !input->has_disk_read_failed) {
+    blake3(input->hash.u64, sizeof(input->hash.u64), input->data.str, input->data.size);
+  }
+}
+
+internal void
+lnk_hash_inputs(TP_Context *tp, LNK_InputPtrArray inputs)
+{
+  ProfBeginFunction();
+  tp_for_parallel(tp, 0, inputs.count, lnk_hash_inputs_task, inputs.v);
+  ProfEnd();
+}
+
+internal U128
+lnk_directives_hash_from_obj(LNK_Obj *obj)
+{
+  Temp scratch = scratch_begin(0,0);
+  String8List   directives = lnk_raw_directives_from_obj(scratch.arena, obj);
+  blake3_hasher hasher; blake3_hasher_init(&hasher);
+  for EachNode(n, String8Node, directives.first) { lnk_blake3_update_string(&hasher, n->string); }
+  U128 result;
+  blake3_hasher_finalize(&hasher, (U8 *)result.u64, sizeof(result.u64));
+  scratch_end(scratch);
+  return result;
+}
+
+internal U128
+lnk_base_relocs_hash_from_obj(LNK_Obj *obj, LNK_LinkStateSect *sects)
+{
+  Temp scratch = scratch_begin(0,0);
+  COFF_SectionHeader *section_table = lnk_coff_section_table_from_obj(obj);
+
+  U64 max_count = 0;
+  for EachIndex(sect_idx, obj->header.section_count_no_null) {
+    if (sects[sect_idx].section_number == 0) { continue; }
+    max_count += lnk_coff_relocs_from_section_header(obj, &section_table[sect_idx]).count;
+  }
+
+  // same filter as base relocation gather, each entry is a voff and an address size
+  U64  count       = 0;
+  U64 *base_relocs = push_array(scratch.arena, U64, max_count);
+  for EachIndex(sect_idx, obj->header.section_count_no_null) {
+    if (sects[sect_idx].section_number == 0) { continue; }
+    COFF_SectionHeader *section_header = &section_table[sect_idx];
+    COFF_RelocArray     relocs         = lnk_coff_relocs_from_section_header(obj, section_header);
+    for EachIndex(reloc_idx, relocs.count) {
+      COFF_Reloc        *r      = &relocs.v[reloc_idx];
+      COFF_ParsedSymbol  symbol = lnk_parsed_symbol_from_coff_symbol_idx(obj, r->isymbol);
+      if (coff_interp_from_parsed_symbol(symbol) == COFF_SymbolValueInterp_Abs) { continue; }
+      U64 is_addr = coff_is_addr_reloc(obj->header.machine, r->type);
+      if (is_addr == 0) { continue; }
+      base_relocs[count++] = Compose64Bit(section_header->voff + r->apply_off, is_addr);
+    }
+  }
+  radsort(base_relocs, count, u64_is_before);
+
+  U128 result;
+  blake3(result.u64, sizeof(result.u64), base_relocs, sizeof(base_relocs[0]) * count);
+  scratch_end(scratch);
+  return result;
+}
+
+internal U32
+lnk_image_section_number_from_voff(COFF_SectionHeader **image_section_table, U64 image_section_count, U64 voff)
+{
+  for (U64 section_number = 1; section_number <= image_section_count; section_number += 1) {
+    COFF_SectionHeader *section_header = image_section_table[section_number];
+    if (section_header->voff <= voff && voff < section_header->voff + section_header->vsize) {
+      return section_number;
+    }
+  }
+  return 0;
+}
+
+internal String8
+lnk_patch_obj_into_image(Arena *arena, LNK_LinkState *state, HashTable *symbol_ht, U32 state_obj_idx, LNK_Obj *obj, String8 image_data, U64 image_section_count, COFF_SectionHeader **image_section_table)
+{
+  LNK_LinkStateObj   *state_obj     = &state->objs.v[state_obj_idx];
+  COFF_SectionHeader *section_table = lnk_coff_section_table_from_obj(obj);
+  String8             string_table  = lnk_coff_string_table_from_obj(obj);
+
+  if (obj->header.section_count_no_null != state_obj->sect_count) {
+    return push_str8f(arena, "section count in %S changed", obj->path);
+  }
+  if (!u128_match(state_obj->directives_hash, lnk_directives_hash_from_obj(obj))) {
+    return push_str8f(arena, "directives in %S changed", obj->path);
+  }
+
+  //
+  // copy sections into slots that previous link reserved for them
+  //
+  for EachIndex(sect_idx, obj->header.section_count_no_null) {
+    COFF_SectionHeader *section_header = &section_table[sect_idx];
+    LNK_LinkStateSect  *slot           = &state_obj->sects[sect_idx];
+    String8             section_name   = coff_name_from_section_header(string_table, section_header);
+
+    if ((section_header->flags & ~LNK_LINK_STATE_IGNORED_SECTION_FLAGS) != slot->flags) {
+      return push_str8f(arena, "flags of section %S (No. 0x%llx) in %S changed", section_name, sect_idx+1, obj->path);
+    }
+
+    // sections that weren't in the image stay out, debug info is not patched
+    if (slot->section_number == 0) {
+      section_header->flags |= COFF_SectionFlag_LnkRemove;
+      continue;
+    }
+    if (slot->section_number > image_section_count) {
+      return push_str8f(arena, "section %S (No. 0x%llx) in %S is not in the image", section_name, sect_idx+1, obj->path);
+    }
+
+    COFF_SectionHeader *image_section_header = image_section_table[slot->section_number];
+    U64                 align                = coff_align_size_from_section_flags(section_header->flags);
+    U64                 voff                 = image_section_header->voff + slot->off;
+    U64                 foff                 = image_section_header->foff + slot->off;
+    B32                 is_code              = !!(section_header->flags & COFF_SectionFlag_CntCode);
+    B32                 is_bss               = !!(section_header->flags & COFF_SectionFlag_CntUninitializedData);
+    B32                 is_fit               = is_code ? section_header->fsize <= slot->slot_size : section_header->fsize == slot->size;
+    if (align == 0) {
+      align = coff_default_align_from_machine(obj->header.machine);
+    }
+    if (!is_fit || AlignPadPow2(voff, align) != 0 || (!is_bss && foff + slot->slot_size > image_data.size)) {
+      return push_str8f(arena, "section %S (No. 0x%llx) in %S doesn't fit into its slot", section_name, sect_idx+1, obj->path);
+    }
+
+    if (!is_bss) {
+      String8 data      = str8_substr(obj->data, rng_1u64(section_header->foff, section_header->foff + section_header->fsize));
+      U8      fill_byte = is_code ? coff_code_align_byte_from_machine(obj->header.machine) : 0;
+      MemoryCopyStr8(image_data.str + foff, data);
+      MemorySet(image_data.str + foff + data.size, fill_byte, slot->slot_size - data.size);
+      section_header->foff = foff;
+    }
+    section_header->voff  = voff;
+    section_header->vsize = section_header->fsize;
+    slot->size            = section_header->fsize;
+  }
+
+  //
+  // move symbols to image locations, externals must stay where the rest of the image expects them
+  //
+  U32               removed_section_number = lnk_obj_get_removed_section_number(obj);
+  U64               defined_symbol_count   = 0;
+  COFF_ParsedSymbol symbol;
+  for (U64 symbol_idx = 0; symbol_idx < obj->header.symbol_count; symbol_idx += (1 + symbol.aux_symbol_count)) {
+    symbol = lnk_parsed_symbol_from_coff_symbol_idx(obj, symbol_idx);
+    COFF_SymbolValueInterpType interp = coff_interp_from_parsed_symbol(symbol);
+
+    LNK_LinkStateSymbol *defn           = 0;
+    B32                  is_external    = symbol.storage_class == COFF_SymStorageClass_External;
+    U32                  section_number = 0;
+    U32                  value          = 0;
+    if (interp == COFF_SymbolValueInterp_Regular) {
+      LNK_LinkStateSect *slot = &state_obj->sects[symbol.section_number-1];
+      if (slot->section_number != 0) {
+        section_number = slot->section_number;
+        value          = slot->off + symbol.value;
+        if (is_external) {
+          LNK_LinkStateSymbol *leader = hash_table_search_string_raw(symbol_ht, symbol.name);
+          if (leader == 0 || leader->obj_idx != state_obj_idx || leader->section_number != section_number || leader->value != value) {
+            return push_str8f(arena, "symbol %S in %S moved", symbol.name, obj->path);
+          }
+          defined_symbol_count += 1;
+        }
+      } else if (is_external) {
+        // definition lost to a definition from another obj, e.g. COMDAT
+        defn = hash_table_search_string_raw(symbol_ht, symbol.name);
+        if (defn == 0 || defn->obj_idx == state_obj_idx) {
+          return push_str8f(arena, "symbol %S in %S moved", symbol.name, obj->path);
+        }
+      } else {
+        section_number = removed_section_number;
+        value          = 0;
+      }
+    } else if (interp == COFF_SymbolValueInterp_Undefined || interp == COFF_SymbolValueInterp_Weak || interp == COFF_SymbolValueInterp_Common) {
+      defn = hash_table_search_string_raw(symbol_ht, symbol.name);
+      if (defn == 0) {
+        return push_str8f(arena, "%S references %S which previous link didn't define", obj->path, symbol.name);
+      }
+    } else {
+      continue;
+    }
+
+    if (defn) {
+      if (defn->section_number == 0) {
+        section_number = obj->header.is_big_obj ? COFF_Symbol_AbsSection32 : COFF_Symbol_AbsSection16;
+      } else {
+        section_number = defn->section_number;
+      }
+      value = defn->value;
+    }
+
+    if (obj->header.is_big_obj) {
+      COFF_Symbol32 *symbol32  = symbol.raw_symbol;
+      symbol32->section_number = section_number;
+      symbol32->value          = value;
+      if (defn) { symbol32->storage_class = COFF_SymStorageClass_Static; }
+    } else {
+      COFF_Symbol16 *symbol16  = symbol.raw_symbol;
+      symbol16->section_number = (U16)section_number;
+      symbol16->value          = value;
+      if (defn) { symbol16->storage_class = COFF_SymStorageClass_Static; }
+    }
+  }
+  if (defined_symbol_count != state_obj->defined_symbol_count) {
+    return push_str8f(arena, "set of symbols defined in %S changed", obj->path);
+  }
+
+  //
+  // relocations must target the image, and image must not need new base relocations
+  //
+  for EachIndex(sect_idx, obj->header.section_count_no_null) {
+    COFF_SectionHeader *section_header = &section_table[sect_idx];
+    if (section_header->flags & COFF_SectionFlag_LnkRemove) { continue; }
+    COFF_RelocArray relocs = lnk_coff_relocs_from_section_header(obj, section_header);
+    for EachIndex(reloc_idx, relocs.count) {
+      COFF_ParsedSymbol reloc_symbol = lnk_parsed_symbol_from_coff_symbol_idx(obj, relocs.v[reloc_idx].isymbol);
+      if (reloc_symbol.section_number == removed_section_number) {
+        return push_str8f(arena, "%S relocates against %S which is not in the image", obj->path, reloc_symbol.name);
+      }
+    }
+  }
+  if (!u128_match(state_obj->base_relocs_hash, lnk_base_relocs_hash_from_obj(obj, state_obj->sects))) {
+    return push_str8f(arena, "base relocations of %S changed", obj->path);
+  }
+
+  return str8_zero();
+}
+
+internal String8
+lnk_patch_image(TP_Context *tp, Arena *arena, LNK_Config *config, LNK_LinkState *state, U64 changed_count, U64 *changed_idxs, String8 *changed_datas)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+
+  String8 relink_reason = str8_zero();
+
+  // everything outside of the changed objs is reused as is, so tables that are built from all objs must stay valid
+  if (lnk_do_debug_info(config)) {
+    relink_reason = str8_lit("debug info is not patched in place");
+    goto exit;
+  }
+  if (config->opt_icf == LNK_SwitchState_Yes) {
+    relink_reason = str8_lit("/OPT:ICF might fold changed sections");
+    goto exit;
+  }
+  if (config->guard_flags != LNK_Guard_None) {
+    relink_reason = str8_lit("guard tables are not patched in place");
+    goto exit;
+  }
+  if (config->rad_chunk_map == LNK_SwitchState_Yes) {
+    relink_reason = str8_lit("chunk map is not patched in place");
+    goto exit;
+  }
+
+  // only objs from the command line have slots in the image
+  U32 *state_obj_idxs = push_array(scratch.arena, U32, changed_count);
+  {
+    HashTable *obj_ht = hash_table_init(scratch.arena, state->objs.count);
+    for EachIndex(obj_idx, state->objs.count) {
+      hash_table_push_u64_u64(scratch.arena, obj_ht, state->objs.v[obj_idx].input_idx, obj_idx);
+    }
+    for EachIndex(i, changed_count) {
+      KeyValuePair *kv = hash_table_search_u64(obj_ht, changed_idxs[i]);
+      if (kv == 0) {
+        relink_reason = push_str8f(arena, "input %S changed", state->inputs.v[changed_idxs[i]].path);
+        goto exit;
+      }
+      state_obj_idxs[i] = kv->value_u64;
+    }
+  }
+
+  String8    image_data = lnk_read_data_from_file_path(scratch.arena, 0, config->image_name);
+  PE_BinInfo pe         = pe_bin_info_from_data(scratch.arena, image_data);
+  if (pe.arch != Arch_x64) {
+    relink_reason = str8_lit("only x64 images are patched in place");
+    goto exit;
+  }
+  COFF_SectionHeader **image_section_table = coff_section_table_from_data(scratch.arena, image_data, pe.section_table_range);
+
+  HashTable *symbol_ht = hash_table_init(scratch.arena, state->symbols.count);
+  for EachIndex(symbol_idx, state->symbols.count) {
+    hash_table_push_string_raw(scratch.arena, symbol_ht, state->symbols.v[symbol_idx].name, &state->symbols.v[symbol_idx]);
+  }
+
+  LNK_Obj **objs = push_array(scratch.arena, LNK_Obj *, changed_count);
+  for EachIndex(i, changed_count) {
+    LNK_Input input = { .path = state->inputs.v[changed_idxs[i]].path, .data = changed_datas[i], .is_thin = 1 };
+    objs[i] = &lnk_obj_from_input(scratch.arena, COFF_MachineType_X64, &input)->data;
+
+    relink_reason = lnk_patch_obj_into_image(arena, state, symbol_ht, state_obj_idxs[i], objs[i], image_data, pe.section_count, image_section_table);
+    if (relink_reason.size) {
+      goto exit;
+    }
+  }
+
+  lnk_patch_relocs(tp, image_data, pe.image_base, image_section_table, changed_count, objs);
+
+  // .pdata entries of changed objs were rewritten in place
+  pe_pdata_sort(COFF_MachineType_X64, str8_substr(image_data, pe.data_dir_franges[PE_DataDirectoryIndex_EXCEPTIONS]));
+
+  if (config->flags & LNK_ConfigFlag_WriteImageChecksum) {
+    *pe.check_sum = 0;
+    *pe.check_sum = pe_compute_checksum(image_data.str, image_data.size);
+  }
+
+  lnk_write_data_to_file_path(config->image_name, config->temp_image_name, image_data);
+
+  exit:;
+  scratch_end(scratch);
+  ProfEnd();
+  return relink_reason;
+}
+
+internal B32
+lnk_try_incremental_link(TP_Context *tp, LNK_Config *config)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
+
+  // changes that can't be patched into the image fall back to a full link
+  B32     is_linked     = 0;
+  String8 relink_reason = str8_zero();
+
+  String8       state_data = lnk_read_data_from_file_path(scratch.arena, 0, config->link_state_name);
+  LNK_LinkState state      = {0};
+  if (!lnk_deserialize_link_state(scratch.arena, state_data, &state)) {
+    relink_reason = push_str8f(scratch.arena, "no valid link state in %S", config->link_state_name);
+    goto exit;
+  }
+
+  // was image built with different switches?
+  if (!u128_match(state.config_hash, lnk_link_state_config_hash(config))) {
+    relink_reason = str8_lit("command line changed");
+    goto exit;
+  }
+
+  // outputs must be exactly what previous link wrote, and the set of outputs must match
+  String8List output_paths = lnk_link_state_output_paths(scratch.arena, config);
+  {
+    if (output_paths.node_count != state.outputs.count) {
+      relink_reason = str8_lit("set of outputs changed");
+      goto exit;
+    }
+    U64 output_idx = 0;
+    for EachNode(path_n, String8Node, output_paths.first) {
+      LNK_LinkStateFile *recorded = &state.outputs.v[output_idx++];
+      LNK_LinkStateFile  current  = lnk_link_state_file_from_path(path_n->string);
+      if (!str8_match(recorded->path, current.path, StringMatchFlag_CaseInsensitive) ||
+          recorded->size != current.size || recorded->modified != current.modified) {
+        relink_reason = push_str8f(scratch.arena, "output %S changed", current.path);
+        goto exit;
+      }
+    }
+  }
+
+  // inputs with a different time stamp or size are re-hashed, those with
+  // same contents only need a new time stamp
+  B32                is_state_stale = 0;
+  U64                changed_count  = 0;
+  U64               *changed_idxs   = push_array(scratch.arena, U64, state.inputs.count);
+  String8           *changed_datas  = push_array(scratch.arena, String8, state.inputs.count);
+  LNK_LinkStateFile *changed_files  = push_array(scratch.arena, LNK_LinkStateFile, state.inputs.count);
+  {
+    U64                rehash_count = 0;
+    String8Array       rehash_paths = { .v = push_array(scratch.arena, String8, state.inputs.count) };
+    LNK_LinkStateFile *rehash_files = push_array(scratch.arena, LNK_LinkStateFile, state.inputs.count);
+    U64               *rehash_idxs  = push_array(scratch.arena, U64, state.inputs.count);
+    for EachIndex(input_idx, state.inputs.count) {
+      LNK_LinkStateFile *recorded = &state.inputs.v[input_idx];
+      LNK_LinkStateFile  current  = lnk_link_state_file_from_path(recorded->path);
+      if (recorded->size != current.size || recorded->modified != current.modified) {
+        rehash_paths.v[rehash_count] = recorded->path;
+        rehash_files[rehash_count]   = current;
+        rehash_idxs[rehash_count]    = input_idx;
+        rehash_count += 1;
+      }
+    }
+    rehash_paths.count = rehash_count;
+
+    if (rehash_count > 0) {
+      String8Array rehash_datas = lnk_read_data_from_file_path_parallel(tp, scratch.arena, config->io_flags, rehash_paths);
+      lnk_hash_link_state_files(tp, rehash_datas, rehash_files);
+      for EachIndex(i, rehash_count) {
+        LNK_LinkStateFile *recorded = &state.inputs.v[rehash_idxs[i]];
+        if (u128_match(recorded->hash, rehash_files[i].hash)) {
+          recorded->modified = rehash_files[i].modified;
+          is_state_stale     = 1;
+        } else {
+          changed_idxs[changed_count]  = rehash_idxs[i];
+          changed_datas[changed_count] = rehash_datas.v[i];
+          changed_files[changed_count] = rehash_files[i];
+          changed_count += 1;
+        }
+      }
+    }
+  }
+
+  if (changed_count == 0) {
+    lnk_log(LNK_Log_Debug, "[Image Is Up To Date %S]", config->image_name);
+  } else {
+    relink_reason = lnk_patch_image(tp, scratch.arena, config, &state, changed_count, changed_idxs, changed_datas);
+    if (relink_reason.size) {
+      goto exit;
+    }
+
+    for EachIndex(i, changed_count) {
+      state.inputs.v[changed_idxs[i]] = changed_files[i];
+    }
+    U64 output_idx = 0;
+    for EachNode(path_n, String8Node, output_paths.first) {
+      state.outputs.v[output_idx++] = lnk_link_state_file_from_path(path_n->string);
+    }
+    is_state_stale = 1;
+
+    lnk_log(LNK_Log_Debug, "[Image Patched In Place %S, Changed Objs %llu]", config->image_name, changed_count);
+  }
+
+  // update state so next link does not have to re-hash same files
+  if (is_state_stale) {
+    String8List srl = lnk_serialize_link_state(scratch.arena, state);
+    lnk_write_data_list_to_file_path(config->link_state_name, str8_zero(), srl);
+  }
+
+  is_linked = 1;
+
+  exit:;
+  if (!is_linked) {
+    lnk_log(LNK_Log_Debug, "[Full Link: %S]", relink_reason);
+  }
+  scratch_end(scratch);
+  ProfEnd();
+  return is_linked;
+}
+
+internal void
+lnk_write_link_state(TP_Context *tp, LNK_Config *config, LNK_Inputer *inputer, LNK_SymbolTable *symtab, U64 objs_count, LNK_Obj **objs, String8 image_data)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
+
+  LNK_LinkState state = {0};
+  state.config_hash = lnk_link_state_config_hash(config);
+
+  //
+  // inputs: objs and libs that were read from disk, plus files consumed directly from command line
+  //
+  HashTable *obj_input_ht = hash_table_init(scratch.arena, inputer->objs.count);
+  {
+    String8List extra_paths = {0};
+    {
+      String8List res_paths      = str8_list_copy(scratch.arena, &config->input_list[LNK_Input_Res]);
+      String8List manifest_paths = str8_list_copy(scratch.arena, &config->input_list[LNK_Input_Manifest]);
+      String8List natvis_paths   = str8_list_copy(scratch.arena, &config->natvis_list);
+      str8_list_concat_in_place(&extra_paths, &res_paths);
+      str8_list_concat_in_place(&extra_paths, &manifest_paths);
+      str8_list_concat_in_place(&extra_paths, &natvis_paths);
+      if (config->order_file_name.size)      { str8_list_push(scratch.arena, &extra_paths, config->order_file_name);      }
+      if (config->call_graph_file_name.size) { str8_list_push(scratch.arena, &extra_paths, config->call_graph_file_name); }
+    }
+
+    U64 max_input_count = inputer->objs.count + inputer->libs.count + extra_paths.node_count;
+    state.inputs.v = push_array(scratch.arena, LNK_LinkStateFile, max_input_count);
+
+    // objs and libs were hashed when they were loaded, before linker patched them in memory
+    LNK_InputList input_lists[] = { inputer->objs, inputer->libs };
+    for EachElement(list_idx, input_lists) {
+      for EachNode(input, LNK_Input, input_lists[list_idx].first) {
+        if (!input->is_thin || input->has_disk_read_failed) { continue; }
+        if (list_idx == 0) {
+          hash_table_push_path_u64(scratch.arena, obj_input_ht, input->path, state.inputs.count);
+        }
+        state.inputs.v[state.inputs.count]      = lnk_link_state_file_from_path(input->path);
+        state.inputs.v[state.inputs.count].hash = input->hash;
+        state.inputs.count += 1;
+      }
+    }
+
+    U64          extra_first = state.inputs.count;
+    String8Array extra_datas = { .v = push_array(scratch.arena, String8, extra_paths.node_count) };
+    for EachNode(path_n, String8Node, extra_paths.first) {
+      String8 full_path = os_full_path_from_path(scratch.arena, path_n->string);
+      extra_datas.v[extra_datas.count++] = lnk_read_data_from_file_path(scratch.arena, config->io_flags, full_path);
+      state.inputs.v[state.inputs.count] = lnk_link_state_file_from_path(full_path);
+      state.inputs.count += 1;
+    }
+    lnk_hash_link_state_files(tp, extra_datas, state.inputs.v + extra_first);
+  }
+
+  //
+  // outputs: only time stamps and sizes are recorded
+  //
+  {
+    String8List output_paths = lnk_link_state_output_paths(scratch.arena, config);
+    state.outputs.v = push_array(scratch.arena, LNK_LinkStateFile, output_paths.node_count);
+    for EachNode(path_n, String8Node, output_paths.first) {
+      state.outputs.v[state.outputs.count++] = lnk_link_state_file_from_path(path_n->string);
+    }
+  }
+
+  //
+  // objs: image slots of sections from objs on the command line
+  //
+  U32 *state_obj_idx_from_obj = push_array_no_zero(scratch.arena, U32, objs_count);
+  MemorySet(state_obj_idx_from_obj, 0xff, sizeof(state_obj_idx_from_obj[0]) * objs_count);
+  {
+    PE_BinInfo           pe                  = pe_bin_info_from_data(scratch.arena, image_data);
+    COFF_SectionHeader **image_section_table = coff_section_table_from_data(scratch.arena, image_data, pe.section_table_range);
+
+    state.objs.v = push_array(scratch.arena, LNK_LinkStateObj, objs_count);
+    for EachIndex(obj_idx, objs_count) {
+      LNK_Obj *obj       = objs[obj_idx];
+      U64      input_idx = 0;
+      if (obj->link_member)                                                  { continue; }
+      if (!hash_table_search_path_u64(obj_input_ht, obj->path, &input_idx)) { continue; }
+
+      LNK_LinkStateObj   *state_obj     = &state.objs.v[state.objs.count];
+      COFF_SectionHeader *section_table = lnk_coff_section_table_from_obj(obj);
+      state_obj->input_idx  = input_idx;
+      state_obj->sect_count = obj->header.section_count_no_null;
+      state_obj->sects      = push_array(scratch.arena, LNK_LinkStateSect, state_obj->sect_count);
+      for EachIndex(sect_idx, state_obj->sect_count) {
+        COFF_SectionHeader *section_header = &section_table[sect_idx];
+        LNK_LinkStateSect  *sect           = &state_obj->sects[sect_idx];
+        sect->flags = section_header->flags & ~LNK_LINK_STATE_IGNORED_SECTION_FLAGS;
+
+        // sections that were not copied to the image have zero virtual size
+        B32 is_in_image = !(section_header->flags & (COFF_SectionFlag_LnkRemove | COFF_SectionFlag_LnkInfo | LNK_SECTION_FLAG_DEBUG)) && section_header->vsize > 0;
+        if (is_in_image) {
+          sect->section_number = lnk_image_section_number_from_voff(image_section_table, pe.section_count, section_header->voff);
+          if (sect->section_number) {
+            sect->off       = section_header->voff - image_section_table[sect->section_number]->voff;
+            sect->size      = section_header->vsize;
+            sect->slot_size = sect->size;
+            if (section_header->flags & COFF_SectionFlag_CntCode) {
+              sect->slot_size += lnk_incremental_pad_from_size(sect->size);
+            }
+          }
+        }
+      }
+      state_obj->directives_hash  = lnk_directives_hash_from_obj(obj);
+      state_obj->base_relocs_hash = lnk_base_relocs_hash_from_obj(obj, state_obj->sects);
+
+      state_obj_idx_from_obj[obj_idx] = state.objs.count;
+      state.objs.count += 1;
+    }
+  }
+
+  //
+  // symbols: image locations of external symbols, changed objs are resolved against them
+  //
+  {
+    U64                       chunks_count = 0;
+    LNK_SymbolHashTrieChunk **chunks       = lnk_array_from_symbol_hash_trie_chunk_list(scratch.arena, symtab->chunks, symtab->arena->count, &chunks_count);
+
+    U64 max_symbol_count = 0;
+    for EachIndex(chunk_idx, chunks_count) { max_symbol_count += chunks[chunk_idx]->count; }
+    state.symbols.v = push_array(scratch.arena, LNK_LinkStateSymbol, max_symbol_count);
+
+    for EachIndex(chunk_idx, chunks_count) {
+      LNK_SymbolHashTrieChunk *chunk = chunks[chunk_idx];
+      for EachIndex(i, chunk->count) {
+        LNK_Symbol                 *symbol = chunk->v[i].symbol;
+        LNK_ObjSymbolRef            ref    = lnk_ref_from_symbol(symbol);
+        COFF_ParsedSymbol           parsed = lnk_parsed_from_symbol(symbol);
+        COFF_SymbolValueInterpType  interp = coff_interp_from_parsed_symbol(parsed);
+
+        LNK_LinkStateSymbol *dst = &state.symbols.v[state.symbols.count];
+        dst->name    = symbol->name;
+        dst->obj_idx = max_U32;
+        if (interp == COFF_SymbolValueInterp_Regular) {
+          if (parsed.section_number == lnk_obj_get_removed_section_number(ref.obj)) { continue; }
+          dst->section_number = parsed.section_number;
+          dst->value          = parsed.value;
+          if (parsed.storage_class == COFF_SymStorageClass_External && ref.obj->input_idx < objs_count) {
+            dst->obj_idx = state_obj_idx_from_obj[ref.obj->input_idx];
+          }
+        } else if (interp == COFF_SymbolValueInterp_Abs) {
+          dst->section_number = 0;
+          dst->value          = parsed.value;
+        } else {
+          continue;
+        }
+
+        if (dst->obj_idx != max_U32) {
+          state.objs.v[dst->obj_idx].defined_symbol_count += 1;
+        }
+        state.symbols.count += 1;
+      }
+    }
+  }
+
+  String8List srl = lnk_serialize_link_state(scratch.arena, state);
+  lnk_write_data_list_to_file_path(config->link_state_name, str8_zero(), srl);
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+internal String8List
+lnk_serialize_deferred_debug_info(Arena *arena, LNK_DeferredDebugInfo info)
+{
+  String8List srl = {0};
+  str8_serial_begin(arena, &srl);
+  str8_serial_push_u64(arena, &srl, LNK_DEFERRED_DEBUG_INFO_MAGIC);
+  str8_serial_push_u64(arena, &srl, LNK_DEFERRED_DEBUG_INFO_VERSION);
+  str8_serial_push_struct(arena, &srl, &info.guid);
+  str8_serial_push_u32(arena, &srl, info.age);
+  str8_serial_push_u32(arena, &srl, info.time_stamp);
+  str8_serial_push_u64(arena, &srl, info.work_dir.size);
+  str8_serial_push_string(arena, &srl, info.work_dir);
+  str8_serial_push_u64(arena, &srl, info.cmd_line.node_count);
+  for EachNode(n, String8Node, info.cmd_line.first) {
+    str8_serial_push_u64(arena, &srl, n->string.size);
+    str8_serial_push_string(arena, &srl, n->string);
+  }
+  lnk_serialize_link_state_files(arena, &srl, info.inputs);
+  return srl;
+}
+
+internal B32
+lnk_deserialize_deferred_debug_info(Arena *arena, String8 data, LNK_DeferredDebugInfo *info_out)
+{
+  U64 off     = 0;
+  U64 magic   = 0;
+  U64 version = 0;
+  off += str8_deserial_read_struct(data, off, &magic);
+  off += str8_deserial_read_struct(data, off, &version);
+  if (magic != LNK_DEFERRED_DEBUG_INFO_MAGIC || version != LNK_DEFERRED_DEBUG_INFO_VERSION) {
+    return 0;
+  }
+
+  LNK_DeferredDebugInfo info = {0};
+  off += str8_deserial_read_struct(data, off, &info.guid);
+  off += str8_deserial_read_struct(data, off, &info.age);
+  off += str8_deserial_read_struct(data, off, &info.time_stamp);
+
+  U64 work_dir_size = 0;
+  off += str8_deserial_read_struct(data, off, &work_dir_size);
+  off += str8_deserial_read_block(data, off, work_dir_size, &info.work_dir);
+  if (info.work_dir.size != work_dir_size) { return 0; }
+
+  U64 arg_count = 0;
+  off += str8_deserial_read_struct(data, off, &arg_count);
+  if (arg_count > (data.size - Min(off, data.size)) / sizeof(U64)) { return 0; }
+  for EachIndex(arg_idx, arg_count) {
+    U64     arg_size = 0;
+    String8 arg      = {0};
+    off += str8_deserial_read_struct(data, off, &arg_size);
+    off += str8_deserial_read_block(data, off, arg_size, &arg);
+    if (arg.size != arg_size) { return 0; }
+    str8_list_push(arena, &info.cmd_line, arg);
+  }
+
+  off = lnk_deserialize_link_state_files(arena, data, off, &info.inputs);
+  if (off == 0) { return 0; }
+
+  *info_out = info;
+  return 1;
+}
+
+internal void
+lnk_write_deferred_debug_info(LNK_Config *config, LNK_Inputer *inputer)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
+
+  LNK_DeferredDebugInfo info = {0};
+  info.guid       = config->guid;
+  info.age        = config->age;
+  info.time_stamp = config->time_stamp;
+  info.work_dir   = config->work_dir;
+  info.cmd_line   = lnk_unwrap_rsp(scratch.arena, config->raw_cmd_line);
+
+  //
+  // inputs: only time stamps and sizes are recorded, materialize step reads
+  // objs and libs from their original location and must see the same bytes
+  //
+  {
+    String8List   natvis_paths    = config->natvis_list;
+    U64           max_input_count = inputer->objs.count + inputer->libs.count + natvis_paths.node_count;
+    LNK_InputList input_lists[]   = { inputer->objs, inputer->libs };
+    info.inputs.v = push_array(scratch.arena, LNK_LinkStateFile, max_input_count);
+    for EachElement(list_idx, input_lists) {
+      for EachNode(input, LNK_Input, input_lists[list_idx].first) {
+        if (!input->is_thin || input->has_disk_read_failed) { continue; }
+        info.inputs.v[info.inputs.count++] = lnk_link_state_file_from_path(input->path);
+      }
+    }
+    for EachNode(path_n, String8Node, natvis_paths.first) {
+      String8 full_path = os_full_path_from_path(scratch.arena, path_n->string);
+      info.inputs.v[info.inputs.count++] = lnk_link_state_file_from_path(full_path);
+    }
+  }
+
+  String8List srl = lnk_serialize_deferred_debug_info(scratch.arena, info);
+  lnk_write_data_list_to_file_path(config->deferred_debug_info_name, str8_zero(), srl);
+
+  // debug info from a previous link no longer matches the image
+  os_delete_file_at_path(config->pdb_name);
+  os_delete_file_at_path(config->rad_debug_name);
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+internal void
+lnk_materialize_debug_info(String8 exe_path, String8 rfl_path, String8List extra_args)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  String8 rfl_data = lnk_read_data_from_file_path(scratch.arena, 0, rfl_path);
+  if (rfl_data.size == 0) {
+    lnk_error(LNK_Error_FileNotFound, "unable to read deferred debug info %S", rfl_path);
+  }
+
+  LNK_DeferredDebugInfo info = {0};
+  if (!lnk_deserialize_deferred_debug_info(scratch.arena, rfl_data, &info)) {
+    lnk_error(LNK_Error_StaleDeferredDebugInfo, "%S: unsupported deferred debug info format", rfl_path);
+  }
+
+  // objs and libs must be exactly what image was linked with
+  for EachIndex(input_idx, info.inputs.count) {
+    LNK_LinkStateFile *recorded = &info.inputs.v[input_idx];
+    LNK_LinkStateFile  current  = lnk_link_state_file_from_path(recorded->path);
+    if (recorded->size != current.size || recorded->modified != current.modified) {
+      lnk_error(LNK_Error_StaleDeferredDebugInfo, "%S: input %S changed after image was linked, relink image to rebuild debug info", rfl_path, recorded->path);
+    }
+  }
+
+  //
+  // replay recorded link with identity of the image, linker writes only debug info
+  //
+  String8List cmd_line = {0};
+  str8_list_push(scratch.arena, &cmd_line, exe_path);
+  str8_list_concat_in_place(&cmd_line, &info.cmd_line);
+  str8_list_pushf(scratch.arena, &cmd_line, "/DEBUG:FULL");
+  str8_list_pushf(scratch.arena, &cmd_line, "/INCREMENTAL:NO");
+  str8_list_pushf(scratch.arena, &cmd_line, "/RAD_GUID:%S", string_from_guid(scratch.arena, info.guid));
+  str8_list_pushf(scratch.arena, &cmd_line, "/RAD_AGE:%u", info.age);
+  str8_list_pushf(scratch.arena, &cmd_line, "/RAD_TIME_STAMP:%u", info.time_stamp);
+  str8_list_pushf(scratch.arena, &cmd_line, "/RAD_DEBUG_INFO_ONLY");
+  for EachNode(arg_n, String8Node, extra_args.first) {
+    String8 arg = arg_n->string;
+    if (arg.size > 0 && (arg.str[0] == '/' || arg.str[0] == '-')) {
+      String8 name = str8_skip(arg, 1);
+      if (str8_match(str8_prefix(name, str8_lit("RAD_MATERIALIZE_DEBUG_INFO").size), str8_lit("RAD_MATERIALIZE_DEBUG_INFO"), StringMatchFlag_CaseInsensitive)) {
+        continue;
+      }
+    }
+    str8_list_push(scratch.arena, &cmd_line, arg);
+  }
+
+  lnk_log(LNK_Log_Debug, "[Materializing Debug Info %S]", rfl_path);
+
+  OS_ProcessLaunchParams params = {0};
+  params.cmd_line    = cmd_line;
+  params.path        = info.work_dir;
+  params.inherit_env = 1;
+  OS_Handle process = os_process_launch(&params);
+  if (os_handle_match(process, os_handle_zero())) {
+    lnk_error(LNK_Error_StaleDeferredDebugInfo, "%S: unable to launch linker to materialize debug info", rfl_path);
+  }
+
+  U64 exit_code = 0;
+  os_process_join(process, max_U64, &exit_code);
+
+  scratch_end(scratch);
+  os_abort((S32)exit_code);
+}
@@ -0,0 +1,119 @@
+// Copyright (c) Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#pragma once
+
+// --- Link State --------------------------------------------------------------
+
+#define LNK_LINK_STATE_MAGIC   0x45544154534b4c52ull // RLKSTATE
+#define LNK_LINK_STATE_VERSION 2
+
+// every code contribution from an obj on the command line gets at least this
+// many bytes of slack, so functions can grow without moving their neighbours
+#define LNK_INCREMENTAL_PAD_MIN 16
+
+// flags that linker sets on obj sections, masked out when comparing sections between links
+#define LNK_LINK_STATE_IGNORED_SECTION_FLAGS (COFF_SectionFlags_LnkFlags | LNK_SECTION_FLAG_LIVE | LNK_SECTION_FLAG_DEBUG)
+
+typedef struct LNK_LinkStateFile
+{
+  String8 path;
+  U64     size;
+  U64     modified;
+  U128    hash;
+} LNK_LinkStateFile;
+
+typedef struct LNK_LinkStateFileArray
+{
+  U64                count;
+  LNK_LinkStateFile *v;
+} LNK_LinkStateFileArray;
+
+typedef struct LNK_LinkStateSect
+{
+  U32 section_number; // image section number, zero when section is not in the image
+  U32 off;            // contribution offset within the image section
+  U32 size;           // contribution size
+  U32 slot_size;      // contribution size plus pad reserved after it
+  U32 flags;          // obj section flags without linker flags
+} LNK_LinkStateSect;
+
+typedef struct LNK_LinkStateObj
+{
+  U64                input_idx;            // index into link state inputs
+  U64                defined_symbol_count; // number of link state symbols that obj defines
+  U128               directives_hash;
+  U128               base_relocs_hash;
+  U64                sect_count;
+  LNK_LinkStateSect *sects;
+} LNK_LinkStateObj;
+
+typedef struct LNK_LinkStateObjArray
+{
+  U64               count;
+  LNK_LinkStateObj *v;
+} LNK_LinkStateObjArray;
+
+typedef struct LNK_LinkStateSymbol
+{
+  String8 name;
+  U32     obj_idx;        // index into link state objs, max_U32 when symbol is defined by a lib member or linker
+  U32     section_number; // image section number, zero for absolute symbols
+  U32     value;          // offset within the image section or absolute value
+} LNK_LinkStateSymbol;
+
+typedef struct LNK_LinkStateSymbolArray
+{
+  U64                  count;
+  LNK_LinkStateSymbol *v;
+} LNK_LinkStateSymbolArray;
+
+typedef struct LNK_LinkState
+{
+  U128                     config_hash;
+  LNK_LinkStateFileArray   inputs;
+  LNK_LinkStateFileArray   outputs;
+  LNK_LinkStateObjArray    objs;    // objs from the command line that can be patched into the image
+  LNK_LinkStateSymbolArray symbols; // external symbols and their locations in the image
+} LNK_LinkState;
+
+typedef struct
+{
+  String8Array       datas;
+  LNK_LinkStateFile *files;
+} LNK_LinkStateHasher;
+
+// --- Deferred Debug Info -----------------------------------------------------
+
+#define LNK_DEFERRED_DEBUG_INFO_MAGIC   0x52454645444b4c52ull // RLKDEFER
+#define LNK_DEFERRED_DEBUG_INFO_VERSION 1
+
+typedef struct LNK_DeferredDebugInfo
+{
+  Guid                   guid;
+  U32                    age;
+  U32                    time_stamp;
+  String8                work_dir;
+  String8List            cmd_line;
+  LNK_LinkStateFileArray inputs;
+} LNK_DeferredDebugInfo;
+
+// --- Link State --------------------------------------------------------------
+
+internal U128        lnk_link_state_config_hash(LNK_Config *config);
+internal String8List lnk_serialize_link_state(Arena *arena, LNK_LinkState state);
+internal B32         lnk_deserialize_link_state(Arena *arena, String8 data, LNK_LinkState *state_out);
+
+internal U64  lnk_incremental_pad_from_size(U64 size);
+internal void lnk_hash_inputs(TP_Context *tp, LNK_InputPtrArray inputs);
+
+internal B32  lnk_try_incremental_link(TP_Context *tp, LNK_Config *config);
+internal void lnk_write_link_state(TP_Context *tp, LNK_Config *config, LNK_Inputer *inputer, LNK_SymbolTable *symtab, U64 objs_count, LNK_Obj **objs, String8 image_data);
+
+// --- Deferred Debug Info -----------------------------------------------------
+
+internal String8List lnk_serialize_deferred_debug_info(Arena *arena, LNK_DeferredDebugInfo info);
+internal B32         lnk_deserialize_deferred_debug_info(Arena *arena, String8 data, LNK_DeferredDebugInfo *info_out);
+
+internal void lnk_write_deferred_debug_info(LNK_Config *config, LNK_Inputer *inputer);
+internal void lnk_materialize_debug_info(String8 exe_path, String8 rfl_path, String8List extra_args);
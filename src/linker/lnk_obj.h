@@ -5,6 +5,12 @@
 
 // --- Input -------------------------------------------------------------------
 
+typedef struct LNK_SectionFold
+{
+  struct LNK_Obj *obj;
+  U32             section_number;
+} LNK_SectionFold;
+
 typedef struct LNK_Obj
 {
   String8                  path;
@@ -16,6 +22,7 @@ typedef struct LNK_Obj
   B8                       exclude_from_debug_info;
   U32Node                **associated_sections;
   LNK_SymbolHashTrie     **symlinks;
+  LNK_SectionFold         *folds; // indexed by section number, set when /OPT:ICF folds a section into an identical one
 
   struct LNK_LibMemberRef *link_member;
 
@@ -0,0 +1,362 @@
+// Copyright (c) Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+// --- Call Graph --------------------------------------------------------------
+
+internal B32
+lnk_section_from_order_symbol(LNK_SymbolTable *symtab, String8 name, LNK_Obj **obj_out, U32 *obj_sect_idx_out)
+{
+  LNK_Symbol *symbol = lnk_symbol_table_search(symtab, name);
+  if (symbol == 0) { return 0; }
+
+  LNK_ObjSymbolRef  ref    = lnk_ref_from_symbol(symbol);
+  COFF_ParsedSymbol parsed = lnk_parsed_symbol_from_coff_symbol_idx(ref.obj, ref.symbol_idx);
+  if (coff_interp_from_parsed_symbol(parsed) != COFF_SymbolValueInterp_Regular) { return 0; }
+
+  LNK_Obj *obj            = ref.obj;
+  U32      section_number = parsed.section_number;
+
+  // order contribution that survived /OPT:ICF
+  if (obj->folds && obj->folds[section_number].obj) {
+    LNK_SectionFold fold = obj->folds[section_number];
+    obj            = fold.obj;
+    section_number = fold.section_number;
+  }
+
+  *obj_out          = obj;
+  *obj_sect_idx_out = section_number - 1;
+  return 1;
+}
+
+internal U32
+lnk_call_graph_node_from_symbol(Arena *arena, LNK_CallGraph *cg, LNK_SymbolTable *symtab, String8 name)
+{
+  LNK_Obj *obj          = 0;
+  U32      obj_sect_idx = 0;
+  if (!lnk_section_from_order_symbol(symtab, name, &obj, &obj_sect_idx)) {
+    return max_U32;
+  }
+
+  U64           key = Compose64Bit(obj->input_idx, obj_sect_idx);
+  KeyValuePair *kv  = hash_table_search_u64(cg->node_ht, key);
+  if (kv) {
+    return kv->value_u32;
+  }
+
+  Assert(cg->count < cg->cap);
+  U32                node_idx = (U32)cg->count++;
+  LNK_CallGraphNode *node     = &cg->nodes[node_idx];
+  node->obj          = obj;
+  node->obj_sect_idx = obj_sect_idx;
+  node->size         = lnk_coff_section_header_from_section_number(obj, obj_sect_idx + 1)->fsize;
+  node->best_pred    = max_U32;
+  node->cluster      = node_idx;
+  node->next         = max_U32;
+  hash_table_push_u64_u64(arena, cg->node_ht, key, node_idx);
+
+  return node_idx;
+}
+
+internal int
+lnk_call_graph_density_is_before(void *raw_a, void *raw_b)
+{
+  LNK_CallGraphDensity *a = raw_a, *b = raw_b;
+  if (a->density == b->density) {
+    return a->idx < b->idx;
+  }
+  return a->density > b->density;
+}
+
+internal F64
+lnk_call_graph_density(U64 weight, U64 size)
+{
+  return (F64)weight / (F64)Max(size, 1);
+}
+
+internal U32
+lnk_call_graph_cluster_leader(LNK_CallGraph *cg, U32 node_idx)
+{
+  U32 leader = node_idx;
+  while (cg->nodes[leader].cluster != leader) { leader = cg->nodes[leader].cluster; }
+
+  // compress path so next lookup is direct
+  while (cg->nodes[node_idx].cluster != leader) {
+    U32 next = cg->nodes[node_idx].cluster;
+    cg->nodes[node_idx].cluster = leader;
+    node_idx = next;
+  }
+
+  return leader;
+}
+
+internal LNK_CallGraph
+lnk_call_graph_from_data(Arena *arena, LNK_SymbolTable *symtab, String8 path, String8 data)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+
+  String8List lines = str8_split_by_string_chars(scratch.arena, data, str8_lit("\r\n"), 0);
+
+  LNK_CallGraph cg = {0};
+  cg.cap      = lines.node_count * 2;
+  cg.nodes    = push_array(arena, LNK_CallGraphNode, cg.cap);
+  cg.clusters = push_array(arena, LNK_CallGraphCluster, cg.cap);
+  cg.node_ht  = hash_table_init(scratch.arena, Max(cg.cap, 1));
+
+  //
+  // parse "CALLER CALLEE COUNT" lines, duplicate edges are summed
+  //
+  U64        edges_count  = 0;
+  U32       *edge_from    = push_array(scratch.arena, U32, lines.node_count);
+  U32       *edge_to      = push_array(scratch.arena, U32, lines.node_count);
+  U64       *edge_weight  = push_array(scratch.arena, U64, lines.node_count);
+  HashTable *edge_ht      = hash_table_init(scratch.arena, Max(lines.node_count, 1));
+  U64        line_number  = 0;
+  for EachNode(line_n, String8Node, lines.first) {
+    line_number += 1;
+
+    String8 line = str8_skip_chop_whitespace(line_n->string);
+    if (line.size == 0 || line.str[0] == '#') { continue; }
+
+    String8List tokens = str8_split_by_string_chars(scratch.arena, line, str8_lit(" \t"), 0);
+    U64         weight = 0;
+    if (tokens.node_count != 3 || !try_u64_from_str8_c_rules(tokens.last->string, &weight)) {
+      lnk_error(LNK_Warning_UnorderableSymbol, "%S(%llu): syntax error, expected \"CALLER CALLEE COUNT\"", path, line_number);
+      continue;
+    }
+
+    String8 caller_name = tokens.first->string;
+    String8 callee_name = tokens.first->next->string;
+    U32     from        = lnk_call_graph_node_from_symbol(arena, &cg, symtab, caller_name);
+    U32     to          = lnk_call_graph_node_from_symbol(arena, &cg, symtab, callee_name);
+    if (from == max_U32 || to == max_U32) {
+      lnk_error(LNK_Warning_UnorderableSymbol, "%S(%llu): \"%S\" cannot be ordered; ignored", path, line_number, from == max_U32 ? caller_name : callee_name);
+      continue;
+    }
+
+    U64           edge_key = Compose64Bit(from, to);
+    KeyValuePair *kv       = hash_table_search_u64(edge_ht, edge_key);
+    if (kv) {
+      edge_weight[kv->value_u64] += weight;
+    } else {
+      hash_table_push_u64_u64(scratch.arena, edge_ht, edge_key, edges_count);
+      edge_from[edges_count]   = from;
+      edge_to[edges_count]     = to;
+      edge_weight[edges_count] = weight;
+      edges_count += 1;
+    }
+  }
+
+  //
+  // weigh nodes and pick the heaviest caller for each callee
+  //
+  for EachIndex(edge_idx, edges_count) {
+    LNK_CallGraphNode *to = &cg.nodes[edge_to[edge_idx]];
+    to->weight += edge_weight[edge_idx];
+    if (edge_from[edge_idx] == edge_to[edge_idx]) { continue; }
+    if (to->best_pred_weight < edge_weight[edge_idx]) {
+      to->best_pred        = edge_from[edge_idx];
+      to->best_pred_weight = edge_weight[edge_idx];
+    }
+  }
+
+  for EachIndex(node_idx, cg.count) {
+    cg.clusters[node_idx].first  = (U32)node_idx;
+    cg.clusters[node_idx].last   = (U32)node_idx;
+    cg.clusters[node_idx].size   = cg.nodes[node_idx].size;
+    cg.clusters[node_idx].weight = cg.nodes[node_idx].weight;
+  }
+
+  scratch_end(scratch);
+  return cg;
+}
+
+// C3 (Ottoni & Maher, "Optimizing Function Placement for Large-Scale
+// Data-Center Applications"): visit functions from densest to sparsest and
+// append each function's cluster to the cluster of its heaviest caller, so
+// callees land right after their callers.
+internal U32 *
+lnk_call_graph_order(Arena *arena, LNK_CallGraph *cg, U64 *count_out)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+
+  LNK_CallGraphDensity *sorted = push_array(scratch.arena, LNK_CallGraphDensity, cg->count);
+  for EachIndex(node_idx, cg->count) {
+    sorted[node_idx].density = lnk_call_graph_density(cg->nodes[node_idx].weight, cg->nodes[node_idx].size);
+    sorted[node_idx].idx     = (U32)node_idx;
+  }
+  radsort(sorted, cg->count, lnk_call_graph_density_is_before);
+
+  for EachIndex(sorted_idx, cg->count) {
+    U32                   c_idx = sorted[sorted_idx].idx;
+    LNK_CallGraphNode    *node  = &cg->nodes[c_idx];
+    LNK_CallGraphCluster *c     = &cg->clusters[c_idx];
+
+    // skip functions without callers and functions that are mostly called from elsewhere
+    if (node->best_pred == max_U32 || node->best_pred_weight * 10 <= node->weight) { continue; }
+
+    U32 pred_idx = lnk_call_graph_cluster_leader(cg, node->best_pred);
+    if (pred_idx == c_idx) { continue; }
+
+    LNK_CallGraphCluster *pred = &cg->clusters[pred_idx];
+    if (pred->size + c->size > LNK_CALL_GRAPH_MAX_CLUSTER_SIZE) { continue; }
+
+    F64 pred_density = lnk_call_graph_density(pred->weight, pred->size);
+    F64 new_density  = lnk_call_graph_density(pred->weight + c->weight, pred->size + c->size);
+    if (new_density * LNK_CALL_GRAPH_MAX_DENSITY_DEGRADATION < pred_density) { continue; }
+
+    // append cluster to the caller's cluster
+    cg->nodes[pred->last].next = c->first;
+    pred->last    = c->last;
+    pred->size   += c->size;
+    pred->weight += c->weight;
+    node->cluster = pred_idx;
+    MemoryZeroStruct(c);
+  }
+
+  // lay out surviving clusters from densest to sparsest
+  U64 clusters_count = 0;
+  for EachIndex(node_idx, cg->count) {
+    if (cg->nodes[node_idx].cluster != node_idx) { continue; }
+    LNK_CallGraphCluster *c = &cg->clusters[node_idx];
+    sorted[clusters_count].density = lnk_call_graph_density(c->weight, c->size);
+    sorted[clusters_count].idx     = (U32)node_idx;
+    clusters_count += 1;
+  }
+  radsort(sorted, clusters_count, lnk_call_graph_density_is_before);
+
+  U64  order_count = 0;
+  U32 *order       = push_array(arena, U32, cg->count);
+  for EachIndex(sorted_idx, clusters_count) {
+    for (U32 node_idx = cg->clusters[sorted[sorted_idx].idx].first; node_idx != max_U32; node_idx = cg->nodes[node_idx].next) {
+      order[order_count++] = node_idx;
+    }
+  }
+  Assert(order_count == cg->count);
+
+  scratch_end(scratch);
+  *count_out = order_count;
+  return order;
+}
+
+// --- Function Order ----------------------------------------------------------
+
+internal void
+lnk_push_section_rank(Arena *arena, U32 **ranks, LNK_Obj *obj, U32 obj_sect_idx, U32 *next_rank)
+{
+  if (ranks[obj->input_idx] == 0) {
+    ranks[obj->input_idx] = push_array(arena, U32, obj->header.section_count_no_null);
+  }
+  // first occurrence wins
+  if (ranks[obj->input_idx][obj_sect_idx] == 0) {
+    ranks[obj->input_idx][obj_sect_idx] = (*next_rank)++;
+  }
+}
+
+internal U32 **
+lnk_section_ranks_from_order(Arena *arena, LNK_Config *config, LNK_SymbolTable *symtab, U64 objs_count, LNK_Obj **objs)
+{
+  if (config->order_file_name.size == 0 && config->call_graph_file_name.size == 0) {
+    return 0;
+  }
+
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+
+  U32 **ranks     = push_array(arena, U32 *, objs_count);
+  U32   next_rank = 1;
+
+  //
+  // /ORDER: one symbol per line, sections are placed in the file order
+  //
+  if (config->order_file_name.size) {
+    String8 data = lnk_read_data_from_file_path(scratch.arena, config->io_flags, config->order_file_name);
+    if (data.size == 0) {
+      lnk_error(LNK_Error_FileNotFound, "unable to open order file %S", config->order_file_name);
+    }
+
+    String8List lines = str8_split_by_string_chars(scratch.arena, data, str8_lit("\r\n"), 0);
+    for EachNode(line_n, String8Node, lines.first) {
+      String8 name = str8_skip_chop_whitespace(line_n->string);
+      if (name.size == 0) { continue; }
+
+      LNK_Obj *obj          = 0;
+      U32      obj_sect_idx = 0;
+      if (lnk_section_from_order_symbol(symtab, name, &obj, &obj_sect_idx)) {
+        lnk_push_section_rank(arena, ranks, obj, obj_sect_idx, &next_rank);
+      } else {
+        lnk_error(LNK_Warning_UnorderableSymbol, "%S: \"%S\" cannot be ordered; ignored", config->order_file_name, name);
+      }
+    }
+  }
+
+  //
+  // /RAD_CALL_GRAPH_ORDER: sections that are not in /ORDER follow in C3 order
+  //
+  if (config->call_graph_file_name.size) {
+    String8 data = lnk_read_data_from_file_path(scratch.arena, config->io_flags, config->call_graph_file_name);
+    if (data.size == 0) {
+      lnk_error(LNK_Error_FileNotFound, "unable to open call graph file %S", config->call_graph_file_name);
+    }
+
+    LNK_CallGraph cg          = lnk_call_graph_from_data(scratch.arena, symtab, config->call_graph_file_name, data);
+    U64           order_count = 0;
+    U32          *order       = lnk_call_graph_order(scratch.arena, &cg, &order_count);
+    for EachIndex(order_idx, order_count) {
+      LNK_CallGraphNode *node = &cg.nodes[order[order_idx]];
+      lnk_push_section_rank(arena, ranks, node->obj, node->obj_sect_idx, &next_rank);
+    }
+  }
+
+  lnk_log(LNK_Log_Debug, "[Ordered Sections %u]", next_rank - 1);
+
+  scratch_end(scratch);
+  ProfEnd();
+  return ranks;
+}
+
+internal int
+lnk_ranked_section_contrib_is_before(void *raw_a, void *raw_b)
+{
+  LNK_RankedSectionContrib *a = raw_a, *b = raw_b;
+  return a->rank < b->rank;
+}
+
+internal void
+lnk_order_section_contribs(LNK_SectionContribChunk *chunk, U32 **ranks)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  // chunk is already sorted by input index, move ranked contribs to the front
+  // and keep the rest in input order
+  U64                       ranked_count = 0;
+  LNK_RankedSectionContrib *ranked       = push_array(scratch.arena, LNK_RankedSectionContrib, chunk->count);
+  for EachIndex(sc_idx, chunk->count) {
+    LNK_SectionContrib *sc        = chunk->v[sc_idx];
+    U32                *obj_ranks = ranks[sc->u.obj_idx];
+    if (obj_ranks && obj_ranks[sc->u.obj_sect_idx]) {
+      ranked[ranked_count].rank = obj_ranks[sc->u.obj_sect_idx];
+      ranked[ranked_count].sc   = sc;
+      ranked_count += 1;
+    }
+  }
+
+  if (ranked_count) {
+    radsort(ranked, ranked_count, lnk_ranked_section_contrib_is_before);
+
+    LNK_SectionContrib **unranked       = push_array(scratch.arena, LNK_SectionContrib *, chunk->count - ranked_count);
+    U64                  unranked_count = 0;
+    for EachIndex(sc_idx, chunk->count) {
+      LNK_SectionContrib *sc        = chunk->v[sc_idx];
+      U32                *obj_ranks = ranks[sc->u.obj_idx];
+      if (obj_ranks == 0 || obj_ranks[sc->u.obj_sect_idx] == 0) {
+        unranked[unranked_count++] = sc;
+      }
+    }
+
+    for EachIndex(i, ranked_count)   { chunk->v[i]                = ranked[i].sc; }
+    for EachIndex(i, unranked_count) { chunk->v[ranked_count + i] = unranked[i];  }
+  }
+
+  scratch_end(scratch);
+}
+
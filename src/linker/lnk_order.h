@@ -0,0 +1,59 @@
+// Copyright (c) Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#pragma once
+
+// --- Call Graph --------------------------------------------------------------
+
+// clusters are capped so hot code from unrelated call chains doesn't end up on the same pages
+#define LNK_CALL_GRAPH_MAX_CLUSTER_SIZE MB(1)
+
+// merge is rejected when it makes caller's cluster this many times less dense
+#define LNK_CALL_GRAPH_MAX_DENSITY_DEGRADATION 8
+
+typedef struct LNK_CallGraphNode
+{
+  LNK_Obj *obj;
+  U32      obj_sect_idx;
+  U64      size;
+  U64      weight;           // sum of incoming edge weights
+  U32      best_pred;        // caller with the heaviest edge, max_U32 if there are no callers
+  U64      best_pred_weight;
+  U32      cluster;          // leader of the cluster node was merged into
+  U32      next;             // next node in the cluster, max_U32 terminates
+} LNK_CallGraphNode;
+
+typedef struct LNK_CallGraphCluster
+{
+  U32 first;
+  U32 last;
+  U64 size;
+  U64 weight;
+} LNK_CallGraphCluster;
+
+typedef struct LNK_CallGraph
+{
+  U64                   count;
+  U64                   cap;
+  LNK_CallGraphNode    *nodes;
+  LNK_CallGraphCluster *clusters; // indexed by leader node
+  HashTable            *node_ht;  // Compose64Bit(obj input index, section index) -> node index
+} LNK_CallGraph;
+
+typedef struct LNK_CallGraphDensity
+{
+  F64 density;
+  U32 idx;
+} LNK_CallGraphDensity;
+
+typedef struct LNK_RankedSectionContrib
+{
+  U32                 rank;
+  LNK_SectionContrib *sc;
+} LNK_RankedSectionContrib;
+
+// --- Function Order ----------------------------------------------------------
+
+internal U32 ** lnk_section_ranks_from_order(Arena *arena, LNK_Config *config, LNK_SymbolTable *symtab, U64 objs_count, LNK_Obj **objs);
+internal void   lnk_order_section_contribs(LNK_SectionContribChunk *chunk, U32 **ranks);
+
@@ -374,6 +374,7 @@ lnk_finalize_section_layout(LNK_Section *sect, U64 file_align, U64 pad_size)
       // advance cursor
       U64 sc_size = lnk_size_from_section_contrib(sc);
       cursor += sc_size;
+      cursor += sc->incremental_pad;
     }
   }
   ProfEnd();
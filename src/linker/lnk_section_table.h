@@ -23,6 +23,7 @@ typedef struct LNK_SectionContrib
   } u;
   U16 align; // contribution alignment in the image
   B8 hotpatch;
+  U32 incremental_pad; // bytes reserved after contribution so /INCREMENTAL can patch it in place
 } LNK_SectionContrib;
 
 typedef struct LNK_SectionContribChunk
@@ -1933,7 +1933,7 @@ rdib_string_map_insert_item(Arena *arena, RDIB_CollectStringsTask *task, U64 tas
   // fill out bucket
   (*bucket)->string     = string;
   (*bucket)->raw_values = value;
-  (*bucket)->sorter.hi  = safe_cast_u32(task_id);
+  (*bucket)->sorter.hi  = safe_cast_u32(task->chunk_idx_base + task_id);
   (*bucket)->sorter.lo  = safe_cast_u32(task->element_indices[task_id]);
 
   // insert bucket into string map
@@ -2369,17 +2369,6 @@ THREAD_POOL_TASK_FUNC(rdib_collect_strings_types_task)
   ProfEnd();
 }
 
-internal
-THREAD_POOL_TASK_FUNC(rdib_collect_strings_path_nodes_task)
-{
-  ProfBeginFunction();
-  RDIB_CollectStringsTask *task = raw_task;
-  for (RDIB_PathTreeNode *n = task->path_node_lists[task_id].first; n != 0; n = n->next_order) {
-    rdib_string_map_insert_string_table_item(arena, task, task_id, n->sub_path);
-  }
-  ProfEnd();
-}
-
 ////////////////////////////////
 // Name Map Tasks
 
@@ -5282,6 +5271,7 @@ if (((RDIB_Type*)(t))->kind == RDI_TypeKindExt_VirtualTable) break; \
   // loop over structs and build a map with every possible string
   ProfBegin("String Map");
   RDIB_StringMap *string_map;
+  U64             string_map_chunk_count;
   {
     U64 top_level_string_count   = 2;
     U64 sect_string_count        = 1;
@@ -5326,77 +5316,107 @@ if (((RDIB_Type*)(t))->kind == RDI_TypeKindExt_VirtualTable) break; \
     rdib_string_map_insert_string_table_item(arena->v[0], &task, 0, input->top_level_info.exe_name);
     rdib_string_map_insert_string_table_item(arena->v[0], &task, 0, input->top_level_info.producer_string);
 
+    // buckets are sorted on (chunk, element) pairs, each pass gets its own range of chunks so string
+    // order follows pass and item order rather than which worker picked up the item
+    task.chunk_idx_base += 1;
+
     ProfBegin("Sections");
     task.ranges = tp_divide_work(scratch.arena, input->sect_count, tp->worker_count);
     task.sects  = input->sections;
     tp_for_parallel(tp, arena, tp->worker_count, rdib_collect_strings_sects_task, &task);
+    task.chunk_idx_base += tp->worker_count;
     ProfEnd();
 
     ProfBegin("Units");
     task.ranges = tp_divide_work(scratch.arena, all_units.count, tp->worker_count);
     task.units  = all_unit_chunks;
     tp_for_parallel(tp, arena, tp->worker_count, rdib_collect_strings_units_task, &task);
+    task.chunk_idx_base += tp->worker_count;
     ProfEnd();
 
     ProfBegin("Source Files");
     task.ranges          = tp_divide_work(scratch.arena, all_src_files.count, tp->worker_count);
     task.src_file_chunks = all_src_file_chunks;
     tp_for_parallel(tp, arena, tp->worker_count, rdib_collect_strings_source_files_task, &task);
+    task.chunk_idx_base += tp->worker_count;
     ProfEnd();
 
     ProfBegin("Locals");
     task.ranges = tp_divide_work(scratch.arena, all_locals.count, tp->worker_count);
     task.vars   = all_local_chunks;
     tp_for_parallel(tp, arena, tp->worker_count, rdib_collect_strings_vars_task, &task);
+    task.chunk_idx_base += tp->worker_count;
     ProfEnd();
 
     ProfBegin("Global Variables");
     task.ranges = tp_divide_work(scratch.arena, all_gvars.count, tp->worker_count);
     task.vars   = all_gvar_chunks;
     tp_for_parallel(tp, arena, tp->worker_count, rdib_collect_strings_vars_task, &task);
+    task.chunk_idx_base += tp->worker_count;
     ProfEnd();
 
     ProfBegin("Thread Variables");
     task.ranges = tp_divide_work(scratch.arena, all_tvars.count, tp->worker_count);
     task.vars   = all_tvar_chunks;
     tp_for_parallel(tp, arena, tp->worker_count, rdib_collect_strings_vars_task, &task);
+    task.chunk_idx_base += tp->worker_count;
     ProfEnd();
 
     ProfBegin("Procedures");
     task.ranges = tp_divide_work(scratch.arena, all_procs.count, tp->worker_count);
     task.procs  = all_proc_chunks;
     tp_for_parallel(tp, arena, tp->worker_count, rdib_collect_strings_procs_task, &task);
+    task.chunk_idx_base += tp->worker_count;
     ProfEnd();
 
     ProfBegin("Inline Sites");
     task.ranges       = tp_divide_work(scratch.arena, all_inline_sites.count, tp->worker_count);
     task.inline_sites = all_inline_site_chunks;
     tp_for_parallel(tp, arena, tp->worker_count, rdib_collect_strings_inline_sites_task, &task);
+    task.chunk_idx_base += tp->worker_count;
     ProfEnd();
 
     ProfBegin("UDT Members");
     task.ranges      = tp_divide_work(scratch.arena, all_udt_members.count, tp->worker_count);
     task.udt_members = all_udt_member_chunks;
     tp_for_parallel(tp, arena, tp->worker_count, rdib_collect_strings_udt_members_task, &task);
+    task.chunk_idx_base += tp->worker_count;
     ProfEnd();
 
     ProfBegin("Enum Members");
     task.ranges      = tp_divide_work(scratch.arena, all_enum_members.count, tp->worker_count);
     task.udt_members = all_enum_member_chunks;
     tp_for_parallel(tp, arena, tp->worker_count, rdib_collect_strings_enum_members_task, &task);
+    task.chunk_idx_base += tp->worker_count;
     ProfEnd();
 
     ProfBegin("Types");
     task.ranges     = tp_divide_work(scratch.arena, all_types.count, tp->worker_count);
     task.types      = all_type_chunks;
     tp_for_parallel(tp, arena, tp->worker_count, rdib_collect_strings_types_task, &task);
+    task.chunk_idx_base += tp->worker_count;
     ProfEnd();
 
     ProfBegin("Path Tree");
-    task.ranges          = tp_divide_work(scratch.arena, path_tree->list_count, tp->worker_count);
-    task.path_node_lists = path_tree->node_lists;
-    tp_for_parallel(tp, arena, tp->worker_count, rdib_collect_strings_path_nodes_task, &task);
+    {
+      // nodes are dealt round-robin into per-worker lists, walk lists in insertion order
+      // so string order doesn't depend on the worker count
+      Temp temp = temp_begin(scratch.arena);
+      RDIB_PathTreeNode **cursors = push_array(temp.arena, RDIB_PathTreeNode *, path_tree->list_count);
+      for (U64 list_idx = 0; list_idx < path_tree->list_count; ++list_idx) {
+        cursors[list_idx] = path_tree->node_lists[list_idx].first;
+      }
+      for (U64 node_idx = 0; node_idx < path_tree->next_list_idx; ++node_idx) {
+        U64 list_idx = node_idx % path_tree->list_count;
+        rdib_string_map_insert_string_table_item(arena->v[0], &task, 0, cursors[list_idx]->sub_path);
+        cursors[list_idx] = cursors[list_idx]->next_order;
+      }
+      temp_end(temp);
+      task.chunk_idx_base += 1;
+    }
     ProfEnd();
+
+    string_map_chunk_count = task.chunk_idx_base;
   }
   ProfEnd();
 
@@ -5406,6 +5426,7 @@ if (((RDIB_Type*)(t))->kind == RDI_TypeKindExt_VirtualTable) break; \
     name_maps[RDI_NameMapKind_NULL              ] = rdib_init_string_map(scratch.arena, 1                   );
     name_maps[RDI_NameMapKind_GlobalVariables   ] = rdib_init_string_map(scratch.arena, total_gvar_count    );
     name_maps[RDI_NameMapKind_ThreadVariables   ] = rdib_init_string_map(scratch.arena, total_tvar_count    );
+    name_maps[RDI_NameMapKind_Constants         ] = rdib_init_string_map(scratch.arena, 1                   );
     name_maps[RDI_NameMapKind_Procedures        ] = rdib_init_string_map(scratch.arena, total_proc_count    );
     name_maps[RDI_NameMapKind_Types             ] = rdib_init_string_map(scratch.arena, total_type_count    );
     name_maps[RDI_NameMapKind_LinkNameProcedures] = rdib_init_string_map(scratch.arena, total_proc_count    );
@@ -5457,7 +5478,7 @@ if (((RDIB_Type*)(t))->kind == RDI_TypeKindExt_VirtualTable) break; \
   ProfBeginDynamic("Extract String Table Buckets [Cap: %llu]", string_map->cap);
   U64                    string_map_bucket_count;
   RDIB_StringMapBucket **string_map_buckets = rdib_extant_buckets_from_string_map(tp, scratch.arena, string_map, &string_map_bucket_count);
-  rdib_string_map_sort_buckets(tp, string_map_buckets, string_map_bucket_count, tp->worker_count);
+  rdib_string_map_sort_buckets(tp, string_map_buckets, string_map_bucket_count, string_map_chunk_count);
   rdib_string_map_assign_indices(string_map_buckets, string_map_bucket_count);
   ProfEnd();
 
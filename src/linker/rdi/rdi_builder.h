@@ -844,6 +844,7 @@ typedef struct
   RDIB_StringMapBucket     **free_buckets;
   U64                       *insert_counts;
   U64                       *element_indices;
+  U64                        chunk_idx_base;
   union
   {
     RDIB_UnitChunk        **units;
@@ -855,7 +856,6 @@ typedef struct
     RDIB_UDTMemberChunk   **udt_members;
     RDIB_UDTMemberChunk   **enum_members;
     RDIB_TypeChunk        **types;
-    RDIB_PathTreeNodeList  *path_node_lists;
   };
 } RDIB_CollectStringsTask;
 
@@ -1,31 +1,254 @@
 // Copyright (c) Epic Games Tools
 // Licensed under the MIT license (https://opensource.org/license/mit/)
 
+thread_static TP_Worker *tp_tl_worker;
+
 internal void
-tp_run_tasks(TP_Context *pool, TP_Worker *worker)
+tp_lock(Mutex mutex)
 {
-  for (;;) {
-    S64 task_left = ins_atomic_u64_dec_eval(&pool->task_left);
+  // single worker pools don't allocate sync primitives
+  if (mutex.u64[0]) { mutex_take(mutex); }
+}
 
-    // are there any tasks left to run?
-    if (task_left < 0) {
-      break;
+internal void
+tp_unlock(Mutex mutex)
+{
+  if (mutex.u64[0]) { mutex_drop(mutex); }
+}
+
+internal TP_Worker *
+tp_worker_from_pool(TP_Context *pool)
+{
+  // threads that don't belong to the pool act as the main worker, only the
+  // owner touches bottom of a deque so one such thread may drive the pool at a time
+  TP_Worker *worker = tp_tl_worker;
+  if (worker == 0 || worker->pool != pool) {
+    worker = &pool->worker_arr[0];
+  }
+  return worker;
+}
+
+internal void
+tp_wake_workers(TP_Context *pool, U64 task_count)
+{
+  if (pool->worker_count > 1) {
+    U64 drop_count = Min(task_count, pool->worker_count);
+
+    // if we are in shared mode ping local semaphore
+    if (pool->exec_semaphore.u64[0] != 0) {
+      for (U64 worker_idx = 0; worker_idx < drop_count; worker_idx += 1) {
+        os_semaphore_drop(pool->exec_semaphore);
+      }
     }
 
-    // run task
-    Arena *arena   = pool->task_arena ? pool->task_arena->v[worker->id] : 0;
-    U64    task_id = pool->task_count - (task_left+1);
-    pool->task_func(arena, worker->id, task_id, pool->task_data);
+    // ping shared semaphore
+    for (U64 worker_idx = 0; worker_idx < drop_count; worker_idx += 1) {
+      os_semaphore_drop(pool->task_semaphore);
+    }
+
+    // wake up threads that are waiting on a job so they can help
+    tp_lock(pool->sync_mutex);
+    pool->sync_gen += 1;
+    cond_var_broadcast(pool->sync_cv);
+    tp_unlock(pool->sync_mutex);
+  }
+}
+
+internal TP_DequeBuffer *
+tp_deque_buffer_alloc(Arena *arena, U64 cap)
+{
+  TP_DequeBuffer *buffer = push_array(arena, TP_DequeBuffer, 1);
+  buffer->cap = cap;
+  buffer->v   = push_array_no_zero(arena, TP_Slice, cap);
+  return buffer;
+}
 
-    // cache task count so we dont touch pool memory after atomic inc
-    U64 task_count = pool->task_count;
+internal void
+tp_deque_push(TP_Deque *deque, TP_Slice slice)
+{
+  // only owner writes bottom and buffer
+  U64             b      = deque->bottom;
+  U64             t      = ins_atomic_u64_eval(&deque->top);
+  TP_DequeBuffer *buffer = deque->buffer;
 
-    // on last task ping main thread
-    U64 task_done = ins_atomic_u64_inc_eval(&pool->task_done);
-    if (task_done == task_count) {
-      os_semaphore_drop(pool->main_semaphore);
+  if (b - t >= buffer->cap) {
+    TP_DequeBuffer *new_buffer = tp_deque_buffer_alloc(deque->arena, buffer->cap * 2);
+    for (U64 i = t; i < b; i += 1) {
+      new_buffer->v[i & (new_buffer->cap - 1)] = buffer->v[i & (buffer->cap - 1)];
     }
+    ins_atomic_ptr_eval_assign(&deque->buffer, new_buffer);
+    buffer = new_buffer;
   }
+
+  buffer->v[b & (buffer->cap - 1)] = slice;
+  ins_atomic_u64_eval_assign(&deque->bottom, b + 1);
+}
+
+internal B32
+tp_deque_pop(TP_Deque *deque, TP_Job *job_filter, TP_Slice *slice_out)
+{
+  U64             b      = deque->bottom;
+  TP_DequeBuffer *buffer = deque->buffer;
+  if ((S64)(b - ins_atomic_u64_eval(&deque->top)) <= 0) {
+    return 0;
+  }
+
+  // filtered waits only run slices of the awaited job, which are always pushed last
+  if (job_filter && buffer->v[(b - 1) & (buffer->cap - 1)].job != job_filter) {
+    return 0;
+  }
+
+  b -= 1;
+  ins_atomic_u64_eval_assign(&deque->bottom, b);
+  U64 t = ins_atomic_u64_eval(&deque->top);
+
+  B32 is_taken = 0;
+  if ((S64)(b - t) >= 0) {
+    *slice_out = buffer->v[b & (buffer->cap - 1)];
+    is_taken   = 1;
+
+    // last slice, race thieves for it
+    if (b == t) {
+      is_taken = ins_atomic_u64_eval_cond_assign(&deque->top, t + 1, t) == t;
+      ins_atomic_u64_eval_assign(&deque->bottom, b + 1);
+    }
+  } else {
+    ins_atomic_u64_eval_assign(&deque->bottom, b + 1);
+  }
+
+  return is_taken;
+}
+
+internal B32
+tp_deque_steal(TP_Deque *deque, TP_Job *job_filter, TP_Slice *slice_out)
+{
+  B32 is_taken = 0;
+  U64 t        = ins_atomic_u64_eval(&deque->top);
+  U64 b        = ins_atomic_u64_eval(&deque->bottom);
+  if ((S64)(b - t) > 0) {
+    // owner never writes to slot at top without growing the buffer first,
+    // so slice is valid if we win the race for top
+    TP_DequeBuffer *buffer = ins_atomic_ptr_eval(&deque->buffer);
+    TP_Slice        slice  = buffer->v[t & (buffer->cap - 1)];
+    if (job_filter == 0 || slice.job == job_filter) {
+      if (ins_atomic_u64_eval_cond_assign(&deque->top, t + 1, t) == t) {
+        *slice_out = slice;
+        is_taken   = 1;
+      }
+    }
+  }
+  return is_taken;
+}
+
+internal void tp_job_schedule(TP_Context *pool, TP_Worker *worker, TP_Job *job);
+
+internal void
+tp_job_finish(TP_Context *pool, TP_Worker *worker, TP_Job *job)
+{
+  // job memory may be released as soon as waiter sees the done flag,
+  // so grab dependents first and don't touch the job after that
+  tp_lock(pool->sync_mutex);
+  TP_JobNode *dependents = job->dependents;
+  ins_atomic_u32_eval_assign(&job->is_done, 1);
+  pool->sync_gen += 1;
+  if (pool->sync_cv.u64[0]) { cond_var_broadcast(pool->sync_cv); }
+  tp_unlock(pool->sync_mutex);
+
+  for EachNode(n, TP_JobNode, dependents) {
+    if (ins_atomic_u64_dec_eval(&n->job->deps_left) == 0) {
+      tp_job_schedule(pool, worker, n->job);
+    }
+  }
+}
+
+internal void
+tp_job_schedule(TP_Context *pool, TP_Worker *worker, TP_Job *job)
+{
+  if (job->task_count == 0) {
+    tp_job_finish(pool, worker, job);
+  } else {
+    tp_deque_push(&worker->deque, (TP_Slice){ .job = job, .lo = 0, .hi = job->task_count });
+    tp_wake_workers(pool, job->task_count);
+  }
+}
+
+internal void
+tp_job_launch(TP_Context *pool, TP_Job *job, U64 dep_count, TP_Job **deps, TP_JobNode *dep_nodes)
+{
+  TP_Worker *worker = tp_worker_from_pool(pool);
+
+  // extra count holds the job back until all dependencies are linked
+  job->tasks_left = job->task_count;
+  job->deps_left  = dep_count + 1;
+
+  for EachIndex(dep_idx, dep_count) {
+    TP_Job *dep     = deps[dep_idx];
+    B32     is_done = 1;
+    tp_lock(pool->sync_mutex);
+    if (!ins_atomic_u32_eval(&dep->is_done)) {
+      dep_nodes[dep_idx].job = job;
+      SLLStackPush(dep->dependents, &dep_nodes[dep_idx]);
+      is_done = 0;
+    }
+    tp_unlock(pool->sync_mutex);
+    if (is_done) {
+      ins_atomic_u64_dec_eval(&job->deps_left);
+    }
+  }
+
+  if (ins_atomic_u64_dec_eval(&job->deps_left) == 0) {
+    tp_job_schedule(pool, worker, job);
+  }
+}
+
+internal B32
+tp_run_next_task(TP_Context *pool, TP_Worker *worker, TP_Job *job_filter)
+{
+  TP_Slice slice     = {0};
+  B32      is_found  = tp_deque_pop(&worker->deque, job_filter, &slice);
+  B32      is_stolen = 0;
+
+  // own deque is empty, steal from other workers
+  for (U64 i = 1; i < pool->worker_count && !is_found; i += 1) {
+    TP_Worker *victim = &pool->worker_arr[(worker->id + i) % pool->worker_count];
+    is_found  = tp_deque_steal(&victim->deque, job_filter, &slice);
+    is_stolen = is_found;
+  }
+
+  if (is_found) {
+    // push rest of the range back in two halves, thieves take the upper half
+    // from the top and this worker continues with the lower half
+    U64 lo = slice.lo + 1;
+    if (lo < slice.hi) {
+      U64 mid = lo + (slice.hi - lo) / 2;
+      if (mid > lo) {
+        tp_deque_push(&worker->deque, (TP_Slice){ .job = slice.job, .lo = mid, .hi = slice.hi });
+        tp_deque_push(&worker->deque, (TP_Slice){ .job = slice.job, .lo = lo,  .hi = mid      });
+      } else {
+        tp_deque_push(&worker->deque, (TP_Slice){ .job = slice.job, .lo = lo,  .hi = slice.hi });
+      }
+
+      // wake up another worker to help with the stolen range
+      if (is_stolen) {
+        tp_wake_workers(pool, 1);
+      }
+    }
+  }
+
+  if (is_found) {
+    TP_Job *job   = slice.job;
+    Arena  *arena = job->task_arena ? job->task_arena->v[worker->id] : 0;
+
+    worker->task_depth += 1;
+    job->task_func(arena, worker->id, slice.lo, job->task_data);
+    worker->task_depth -= 1;
+
+    if (ins_atomic_u64_dec_eval(&job->tasks_left) == 0) {
+      tp_job_finish(pool, worker, job);
+    }
+  }
+
+  return is_found;
 }
 
 internal void
@@ -33,9 +256,10 @@ tp_worker_main(void *raw_worker)
 {
   TP_Worker  *worker = raw_worker;
   TP_Context *pool   = worker->pool;
+  tp_tl_worker = worker;
   for (; pool->is_live; ) {
     if (os_semaphore_take(pool->task_semaphore, max_U64)) {
-      tp_run_tasks(pool, worker);
+      while (tp_run_next_task(pool, worker, 0)) {}
     }
   }
 }
@@ -45,10 +269,11 @@ tp_worker_main_shared(void *raw_worker)
 {
   TP_Worker  *worker = raw_worker;
   TP_Context *pool   = worker->pool;
+  tp_tl_worker = worker;
   for (; pool->is_live; ) {
     if (os_semaphore_take(pool->exec_semaphore, max_U64)) {
       if (os_semaphore_take(pool->task_semaphore, max_U64)) {
-        tp_run_tasks(pool, worker);
+        while (tp_run_next_task(pool, worker, 0)) {}
       }
     }
   }
@@ -63,11 +288,11 @@ tp_alloc(Arena *arena, U32 worker_count, U32 max_worker_count, String8 name)
   B32 is_shared = (name.size > 0);
 
   // alloc semaphores
-  Semaphore main_semaphore = {0};
   Semaphore task_semaphore = {0};
   Semaphore exec_semaphore = {0};
+  Mutex     sync_mutex     = {0};
+  CondVar   sync_cv        = {0};
   if (worker_count > 1) {
-    main_semaphore = os_semaphore_alloc(0, 1, str8_zero());
     if (is_shared) {
       AssertAlways(worker_count <= max_worker_count);
       task_semaphore = os_semaphore_alloc(0, max_worker_count, name);
@@ -75,6 +300,8 @@ tp_alloc(Arena *arena, U32 worker_count, U32 max_worker_count, String8 name)
     } else {
       task_semaphore = os_semaphore_alloc(0, worker_count, str8_zero());
     }
+    sync_mutex = mutex_alloc();
+    sync_cv    = cond_var_alloc();
   }
 
   // pick entry point for the workers
@@ -84,7 +311,8 @@ tp_alloc(Arena *arena, U32 worker_count, U32 max_worker_count, String8 name)
   TP_Context *pool     = push_array(arena, TP_Context, 1);
   pool->exec_semaphore = exec_semaphore;
   pool->task_semaphore = task_semaphore;
-  pool->main_semaphore = main_semaphore;
+  pool->sync_mutex     = sync_mutex;
+  pool->sync_cv        = sync_cv;
   pool->is_live        = 1;
   pool->worker_count   = worker_count;
   pool->worker_arr     = push_array(arena, TP_Worker, worker_count);
@@ -94,6 +322,8 @@ tp_alloc(Arena *arena, U32 worker_count, U32 max_worker_count, String8 name)
     TP_Worker *worker = &pool->worker_arr[i];
     worker->id        = i;
     worker->pool      = pool;
+    worker->deque.arena  = arena_alloc();
+    worker->deque.buffer = tp_deque_buffer_alloc(worker->deque.arena, TP_DEQUE_INITIAL_CAP);
   }
   
   // launch worker threads
@@ -111,23 +341,30 @@ tp_release(TP_Context *pool)
 {
   pool->is_live = 0;
 
-  B32 is_shared = pool->exec_semaphore.u64[0] != 0;
-  if (is_shared) {
+  if (pool->worker_count > 1) {
+    B32 is_shared = pool->exec_semaphore.u64[0] != 0;
+    if (is_shared) {
+      for (U64 i = 0; i < pool->worker_count; ++i) {
+        semaphore_drop(pool->exec_semaphore);
+      }
+    }
     for (U64 i = 0; i < pool->worker_count; ++i) {
-      semaphore_drop(pool->exec_semaphore);
+      semaphore_drop(pool->task_semaphore);
     }
+    for (U64 i = 1; i < pool->worker_count; i += 1) {
+      thread_detach(pool->worker_arr[i].handle);
+    }
+    if (is_shared) {
+      semaphore_release(pool->exec_semaphore);
+    }
+    semaphore_release(pool->task_semaphore);
+    cond_var_release(pool->sync_cv);
+    mutex_release(pool->sync_mutex);
   }
-  for (U64 i = 0; i < pool->worker_count; ++i) {
-    semaphore_drop(pool->task_semaphore);
-  }
-  for (U64 i = 1; i < pool->worker_count; i += 1) {
-    thread_detach(pool->worker_arr[i].handle);
-  }
-  if (is_shared) {
-    semaphore_release(pool->exec_semaphore);
+
+  for (U64 i = 0; i < pool->worker_count; i += 1) {
+    arena_release(pool->worker_arr[i].deque.arena);
   }
-  semaphore_release(pool->task_semaphore);
-  semaphore_release(pool->main_semaphore);
 
   MemoryZeroStruct(pool);
 }
@@ -194,37 +431,85 @@ tp_temp_end(TP_Temp temp)
   ProfEnd();
 }
 
+internal TP_Job *
+tp_submit(TP_Context *pool, Arena *arena, TP_Arena *task_arena, U64 task_count, TP_TaskFunc *task_func, void *task_data, U64 dep_count, TP_Job **deps)
+{
+  TP_Job *job     = push_array(arena, TP_Job, 1);
+  job->task_func  = task_func;
+  job->task_data  = task_data;
+  job->task_arena = task_arena;
+  job->task_count = task_count;
+
+  TP_JobNode *dep_nodes = push_array(arena, TP_JobNode, dep_count);
+  tp_job_launch(pool, job, dep_count, deps, dep_nodes);
+
+  return job;
+}
+
 internal void
-tp_for_parallel(TP_Context *pool, TP_Arena *task_arena, U64 task_count, TP_TaskFunc *task_func, void *task_data)
+tp_wait(TP_Context *pool, TP_Job *job)
 {
-  if (task_count > 0) {
-    // init run
-    pool->task_arena = task_arena;
-    pool->task_func  = task_func;
-    pool->task_data  = task_data;
-    pool->task_count = task_count;
-    pool->task_done  = 0;
-    ins_atomic_u64_eval_assign(&pool->task_left, task_count);
+  TP_Worker *worker = tp_worker_from_pool(pool);
 
-    U64 drop_count = Min(task_count, pool->worker_count);
+  // when waiting from inside a task run only tasks from the awaited job,
+  // unrelated tasks could push into the same worker arena under caller's temp
+  TP_Job *job_filter = worker->task_depth > 0 ? job : 0;
 
-    // if we are in shared mode ping local semaphore
-    if (pool->exec_semaphore.u64[0] != 0) {
-      for (U64 worker_idx = 0; worker_idx < drop_count; worker_idx +=1) {
-        os_semaphore_drop(pool->exec_semaphore);
-      }
+  for (;;) {
+    if (ins_atomic_u32_eval(&job->is_done)) {
+      break;
     }
-    
-    // ping shared semaphore
-    for (U64 worker_idx = 0; worker_idx < drop_count; worker_idx += 1) {
-      os_semaphore_drop(pool->task_semaphore);
+
+    tp_lock(pool->sync_mutex);
+    U64 sync_gen = pool->sync_gen;
+    tp_unlock(pool->sync_mutex);
+
+    if (tp_run_next_task(pool, worker, job_filter)) {
+      continue;
+    }
+
+    // remaining tasks are running on other workers, sleep until a job finishes or new work arrives
+    AssertAlways(pool->worker_count > 1);
+    tp_lock(pool->sync_mutex);
+    if (!ins_atomic_u32_eval(&job->is_done) && sync_gen == pool->sync_gen) {
+      cond_var_wait(pool->sync_cv, pool->sync_mutex, max_U64);
     }
-    
-    // run tasks on main worker
-    tp_run_tasks(pool, &pool->worker_arr[0]);
-    
-    // wait for workers to finish tasks
-    os_semaphore_take(pool->main_semaphore, max_U64);
+    tp_unlock(pool->sync_mutex);
+  }
+}
+
+internal B32
+tp_is_job_done(TP_Job *job)
+{
+  return ins_atomic_u32_eval(&job->is_done);
+}
+
+internal void
+tp_task_scope_begin(TP_Context *pool)
+{
+  TP_Worker *worker = tp_worker_from_pool(pool);
+  worker->task_depth += 1;
+}
+
+internal void
+tp_task_scope_end(TP_Context *pool)
+{
+  TP_Worker *worker = tp_worker_from_pool(pool);
+  Assert(worker->task_depth > 0);
+  worker->task_depth -= 1;
+}
+
+internal void
+tp_for_parallel(TP_Context *pool, TP_Arena *task_arena, U64 task_count, TP_TaskFunc *task_func, void *task_data)
+{
+  if (task_count > 0) {
+    TP_Job job = {0};
+    job.task_func  = task_func;
+    job.task_data  = task_data;
+    job.task_arena = task_arena;
+    job.task_count = task_count;
+    tp_job_launch(pool, &job, 0, 0, 0);
+    tp_wait(pool, &job);
   }
 }
 
@@ -6,6 +6,8 @@
 #define THREAD_POOL_TASK_FUNC(name) void name(Arena *arena, U64 worker_id, U64 task_id, void *raw_task)
 typedef THREAD_POOL_TASK_FUNC(TP_TaskFunc);
 
+#define TP_DEQUE_INITIAL_CAP 256
+
 typedef struct TP_Arena
 {
   U64     count;
@@ -18,11 +20,54 @@ typedef struct TP_Temp
   Temp *v;
 } TP_Temp;
 
+typedef struct TP_JobNode
+{
+  struct TP_JobNode *next;
+  struct TP_Job     *job;
+} TP_JobNode;
+
+typedef struct TP_Job
+{
+  TP_TaskFunc *task_func;
+  void        *task_data;
+  TP_Arena    *task_arena;
+  U64          task_count;
+  U64          tasks_left;  // job is done when this drops to zero
+  U64          deps_left;   // job is scheduled when this drops to zero
+  U32          is_done;
+  TP_JobNode  *dependents;  // jobs to schedule when this job is done, guarded by pool sync mutex
+} TP_Job;
+
+// range of task ids from one job
+typedef struct TP_Slice
+{
+  TP_Job *job;
+  U64     lo;
+  U64     hi;
+} TP_Slice;
+
+typedef struct TP_DequeBuffer
+{
+  U64       cap; // power of two
+  TP_Slice *v;
+} TP_DequeBuffer;
+
+// Chase-Lev deque, owner pushes and pops at the bottom, thieves take from the top
+typedef struct TP_Deque
+{
+  U64             top;
+  U64             bottom;
+  TP_DequeBuffer *buffer;
+  Arena          *arena; // grown buffers, old ones are kept around since thieves might still read them
+} TP_Deque;
+
 typedef struct TP_Worker
 {
   U64                id;
   struct TP_Context *pool;
   Thread             handle;
+  TP_Deque           deque;
+  U64                task_depth;
 } TP_Worker;
 
 typedef struct TP_Context
@@ -30,17 +75,13 @@ typedef struct TP_Context
   B32          is_live;
   Semaphore    exec_semaphore;
   Semaphore    task_semaphore;
-  Semaphore    main_semaphore;
+
+  Mutex        sync_mutex;
+  CondVar      sync_cv;
+  U64          sync_gen;
 
   U32          worker_count;
   TP_Worker   *worker_arr;
-
-  TP_Arena    *task_arena;
-  TP_TaskFunc *task_func;
-  void        *task_data;
-  U64          task_count;
-  U64          task_done;
-  S64          task_left;
 } TP_Context;
 
 internal TP_Context * tp_alloc(Arena *arena, U32 worker_count, U32 max_worker_count, String8 name);
@@ -49,6 +90,17 @@ internal TP_Arena *   tp_arena_alloc(TP_Context *pool);
 internal void         tp_arena_release(TP_Arena **arena_ptr);
 internal TP_Temp      tp_temp_begin(TP_Arena *arena);
 internal void         tp_temp_end(TP_Temp temp);
+
+// jobs
+internal TP_Job * tp_submit(TP_Context *pool, Arena *arena, TP_Arena *task_arena, U64 task_count, TP_TaskFunc *task_func, void *task_data, U64 dep_count, TP_Job **deps);
+internal void     tp_wait(TP_Context *pool, TP_Job *job);
+internal B32      tp_is_job_done(TP_Job *job);
+
+// marks calling thread as running a task, waits inside the scope help only with jobs they wait on
+internal void tp_task_scope_begin(TP_Context *pool);
+internal void tp_task_scope_end(TP_Context *pool);
+
+// fork-join
 #define tp_for_parallel_prof(pool, arena, task_count, task_func, task_data, zone_name) ProfBegin(zone_name); tp_for_parallel(pool, arena, task_count, task_func, task_data); ProfEnd();
 internal void         tp_for_parallel(TP_Context *pool, TP_Arena *arena, U64 task_count, TP_TaskFunc *task_func, void *task_data);
 internal Rng1U64 *    tp_divide_work(Arena *arena, U64 item_count, U32 worker_count);
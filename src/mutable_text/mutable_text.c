@@ -45,6 +45,204 @@ mtx_push_op(C_Key buffer_key, MTX_Op op)
   mtx_enqueue_op(thread, buffer_key, op);
 }
 
+internal MTX_Node *
+mtx_node_from_key(C_Key buffer_key)
+{
+  U64 hash = u64_hash_from_str8(str8_struct(&buffer_key));
+  U64 slot_idx = hash%mtx_shared->slots_count;
+  U64 stripe_idx = slot_idx%mtx_shared->stripes_count;
+  MTX_Slot *slot = &mtx_shared->slots[slot_idx];
+  MTX_Stripe *stripe = &mtx_shared->stripes[stripe_idx];
+  MTX_Node *node = 0;
+  B32 node_is_new = 0;
+  U128 key_hash = c_hash_from_key(buffer_key, 0);
+  RWMutexScope(stripe->rw_mutex, 1)
+  {
+    for(MTX_Node *n = slot->first; n != 0; n = n->next)
+    {
+      if(c_key_match(n->key, buffer_key))
+      {
+        node = n;
+        break;
+      }
+    }
+    
+    // rjf: key's data was replaced or closed outside of this layer -> node's
+    // chunks are stale; free it, and re-seed from the key's current data
+    if(node != 0 && !u128_match(node->hash, key_hash))
+    {
+      DLLRemove(slot->first, slot->last, node);
+      mtx_node_release_chunks(node);
+      arena_release(node->arena);
+      SLLStackPush(stripe->free_node, node);
+      node = 0;
+    }
+    
+    if(node == 0)
+    {
+      node = stripe->free_node;
+      if(node != 0)
+      {
+        SLLStackPop(stripe->free_node);
+      }
+      else
+      {
+        node = push_array_no_zero(stripe->arena, MTX_Node, 1);
+      }
+      MemoryZeroStruct(node);
+      node->key = buffer_key;
+      node->arena = arena_alloc();
+      DLLPushBack(slot->first, slot->last, node);
+      node_is_new = 1;
+    }
+  }
+  
+  //- rjf: new node -> seed chunks from the buffer's current contiguous data
+  // NOTE: buffer keys are only ever mutated on their own mutation thread, so
+  // the node's chunks are not touched by anyone else past this point.
+  if(node_is_new)
+  {
+    Access *access = access_open();
+    String8 data = c_data_from_hash(access, key_hash);
+    mtx_node_replace_chunks(node, 0, 0, data);
+    node->size = data.size;
+    node->hash = key_hash;
+    access_close(access);
+  }
+  
+  return node;
+}
+
+internal void
+mtx_node_release_chunks(MTX_Node *node)
+{
+  for EachIndex(idx, node->chunks_count)
+  {
+    c_hash_downstream_dec(node->chunk_hashes[idx]);
+  }
+  node->chunks_count = 0;
+  node->size = 0;
+}
+
+internal void
+mtx_node_replace_chunks(MTX_Node *node, U64 chunk_idx_min, U64 chunk_idx_max, String8 data)
+{
+  U64 new_chunks_count = (data.size + MTX_CHUNK_SIZE - 1) / MTX_CHUNK_SIZE;
+  U64 removed_chunks_count = chunk_idx_max - chunk_idx_min;
+  U64 needed_cap = node->chunks_count - removed_chunks_count + new_chunks_count;
+  
+  //- rjf: grow chunk arrays into a fresh arena, so the old arrays are freed
+  if(needed_cap > node->chunks_cap)
+  {
+    U64 new_cap = Max(Max(node->chunks_cap*2, needed_cap), 64);
+    Arena *new_arena = arena_alloc();
+    U128 *new_hashes = push_array_no_zero(new_arena, U128, new_cap);
+    U64 *new_sizes = push_array_no_zero(new_arena, U64, new_cap);
+    if(node->chunks_count != 0)
+    {
+      MemoryCopy(new_hashes, node->chunk_hashes, sizeof(node->chunk_hashes[0])*node->chunks_count);
+      MemoryCopy(new_sizes, node->chunk_sizes, sizeof(node->chunk_sizes[0])*node->chunks_count);
+    }
+    arena_release(node->arena);
+    node->arena = new_arena;
+    node->chunk_hashes = new_hashes;
+    node->chunk_sizes = new_sizes;
+    node->chunks_cap = new_cap;
+  }
+  
+  //- rjf: release replaced chunks
+  for(U64 idx = chunk_idx_min; idx < chunk_idx_max; idx += 1)
+  {
+    c_hash_downstream_dec(node->chunk_hashes[idx]);
+  }
+  
+  //- rjf: shift trailing chunks
+  U64 trailing_chunks_count = node->chunks_count - chunk_idx_max;
+  if(trailing_chunks_count != 0 && new_chunks_count != removed_chunks_count)
+  {
+    MemoryCopy(node->chunk_hashes + chunk_idx_min + new_chunks_count, node->chunk_hashes + chunk_idx_max, sizeof(node->chunk_hashes[0])*trailing_chunks_count);
+    MemoryCopy(node->chunk_sizes + chunk_idx_min + new_chunks_count, node->chunk_sizes + chunk_idx_max, sizeof(node->chunk_sizes[0])*trailing_chunks_count);
+  }
+  node->chunks_count = needed_cap;
+  
+  //- rjf: submit new chunks
+  for EachIndex(new_chunk_num, new_chunks_count)
+  {
+    String8 chunk_data = str8_substr(data, r1u64(new_chunk_num*MTX_CHUNK_SIZE, (new_chunk_num+1)*MTX_CHUNK_SIZE));
+    Arena *chunk_arena = arena_alloc(.commit_size = chunk_data.size + ARENA_HEADER_SIZE, .reserve_size = chunk_data.size + ARENA_HEADER_SIZE);
+    U8 *chunk_base = push_array_no_zero(chunk_arena, U8, chunk_data.size);
+    MemoryCopy(chunk_base, chunk_data.str, chunk_data.size);
+    node->chunk_hashes[chunk_idx_min + new_chunk_num] = c_submit_blob(&chunk_arena, str8(chunk_base, chunk_data.size));
+    node->chunk_sizes[chunk_idx_min + new_chunk_num] = chunk_data.size;
+  }
+}
+
+internal void
+mtx_node_apply_op(MTX_Node *node, MTX_Op op)
+{
+  Temp scratch = scratch_begin(0, 0);
+  Access *access = access_open();
+  
+  //- rjf: clamp op by data
+  op.range.min = Min(op.range.min, node->size);
+  op.range.max = Min(op.range.max, node->size);
+  
+  //- rjf: apply
+  if(op.range.max != op.range.min || op.replace.size != 0)
+  {
+    //- rjf: find first chunk touched by the edit; appends at the end of a
+    // full chunk start a new chunk rather than re-submitting the full one
+    U64 chunk_idx_min = 0;
+    U64 chunk_idx_min_off = 0;
+    for(;chunk_idx_min < node->chunks_count; chunk_idx_min += 1)
+    {
+      U64 chunk_end = chunk_idx_min_off + node->chunk_sizes[chunk_idx_min];
+      if(op.range.min < chunk_end || (op.range.min == chunk_end && node->chunk_sizes[chunk_idx_min] < MTX_CHUNK_SIZE))
+      {
+        break;
+      }
+      chunk_idx_min_off = chunk_end;
+    }
+    
+    //- rjf: find last chunk touched by the edit
+    U64 chunk_idx_max = chunk_idx_min;
+    U64 chunk_idx_max_off = chunk_idx_min_off;
+    for(;chunk_idx_max < node->chunks_count; chunk_idx_max += 1)
+    {
+      U64 chunk_end = chunk_idx_max_off + node->chunk_sizes[chunk_idx_max];
+      if(op.range.max <= chunk_end)
+      {
+        break;
+      }
+      chunk_idx_max_off = chunk_end;
+    }
+    
+    //- rjf: gather [pre-edit part of first chunk] + replace + [post-edit part of last chunk]
+    String8List parts = {0};
+    if(chunk_idx_min < node->chunks_count)
+    {
+      String8 first_chunk_data = c_data_from_hash(access, node->chunk_hashes[chunk_idx_min]);
+      str8_list_push(scratch.arena, &parts, str8_prefix(first_chunk_data, op.range.min - chunk_idx_min_off));
+    }
+    str8_list_push(scratch.arena, &parts, op.replace);
+    if(chunk_idx_max < node->chunks_count)
+    {
+      String8 last_chunk_data = c_data_from_hash(access, node->chunk_hashes[chunk_idx_max]);
+      str8_list_push(scratch.arena, &parts, str8_skip(last_chunk_data, op.range.max - chunk_idx_max_off));
+      chunk_idx_max += 1;
+    }
+    String8 new_data = str8_list_join(scratch.arena, &parts, 0);
+    
+    //- rjf: replace touched chunks, submit new rope
+    mtx_node_replace_chunks(node, chunk_idx_min, chunk_idx_max, new_data);
+    node->size = node->size + op.replace.size - dim_1u64(op.range);
+    node->hash = c_submit_rope(node->key, node->chunk_hashes, node->chunk_sizes, node->chunks_count);
+  }
+  
+  access_close(access);
+  scratch_end(scratch);
+}
+
 ////////////////////////////////
 //~ rjf: Mutation Threads
 
@@ -90,6 +288,38 @@ mtx_dequeue_op(Arena *arena, MTX_MutThread *thread, C_Key *buffer_key_out, MTX_O
   cond_var_broadcast(thread->cv);
 }
 
+internal B32
+mtx_dequeue_append_op(Arena *arena, MTX_MutThread *thread, C_Key buffer_key, String8 *replace_out)
+{
+  B32 result = 0;
+  MutexScope(thread->mutex)
+  {
+    U64 unconsumed_size = thread->ring_write_pos - thread->ring_read_pos;
+    if(unconsumed_size >= sizeof(C_Key) + sizeof(Rng1U64) + sizeof(U64))
+    {
+      // rjf: peek next op's header; only consume it if it appends to the same buffer
+      C_Key next_key = {0};
+      Rng1U64 next_range = {0};
+      U64 read_pos = thread->ring_read_pos;
+      read_pos += ring_read_struct(thread->ring_base, thread->ring_size, read_pos, &next_key);
+      read_pos += ring_read_struct(thread->ring_base, thread->ring_size, read_pos, &next_range);
+      if(c_key_match(next_key, buffer_key) && next_range.min == max_U64 && next_range.max == max_U64)
+      {
+        result = 1;
+        read_pos += ring_read_struct(thread->ring_base, thread->ring_size, read_pos, &replace_out->size);
+        replace_out->str = push_array_no_zero(arena, U8, replace_out->size);
+        read_pos += ring_read(thread->ring_base, thread->ring_size, read_pos, replace_out->str, replace_out->size);
+        thread->ring_read_pos = read_pos;
+      }
+    }
+  }
+  if(result)
+  {
+    cond_var_broadcast(thread->cv);
+  }
+  return result;
+}
+
 internal void
 mtx_mut_thread__entry_point(void *p)
 {
@@ -98,46 +328,32 @@ mtx_mut_thread__entry_point(void *p)
   for(;;)
   {
     Temp scratch = scratch_begin(0, 0);
-    Access *access = access_open();
     
     //- rjf: get next op
     C_Key buffer_key = {0};
     MTX_Op op = {0};
     mtx_dequeue_op(scratch.arena, mut_thread, &buffer_key, &op);
     
-    //- rjf: get buffer's current data
-    U128 hash = c_hash_from_key(buffer_key, 0);
-    String8 data = c_data_from_hash(access, hash);
-    
-    //- rjf: clamp op by data
-    op.range.min = Min(op.range.min, data.size);
-    op.range.max = Min(op.range.max, data.size);
-    
-    //- rjf: construct new buffer
-    if(op.range.max != op.range.min || op.replace.size != 0)
+    //- rjf: op is an append -> merge all immediately-queued appends to the same buffer
+    if(op.range.min == max_U64 && op.range.max == max_U64)
     {
-      U64 new_data_size = data.size + op.replace.size - dim_1u64(op.range);
-      Arena *arena = arena_alloc(.commit_size = new_data_size + ARENA_HEADER_SIZE, .reserve_size = new_data_size + ARENA_HEADER_SIZE);
-      U8 *new_data_base = push_array_no_zero(arena, U8, new_data_size);
-      String8 pre_replace_data = str8_substr(data, r1u64(0, op.range.min));
-      String8 post_replace_data = str8_substr(data, r1u64(op.range.max, data.size));
-      if(pre_replace_data.size != 0)
-      {
-        MemoryCopy(new_data_base+0,                                     pre_replace_data.str, pre_replace_data.size);
-      }
-      if(op.replace.size != 0)
+      String8List appends = {0};
+      str8_list_push(scratch.arena, &appends, op.replace);
+      for(String8 replace = {0};
+          appends.total_size < MTX_MERGED_APPEND_SIZE_MAX && mtx_dequeue_append_op(scratch.arena, mut_thread, buffer_key, &replace);)
       {
-        MemoryCopy(new_data_base+pre_replace_data.size,                 op.replace.str, op.replace.size);
+        str8_list_push(scratch.arena, &appends, replace);
       }
-      if(post_replace_data.size != 0)
+      if(appends.node_count > 1)
       {
-        MemoryCopy(new_data_base+pre_replace_data.size+op.replace.size, post_replace_data.str, post_replace_data.size);
+        op.replace = str8_list_join(scratch.arena, &appends, 0);
       }
-      String8 new_data = str8(new_data_base, new_data_size);
-      c_submit_data(buffer_key, &arena, new_data);
     }
     
-    access_close(access);
+    //- rjf: apply op to buffer's rope
+    MTX_Node *node = mtx_node_from_key(buffer_key);
+    mtx_node_apply_op(node, op);
+    
     scratch_end(scratch);
   }
 }
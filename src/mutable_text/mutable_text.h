@@ -7,12 +7,23 @@
 ////////////////////////////////
 //~ rjf: Cache Types
 
+// NOTE: each buffer is stored as a rope of chunk blobs in the hash store, so
+// an edit only re-hashes & re-submits the chunks it touches.
+#define MTX_CHUNK_SIZE KB(16)
+
 typedef struct MTX_Node MTX_Node;
 struct MTX_Node
 {
   MTX_Node *next;
   MTX_Node *prev;
-  U128 key;
+  C_Key key;
+  U128 hash;
+  Arena *arena;
+  U64 size;
+  U64 chunks_count;
+  U64 chunks_cap;
+  U128 *chunk_hashes;
+  U64 *chunk_sizes;
 };
 
 typedef struct MTX_Slot MTX_Slot;
@@ -40,6 +51,8 @@ struct MTX_Op
   String8 replace;
 };
 
+#define MTX_MERGED_APPEND_SIZE_MAX MB(1)
+
 typedef struct MTX_MutThread MTX_MutThread;
 struct MTX_MutThread
 {
@@ -85,12 +98,17 @@ internal void mtx_init(void);
 //~ rjf: Buffer Operations
 
 internal void mtx_push_op(C_Key buffer_key, MTX_Op op);
+internal MTX_Node *mtx_node_from_key(C_Key buffer_key);
+internal void mtx_node_release_chunks(MTX_Node *node);
+internal void mtx_node_replace_chunks(MTX_Node *node, U64 chunk_idx_min, U64 chunk_idx_max, String8 data);
+internal void mtx_node_apply_op(MTX_Node *node, MTX_Op op);
 
 ////////////////////////////////
 //~ rjf: Mutation Threads
 
 internal void mtx_enqueue_op(MTX_MutThread *thread, C_Key buffer_key, MTX_Op op);
 internal void mtx_dequeue_op(Arena *arena, MTX_MutThread *thread, C_Key *buffer_key_out, MTX_Op *op_out);
+internal B32 mtx_dequeue_append_op(Arena *arena, MTX_MutThread *thread, C_Key buffer_key, String8 *replace_out);
 internal void mtx_mut_thread__entry_point(void *p);
 
 #endif // MUTABLE_TEXT_H
@@ -65,6 +65,10 @@ os_lnx_file_properties_from_stat(struct stat *s)
   {
     props.flags |= FilePropertyFlag_IsFolder;
   }
+  if(!(s->st_mode & (S_IWUSR|S_IWGRP|S_IWOTH)))
+  {
+    props.flags |= FilePropertyFlag_IsReadOnly;
+  }
   return props;
 }
 
@@ -350,6 +354,32 @@ os_file_write(OS_Handle file, Rng1U64 rng, void *data)
   return total_num_bytes_written;
 }
 
+internal B32
+os_file_append(OS_Handle file, String8 data, U64 *off_out)
+{
+  // NOTE: `file` is opened with O_APPEND, so this lands at the end of the
+  // file in one write, which other appenders cannot interleave with; the file
+  // offset afterwards tells us where it landed.
+  if(os_handle_match(file, os_handle_zero())) { return 0; }
+  int fd = (int)file.u64[0];
+  ssize_t write_result = -1;
+  do
+  {
+    write_result = write(fd, data.str, data.size);
+  } while(write_result == -1 && errno == EINTR);
+  B32 good = (write_result >= 0 && (U64)write_result == data.size);
+  if(good)
+  {
+    off_t end_off = lseek(fd, 0, SEEK_CUR);
+    good = (end_off != (off_t)-1 && (U64)end_off >= data.size);
+    if(good && off_out != 0)
+    {
+      off_out[0] = (U64)end_off - data.size;
+    }
+  }
+  return good;
+}
+
 internal B32
 os_file_set_times(OS_Handle file, DateTime date_time)
 {
@@ -644,6 +674,198 @@ os_make_directory(String8 path)
   return result;
 }
 
+//- rjf: file change notifications
+
+internal OS_Handle
+os_file_watcher_alloc(void)
+{
+  OS_Handle result = {0};
+  int fd = inotify_init1(IN_NONBLOCK|IN_CLOEXEC);
+  if(fd != -1)
+  {
+    OS_LNX_Entity *entity = os_lnx_entity_alloc(OS_LNX_EntityKind_FileWatcher);
+    entity->file_watcher.fd = fd;
+    entity->file_watcher.arena = arena_alloc();
+    pthread_mutex_init(&entity->file_watcher.mutex, 0);
+    result.u64[0] = (U64)entity;
+  }
+  return result;
+}
+
+internal void
+os_file_watcher_release(OS_Handle watcher)
+{
+  if(os_handle_match(watcher, os_handle_zero())) { return; }
+  OS_LNX_Entity *entity = (OS_LNX_Entity *)watcher.u64[0];
+  close(entity->file_watcher.fd);
+  pthread_mutex_destroy(&entity->file_watcher.mutex);
+  arena_release(entity->file_watcher.arena);
+  os_lnx_entity_release(entity);
+}
+
+internal B32
+os_file_watcher_add_file(OS_Handle watcher, String8 file_path)
+{
+  if(os_handle_match(watcher, os_handle_zero())) { return 0; }
+  OS_LNX_Entity *entity = (OS_LNX_Entity *)watcher.u64[0];
+  Temp scratch = scratch_begin(0, 0);
+  String8 path = str8_chop_last_slash(file_path);
+  String8 file_path_copy = push_str8_copy(scratch.arena, file_path);
+  String8 path_copy = push_str8_copy(scratch.arena, path.size != 0 ? path : str8_lit("."));
+  
+  // rjf: the folder's events describe a symbolic link itself, not its target;
+  // and network & FUSE filesystems only report changes made by this machine -
+  // both must be polled instead
+  B32 is_watchable = 1;
+  {
+    struct stat link_stat = {0};
+    if(lstat((char *)file_path_copy.str, &link_stat) != -1 && S_ISLNK(link_stat.st_mode))
+    {
+      is_watchable = 0;
+    }
+  }
+  if(is_watchable)
+  {
+    struct statfs fs_stat = {0};
+    if(statfs((char *)path_copy.str, &fs_stat) != -1)
+    {
+      switch((U32)fs_stat.f_type)
+      {
+        default:{}break;
+        case 0x00006969: // NFS_SUPER_MAGIC
+        case 0x0000517b: // SMB_SUPER_MAGIC
+        case 0xff534d42: // CIFS_SUPER_MAGIC
+        case 0xfe534d42: // SMB2_SUPER_MAGIC
+        case 0x65735546: // FUSE_SUPER_MAGIC
+        case 0x01021997: // V9FS_MAGIC
+        case 0x00c36400: // CEPH_SUPER_MAGIC
+        {
+          is_watchable = 0;
+        }break;
+      }
+    }
+  }
+  
+  U32 mask = (IN_MODIFY|IN_ATTRIB|IN_CLOSE_WRITE|IN_CREATE|IN_DELETE|IN_MOVED_FROM|IN_MOVED_TO|
+              IN_DELETE_SELF|IN_MOVE_SELF|IN_ONLYDIR);
+  int wd = -1;
+  if(is_watchable)
+  {
+    wd = inotify_add_watch(entity->file_watcher.fd, (char *)path_copy.str, mask);
+  }
+  
+  // rjf: the kernel hands back the same descriptor for each watch of one
+  // folder; record each distinct spelling of the folder's path, so that
+  // reported paths match the paths our callers use
+  if(wd != -1)
+  {
+    DeferLoop(pthread_mutex_lock(&entity->file_watcher.mutex),
+              pthread_mutex_unlock(&entity->file_watcher.mutex))
+    {
+      B32 is_new = 1;
+      for(OS_LNX_FileWatch *w = entity->file_watcher.first; w != 0; w = w->next)
+      {
+        if(w->wd == wd && str8_match(w->path, path, 0))
+        {
+          is_new = 0;
+          break;
+        }
+      }
+      if(is_new)
+      {
+        OS_LNX_FileWatch *w = entity->file_watcher.free;
+        if(w != 0)
+        {
+          SLLStackPop(entity->file_watcher.free);
+        }
+        else
+        {
+          w = push_array_no_zero(entity->file_watcher.arena, OS_LNX_FileWatch, 1);
+        }
+        MemoryZeroStruct(w);
+        w->wd = wd;
+        w->path = push_str8_copy(entity->file_watcher.arena, path);
+        SLLStackPush(entity->file_watcher.first, w);
+      }
+    }
+  }
+  scratch_end(scratch);
+  return (wd != -1);
+}
+
+internal String8List
+os_file_watcher_changed_paths(Arena *arena, OS_Handle watcher, B32 *rescan_out)
+{
+  String8List result = {0};
+  B32 rescan = 0;
+  if(!os_handle_match(watcher, os_handle_zero()))
+  {
+    OS_LNX_Entity *entity = (OS_LNX_Entity *)watcher.u64[0];
+    U8 buffer[KB(4)] __attribute__((aligned(__alignof__(struct inotify_event))));
+    for(;;)
+    {
+      ssize_t read_size = read(entity->file_watcher.fd, buffer, sizeof(buffer));
+      if(read_size <= 0)
+      {
+        break;
+      }
+      DeferLoop(pthread_mutex_lock(&entity->file_watcher.mutex),
+                pthread_mutex_unlock(&entity->file_watcher.mutex))
+      {
+        for(ssize_t off = 0; off + (ssize_t)sizeof(struct inotify_event) <= read_size;)
+        {
+          struct inotify_event *event = (struct inotify_event *)(buffer + off);
+          off += sizeof(*event) + event->len;
+          
+          // rjf: events were dropped, or a watched folder went away - the
+          // caller can no longer trust that it has seen every change
+          if(event->mask & (IN_Q_OVERFLOW|IN_DELETE_SELF|IN_MOVE_SELF|IN_IGNORED))
+          {
+            rescan = 1;
+          }
+          
+          // rjf: watch removed by the kernel -> drop all spellings of its folder
+          if(event->mask & IN_IGNORED)
+          {
+            for(OS_LNX_FileWatch **w_ptr = &entity->file_watcher.first; *w_ptr != 0;)
+            {
+              OS_LNX_FileWatch *w = *w_ptr;
+              if(w->wd == event->wd)
+              {
+                *w_ptr = w->next;
+                SLLStackPush(entity->file_watcher.free, w);
+              }
+              else
+              {
+                w_ptr = &w->next;
+              }
+            }
+          }
+          
+          // rjf: change to a file within a folder -> report its path for each spelling of the folder
+          else if(event->len != 0)
+          {
+            String8 name = str8_cstring(event->name);
+            for(OS_LNX_FileWatch *w = entity->file_watcher.first; w != 0; w = w->next)
+            {
+              if(w->wd == event->wd)
+              {
+                String8 path = (w->path.size != 0 ? push_str8f(arena, "%S/%S", w->path, name) : push_str8_copy(arena, name));
+                str8_list_push(arena, &result, path);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  if(rescan_out != 0)
+  {
+    rescan_out[0] = rescan;
+  }
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: @os_hooks Shared Memory (Implemented Per-OS)
 
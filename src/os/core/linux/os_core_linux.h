@@ -18,6 +18,7 @@
 #include <semaphore.h>
 #include <signal.h>
 #include <stdlib.h>
+#include <sys/inotify.h>
 #include <sys/mman.h>
 #include <sys/random.h>
 #include <sys/sendfile.h>
@@ -25,6 +26,7 @@
 #include <sys/syscall.h>
 #include <sys/sysinfo.h>
 #include <sys/types.h>
+#include <sys/vfs.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -58,6 +60,17 @@ struct OS_LNX_SafeCallChain
   void *ptr;
 };
 
+////////////////////////////////
+//~ rjf: File Watches
+
+typedef struct OS_LNX_FileWatch OS_LNX_FileWatch;
+struct OS_LNX_FileWatch
+{
+  OS_LNX_FileWatch *next;
+  int wd;
+  String8 path;
+};
+
 ////////////////////////////////
 //~ rjf: Entities
 
@@ -68,6 +81,7 @@ typedef enum OS_LNX_EntityKind
   OS_LNX_EntityKind_RWMutex,
   OS_LNX_EntityKind_ConditionVariable,
   OS_LNX_EntityKind_Barrier,
+  OS_LNX_EntityKind_FileWatcher,
 }
 OS_LNX_EntityKind;
 
@@ -92,6 +106,14 @@ struct OS_LNX_Entity
       pthread_mutex_t rwlock_mutex_handle;
     } cv;
     pthread_barrier_t barrier;
+    struct
+    {
+      int fd;
+      pthread_mutex_t mutex;
+      Arena *arena;
+      OS_LNX_FileWatch *first;
+      OS_LNX_FileWatch *free;
+    } file_watcher;
   };
 };
 
@@ -195,6 +195,7 @@ internal void           os_file_close(OS_Handle file);
 internal U64            os_file_read(OS_Handle file, Rng1U64 rng, void *out_data);
 #define os_file_read_struct(f, off, ptr) os_file_read((f), r1u64((off), (off)+sizeof(*(ptr))), (ptr))
 internal U64            os_file_write(OS_Handle file, Rng1U64 rng, void *data);
+internal B32            os_file_append(OS_Handle file, String8 data, U64 *off_out);
 internal B32            os_file_set_times(OS_Handle file, DateTime time);
 internal FileProperties os_properties_from_file(OS_Handle file);
 internal OS_FileID      os_id_from_file(OS_Handle file);
@@ -221,6 +222,23 @@ internal void         os_file_iter_end(OS_FileIter *iter);
 //- rjf: directory creation
 internal B32 os_make_directory(String8 path);
 
+//- rjf: file change notifications
+// NOTE: watchers report changes to files by watching the folders which
+// contain them (not recursively). A zero watcher handle means change
+// notifications are not supported, and callers must fall back to polling file
+// properties; so must callers for which `os_file_watcher_add_file` returns 0,
+// which it does when changes to that file cannot be reported reliably (e.g.
+// the file is a symbolic link, or lives on a network or FUSE filesystem).
+// `os_file_watcher_changed_paths` does not block; it returns the path of each
+// changed file, formed from the folder part of the path exactly as it was
+// passed to `os_file_watcher_add_file`, and sets `rescan_out` if changes may
+// have been missed (e.g. the notification queue overflowed, or a watch was
+// lost).
+internal OS_Handle   os_file_watcher_alloc(void);
+internal void        os_file_watcher_release(OS_Handle watcher);
+internal B32         os_file_watcher_add_file(OS_Handle watcher, String8 path);
+internal String8List os_file_watcher_changed_paths(Arena *arena, OS_Handle watcher, B32 *rescan_out);
+
 ////////////////////////////////
 //~ rjf: @os_hooks Shared Memory (Implemented Per-OS)
 
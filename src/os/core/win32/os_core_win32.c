@@ -21,6 +21,10 @@ os_w32_file_property_flags_from_dwFileAttributes(DWORD dwFileAttributes)
   {
     flags |= FilePropertyFlag_IsFolder;
   }
+  if(dwFileAttributes & FILE_ATTRIBUTE_READONLY)
+  {
+    flags |= FilePropertyFlag_IsReadOnly;
+  }
   return flags;
 }
 
@@ -422,6 +426,36 @@ os_file_write(OS_Handle file, Rng1U64 rng, void *data)
   return src_off;
 }
 
+internal B32
+os_file_append(OS_Handle file, String8 data, U64 *off_out)
+{
+  // NOTE: an all-ones offset writes at the end of the file, in one write,
+  // which other appenders cannot interleave with; the file pointer afterwards
+  // tells us where it landed.
+  if(os_handle_match(file, os_handle_zero())) { return 0; }
+  HANDLE win_handle = (HANDLE)file.u64[0];
+  B32 good = 0;
+  if(data.size <= max_U32)
+  {
+    DWORD bytes_written = 0;
+    OVERLAPPED overlapped = {0};
+    overlapped.Offset = 0xffffffff;
+    overlapped.OffsetHigh = 0xffffffff;
+    good = (WriteFile(win_handle, data.str, (DWORD)data.size, &bytes_written, &overlapped) && bytes_written == data.size);
+  }
+  if(good)
+  {
+    LARGE_INTEGER zero = {0};
+    LARGE_INTEGER end_off = {0};
+    good = (SetFilePointerEx(win_handle, zero, &end_off, FILE_CURRENT) && (U64)end_off.QuadPart >= data.size);
+    if(good && off_out != 0)
+    {
+      off_out[0] = (U64)end_off.QuadPart - data.size;
+    }
+  }
+  return good;
+}
+
 internal B32
 os_file_set_time(OS_Handle file, DateTime time)
 {
@@ -836,6 +870,42 @@ os_make_directory(String8 path)
   return(result);
 }
 
+//- rjf: file change notifications
+
+// NOTE: change notifications are not provided on Windows - the zero
+// handle tells callers to poll file properties instead, which is the intended
+// behavior here; watched folders would need a dedicated overlapped
+// ReadDirectoryChangesW handle each, which costs more than the poll.
+
+internal OS_Handle
+os_file_watcher_alloc(void)
+{
+  OS_Handle result = {0};
+  return result;
+}
+
+internal void
+os_file_watcher_release(OS_Handle watcher)
+{
+}
+
+internal B32
+os_file_watcher_add_file(OS_Handle watcher, String8 path)
+{
+  return 0;
+}
+
+internal String8List
+os_file_watcher_changed_paths(Arena *arena, OS_Handle watcher, B32 *rescan_out)
+{
+  String8List result = {0};
+  if(rescan_out != 0)
+  {
+    rescan_out[0] = 0;
+  }
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: @os_hooks Shared Memory (Implemented Per-OS)
 
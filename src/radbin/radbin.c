@@ -1166,8 +1166,13 @@ rb_thread_entry_point(void *p)
             U64 decompressed_size = rdi_decompressed_size_from_parsed(&rdi);
             if(decompressed_size > rdi.raw_data_size)
             {
-              U8 *decompressed_data = push_array_no_zero(arena, U8, decompressed_size);
-              rdi_decompress_parsed(decompressed_data, decompressed_size, &rdi);
+              U8 *decompressed_data = 0;
+              if(lane_idx() == 0)
+              {
+                decompressed_data = push_array_no_zero(arena, U8, decompressed_size);
+              }
+              lane_sync_u64(&decompressed_data, 0);
+              rdi_decompress_parsed_wide(decompressed_data, decompressed_size, &rdi);
               rdi_status = rdi_parse(decompressed_data, decompressed_size, &rdi);
             }
             switch(rdi_status)
@@ -1167,8 +1167,7 @@ rd_whole_range_from_eval_space(E_Space space)
       U128 hash = c_hash_from_key(key, 0);
       Access *access = access_open();
       {
-        String8 data = c_data_from_hash(access, hash);
-        result = r1u64(0, data.size);
+        result = r1u64(0, c_size_from_hash(access, hash));
       }
       access_close(access);
     }break;
@@ -5741,6 +5740,25 @@ rd_window_frame(void)
         }
         
         ui_divider(ui_em(1.f, 1.f));
+        
+        //- rjf: draw artifact cache stats
+        {
+          AC_Stats stats = ac_stats(scratch.arena);
+          String8List lines = ac_string_list_from_stats(scratch.arena, &stats);
+          if(ui_clicked(ui_buttonf("Log Artifact Cache Stats###ac_stats_log")))
+          {
+            for EachNode(n, String8Node, lines.first)
+            {
+              log_info(n->string);
+            }
+          }
+          for EachNode(n, String8Node, lines.first)
+          {
+            ui_label(n->string);
+          }
+        }
+        
+        ui_divider(ui_em(1.f, 1.f));
       }
     }
     
@@ -11609,14 +11627,14 @@ rd_frame(void)
         Access *access = access_open();
         C_Key key = d_state->output_log_key;
         U128 hash = c_hash_from_key(key, 0);
-        String8 data = c_data_from_hash(access, hash);
+        U64 size = c_size_from_hash(access, hash);
         E_Space space = e_space_make(E_SpaceKind_HashStoreKey);
         space.u64_0 = key.root.u64[0];
         space.u128 = key.id.u128[0];
         E_Expr *expr = e_push_expr(scratch.arena, E_ExprKind_LeafOffset, r1u64(0, 0));
         expr->space    = space;
         expr->mode     = E_Mode_Offset;
-        expr->type_key = e_type_key_cons_array(e_type_key_basic(E_TypeKind_U8), data.size, 0);
+        expr->type_key = e_type_key_cons_array(e_type_key_basic(E_TypeKind_U8), size, 0);
         e_string2expr_map_insert(scratch.arena, macro_map, str8_lit("output"), expr);
         access_close(access);
       }
@@ -16530,6 +16548,14 @@ rd_frame(void)
   access_close(rd_state->frame_access);
   rd_state->frame_access = frame_access_restore;
   
+  //////////////////////////////
+  //- rjf: glyphs still rasterizing => keep drawing until they land
+  //
+  if(fnt_raster_pending())
+  {
+    rd_request_frame();
+  }
+  
   //////////////////////////////
   //- rjf: submit rendering to all windows
   //
@@ -23,17 +23,20 @@ static const U64 INLINE_SITE_CHUNK_CAP = 256;
 
 RDIM_TopLevelInfo        top_level_info  = {0};
 RDIM_BinarySectionList   binary_sections = {0};
-RDIM_UnitChunkList       units           = {0};
-RDIM_UDTChunkList        udts            = {0};
-RDIM_TypeChunkList       types           = {0};
-RDIM_SrcFileChunkList    src_files       = {0};
-RDIM_LineTableChunkList  line_tables     = {0};
-RDIM_LocationChunkList   locations       = {0};
-RDIM_SymbolChunkList     gvars           = {0};
-RDIM_SymbolChunkList     tvars           = {0};
-RDIM_SymbolChunkList     procs           = {0};
-RDIM_ScopeChunkList      scopes          = {0};
-RDIM_InlineSiteChunkList inline_sites    = {0};
+
+// NOTE: compile units are converted on all lanes; each lane pushes into its own
+// chunk lists, which lane 0 joins in lane order once conversion is done.
+thread_static RDIM_UnitChunkList       units        = {0};
+thread_static RDIM_UDTChunkList        udts         = {0};
+thread_static RDIM_TypeChunkList       types        = {0};
+thread_static RDIM_SrcFileChunkList    src_files    = {0};
+thread_static RDIM_LineTableChunkList  line_tables  = {0};
+thread_static RDIM_LocationChunkList   locations    = {0};
+thread_static RDIM_SymbolChunkList     gvars        = {0};
+thread_static RDIM_SymbolChunkList     tvars        = {0};
+thread_static RDIM_SymbolChunkList     procs        = {0};
+thread_static RDIM_ScopeChunkList      scopes       = {0};
+thread_static RDIM_InlineSiteChunkList inline_sites = {0};
 
 ////////////////////////////////
 //~ rjf: Enum Conversion Helpers
@@ -2569,23 +2572,71 @@ d2r_convert_symbols(Arena         *arena,
   scratch_end(scratch);
 }
 
+internal Rng1U64 *
+d2r_lane_cu_ranges_from_cu_ranges(Arena *arena, Rng1U64Array cu_ranges, U64 lane_count)
+{
+  // split compile units into contiguous runs of roughly equal .debug_info size,
+  // so joining lane outputs in lane order keeps the serial conversion order
+  U64 total_info_size = 0;
+  for EachIndex(cu_idx, cu_ranges.count) {
+    total_info_size += dim_1u64(cu_ranges.v[cu_idx]);
+  }
+  
+  Rng1U64 *lane_cu_ranges = push_array(arena, Rng1U64, lane_count);
+  U64      cu_cursor      = 0;
+  U64      info_cursor    = 0;
+  for EachIndex(lane, lane_count) {
+    U64 info_hi  = (lane+1 == lane_count) ? max_U64 : (total_info_size / lane_count) * (lane+1);
+    U64 cu_first = cu_cursor;
+    for (; cu_cursor < cu_ranges.count && info_cursor < info_hi; cu_cursor += 1) {
+      info_cursor += dim_1u64(cu_ranges.v[cu_cursor]);
+    }
+    lane_cu_ranges[lane] = rng_1u64(cu_first, cu_cursor);
+  }
+  
+  return lane_cu_ranges;
+}
+
 internal RDIM_BakeParams
 d2r_convert(Arena *arena, D2R_ConvertParams *params)
 {
   Temp scratch = scratch_begin(&arena, 1);
+  
+  ////////////////////////////////
+  
+  MemoryZeroStruct(&units);
+  MemoryZeroStruct(&udts);
+  MemoryZeroStruct(&types);
+  MemoryZeroStruct(&src_files);
+  MemoryZeroStruct(&line_tables);
+  MemoryZeroStruct(&locations);
+  MemoryZeroStruct(&gvars);
+  MemoryZeroStruct(&tvars);
+  MemoryZeroStruct(&procs);
+  MemoryZeroStruct(&scopes);
+  MemoryZeroStruct(&inline_sites);
+  
+  ////////////////////////////////
+  
+  Arch                    arch           = Arch_Null;
+  U64                     image_base     = 0;
+  U64                     arch_addr_size = 0;
+  DW_Input               *input          = 0;
+  DW_ListUnitInput       *lu_input       = 0;
+  D2R_CompUnitContribMap *cu_contrib_map = 0;
+  Rng1U64Array            cu_ranges      = {0};
+  Rng1U64                *lane_cu_ranges = 0;
+  RDIM_Type             **builtin_types  = 0;
+  RDIM_Scope             *global_scope   = 0;
+  
   if (lane_idx() == 0) {
-    ////////////////////////////////
-    
     ProfBegin("compute exe hash");
     U64 exe_hash = rdi_hash(params->exe_data.str, params->exe_data.size);
     ProfEnd();
     
     ////////////////////////////////
     
-    Arch     arch       = Arch_Null;
-    U64      image_base = 0;
-    DW_Input input      = {0};
-    
+    input = push_array(scratch.arena, DW_Input, 1);
     switch(params->exe_kind) {
       default:{}break;
       case ExecutableImageKind_CoffPe: {
@@ -2596,7 +2647,7 @@ d2r_convert(Arena *arena, D2R_ConvertParams *params)
         arch            = pe.arch;
         image_base      = pe.image_base;
         binary_sections = c2r_rdi_binary_sections_from_coff_sections(arena, params->exe_data, string_table, pe.section_count, section_table);
-        input           = dw_input_from_coff_section_table(scratch.arena, params->exe_data, string_table, pe.section_count, section_table);
+        *input          = dw_input_from_coff_section_table(scratch.arena, params->exe_data, string_table, pe.section_count, section_table);
       } break;
       case ExecutableImageKind_Elf32:
       case ExecutableImageKind_Elf64: {
@@ -2604,7 +2655,7 @@ d2r_convert(Arena *arena, D2R_ConvertParams *params)
         arch            = arch_from_elf_machine(bin.hdr.e_machine);
         image_base      = elf_base_addr_from_bin(&bin);
         binary_sections = e2r_rdi_binary_sections_from_elf_section_table(arena, bin.shdrs);
-        input           = dw_input_from_elf_bin(scratch.arena, params->dbg_data, &bin);
+        *input          = dw_input_from_elf_bin(scratch.arena, params->dbg_data, &bin);
       } break;
     }
     
@@ -2614,72 +2665,127 @@ d2r_convert(Arena *arena, D2R_ConvertParams *params)
     
     ////////////////////////////////
     
-    U64 arch_addr_size = rdi_addr_size_from_arch(top_level_info.arch);
+    arch_addr_size = rdi_addr_size_from_arch(top_level_info.arch);
     
     ////////////////////////////////
     
-    RDIM_Scope *global_scope = rdim_scope_chunk_list_push(arena, &scopes, SCOPE_CHUNK_CAP);
+    global_scope = rdim_scope_chunk_list_push(arena, &scopes, SCOPE_CHUNK_CAP);
     
     ////////////////////////////////
     
     ProfBegin("Parse Unit Contrib Map");
-    D2R_CompUnitContribMap cu_contrib_map = {0};
-    if (input.sec[DW_Section_ARanges].data.size) {
-      cu_contrib_map = d2r_cu_contrib_map_from_aranges(arena, &input, image_base);
+    cu_contrib_map = push_array(scratch.arena, D2R_CompUnitContribMap, 1);
+    if (input->sec[DW_Section_ARanges].data.size) {
+      *cu_contrib_map = d2r_cu_contrib_map_from_aranges(arena, input, image_base);
     }
     ProfEnd();
     
     ProfBegin("Parse Comop Unit Ranges");
-    DW_ListUnitInput lu_input      = dw_list_unit_input_from_input(scratch.arena, &input);
-    Rng1U64List      cu_range_list = dw_unit_ranges_from_data(scratch.arena, input.sec[DW_Section_Info].data);
-    Rng1U64Array     cu_ranges     = rng1u64_array_from_list(scratch.arena, &cu_range_list);
+    lu_input                   = push_array(scratch.arena, DW_ListUnitInput, 1);
+    *lu_input                  = dw_list_unit_input_from_input(scratch.arena, input);
+    Rng1U64List cu_range_list  = dw_unit_ranges_from_data(scratch.arena, input->sec[DW_Section_Info].data);
+    cu_ranges                  = rng1u64_array_from_list(scratch.arena, &cu_range_list);
+    lane_cu_ranges             = d2r_lane_cu_ranges_from_cu_ranges(scratch.arena, cu_ranges, lane_count());
     ProfEnd();
     
-    ////////////////////////////////
+    //////////////////////////////// 
     
-    ProfBegin("Parse Compile Unit Headers");
-    // TODO(rjf): parse should always be relaxed. any verification checks we do
-    // should just be logged via log_info(...), and then the caller of this
-    // converter can collect those & display as necessary.
-    B32 is_parse_relaxed = 1;
-    DW_CompUnit *cu_arr = push_array(scratch.arena, DW_CompUnit, cu_ranges.count);
-    for EachIndex(cu_idx, cu_ranges.count) {
-      cu_arr[cu_idx] = dw_cu_from_info_off(scratch.arena, &input, lu_input, cu_ranges.v[cu_idx].min, is_parse_relaxed);
+    builtin_types = push_array(scratch.arena, RDIM_Type *, RDI_TypeKind_Count);
+    for (RDI_TypeKind type_kind = RDI_TypeKind_FirstBuiltIn; type_kind <= RDI_TypeKind_LastBuiltIn; type_kind += 1) {
+      RDIM_Type *type = rdim_type_chunk_list_push(arena, &types, TYPE_CHUNK_CAP);
+      type->kind      = type_kind;
+      type->name.str  = rdi_string_from_type_kind(type_kind, &type->name.size);
+      type->byte_size = rdi_size_from_basic_type_kind(type_kind);
+      builtin_types[type_kind] = type;
     }
-    ProfEnd();
+    builtin_types[RDI_TypeKind_Void]->byte_size = arch_addr_size;
+    builtin_types[RDI_TypeKind_Handle]->byte_size = arch_addr_size;
     
-    ////////////////////////////////
+    builtin_types[RDI_TypeKind_Variadic] = rdim_type_chunk_list_push(arena, &types, TYPE_CHUNK_CAP);
+    builtin_types[RDI_TypeKind_Variadic]->kind = RDI_TypeKind_Variadic;
+  }
+  lane_sync_u64(&arch, 0);
+  lane_sync_u64(&image_base, 0);
+  lane_sync_u64(&arch_addr_size, 0);
+  lane_sync_u64(&input, 0);
+  lane_sync_u64(&lu_input, 0);
+  lane_sync_u64(&cu_contrib_map, 0);
+  lane_sync_u64(&cu_ranges.v, 0);
+  lane_sync_u64(&cu_ranges.count, 0);
+  lane_sync_u64(&lane_cu_ranges, 0);
+  lane_sync_u64(&builtin_types, 0);
+  lane_sync_u64(&global_scope, 0);
+  
+  Rng1U64 cu_range = lane_cu_ranges[lane_idx()];
+  
+  ////////////////////////////////
+  
+  DW_CompUnit              *cu_arr             = 0;
+  DW_LineTableParseResult  *cu_line_tables     = 0;
+  String8Array             *cu_file_paths      = 0;
+  RDIM_SrcFile           ***cu_src_file_maps   = 0;
+  RDIM_LineTable          **cu_line_tables_rdi = 0;
+  if (lane_idx() == 0) {
+    cu_arr             = push_array(scratch.arena, DW_CompUnit,             cu_ranges.count);
+    cu_line_tables     = push_array(scratch.arena, DW_LineTableParseResult, cu_ranges.count);
+    cu_file_paths      = push_array(scratch.arena, String8Array,            cu_ranges.count);
+    cu_src_file_maps   = push_array(scratch.arena, RDIM_SrcFile **,         cu_ranges.count);
+    cu_line_tables_rdi = push_array(scratch.arena, RDIM_LineTable *,        cu_ranges.count);
+  }
+  lane_sync_u64(&cu_arr, 0);
+  lane_sync_u64(&cu_line_tables, 0);
+  lane_sync_u64(&cu_file_paths, 0);
+  lane_sync_u64(&cu_src_file_maps, 0);
+  lane_sync_u64(&cu_line_tables_rdi, 0);
+  
+  ////////////////////////////////
+  
+  ProfBegin("Parse Compile Unit Headers");
+  // TODO(rjf): parse should always be relaxed. any verification checks we do
+  // should just be logged via log_info(...), and then the caller of this
+  // converter can collect those & display as necessary.
+  B32 is_parse_relaxed = 1;
+  for EachInRange(cu_idx, cu_range) {
+    cu_arr[cu_idx] = dw_cu_from_info_off(scratch.arena, input, *lu_input, cu_ranges.v[cu_idx].min, is_parse_relaxed);
+  }
+  ProfEnd();
+  
+  ////////////////////////////////
+  
+  ProfBegin("Parse Line Tables");
+  for EachInRange(cu_idx, cu_range) {
+    DW_CompUnit *cu           = &cu_arr[cu_idx];
+    String8      cu_stmt_list = dw_line_ptr_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_StmtList);
+    String8      cu_dir       = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_CompDir);
+    String8      cu_name      = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_Name);
+    cu_line_tables[cu_idx] = dw_parsed_line_table_from_data(scratch.arena, cu_stmt_list, input, cu_dir, cu_name, cu->address_size, cu->str_offsets_lu);
     
-    ProfBegin("Parse Line Tables");
-    DW_LineTableParseResult *cu_line_tables = push_array(scratch.arena, DW_LineTableParseResult, cu_ranges.count);
-    for EachIndex(cu_idx, cu_ranges.count) {
-      DW_CompUnit *cu           = &cu_arr[cu_idx];
-      String8      cu_stmt_list = dw_line_ptr_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_StmtList);
-      String8      cu_dir       = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_CompDir);
-      String8      cu_name      = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_Name);
-      cu_line_tables[cu_idx] = dw_parsed_line_table_from_data(scratch.arena, cu_stmt_list, &input, cu_dir, cu_name, cu->address_size, cu->str_offsets_lu);
+    DW_LineTableParseResult *line_table = &cu_line_tables[cu_idx];
+    DW_LineVMFileArray      *file_table = &line_table->vm_header.file_table;
+    String8Array            *file_paths = &cu_file_paths[cu_idx];
+    file_paths->count = file_table->count;
+    file_paths->v     = push_array(scratch.arena, String8, file_paths->count);
+    for EachIndex(file_idx, file_table->count) {
+      String8     file_path       = dw_path_from_file_idx(scratch.arena, &line_table->vm_header, file_idx);
+      String8List file_path_split = str8_split_path(scratch.arena, file_path);
+      str8_path_list_resolve_dots_in_place(&file_path_split, PathStyle_WindowsAbsolute);
+      file_paths->v[file_idx] = str8_path_list_join_by_style(scratch.arena, &file_path_split, PathStyle_WindowsAbsolute);
     }
-    ProfEnd();
-    
-    ////////////////////////////////
-    
-    ProfBegin("Convert Line Tables");
-    HashTable       *source_file_ht     = hash_table_init(scratch.arena, 0x4000);
-    RDIM_LineTable **cu_line_tables_rdi = push_array(scratch.arena, RDIM_LineTable *, cu_ranges.count);
+  }
+  ProfEnd();
+  lane_sync();
+  
+  ////////////////////////////////
+  
+  ProfBegin("Build Source File Map");
+  if (lane_idx() == 0) {
+    HashTable *source_file_ht = hash_table_init(scratch.arena, 0x4000);
     for EachIndex(cu_idx, cu_ranges.count) {
-      cu_line_tables_rdi[cu_idx] = rdim_line_table_chunk_list_push(arena, &line_tables, LINE_TABLE_CAP);
-      
-      DW_LineTableParseResult *line_table   = &cu_line_tables[cu_idx];
-      DW_LineVMFileArray      *dir_table    = &line_table->vm_header.dir_table;
-      DW_LineVMFileArray      *file_table   = &line_table->vm_header.file_table;
-      RDIM_SrcFile           **src_file_map = push_array(scratch.arena, RDIM_SrcFile *, file_table->count);
-      for EachIndex(file_idx, file_table->count) {
-        DW_LineFile  *file                 = &file_table->v[file_idx];
-        String8       file_path            = dw_path_from_file_idx(scratch.arena, &line_table->vm_header, file_idx);
-        String8List   file_path_split      = str8_split_path(scratch.arena, file_path);
-        str8_path_list_resolve_dots_in_place(&file_path_split, PathStyle_WindowsAbsolute);
-        String8       file_path_resolved   = str8_path_list_join_by_style(scratch.arena, &file_path_split, PathStyle_WindowsAbsolute);
-        RDIM_SrcFile *src_file             = hash_table_search_path_raw(source_file_ht, file_path_resolved);
+      String8Array   file_paths   = cu_file_paths[cu_idx];
+      RDIM_SrcFile **src_file_map = push_array(scratch.arena, RDIM_SrcFile *, file_paths.count);
+      for EachIndex(file_idx, file_paths.count) {
+        String8       file_path_resolved = file_paths.v[file_idx];
+        RDIM_SrcFile *src_file           = hash_table_search_path_raw(source_file_ht, file_path_resolved);
         if (src_file == 0) {
           src_file       = rdim_src_file_chunk_list_push(arena, &src_files, SRC_FILE_CAP);
           src_file->path = push_str8_copy(arena, file_path_resolved);
@@ -2687,183 +2793,212 @@ d2r_convert(Arena *arena, D2R_ConvertParams *params)
         }
         src_file_map[file_idx] = src_file;
       }
+      cu_src_file_maps[cu_idx] = src_file_map;
+    }
+  }
+  ProfEnd();
+  lane_sync();
+  
+  ////////////////////////////////
+  
+  ProfBegin("Convert Line Tables");
+  for EachInRange(cu_idx, cu_range) {
+    cu_line_tables_rdi[cu_idx] = rdim_line_table_chunk_list_push(arena, &line_tables, LINE_TABLE_CAP);
+    
+    DW_LineTableParseResult *line_table   = &cu_line_tables[cu_idx];
+    RDIM_SrcFile           **src_file_map = cu_src_file_maps[cu_idx];
+    for EachNode(line_seq, DW_LineSeqNode, line_table->first_seq) {
+      if (line_seq->count == 0) { continue; }
       
-      for EachNode(line_seq, DW_LineSeqNode, line_table->first_seq) {
-        if (line_seq->count == 0) { continue; }
-        
-        U64 *voffs     = push_array(arena, U64, line_seq->count);
-        U32 *line_nums = push_array(arena, U32, line_seq->count);
-        U16 *col_nums  = 0;
-        U64  line_idx  = 0;
-        
-        DW_LineNode *file_line_n     = line_seq->first;
-        U64          file_line_count = 0;
-        
-        for EachNode(line_n, DW_LineNode, file_line_n) {
-          if (file_line_n->v.file_index != line_n->v.file_index || line_n->next == 0) {
-            U64  file_index     = file_line_n->v.file_index;
-            U64 *file_voffs     = &voffs[line_idx];
-            U32 *file_line_nums = &line_nums[line_idx];
-            U16 *file_col_nums  = 0;
-            
-            U64          lines_written = 0;
-            U64          prev_ln       = max_U64;
-            DW_LineNode *sentinel      = line_n->v.file_index != file_line_n->v.file_index ? line_n : 0;
-            for (; file_line_n != sentinel; file_line_n = file_line_n->next) {
-              if (file_line_n->v.line != prev_ln) {
-                if (file_line_n->v.address == 0) { continue; }
-                
-                voffs[line_idx]     = file_line_n->v.address - image_base;
-                line_nums[line_idx] = file_line_n->v.line;
-                
-                ++lines_written;
-                ++line_idx;
-                
-                prev_ln = file_line_n->v.line;
-              }
-            }
-            
-            RDIM_SrcFile      *src_file = src_file_map[file_index];
-            RDIM_LineSequence *line_seq = rdim_line_table_push_sequence(arena, &line_tables, cu_line_tables_rdi[cu_idx], src_file, file_voffs, file_line_nums, file_col_nums, lines_written);
-            rdim_src_file_push_line_sequence(arena, &src_files, src_file, line_seq);
-            
-            file_line_count = 1;
-          } else {
-            file_line_count += 1;
-          }
-        }
-        
-        // handle last line
-        if (file_line_n) {
+      U64 *voffs     = push_array(arena, U64, line_seq->count);
+      U32 *line_nums = push_array(arena, U32, line_seq->count);
+      U16 *col_nums  = 0;
+      U64  line_idx  = 0;
+      
+      DW_LineNode *file_line_n     = line_seq->first;
+      U64          file_line_count = 0;
+      
+      for EachNode(line_n, DW_LineNode, file_line_n) {
+        if (file_line_n->v.file_index != line_n->v.file_index || line_n->next == 0) {
           U64  file_index     = file_line_n->v.file_index;
           U64 *file_voffs     = &voffs[line_idx];
           U32 *file_line_nums = &line_nums[line_idx];
           U16 *file_col_nums  = 0;
           
-          for (; file_line_n != 0; file_line_n = file_line_n->next, line_idx += 1) {
-            // TODO: error handling
-            AssertAlways(file_line_n->v.address >= image_base);
-            voffs[line_idx]     = file_line_n->v.address - image_base;
-            line_nums[line_idx] = file_line_n->v.line;
+          U64          lines_written = 0;
+          U64          prev_ln       = max_U64;
+          DW_LineNode *sentinel      = line_n->v.file_index != file_line_n->v.file_index ? line_n : 0;
+          for (; file_line_n != sentinel; file_line_n = file_line_n->next) {
+            if (file_line_n->v.line != prev_ln) {
+              if (file_line_n->v.address == 0) { continue; }
+              
+              voffs[line_idx]     = file_line_n->v.address - image_base;
+              line_nums[line_idx] = file_line_n->v.line;
+              
+              ++lines_written;
+              ++line_idx;
+              
+              prev_ln = file_line_n->v.line;
+            }
           }
           
-          RDIM_SrcFile      *src_file = src_file_map[file_index];
-          RDIM_LineSequence *line_seq = rdim_line_table_push_sequence(arena, &line_tables, cu_line_tables_rdi[cu_idx], src_file, file_voffs, file_line_nums, file_col_nums, file_line_count);
-          rdim_src_file_push_line_sequence(arena, &src_files, src_file, line_seq);
+          RDIM_SrcFile *src_file = src_file_map[file_index];
+          rdim_line_table_push_sequence(arena, &line_tables, cu_line_tables_rdi[cu_idx], src_file, file_voffs, file_line_nums, file_col_nums, lines_written);
+          
+          file_line_count = 1;
+        } else {
+          file_line_count += 1;
+        }
+      }
+      
+      // handle last line
+      if (file_line_n) {
+        U64  file_index     = file_line_n->v.file_index;
+        U64 *file_voffs     = &voffs[line_idx];
+        U32 *file_line_nums = &line_nums[line_idx];
+        U16 *file_col_nums  = 0;
+        
+        for (; file_line_n != 0; file_line_n = file_line_n->next, line_idx += 1) {
+          // TODO: error handling
+          AssertAlways(file_line_n->v.address >= image_base);
+          voffs[line_idx]     = file_line_n->v.address - image_base;
+          line_nums[line_idx] = file_line_n->v.line;
         }
         
-        //Assert(line_idx == line_seq->count);
+        RDIM_SrcFile *src_file = src_file_map[file_index];
+        rdim_line_table_push_sequence(arena, &line_tables, cu_line_tables_rdi[cu_idx], src_file, file_voffs, file_line_nums, file_col_nums, file_line_count);
       }
+      
+      //Assert(line_idx == line_seq->count);
     }
-    ProfEnd();
-    
-    //////////////////////////////// 
-    
-    RDIM_Type *builtin_types[RDI_TypeKind_Count] = {0};
-    for (RDI_TypeKind type_kind = RDI_TypeKind_FirstBuiltIn; type_kind <= RDI_TypeKind_LastBuiltIn; type_kind += 1) {
-      RDIM_Type *type = rdim_type_chunk_list_push(arena, &types, TYPE_CHUNK_CAP);
-      type->kind      = type_kind;
-      type->name.str  = rdi_string_from_type_kind(type_kind, &type->name.size);
-      type->byte_size = rdi_size_from_basic_type_kind(type_kind);
-      builtin_types[type_kind] = type;
+  }
+  ProfEnd();
+  lane_sync();
+  
+  // source files are shared between compile units, so line sequences are
+  // attached to them on a single lane, in compile unit order
+  ProfBegin("Attach Line Sequences to Source Files");
+  if (lane_idx() == 0) {
+    for EachIndex(cu_idx, cu_ranges.count) {
+      for EachNode(seq_n, RDIM_LineSequenceNode, cu_line_tables_rdi[cu_idx]->first_seq) {
+        rdim_src_file_push_line_sequence(arena, &src_files, seq_n->v.src_file, &seq_n->v);
+      }
     }
-    builtin_types[RDI_TypeKind_Void]->byte_size = arch_addr_size;
-    builtin_types[RDI_TypeKind_Handle]->byte_size = arch_addr_size;
+  }
+  ProfEnd();
+  
+  //////////////////////////////// 
+  
+  ProfBegin("Convert Units");
+  for EachInRange(cu_idx, cu_range) {
+    Temp comp_temp = temp_begin(scratch.arena);
     
-    builtin_types[RDI_TypeKind_Variadic] = rdim_type_chunk_list_push(arena, &types, TYPE_CHUNK_CAP);
-    builtin_types[RDI_TypeKind_Variadic]->kind = RDI_TypeKind_Variadic;
+    DW_CompUnit *cu = &cu_arr[cu_idx];
     
-    //////////////////////////////// 
+    // parse and build tag tree
+    DW_TagTree tag_tree = dw_tag_tree_from_cu(comp_temp.arena, input, cu);
     
-    ProfBegin("Convert Units");
-    for EachIndex(cu_idx, cu_ranges.count) {
-      Temp comp_temp = temp_begin(scratch.arena);
-      
-      DW_CompUnit *cu = &cu_arr[cu_idx];
-      
-      // parse and build tag tree
-      DW_TagTree tag_tree = dw_tag_tree_from_cu(comp_temp.arena, &input, cu);
-      
-      // skip DWO
-      {
-        if (cu->dwo_id) { goto next_cu; }
-        
-        String8 dwo_name = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_DwoName);
-        if (dwo_name.size) { goto next_cu; }
-        
-        String8 gnu_dwo_name = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_GNU_DwoName);
-        if (gnu_dwo_name.size) { goto next_cu; }
-      }
-      
-      // build (info offset -> tag) hash table to resolve tags with abstract origin
-      cu->tag_ht = dw_make_tag_hash_table(comp_temp.arena, tag_tree);
-      
-      // extract compile unit info
-      String8     cu_name = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_Name);
-      String8     cu_dir  = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_CompDir);
-      String8     cu_prod = dw_string_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_Producer);
-      DW_Language cu_lang = dw_const_u64_from_tag_attrib_kind(&input, cu, cu->tag, DW_AttribKind_Language);
-      
-      // init type table
-      D2R_TypeTable *type_table   = push_array(comp_temp.arena, D2R_TypeTable, 1);
-      type_table->ht              = hash_table_init(comp_temp.arena, 0x4000);
-      type_table->types           = &types;
-      type_table->type_chunk_cap  = TYPE_CHUNK_CAP;
-      type_table->builtin_types   = builtin_types;
+    // skip DWO
+    {
+      if (cu->dwo_id) { goto next_cu; }
       
-      // convert debug info
-      d2r_convert_types(arena, type_table, &input, cu, cu_lang, arch_addr_size, tag_tree.root);
-      d2r_convert_udts(arena, type_table, &input, cu, cu_lang, arch_addr_size, tag_tree.root);
-      d2r_convert_symbols(arena, type_table, global_scope, &input, cu, cu_lang, arch_addr_size, image_base, arch, tag_tree.root);
+      String8 dwo_name = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_DwoName);
+      if (dwo_name.size) { goto next_cu; }
       
-      RDIM_Rng1U64ChunkList cu_voff_ranges = {0};
-      if (cu_idx < cu_contrib_map.count) {
-        cu_voff_ranges = d2r_voff_ranges_from_cu_info_off(cu_contrib_map, cu_ranges.v[cu_idx].min);
-      } else {
-        Rng1U64List range_list  = d2r_range_list_from_tag(scratch.arena, &input, cu, image_base, cu->tag);
-        for EachNode(n, Rng1U64Node, range_list.first) {
-          rdim_rng1u64_chunk_list_push(arena, &cu_voff_ranges, 512, (RDIM_Rng1U64){ .min = n->v.min, .max = n->v.max });
-        }
-      }
-      
-      // convert compile unit
-      {
-        RDIM_Unit *unit     = rdim_unit_chunk_list_push(arena, &units, UNIT_CHUNK_CAP);
-        unit->unit_name     = cu_name;
-        unit->compiler_name = cu_prod;
-        unit->source_file   = str8_zero(); // TODO
-        unit->object_file   = str8_zero(); // TODO
-        unit->archive_file  = str8_zero(); // TODO
-        unit->build_path    = cu_dir;
-        unit->language      = d2r_rdi_language_from_dw_language(cu_lang);
-        unit->line_table    = cu_line_tables_rdi[cu_idx];
-        unit->voff_ranges   = cu_voff_ranges;
+      String8 gnu_dwo_name = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_GNU_DwoName);
+      if (gnu_dwo_name.size) { goto next_cu; }
+    }
+    
+    // build (info offset -> tag) hash table to resolve tags with abstract origin
+    cu->tag_ht = dw_make_tag_hash_table(comp_temp.arena, tag_tree);
+    
+    // extract compile unit info
+    String8     cu_name = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_Name);
+    String8     cu_dir  = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_CompDir);
+    String8     cu_prod = dw_string_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_Producer);
+    DW_Language cu_lang = dw_const_u64_from_tag_attrib_kind(input, cu, cu->tag, DW_AttribKind_Language);
+    
+    // init type table
+    D2R_TypeTable *type_table   = push_array(comp_temp.arena, D2R_TypeTable, 1);
+    type_table->ht              = hash_table_init(comp_temp.arena, 0x4000);
+    type_table->types           = &types;
+    type_table->type_chunk_cap  = TYPE_CHUNK_CAP;
+    type_table->builtin_types   = builtin_types;
+    
+    // convert debug info
+    d2r_convert_types(arena, type_table, input, cu, cu_lang, arch_addr_size, tag_tree.root);
+    d2r_convert_udts(arena, type_table, input, cu, cu_lang, arch_addr_size, tag_tree.root);
+    d2r_convert_symbols(arena, type_table, global_scope, input, cu, cu_lang, arch_addr_size, image_base, arch, tag_tree.root);
+    
+    RDIM_Rng1U64ChunkList cu_voff_ranges = {0};
+    if (cu_idx < cu_contrib_map->count) {
+      cu_voff_ranges = d2r_voff_ranges_from_cu_info_off(*cu_contrib_map, cu_ranges.v[cu_idx].min);
+    } else {
+      Rng1U64List range_list  = d2r_range_list_from_tag(comp_temp.arena, input, cu, image_base, cu->tag);
+      for EachNode(n, Rng1U64Node, range_list.first) {
+        rdim_rng1u64_chunk_list_push(arena, &cu_voff_ranges, 512, (RDIM_Rng1U64){ .min = n->v.min, .max = n->v.max });
       }
-      
-      next_cu:;
-      temp_end(comp_temp);
     }
-    ProfEnd();
+    
+    // convert compile unit
+    {
+      RDIM_Unit *unit     = rdim_unit_chunk_list_push(arena, &units, UNIT_CHUNK_CAP);
+      unit->unit_name     = cu_name;
+      unit->compiler_name = cu_prod;
+      unit->source_file   = str8_zero(); // TODO
+      unit->object_file   = str8_zero(); // TODO
+      unit->archive_file  = str8_zero(); // TODO
+      unit->build_path    = cu_dir;
+      unit->language      = d2r_rdi_language_from_dw_language(cu_lang);
+      unit->line_table    = cu_line_tables_rdi[cu_idx];
+      unit->voff_ranges   = cu_voff_ranges;
+    }
+    
+    next_cu:;
+    temp_end(comp_temp);
   }
+  ProfEnd();
   
+  ////////////////////////////////
+  
+  RDIM_BakeParams *lane_bake_params = 0;
+  if (lane_idx() == 0) {
+    lane_bake_params = push_array(scratch.arena, RDIM_BakeParams, lane_count());
+  }
+  lane_sync_u64(&lane_bake_params, 0);
+  
+  {
+    RDIM_BakeParams *bake_params  = &lane_bake_params[lane_idx()];
+    bake_params->units            = units;
+    bake_params->types            = types;
+    bake_params->udts             = udts;
+    bake_params->src_files        = src_files;
+    bake_params->line_tables      = line_tables;
+    bake_params->locations        = locations;
+    bake_params->global_variables = gvars;
+    bake_params->thread_variables = tvars;
+    bake_params->procedures       = procs;
+    bake_params->scopes           = scopes;
+    bake_params->inline_sites     = inline_sites;
+  }
   lane_sync();
   
-  RDIM_BakeParams bake_params  = {0};
-  bake_params.subset_flags     = params->subset_flags;
-  bake_params.top_level_info   = top_level_info;
-  bake_params.binary_sections  = binary_sections;
-  bake_params.units            = units;
-  bake_params.types            = types;
-  bake_params.udts             = udts;
-  bake_params.src_files        = src_files;
-  bake_params.line_tables      = line_tables;
-  bake_params.locations        = locations;
-  bake_params.global_variables = gvars;
-  bake_params.thread_variables = tvars;
-  bake_params.procedures       = procs;
-  bake_params.scopes           = scopes;
-  bake_params.inline_sites     = inline_sites;
+  ProfBegin("Join Lane Outputs");
+  RDIM_BakeParams *bake_params = 0;
+  if (lane_idx() == 0) {
+    bake_params                  = push_array(arena, RDIM_BakeParams, 1);
+    bake_params->subset_flags    = params->subset_flags;
+    bake_params->top_level_info  = top_level_info;
+    bake_params->binary_sections = binary_sections;
+    for EachIndex(lane, lane_count()) {
+      rdim_bake_params_concat_in_place(bake_params, &lane_bake_params[lane]);
+    }
+  }
+  lane_sync_u64(&bake_params, 0);
+  ProfEnd();
+  
+  RDIM_BakeParams result = *bake_params;
   
   scratch_end(scratch);
-  return bake_params;
+  return result;
 }
@@ -3066,21 +3066,98 @@ rdim_compress(Arena *arena, RDIM_SerializedSectionBundle *in)
   ctx.m_tableSizeBits = 14;
   ctx.m_hashTable = push_array(scratch.arena, U16, 1<<ctx.m_tableSizeBits);
   
-  //- rjf: compress, or just copy, all sections
-  Rng1U64 range = lane_range(RDI_SectionKind_COUNT);
-  for EachInRange(idx, range)
+  //- lay out outputs; blocks are compressed into worst-case-sized slots, since LZB never expands
+  if(lane_idx() == 0) ProfScope("lay out outputs")
   {
-    RDI_SectionKind k = (RDI_SectionKind)idx;
-    RDIM_SerializedSection *src = &in->sections[k];
-    RDIM_SerializedSection *dst = &out->sections[k];
-    MemoryCopyStruct(dst, src);
-    if(src->encoded_size != 0)
-    {
-      MemoryZero(ctx.m_hashTable, sizeof(U16)*(1<<ctx.m_tableSizeBits));
-      dst->data = push_array_no_zero(arena, U8, src->encoded_size);
-      dst->encoded_size = rr_lzb_simple_encode_veryfast(&ctx, src->data, src->encoded_size, dst->data);
-      dst->unpacked_size = src->encoded_size;
-      dst->encoding = RDI_SectionEncoding_LZB;
+    for EachIndex(idx, RDI_SectionKind_COUNT)
+    {
+      RDIM_SerializedSection *src = &in->sections[idx];
+      RDIM_SerializedSection *dst = &out->sections[idx];
+      MemoryCopyStruct(dst, src);
+      if(src->encoded_size > RDIM_LZB_BLOCK_SIZE)
+      {
+        U64 block_count = CeilIntegerDiv(src->encoded_size, RDIM_LZB_BLOCK_SIZE);
+        U64 header_size = sizeof(RDI_U64) + sizeof(RDI_LZBBlock)*block_count;
+        dst->data = push_array_no_zero(arena, U8, header_size + src->encoded_size);
+        dst->unpacked_size = src->encoded_size;
+        dst->encoding = RDI_SectionEncoding_LZBBlocks;
+        MemoryCopy(dst->data, &block_count, sizeof(block_count));
+        RDI_LZBBlock *blocks = (RDI_LZBBlock *)((U8 *)dst->data + sizeof(RDI_U64));
+        for EachIndex(block_idx, block_count)
+        {
+          blocks[block_idx].unpacked_off  = block_idx*RDIM_LZB_BLOCK_SIZE;
+          blocks[block_idx].unpacked_size = Min(RDIM_LZB_BLOCK_SIZE, src->encoded_size - blocks[block_idx].unpacked_off);
+          blocks[block_idx].off           = header_size + blocks[block_idx].unpacked_off;
+          blocks[block_idx].encoded_size  = 0;
+        }
+      }
+      else if(src->encoded_size != 0)
+      {
+        dst->data = push_array_no_zero(arena, U8, src->encoded_size);
+        dst->unpacked_size = src->encoded_size;
+        dst->encoding = RDI_SectionEncoding_LZB;
+      }
+    }
+  }
+  lane_sync();
+  
+  //- rjf: compress all blocks of all sections
+  ProfScope("compress all blocks of all sections")
+  {
+    U64 block_count = 0;
+    for EachIndex(idx, RDI_SectionKind_COUNT)
+    {
+      block_count += (out->sections[idx].encoding == RDI_SectionEncoding_LZBBlocks ? *(RDI_U64 *)out->sections[idx].data :
+                      out->sections[idx].encoding == RDI_SectionEncoding_LZB ? 1 : 0);
+    }
+    Rng1U64 range = lane_range(block_count);
+    U64 section_block_base = 0;
+    for(U64 idx = 0; idx < RDI_SectionKind_COUNT && section_block_base < range.max; idx += 1)
+    {
+      RDIM_SerializedSection *src = &in->sections[idx];
+      RDIM_SerializedSection *dst = &out->sections[idx];
+      U64 section_block_count = (dst->encoding == RDI_SectionEncoding_LZBBlocks ? *(RDI_U64 *)dst->data :
+                                 dst->encoding == RDI_SectionEncoding_LZB ? 1 : 0);
+      U64 first = Max(range.min, section_block_base);
+      U64 opl = Min(range.max, section_block_base + section_block_count);
+      for(U64 block_idx = first; block_idx < opl; block_idx += 1)
+      {
+        MemoryZero(ctx.m_hashTable, sizeof(U16)*(1<<ctx.m_tableSizeBits));
+        if(dst->encoding == RDI_SectionEncoding_LZB)
+        {
+          dst->encoded_size = rr_lzb_simple_encode_veryfast(&ctx, src->data, src->encoded_size, dst->data);
+        }
+        else
+        {
+          RDI_LZBBlock *block = (RDI_LZBBlock *)((U8 *)dst->data + sizeof(RDI_U64)) + (block_idx - section_block_base);
+          block->encoded_size = rr_lzb_simple_encode_veryfast(&ctx, (U8 *)src->data + block->unpacked_off, block->unpacked_size, (U8 *)dst->data + block->off);
+        }
+      }
+      section_block_base += section_block_count;
+    }
+  }
+  lane_sync();
+  
+  //- pack compressed blocks tightly behind block tables
+  ProfScope("pack compressed blocks")
+  {
+    Rng1U64 range = lane_range(RDI_SectionKind_COUNT);
+    for EachInRange(idx, range)
+    {
+      RDIM_SerializedSection *dst = &out->sections[idx];
+      if(dst->encoding == RDI_SectionEncoding_LZBBlocks)
+      {
+        U64 block_count = *(RDI_U64 *)dst->data;
+        RDI_LZBBlock *blocks = (RDI_LZBBlock *)((U8 *)dst->data + sizeof(RDI_U64));
+        U64 off = sizeof(RDI_U64) + sizeof(RDI_LZBBlock)*block_count;
+        for EachIndex(block_idx, block_count)
+        {
+          MemoryCopy((U8 *)dst->data + off, (U8 *)dst->data + blocks[block_idx].off, blocks[block_idx].encoded_size);
+          blocks[block_idx].off = off;
+          off += blocks[block_idx].encoded_size;
+        }
+        dst->encoded_size = off;
+      }
     }
   }
   lane_sync();
@@ -160,6 +160,9 @@ struct RDIM_Shared
 
 global RDIM_Shared *rdim_shared = 0;
 
+//- compression; sections larger than one block are split into independently-decodable LZB blocks
+#define RDIM_LZB_BLOCK_SIZE MB(1)
+
 internal RDIM_DataModel rdim_data_model_from_os_arch(OperatingSystem os, RDI_Arch arch);
 internal RDIM_TopLevelInfo rdim_make_top_level_info(String8 image_name, Arch arch, U64 exe_hash, RDIM_BinarySectionList sections);
 internal RDIM_BakeResults rdim_bake(Arena *arena, RDIM_BakeParams *params);
@@ -13,6 +13,7 @@
 //- rjf: [h]
 #include "base/base_inc.h"
 #include "os/os_inc.h"
+#include "artifact_cache/artifact_cache.h"
 #include "render/render_inc.h"
 #include "font_provider/font_provider_inc.h"
 #include "font_cache/font_cache.h"
@@ -21,6 +22,7 @@
 //- rjf: [c]
 #include "base/base_inc.c"
 #include "os/os_inc.c"
+#include "artifact_cache/artifact_cache.c"
 #include "render/render_inc.c"
 #include "font_provider/font_provider_inc.c"
 #include "font_cache/font_cache.c"
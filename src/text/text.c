@@ -1970,7 +1970,7 @@ struct TXT_ArtifactCreateShared
 };
 
 internal AC_Artifact
-txt_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out)
+txt_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_out, U64 *size_out)
 {
   ProfBeginFunction();
   Temp scratch = scratch_begin(0, 0);
@@ -2227,6 +2227,7 @@ txt_artifact_create(String8 key, B32 *cancel_signal, B32 *retry_out, U64 *gen_ou
     shared->artifact->arena     = shared->arena;
     shared->artifact->data_hash = hash;
     shared->artifact->info      = shared->info;
+    size_out[0] = arena_pos(shared->arena);
   }
   lane_sync();
   
@@ -23,6 +23,10 @@
 #include "coff/coff_lib_writer.h"
 #include "pe/pe.h"
 #include "pe/pe_section_flags.h"
+#include "codeview/codeview.h"
+#include "msf/msf.h"
+#include "msf/msf_parse.h"
+#include "pdb/pdb.h"
 #include "linker/base_ext/base_core.h"
 #include "linker/base_ext/base_arena.h"
 #include "linker/base_ext/base_arrays.h"
@@ -35,6 +39,8 @@
 #include "coff/coff_obj_writer.c"
 #include "coff/coff_lib_writer.c"
 #include "pe/pe.c"
+#include "msf/msf.c"
+#include "msf/msf_parse.c"
 #include "linker/hash_table.c"
 #include "linker/base_ext/base_core.c"
 #include "linker/base_ext/base_arena.c"
@@ -301,6 +307,23 @@ t_coff_section_header_array_from_name(Arena *arena, String8 string_table, COFF_S
   return result;
 }
 
+internal U64
+t_tpi_type_count_from_pdb(String8 pdb)
+{
+  Temp scratch = scratch_begin(0,0);
+  U64 type_count = max_U64;
+  MSF_Parsed *msf = msf_parsed_from_data(scratch.arena, pdb);
+  if (msf) {
+    String8 tpi = msf_data_from_stream(msf, PDB_FixedStream_Tpi);
+    if (tpi.size >= sizeof(PDB_TpiHeader)) {
+      PDB_TpiHeader *header = (PDB_TpiHeader *)tpi.str;
+      type_count = header->ti_hi - header->ti_lo;
+    }
+  }
+  scratch_end(scratch);
+  return type_count;
+}
+
 ////////////////////////////////////////////////////////////////
 
 typedef enum
@@ -4942,6 +4965,517 @@ exit:;
   return result;
 }
 
+internal T_Result
+t_opt_icf(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  // k1 and k2 are identical, f1 and f2 are identical only after their callees are folded,
+  // f3 has same bytes as f1 but calls a different function
+  struct { char *obj_name; char *f_name; char *k_name; U8 k_imm; } objs[] = {
+    { "a.obj", "f1", "k1", 1 },
+    { "b.obj", "f2", "k2", 1 },
+    { "c.obj", "f3", "k3", 2 },
+  };
+  for EachElement(i, objs) {
+    COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+
+    U8 k_text[] = {
+      0xB8, objs[i].k_imm, 0x00, 0x00, 0x00, // mov eax, $imm
+      0xC3                                   // ret
+    };
+    COFF_ObjSection *k_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".text$k"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_LnkCOMDAT, str8_array_fixed(k_text));
+    coff_obj_writer_push_symbol_secdef(obj_writer, k_sect, COFF_ComdatSelect_Any);
+    COFF_ObjSymbol *k = coff_obj_writer_push_symbol_extern(obj_writer, str8_cstring(objs[i].k_name), 0, k_sect);
+
+    U8 f_text[] = {
+      0xE8, 0x00, 0x00, 0x00, 0x00, // call k
+      0xC3                          // ret
+    };
+    COFF_ObjSection *f_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".text$f"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_LnkCOMDAT, str8_array_fixed(f_text));
+    coff_obj_writer_push_symbol_secdef(obj_writer, f_sect, COFF_ComdatSelect_Any);
+    coff_obj_writer_push_symbol_extern(obj_writer, str8_cstring(objs[i].f_name), 0, f_sect);
+    coff_obj_writer_section_push_reloc(obj_writer, f_sect, 1, k, COFF_Reloc_X64_Rel32);
+
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_cstring(objs[i].obj_name), obj)) { goto exit; }
+  }
+
+  {
+    COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    U8 text[] = { 0xC3 };
+    COFF_ObjSection *text_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".text"), PE_TEXT_SECTION_FLAGS, str8_array_fixed(text));
+    coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, text_sect);
+
+    U8 ptrs[12] = {0};
+    COFF_ObjSection *ptrs_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".ptrs"), PE_DATA_SECTION_FLAGS, str8_array_fixed(ptrs));
+    coff_obj_writer_section_push_reloc_voff(obj_writer, ptrs_sect, 0, coff_obj_writer_push_symbol_undef(obj_writer, str8_lit("f1")));
+    coff_obj_writer_section_push_reloc_voff(obj_writer, ptrs_sect, 4, coff_obj_writer_push_symbol_undef(obj_writer, str8_lit("f2")));
+    coff_obj_writer_section_push_reloc_voff(obj_writer, ptrs_sect, 8, coff_obj_writer_push_symbol_undef(obj_writer, str8_lit("f3")));
+
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("entry.obj"), obj)) { goto exit; }
+  }
+
+  for EachIndex(do_icf, 2) {
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /opt:%s /out:a.exe entry.obj a.obj b.obj c.obj", do_icf ? "icf" : "noicf");
+    if (linker_exit_code != 0) { goto exit; }
+
+    String8             exe           = t_read_file(scratch.arena, str8_lit("a.exe"));
+    PE_BinInfo          pe            = pe_bin_info_from_data(scratch.arena, exe);
+    COFF_SectionHeader *section_table = (COFF_SectionHeader *)str8_substr(exe, pe.section_table_range).str;
+    COFF_SectionHeader *ptrs_sect     = t_coff_section_header_from_name(exe, section_table, pe.section_count, str8_lit(".ptrs"));
+    if (ptrs_sect == 0 || ptrs_sect->vsize < 12) { goto exit; }
+
+    U32 *ptrs = (U32 *)(exe.str + ptrs_sect->foff);
+    if (do_icf) {
+      if (ptrs[0] != ptrs[1]) { goto exit; }
+    } else {
+      if (ptrs[0] == ptrs[1]) { goto exit; }
+    }
+    if (ptrs[0] == ptrs[2]) { goto exit; }
+    if (ptrs[1] == ptrs[2]) { goto exit; }
+  }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal U64
+t_entry_call_target_voff(Arena *arena, String8 image)
+{
+  PE_BinInfo pe    = pe_bin_info_from_data(arena, image);
+  U64        foff  = pe_foff_from_voff(image, &pe, pe.entry_point);
+  S32        rel32 = 0;
+  str8_deserial_read_struct(image, foff + 1, &rel32);
+  return pe.entry_point + 5 + rel32;
+}
+
+internal T_Result
+t_incremental(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  U8 f_a[] = {
+    0xB8, 0x01, 0x00, 0x00, 0x00, // mov eax, 1
+    0xC3                          // ret
+  };
+  // grows into the pad that first link reserved after f
+  U8 f_b[] = {
+    0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, // nop
+    0xB8, 0x02, 0x00, 0x00, 0x00, // mov eax, 2
+    0xC3                          // ret
+  };
+  // doesn't fit into the slot anymore
+  U8 f_c[40];
+  MemorySet(f_c, 0x90, sizeof(f_c));
+  f_c[sizeof(f_c)-1] = 0xC3;
+
+  String8 f_texts[] = { str8_array_fixed(f_a), str8_array_fixed(f_b), str8_array_fixed(f_c) };
+  String8 f_objs[ArrayCount(f_texts)];
+  for EachElement(i, f_texts) {
+    COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    COFF_ObjSection *sect       = coff_obj_writer_push_section(obj_writer, str8_lit(".text"), PE_TEXT_SECTION_FLAGS, f_texts[i]);
+    coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("f"), 0, sect);
+    f_objs[i] = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+  }
+
+  {
+    U8 text[] = {
+      0xE8, 0x00, 0x00, 0x00, 0x00, // call f
+      0xC3                          // ret
+    };
+    COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    COFF_ObjSection *sect       = coff_obj_writer_push_section(obj_writer, str8_lit(".text"), PE_TEXT_SECTION_FLAGS, str8_array_fixed(text));
+    coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, sect);
+    COFF_ObjSymbol *f_symbol = coff_obj_writer_push_symbol_undef(obj_writer, str8_lit("f"));
+    coff_obj_writer_section_push_reloc(obj_writer, sect, 1, f_symbol, COFF_Reloc_X64_Rel32);
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("entry.obj"), obj)) { goto exit; }
+  }
+
+  // first link writes image and link state, state left by a previous run would let it patch the old image
+  os_delete_file_at_path(t_make_file_path(scratch.arena, str8_lit("a.exe.rlk")));
+  if (!t_write_file(str8_lit("f.obj"), f_objs[0])) { goto exit; }
+  int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /incremental /out:a.exe f.obj entry.obj");
+  if (linker_exit_code != 0) { goto exit; }
+  FileProperties state_props = os_properties_from_file_path(t_make_file_path(scratch.arena, str8_lit("a.exe.rlk")));
+  if (state_props.size == 0) { goto exit; }
+  FileProperties image_props = os_properties_from_file_path(t_make_file_path(scratch.arena, str8_lit("a.exe")));
+  String8        image       = t_read_file(scratch.arena, str8_lit("a.exe"));
+  PE_BinInfo     pe          = pe_bin_info_from_data(scratch.arena, image);
+  U64            f_voff      = t_entry_call_target_voff(scratch.arena, image);
+
+  // nothing changed, image must not be touched
+  linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /incremental /out:a.exe f.obj entry.obj");
+  if (linker_exit_code != 0) { goto exit; }
+  FileProperties skip_props = os_properties_from_file_path(t_make_file_path(scratch.arena, str8_lit("a.exe")));
+  if (skip_props.modified != image_props.modified) { goto exit; }
+
+  // f grew but still fits, it must be patched in place without moving entry
+  if (!t_write_file(str8_lit("f.obj"), f_objs[1])) { goto exit; }
+  linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /incremental /out:a.exe f.obj entry.obj");
+  if (linker_exit_code != 0) { goto exit; }
+  String8    patched_image = t_read_file(scratch.arena, str8_lit("a.exe"));
+  PE_BinInfo patched_pe    = pe_bin_info_from_data(scratch.arena, patched_image);
+  if (str8_match(image, patched_image, 0))                              { goto exit; }
+  if (patched_pe.entry_point != pe.entry_point)                         { goto exit; }
+  if (t_entry_call_target_voff(scratch.arena, patched_image) != f_voff) { goto exit; }
+  String8 patched_f = str8_skip(patched_image, pe_foff_from_voff(patched_image, &patched_pe, f_voff));
+  if (!str8_match(str8_prefix(patched_f, sizeof(f_b)), str8_array_fixed(f_b), 0)) { goto exit; }
+
+  // f outgrew its slot, image must be relinked
+  if (!t_write_file(str8_lit("f.obj"), f_objs[2])) { goto exit; }
+  linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /incremental /out:a.exe f.obj entry.obj");
+  if (linker_exit_code != 0) { goto exit; }
+  String8    relinked_image = t_read_file(scratch.arena, str8_lit("a.exe"));
+  PE_BinInfo relinked_pe    = pe_bin_info_from_data(scratch.arena, relinked_image);
+  if (relinked_pe.entry_point == pe.entry_point)                         { goto exit; }
+  if (t_entry_call_target_voff(scratch.arena, relinked_image) != f_voff) { goto exit; }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_incremental_type_cache(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  U8 debug_t[] = {
+    0x04, 0x00, 0x00, 0x00,             // CV_Signature_C13
+    0x06, 0x00, 0x01, 0x12,             // LF_ARGLIST (0x1000)
+    0x00, 0x00, 0x00, 0x00,             //   count: 0
+    0x0E, 0x00, 0x08, 0x10,             // LF_PROCEDURE (0x1001)
+    0x74, 0x00, 0x00, 0x00,             //   ret_itype: int
+    0x00, 0x00, 0x00, 0x00,             //   call_kind, attribs, arg_count
+    0x00, 0x10, 0x00, 0x00,             //   arg_itype: 0x1000
+  };
+  U8 text_a[] = {
+    0xB8, 0x01, 0x00, 0x00, 0x00, // mov eax, 1
+    0xC3                          // ret
+  };
+  U8 text_b[] = {
+    0xB8, 0x02, 0x00, 0x00, 0x00, // mov eax, 2
+    0xC3                          // ret
+  };
+  String8 texts[] = { str8_array_fixed(text_a), str8_array_fixed(text_b) };
+  String8 objs[ArrayCount(texts)];
+  for EachElement(i, texts) {
+    COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    COFF_ObjSection *sect       = coff_obj_writer_push_section(obj_writer, str8_lit(".text"), PE_TEXT_SECTION_FLAGS, texts[i]);
+    coff_obj_writer_push_section(obj_writer, str8_lit(".debug$T"), PE_DEBUG_SECTION_FLAGS|COFF_SectionFlag_Align4Bytes, str8_array_fixed(debug_t));
+    coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, sect);
+    objs[i] = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+  }
+
+  // first link populates the cache
+  if (!t_write_file(str8_lit("entry.obj"), objs[0])) { goto exit; }
+  int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /incremental /debug:full /out:a.exe entry.obj");
+  if (linker_exit_code != 0) { goto exit; }
+  String8 type_cache = t_read_file(scratch.arena, str8_lit("a.exe.rlt"));
+  U64 entry_header_size = sizeof(U128)*3 + sizeof(U64)*3;
+  if (type_cache.size != AlignPow2(sizeof(U64)*3 + entry_header_size + (sizeof(U128) + sizeof(U32))*2, 16)) { goto exit; }
+
+  // time stamp and size of obj change with every write, the rest of the entry depends only on types
+  U64 type_cache_types_off = sizeof(U64)*3 + sizeof(U128) + sizeof(U64)*2;
+  String8 pdb = t_read_file(scratch.arena, str8_lit("a.pdb"));
+
+  // code changed but types did not, leaf hashes come from the cache
+  if (!t_write_file(str8_lit("entry.obj"), objs[1])) { goto exit; }
+  linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /incremental /debug:full /out:a.exe entry.obj");
+  if (linker_exit_code != 0) { goto exit; }
+  String8 cached_type_cache = t_read_file(scratch.arena, str8_lit("a.exe.rlt"));
+  if (!str8_match(str8_skip(type_cache, type_cache_types_off), str8_skip(cached_type_cache, type_cache_types_off), 0)) { goto exit; }
+  String8 cached_pdb = t_read_file(scratch.arena, str8_lit("a.pdb"));
+  if (cached_pdb.size != pdb.size) { goto exit; }
+
+  // corrupted cache must be discarded
+  if (!t_write_file(str8_lit("a.exe.rlt"), str8_lit("garbage"))) { goto exit; }
+  if (!t_write_file(str8_lit("entry.obj"), objs[0])) { goto exit; }
+  linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /incremental /debug:full /out:a.exe entry.obj");
+  if (linker_exit_code != 0) { goto exit; }
+  String8 rebuilt_type_cache = t_read_file(scratch.arena, str8_lit("a.exe.rlt"));
+  if (!str8_match(str8_skip(type_cache, type_cache_types_off), str8_skip(rebuilt_type_cache, type_cache_types_off), 0)) { goto exit; }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_debug_ghash(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  U8 debug_t[] = {
+    0x04, 0x00, 0x00, 0x00,             // CV_Signature_C13
+    0x06, 0x00, 0x01, 0x12,             // LF_ARGLIST (0x1000)
+    0x00, 0x00, 0x00, 0x00,             //   count: 0
+    0x0E, 0x00, 0x08, 0x10,             // LF_PROCEDURE (0x1001)
+    0x74, 0x00, 0x00, 0x00,             //   ret_itype: int
+    0x00, 0x00, 0x00, 0x00,             //   call_kind, attribs, arg_count
+    0x00, 0x10, 0x00, 0x00,             //   arg_itype: 0x1000
+  };
+
+  // both objs have identical leaves, but global hashes disagree, so types dedup
+  // only when linker computes hashes itself
+  U8 debug_h_a[] = {
+    0xC5, 0xC9, 0x33, 0x01,             // magic
+    0x00, 0x00,                         // version
+    0x02, 0x00,                         // hash_alg: BLAKE3
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x1000
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x1001
+  };
+  U8 debug_h_b[] = {
+    0xC5, 0xC9, 0x33, 0x01,             // magic
+    0x00, 0x00,                         // version
+    0x02, 0x00,                         // hash_alg: BLAKE3
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x1000
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x1001
+  };
+  U8 debug_h_bad[] = {
+    0xC5, 0xC9, 0x33, 0x01,             // magic
+    0x00, 0x00,                         // version
+    0x02, 0x00,                         // hash_alg: BLAKE3
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // one hash for two leaves
+  };
+
+  struct { char *obj_name; char *symbol_name; String8 debug_h; } objs[] = {
+    { "a.obj",     "entry", str8_array_fixed(debug_h_a)   },
+    { "b.obj",     "b",     str8_array_fixed(debug_h_b)   },
+    { "a_bad.obj", "entry", str8_array_fixed(debug_h_bad) },
+    { "b_bad.obj", "b",     str8_array_fixed(debug_h_bad) },
+  };
+  for EachElement(i, objs) {
+    U8 text[] = { 0xC3 };
+    COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    COFF_ObjSection *sect       = coff_obj_writer_push_section(obj_writer, str8_lit(".text"), PE_TEXT_SECTION_FLAGS, str8_array_fixed(text));
+    coff_obj_writer_push_section(obj_writer, str8_lit(".debug$T"), PE_DEBUG_SECTION_FLAGS|COFF_SectionFlag_Align4Bytes, str8_array_fixed(debug_t));
+    coff_obj_writer_push_section(obj_writer, str8_lit(".debug$H"), PE_DEBUG_SECTION_FLAGS|COFF_SectionFlag_Align4Bytes, objs[i].debug_h);
+    coff_obj_writer_push_symbol_extern(obj_writer, str8_cstring(objs[i].symbol_name), 0, sect);
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_cstring(objs[i].obj_name), obj)) { goto exit; }
+  }
+
+  // .debug$H is ignored outside of /DEBUG:GHASH
+  int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /debug:full /out:a.exe a.obj b.obj");
+  if (linker_exit_code != 0) { goto exit; }
+  if (t_tpi_type_count_from_pdb(t_read_file(scratch.arena, str8_lit("a.pdb"))) != 2) { goto exit; }
+
+  // hashes from .debug$H are used as is
+  linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /debug:ghash /out:a.exe a.obj b.obj");
+  if (linker_exit_code != 0) { goto exit; }
+  if (t_tpi_type_count_from_pdb(t_read_file(scratch.arena, str8_lit("a.pdb"))) != 4) { goto exit; }
+
+  // malformed .debug$H is a warning, leaves are hashed instead
+  linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /debug:ghash /out:a.exe a_bad.obj b_bad.obj");
+  if (linker_exit_code != 0) { goto exit; }
+  if (t_tpi_type_count_from_pdb(t_read_file(scratch.arena, str8_lit("a.pdb"))) != 2) { goto exit; }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_debug_fastlink(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  U8 debug_t[] = {
+    0x04, 0x00, 0x00, 0x00,             // CV_Signature_C13
+    0x06, 0x00, 0x01, 0x12,             // LF_ARGLIST (0x1000)
+    0x00, 0x00, 0x00, 0x00,             //   count: 0
+    0x0E, 0x00, 0x08, 0x10,             // LF_PROCEDURE (0x1001)
+    0x74, 0x00, 0x00, 0x00,             //   ret_itype: int
+    0x00, 0x00, 0x00, 0x00,             //   call_kind, attribs, arg_count
+    0x00, 0x10, 0x00, 0x00,             //   arg_itype: 0x1000
+  };
+  U8 text_a[] = {
+    0xB8, 0x01, 0x00, 0x00, 0x00, // mov eax, 1
+    0xC3                          // ret
+  };
+  U8 text_b[] = {
+    0x90,                         // nop
+    0xB8, 0x02, 0x00, 0x00, 0x00, // mov eax, 2
+    0xC3                          // ret
+  };
+  String8 texts[] = { str8_array_fixed(text_a), str8_array_fixed(text_b) };
+  String8 objs[ArrayCount(texts)];
+  for EachElement(i, texts) {
+    COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    COFF_ObjSection *sect       = coff_obj_writer_push_section(obj_writer, str8_lit(".text"), PE_TEXT_SECTION_FLAGS, texts[i]);
+    coff_obj_writer_push_section(obj_writer, str8_lit(".debug$T"), PE_DEBUG_SECTION_FLAGS|COFF_SectionFlag_Align4Bytes, str8_array_fixed(debug_t));
+    coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, sect);
+    objs[i] = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+  }
+  if (!t_write_file(str8_lit("entry.obj"), objs[0])) { goto exit; }
+
+  // stale debug info from a full link must be removed by the fastlink
+  int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /debug:full /out:a.exe entry.obj");
+  if (linker_exit_code != 0) { goto exit; }
+  if (!os_file_path_exists(t_make_file_path(scratch.arena, str8_lit("a.pdb")))) { goto exit; }
+
+  // debug info is deferred, only the manifest is written
+  linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /debug:fastlink /out:a.exe entry.obj");
+  if (linker_exit_code != 0) { goto exit; }
+  if (!os_file_path_exists(t_make_file_path(scratch.arena, str8_lit("a.rfl")))) { goto exit; }
+  if (os_file_path_exists(t_make_file_path(scratch.arena, str8_lit("a.pdb")))) { goto exit; }
+  String8 image = t_read_file(scratch.arena, str8_lit("a.exe"));
+
+  // materialize builds debug info without touching the image
+  linker_exit_code = t_invoke_linkerf("/rad_materialize_debug_info:a.rfl");
+  if (linker_exit_code != 0) { goto exit; }
+  if (t_tpi_type_count_from_pdb(t_read_file(scratch.arena, str8_lit("a.pdb"))) != 2) { goto exit; }
+  if (!str8_match(image, t_read_file(scratch.arena, str8_lit("a.exe")), 0)) { goto exit; }
+
+  // input changed after the image was linked, materialize must refuse
+  if (!os_delete_file_at_path(t_make_file_path(scratch.arena, str8_lit("a.pdb")))) { goto exit; }
+  if (!t_write_file(str8_lit("entry.obj"), objs[1])) { goto exit; }
+  linker_exit_code = t_invoke_linkerf("/rad_materialize_debug_info:a.rfl");
+  if (linker_exit_code == 0) { goto exit; }
+  if (os_file_path_exists(t_make_file_path(scratch.arena, str8_lit("a.pdb")))) { goto exit; }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_order(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  {
+    COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    U8 text[] = { 0xC3 };
+    COFF_ObjSection *text_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".text"), PE_TEXT_SECTION_FLAGS, str8_array_fixed(text));
+    coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, text_sect);
+
+    char *f_names[] = { "f1", "f2", "f3" };
+    U8    ptrs[12]  = {0};
+    COFF_ObjSection *ptrs_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".ptrs"), PE_DATA_SECTION_FLAGS, str8_array_fixed(ptrs));
+    for EachElement(i, f_names) {
+      U8 f_text[] = {
+        0xB8, (U8)i, 0x00, 0x00, 0x00, // mov eax, $i
+        0xC3                           // ret
+      };
+      COFF_ObjSection *f_sect = coff_obj_writer_push_section(obj_writer, str8_lit(".text$f"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_LnkCOMDAT, push_str8_copy(scratch.arena, str8_array_fixed(f_text)));
+      coff_obj_writer_push_symbol_secdef(obj_writer, f_sect, COFF_ComdatSelect_Any);
+      COFF_ObjSymbol *f = coff_obj_writer_push_symbol_extern(obj_writer, str8_cstring(f_names[i]), 0, f_sect);
+      coff_obj_writer_section_push_reloc_voff(obj_writer, ptrs_sect, i * sizeof(U32), f);
+    }
+
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("entry.obj"), obj)) { goto exit; }
+  }
+
+  // unknown symbols in the order file are a warning
+  if (!t_write_file(str8_lit("order.txt"), str8_lit("f3\r\nmissing\r\nf2\r\nf1\r\n"))) { goto exit; }
+  if (!t_write_file(str8_lit("call_graph.txt"), str8_lit("f3 f1 100\n"))) { goto exit; }
+
+  struct { char *switches; U32 expected_order[3]; } links[] = {
+    { "",                                     { 0, 1, 2 } },
+    { "/order:@order.txt",                    { 2, 1, 0 } },
+    { "/rad_call_graph_order:call_graph.txt", { 2, 0, 1 } },
+  };
+  for EachElement(link_idx, links) {
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe %s entry.obj", links[link_idx].switches);
+    if (linker_exit_code != 0) { goto exit; }
+
+    String8             exe           = t_read_file(scratch.arena, str8_lit("a.exe"));
+    PE_BinInfo          pe            = pe_bin_info_from_data(scratch.arena, exe);
+    COFF_SectionHeader *section_table = (COFF_SectionHeader *)str8_substr(exe, pe.section_table_range).str;
+    COFF_SectionHeader *ptrs_sect     = t_coff_section_header_from_name(exe, section_table, pe.section_count, str8_lit(".ptrs"));
+    if (ptrs_sect == 0 || ptrs_sect->vsize < 12) { goto exit; }
+
+    // functions must be laid out in the expected order
+    U32 *ptrs = (U32 *)(exe.str + ptrs_sect->foff);
+    U32 *expected_order = links[link_idx].expected_order;
+    if (ptrs[expected_order[0]] >= ptrs[expected_order[1]]) { goto exit; }
+    if (ptrs[expected_order[1]] >= ptrs[expected_order[2]]) { goto exit; }
+  }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_debug_info_parity(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  U8 debug_t[] = {
+    0x04, 0x00, 0x00, 0x00,             // CV_Signature_C13
+    0x06, 0x00, 0x01, 0x12,             // LF_ARGLIST (0x1000)
+    0x00, 0x00, 0x00, 0x00,             //   count: 0
+    0x0E, 0x00, 0x08, 0x10,             // LF_PROCEDURE (0x1001)
+    0x74, 0x00, 0x00, 0x00,             //   ret_itype: int
+    0x00, 0x00, 0x00, 0x00,             //   call_kind, attribs, arg_count
+    0x00, 0x10, 0x00, 0x00,             //   arg_itype: 0x1000
+  };
+  struct { char *obj_name; char *symbol_name; } objs[] = {
+    { "a.obj", "entry" },
+    { "b.obj", "b"     },
+  };
+  for EachElement(i, objs) {
+    U8 text[] = { 0xC3 };
+    COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    COFF_ObjSection *sect       = coff_obj_writer_push_section(obj_writer, str8_lit(".text"), PE_TEXT_SECTION_FLAGS, str8_array_fixed(text));
+    coff_obj_writer_push_section(obj_writer, str8_lit(".debug$T"), PE_DEBUG_SECTION_FLAGS|COFF_SectionFlag_Align4Bytes, str8_array_fixed(debug_t));
+    coff_obj_writer_push_symbol_extern(obj_writer, str8_cstring(objs[i].symbol_name), 0, sect);
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_cstring(objs[i].obj_name), obj)) { goto exit; }
+  }
+
+  // single worker builds PDB and RDI one after another, more workers build them concurrently;
+  // with fixed image identity both must produce the same bytes
+  String8 pdbs[2]    = {0};
+  String8 rdis[2]    = {0};
+  U32     workers[2] = { 1, 4 };
+  for EachElement(i, workers) {
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /debug:full /rad_debug /rad_workers:%u /rad_guid:00000000-0000-0000-0000-000000000001 /rad_time_stamp:1 /out:a.exe a.obj b.obj", workers[i]);
+    if (linker_exit_code != 0) { goto exit; }
+    pdbs[i] = t_read_file(scratch.arena, str8_lit("a.pdb"));
+    rdis[i] = t_read_file(scratch.arena, str8_lit("a.rdi"));
+    if (t_tpi_type_count_from_pdb(pdbs[i]) != 2) { goto exit; }
+    if (rdis[i].size == 0) { goto exit; }
+  }
+  if (!str8_match(pdbs[0], pdbs[1], 0)) { goto exit; }
+  if (!str8_match(rdis[0], rdis[1], 0)) { goto exit; }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////
 
 internal void
@@ -5021,6 +5555,13 @@ entry_point(CmdLine *cmdline)
     { "function_pad_min",                  t_function_pad_min                  },
     { "first_member_header",               t_first_member_header               },
     { "second_member_header",              t_second_member_header              },
+    { "opt_icf",                           t_opt_icf                           },
+    { "incremental",                       t_incremental                       },
+    { "incremental_type_cache",            t_incremental_type_cache            },
+    { "debug_ghash",                       t_debug_ghash                       },
+    { "debug_fastlink",                    t_debug_fastlink                    },
+    { "order",                             t_order                             },
+    { "debug_info_parity",                 t_debug_info_parity                 },
   };
 
   //